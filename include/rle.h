@@ -85,7 +85,8 @@ enum rle_pack_status {
 	RLE_PACK_ERR,                /**< Default error. SDUs should be dropped.                   */
 	RLE_PACK_ERR_FPDU_TOO_SMALL, /**< Error. FPDU is too small for the current PPDU. No drop.  */
 	RLE_PACK_ERR_INVALID_PPDU,   /**< Error. Current PPDU is invalid, maybe NULL or bad size.  */
-	RLE_PACK_ERR_INVALID_LAB     /**< Error. Current label is invalid, maybe NULL or bad size. */
+	RLE_PACK_ERR_INVALID_LAB,    /**< Error. Current label is invalid, maybe NULL or bad size. */
+	RLE_PACK_ERR_INVALID_SDU     /**< Error. Current SDU is invalid, maybe NULL or bad size.   */
 };
 
 /** Status of the decapsulation. */
@@ -97,7 +98,8 @@ enum rle_decap_status {
 	RLE_DECAP_ERR_SOME_DROP, /**< Error. Some SDUs were dropped. Some may be lost.          */
 	RLE_DECAP_ERR_INV_FPDU,  /**< Error. Invalid FPDU. Maybe Null or bad size.              */
 	RLE_DECAP_ERR_INV_SDUS,  /**< Error. Given preallocated SDUs array is invalid.          */
-	RLE_DECAP_ERR_INV_PL     /**< Error. Given preallocated payload label array is invalid. */
+	RLE_DECAP_ERR_INV_PL,    /**< Error. Given preallocated payload label array is invalid. */
+	RLE_DECAP_NEED_RCVR      /**< The FPDU contains PPDU fragments, a receiver is needed.   */
 };
 
 /** Status of RLE header size. */
@@ -188,6 +190,12 @@ struct rle_receiver;
  */
 struct rle_frag_buf;
 
+/**
+ * Memory pool.
+ * Holds the transmitters, receivers and their buffers on the NUMA node of a worker thread.
+ */
+struct rle_pool;
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*--------------------------------- PUBLIC STRUCTS AND TYPEDEFS ----------------------------------*/
@@ -321,6 +329,28 @@ struct rle_receiver_stats {
 	uint64_t bytes_dropped;     /**< Number of octets dropped.              */
 };
 
+/**
+ * Configuration of a memory pool.
+ *
+ * A pool holds the transmitters and receivers of one worker thread, with their fragmentation
+ * and reassembly buffers, in large chunks of memory placed on the NUMA node of the worker.
+ */
+struct rle_pool_config {
+	/** The NUMA node of the memory, -1 for the node of the CPU of the calling thread */
+	int numa_node;
+	/** Whether the memory is backed by 2 MB huge pages, if any is available (0 or 1) */
+	int use_hugepages;
+};
+
+/** Statistics of a memory pool. */
+struct rle_pool_stats {
+	uint64_t chunks_nr;           /**< Number of chunks of memory mapped.                */
+	uint64_t hugepage_chunks_nr;  /**< Number of chunks backed by huge pages.            */
+	uint64_t bytes_mapped;        /**< Number of octets mapped.                          */
+	uint64_t bytes_used;          /**< Number of octets given and not yet given back.    */
+	int numa_node;                /**< NUMA node the memory is bound to, -1 if none.     */
+};
+
 /*------------------------------------------------------------------------------------------------*/
 /*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
@@ -328,6 +358,10 @@ struct rle_receiver_stats {
 /**
  * @brief         Create and initialize a RLE transmitter module.
  *
+ *                The fragmentation buffers of the transmitter are allocated once, of
+ *                RLE_MAX_PDU_SIZE octets each. Only the transmitters created in a memory pool by
+ *                rle_transmitter_new_in_pool() fit the buffers to the size class of each SDU.
+ *
  * @param[in]     conf  The configuration of the RLE transmitter.
  *
  * @return        A pointer to the transmitter module.
@@ -346,6 +380,29 @@ __attribute__((warn_unused_result));
  */
 void rle_transmitter_destroy(struct rle_transmitter **const transmitter);
 
+/**
+ * @brief         Enable the ALPDU cache of a RLE transmitter.
+ *
+ *                The cache keeps the ALPDU header and the CRC of the last 16 distinct SDUs of up
+ *                to 256 octets, such as the L2S signalling SDUs and the keep-alives that are sent
+ *                unchanged again and again. \ref rle_encapsulate gives the SDUs found there the
+ *                ALPDU header and the CRC of the cache instead of building them again. The cache
+ *                is taken from the memory pool of the transmitter, or from the heap, and is
+ *                destroyed with the transmitter.
+ *
+ *                The cache is refused to the transmitters configured with ALPDU sequence numbers
+ *                (allow_alpdu_sequence_number set, or allow_alpdu_crc not set), which have no CRC
+ *                to save.
+ *
+ * @param[in,out] transmitter              The transmitter.
+ *
+ * @return        0 if OK, else 1, for instance if the ALPDUs are not protected by a CRC.
+ *
+ * @ingroup       RLE transmitter
+ */
+int rle_transmitter_enable_alpdu_cache(struct rle_transmitter *const transmitter)
+__attribute__((warn_unused_result));
+
 /**
  * @brief         Create and initialize a RLE receiver module.
  *
@@ -367,9 +424,120 @@ __attribute__((warn_unused_result));
  */
 void rle_receiver_destroy(struct rle_receiver **const receiver);
 
+/**
+ * @brief         Create a memory pool for the transmitters and receivers of one thread.
+ *
+ *                The memory is mapped by chunks of 2 MB, bound to the NUMA node of the
+ *                configuration, and backed by huge pages if requested and available, normal
+ *                pages otherwise. All the buffers given by the pool are aligned on cache lines.
+ *                A pool is not thread-safe: the instances of a pool shall be created and
+ *                destroyed by one thread at a time.
+ *
+ * @param[in]     conf  The configuration of the pool.
+ *
+ * @return        A pointer to the pool, NULL in case of error.
+ *
+ * @ingroup       RLE pool
+ */
+struct rle_pool * rle_pool_new(const struct rle_pool_config *const conf)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Destroy a memory pool.
+ *
+ *                All the transmitters and receivers created in the pool shall be destroyed
+ *                before.
+ *
+ * @param[in,out] pool                     The pool to destroy.
+ *
+ * @ingroup       RLE pool
+ */
+void rle_pool_destroy(struct rle_pool **const pool);
+
+/**
+ * @brief         Get the statistics of a memory pool.
+ *
+ * @param[in]     pool                     The pool.
+ * @param[out]    stats                    The statistics.
+ *
+ * @ingroup       RLE pool
+ */
+void rle_pool_get_stats(const struct rle_pool *const pool, struct rle_pool_stats *const stats);
+
+/**
+ * @brief         Allocate a buffer in a memory pool, for instance for the FPDUs of a thread.
+ *
+ *                The buffers are recycled by size. A pool keeps the buffers of up to 16 sizes,
+ *                its transmitters, receivers and their buffers included; the buffers of the
+ *                other sizes are taken in the next power of 2, so they may use up to twice
+ *                their size.
+ *
+ * @param[in,out] pool                     The pool.
+ * @param[in]     size                     The size of the buffer.
+ *
+ * @return        The buffer, aligned on a cache line, NULL in case of error.
+ *
+ * @ingroup       RLE pool
+ */
+void * rle_pool_buf_new(struct rle_pool *const pool, const size_t size)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Give back a buffer to the memory pool it was allocated in.
+ *
+ *                While the pool has less than 16 sizes, a size never allocated in the pool is
+ *                reported as an error, and the buffer is not given back.
+ *
+ * @param[in,out] pool                     The pool.
+ * @param[in,out] buf                      The buffer, set to NULL.
+ * @param[in]     size                     The size of the buffer, as allocated.
+ *
+ * @ingroup       RLE pool
+ */
+void rle_pool_buf_del(struct rle_pool *const pool, void **const buf, const size_t size);
+
+/**
+ * @brief         Create and initialize a RLE transmitter module in a memory pool.
+ *
+ *                The transmitter and its fragmentation buffers are given by the pool. It is
+ *                destroyed by rle_transmitter_destroy(), before the pool. Every SDU is copied in a
+ *                fragmentation buffer of its size class, 256, 2048 or RLE_MAX_PDU_SIZE octets,
+ *                taken from the pool by \ref rle_encapsulate. The transmitters created on the
+ *                heap by rle_transmitter_new() keep their RLE_MAX_PDU_SIZE-octet buffers instead.
+ *
+ * @param[in]     conf  The configuration of the RLE transmitter.
+ * @param[in,out] pool  The memory pool.
+ *
+ * @return        A pointer to the transmitter module.
+ *
+ * @ingroup       RLE transmitter
+ */
+struct rle_transmitter * rle_transmitter_new_in_pool(const struct rle_config *const conf,
+                                                     struct rle_pool *const pool)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Create and initialize a RLE receiver module in a memory pool.
+ *
+ *                The receiver and its reassembly buffers are given by the pool. It is
+ *                destroyed by rle_receiver_destroy(), before the pool.
+ *
+ * @param[in]     conf  The configuration of the RLE receiver.
+ * @param[in,out] pool  The memory pool.
+ *
+ * @return        A pointer to the receiver module.
+ *
+ * @ingroup       RLE receiver
+ */
+struct rle_receiver * rle_receiver_new_in_pool(const struct rle_config *const conf,
+                                               struct rle_pool *const pool)
+__attribute__((warn_unused_result));
+
 /**
  * @brief         Create a new fragmentation buffer.
  *
+ *                The buffer holds SDUs of up to RLE_MAX_PDU_SIZE octets.
+ *
  * @return        The fragmentation buffer if OK, else NULL
  *
  * @ingroup       RLE Fragmentation buffer
@@ -377,6 +545,23 @@ void rle_receiver_destroy(struct rle_receiver **const receiver);
 struct rle_frag_buf * rle_frag_buf_new(void)
 __attribute__((warn_unused_result));
 
+/**
+ * @brief         Create a new fragmentation buffer for SDUs of up to the given size.
+ *
+ *                The buffer is of the smallest size class, 256, 2048 or RLE_MAX_PDU_SIZE octets
+ *                of SDU, that holds sdu_max_size octets: the buffers of small SDUs are a few
+ *                cache lines instead of a few pages. Longer SDUs are refused by
+ *                \ref rle_frag_buf_cpy_sdu.
+ *
+ * @param[in]     sdu_max_size             The size of the longest SDU, up to RLE_MAX_PDU_SIZE.
+ *
+ * @return        The fragmentation buffer if OK, else NULL
+ *
+ * @ingroup       RLE Fragmentation buffer
+ */
+struct rle_frag_buf * rle_frag_buf_new_sized(const size_t sdu_max_size)
+__attribute__((warn_unused_result));
+
 /**
  * @brief         Destroy a fragmentation buffer.
  *
@@ -408,7 +593,8 @@ __attribute__((warn_unused_result));
  *                         initialized.
  * @param[in]     sdu      The SDU to copy.
  *
- * @return        0 if OK, else 1.
+ * @return        0 if OK, else 1, for instance if the SDU is longer than the size class of the
+ *                fragmentation buffer.
  *
  * @ingroup       RLE Fragmentation buffer
  */
@@ -512,6 +698,45 @@ enum rle_frag_status rle_frag_contextless(struct rle_transmitter *const transmit
                                           size_t *const ppdu_length)
 __attribute__((warn_unused_result));
 
+/**
+ * @brief         RLE stateless encapsulation. Pack one SDU in a COMPLETE PPDU in the given FPDU.
+ *
+ *                The ALPDU and the COMPLETE PPDU are built straight in the FPDU, with neither a
+ *                transmitter nor a fragmentation buffer: the function only reads the
+ *                configuration and the SDU, so any number of threads may share one
+ *                configuration and encapsulate in their own FPDUs.
+ *
+ *                The configuration shall be a valid one, as accepted by
+ *                \ref rle_transmitter_new. A COMPLETE PPDU has no ALPDU trailer, so the same
+ *                PPDU is built whether CRC or sequence number is used.
+ *
+ *                If the SDU does not fit in the remaining room of the FPDU, or if its ALPDU is
+ *                too long for a COMPLETE PPDU, nothing is written and the SDU is not dropped: it
+ *                may be packed in the next FPDU, or be encapsulated by \ref rle_encapsulate then
+ *                fragmented by \ref rle_fragment.
+ *
+ * @param[in]     conf                    The RLE configuration.
+ * @param[in]     sdu                     The SDU to encapsulate.
+ * @param[in]     label                   The FPDU label fields.
+ * @param[in]     label_size              Size of the FPDU label fields.
+ * @param[in,out] fpdu                    Generated/modified Frame PDU.
+ * @param[in,out] fpdu_current_pos        Current position in the FPDU.
+ * @param[in,out] fpdu_remaining_size     Remaining size in the FPDU.
+ *
+ * @return        Frame packing status, RLE_PACK_ERR_FPDU_TOO_SMALL if the SDU needs another FPDU
+ *                or fragmentation.
+ *
+ * @ingroup       RLE transmitter
+ */
+enum rle_pack_status rle_encap_pack_complete(const struct rle_config *const conf,
+                                             const struct rle_sdu *const sdu,
+                                             const unsigned char *const label,
+                                             const size_t label_size,
+                                             unsigned char *const fpdu,
+                                             size_t *const fpdu_current_pos,
+                                             size_t *const fpdu_remaining_size)
+__attribute__((warn_unused_result));
+
 /**
  * @brief         Init the given FPDU with the given Payload Label
  *
@@ -609,6 +834,43 @@ enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
                                       const size_t payload_label_size)
 __attribute__((warn_unused_result));
 
+/**
+ * @brief Decapsulate the given FPDU of COMPLETE PPDUs into zero or more SDUs, without receiver
+ *
+ * COMPLETE PPDUs need no reassembly context: the function only reads the configuration, so
+ * any number of threads may share one configuration and decapsulate their own FPDUs in
+ * parallel. The configuration shall be the one of the receiver of the FPDU.
+ *
+ * The PPDU headers of the whole FPDU are checked first. If one of the PPDUs is a START, CONT or
+ * END fragment, nothing is decapsulated and RLE_DECAP_NEED_RCVR is returned: the FPDU shall
+ * then be given as is to \ref rle_decapsulate with the receiver of its terminal.
+ *
+ * The payload label and the SDUs array are handled as by \ref rle_decapsulate.
+ *
+ * @param[in]     conf                    The configuration of the receiver.
+ * @param[in]     fpdu                    The FPDU to decapsulate.
+ * @param[in]     fpdu_length             The size of the FPDU.
+ * @param[in,out] sdus                    The SDUs array to extract from the FPDU, preallocated.
+ * @param[in]     sdus_max_nr             The SDUs array size, max number of extractable SDUs.
+ * @param[out]    sdus_nr                 The current number of SDUs in the SDUs array, 0 if
+ *                                        RLE_DECAP_NEED_RCVR is returned.
+ * @param[in,out] payload_label           The identifier of the RCST, preallocated.
+ * @param[in]     payload_label_size      The size of the paylod label.
+ *
+ * @return        decapsulation status, RLE_DECAP_NEED_RCVR if the FPDU contains fragments.
+ *
+ * @ingroup       RLE receiver
+ */
+enum rle_decap_status rle_decapsulate_complete(const struct rle_config *const conf,
+                                               unsigned char *const fpdu,
+                                               const size_t fpdu_length,
+                                               struct rle_sdu sdus[],
+                                               const size_t sdus_max_nr,
+                                               size_t *const sdus_nr,
+                                               unsigned char *const payload_label,
+                                               const size_t payload_label_size)
+__attribute__((warn_unused_result));
+
 /**
  * @brief         Get occupied size of a queue (frag_id) in an RLE transmitter module.
  *
@@ -738,6 +1000,32 @@ __attribute__((warn_unused_result));
 void rle_transmitter_stats_reset_counters(struct rle_transmitter *const transmitter,
                                           const uint8_t fragment_id);
 
+/**
+ * @brief         Get the number of SDUs found in the ALPDU cache of a RLE transmitter.
+ *
+ * @param[in]     transmitter              The transmitter module. Must be initialize.
+ *
+ * @return        Number of SDUs found in the cache, 0 if the cache is disabled.
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+uint64_t rle_transmitter_stats_get_alpdu_cache_hits(const struct rle_transmitter *const transmitter)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Get the number of SDUs looked for but not found in the ALPDU cache of a RLE
+ *                transmitter.
+ *
+ * @param[in]     transmitter              The transmitter module. Must be initialize.
+ *
+ * @return        Number of SDUs not found in the cache, 0 if the cache is disabled.
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+uint64_t rle_transmitter_stats_get_alpdu_cache_misses(
+	const struct rle_transmitter *const transmitter)
+__attribute__((warn_unused_result));
+
 /**
  * @brief         Get occupied size of a queue (frag_id) in a RLE receiver queue.
  *
@@ -973,7 +1261,8 @@ typedef enum {
 	RLE_MOD_ID_CTX = 9,
 	RLE_MOD_ID_RECEIVER = 10,
 	RLE_MOD_ID_TRANSMITTER = 11,
-	RLE_MOD_ID_TRAILER = 12
+	RLE_MOD_ID_TRAILER = 12,
+	RLE_MOD_ID_POOL = 13
 } rle_mod_id_t;
 
 
@@ -41,14 +41,23 @@ MODULE_DESCRIPTION(PACKAGE_NAME ", version " PACKAGE_VERSION);
 
 EXPORT_SYMBOL(rle_transmitter_new);
 EXPORT_SYMBOL(rle_transmitter_destroy);
+EXPORT_SYMBOL(rle_transmitter_enable_alpdu_cache);
 EXPORT_SYMBOL(rle_receiver_new);
 EXPORT_SYMBOL(rle_receiver_destroy);
+EXPORT_SYMBOL(rle_pool_new);
+EXPORT_SYMBOL(rle_pool_destroy);
+EXPORT_SYMBOL(rle_pool_get_stats);
+EXPORT_SYMBOL(rle_pool_buf_new);
+EXPORT_SYMBOL(rle_pool_buf_del);
+EXPORT_SYMBOL(rle_transmitter_new_in_pool);
+EXPORT_SYMBOL(rle_receiver_new_in_pool);
 EXPORT_SYMBOL(rle_encapsulate);
 EXPORT_SYMBOL(rle_fragment);
 EXPORT_SYMBOL(rle_pack);
 EXPORT_SYMBOL(rle_pack_init);
 EXPORT_SYMBOL(rle_pad);
 EXPORT_SYMBOL(rle_decapsulate);
+EXPORT_SYMBOL(rle_decapsulate_complete);
 EXPORT_SYMBOL(rle_transmitter_stats_get_queue_size);
 EXPORT_SYMBOL(rle_transmitter_stats_get_counter_sdus_in);
 EXPORT_SYMBOL(rle_transmitter_stats_get_counter_sdus_sent);
@@ -58,6 +67,8 @@ EXPORT_SYMBOL(rle_transmitter_stats_get_counter_bytes_sent);
 EXPORT_SYMBOL(rle_transmitter_stats_get_counter_bytes_dropped);
 EXPORT_SYMBOL(rle_transmitter_stats_get_counters);
 EXPORT_SYMBOL(rle_transmitter_stats_reset_counters);
+EXPORT_SYMBOL(rle_transmitter_stats_get_alpdu_cache_hits);
+EXPORT_SYMBOL(rle_transmitter_stats_get_alpdu_cache_misses);
 EXPORT_SYMBOL(rle_receiver_stats_get_queue_size);
 EXPORT_SYMBOL(rle_receiver_stats_get_counter_sdus_received);
 EXPORT_SYMBOL(rle_receiver_stats_get_counter_sdus_reassembled);
@@ -73,8 +84,10 @@ EXPORT_SYMBOL(rle_header_ptype_is_compressible);
 EXPORT_SYMBOL(rle_header_ptype_compression);
 EXPORT_SYMBOL(rle_get_header_size);
 EXPORT_SYMBOL(rle_frag_buf_new);
+EXPORT_SYMBOL(rle_frag_buf_new_sized);
 EXPORT_SYMBOL(rle_frag_buf_del);
 EXPORT_SYMBOL(rle_frag_buf_init);
 EXPORT_SYMBOL(rle_frag_buf_cpy_sdu);
 EXPORT_SYMBOL(rle_encap_contextless);
 EXPORT_SYMBOL(rle_frag_contextless);
+EXPORT_SYMBOL(rle_encap_pack_complete);
@@ -0,0 +1,179 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   alpdu_cache.c
+ * @brief  Cache of the ALPDU headers and CRCs of the short SDUs sent again and again.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#include "alpdu_cache.h"
+#include "fragmentation_buffer.h"
+#include "rle_pool.h"
+
+#ifndef __KERNEL__
+
+#include <string.h>
+#include <assert.h>
+
+#else
+
+#include <linux/string.h>
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** The multiplier of the hash of the SDUs. */
+#define RLE_ALPDU_CACHE_HASH_MUL 0x9e3779b97f4a7c15ULL
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief  Hash a SDU, 8 octets at a time.
+ *
+ *         The hash only chooses the slot of the SDU and rejects most of the other SDUs of the
+ *         slot before they are compared, so it is much cheaper than the CRC of the SDU.
+ *
+ * @param[in] sdu  The SDU.
+ *
+ * @return  The hash.
+ */
+static uint64_t alpdu_cache_hash(const struct rle_sdu *const sdu);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static uint64_t alpdu_cache_hash(const struct rle_sdu *const sdu)
+{
+	const unsigned char *const buf = (const unsigned char *)sdu->buffer;
+	uint64_t hash = ((uint64_t)sdu->protocol_type << 32) | sdu->size;
+	uint64_t word;
+	size_t pos;
+
+	for (pos = 0; pos + sizeof(word) <= sdu->size; pos += sizeof(word)) {
+		memcpy(&word, buf + pos, sizeof(word));
+		hash = (hash ^ word) * RLE_ALPDU_CACHE_HASH_MUL;
+		hash ^= hash >> 29;
+	}
+	if (pos < sdu->size) {
+		word = 0;
+		memcpy(&word, buf + pos, sdu->size - pos);
+		hash = (hash ^ word) * RLE_ALPDU_CACHE_HASH_MUL;
+	}
+
+	/* the slot is taken in the low bits, mix the high ones in */
+	return hash ^ (hash >> 32);
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+struct alpdu_cache * alpdu_cache_new(struct rle_pool *const pool)
+{
+	struct alpdu_cache *cache;
+
+	cache = (struct alpdu_cache *)rle_pool_alloc(pool, sizeof(struct alpdu_cache));
+	if (cache != NULL) {
+		memset(cache, 0, sizeof(struct alpdu_cache));
+	}
+
+	return cache;
+}
+
+void alpdu_cache_del(struct rle_pool *const pool, struct alpdu_cache **const cache)
+{
+	if (cache == NULL || *cache == NULL) {
+		goto out;
+	}
+
+	rle_pool_free(pool, *cache, sizeof(struct alpdu_cache));
+	*cache = NULL;
+
+out:
+	return;
+}
+
+const struct alpdu_cache_entry * alpdu_cache_lookup(struct alpdu_cache *const cache,
+                                                    const struct rle_sdu *const sdu,
+                                                    uint64_t *const hash)
+{
+	const struct alpdu_cache_entry *entry;
+
+	assert(sdu->size > 0 && sdu->size <= RLE_ALPDU_CACHE_SDU_MAX_LEN);
+
+	*hash = alpdu_cache_hash(sdu);
+	entry = &cache->entries[*hash & (RLE_ALPDU_CACHE_ENTRIES_NR - 1)];
+
+	if (entry->hash != *hash || entry->sdu_len != sdu->size ||
+	    entry->protocol_type != sdu->protocol_type ||
+	    memcmp(entry->sdu, sdu->buffer, sdu->size) != 0) {
+		cache->counter_misses++;
+		entry = NULL;
+		goto out;
+	}
+
+	cache->counter_hits++;
+
+out:
+	return entry;
+}
+
+void alpdu_cache_store(struct alpdu_cache *const cache, const uint64_t hash,
+                       const struct rle_sdu *const sdu,
+                       const struct rle_frag_buf *const frag_buf)
+{
+	struct alpdu_cache_entry *const entry =
+		&cache->entries[hash & (RLE_ALPDU_CACHE_ENTRIES_NR - 1)];
+	const size_t alpdu_hdr_len = frag_buf_get_alpdu_hdr_len(frag_buf);
+
+	assert(sdu->size > 0 && sdu->size <= RLE_ALPDU_CACHE_SDU_MAX_LEN);
+	assert(alpdu_hdr_len <= sizeof(entry->alpdu_hdr));
+
+	entry->hash = hash;
+	entry->sdu_len = sdu->size;
+	entry->protocol_type = sdu->protocol_type;
+	entry->alpdu_hdr_len = alpdu_hdr_len;
+	/* the SDU is shorter in the buffer than given if the VLAN protocol type was omitted */
+	entry->omit_vlan_ptype = ((size_t)frag_buf_get_sdu_len(frag_buf) != sdu->size);
+	entry->crc = frag_buf->crc;
+	memcpy(entry->alpdu_hdr, frag_buf->alpdu.start, alpdu_hdr_len);
+	memcpy(entry->sdu, sdu->buffer, sdu->size);
+}
+
+void alpdu_cache_push_alpdu_hdr(const struct alpdu_cache_entry *const entry,
+                                struct rle_frag_buf *const frag_buf)
+{
+	frag_buf->crc = entry->crc;
+	push_alpdu_hdr_bytes(frag_buf, entry->alpdu_hdr, entry->alpdu_hdr_len,
+	                     entry->omit_vlan_ptype);
+}
@@ -0,0 +1,162 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   alpdu_cache.h
+ * @brief  Cache of the ALPDU headers and CRCs of the short SDUs sent again and again.
+ *
+ *         The L2S signalling SDUs and the keep-alives of a terminal are sent unchanged many
+ *         times. The cache keeps, for the last SDUs of each slot, the ALPDU header and the CRC
+ *         built for them, so the SDUs found there are not classified and CRC'd again. The slot
+ *         is chosen by a hash of the protocol type and the content of the SDU, and the SDU is
+ *         compared octet per octet to the one of the slot.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __ALPDU_CACHE_H__
+#define __ALPDU_CACHE_H__
+
+#include "rle.h"
+#include "header.h"
+
+#ifndef __KERNEL__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#else
+
+#include <linux/stddef.h>
+#include <linux/types.h>
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*---------------------------------- PUBLIC CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** The number of slots of an ALPDU cache, a power of 2. */
+#define RLE_ALPDU_CACHE_ENTRIES_NR 16U
+
+/** The longest SDU kept in an ALPDU cache, the longer ones are always encapsulated. */
+#define RLE_ALPDU_CACHE_SDU_MAX_LEN 256U
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PUBLIC STRUCTS AND TYPEDEFS ----------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** A slot of an ALPDU cache, with the last SDU encapsulated in it. */
+struct alpdu_cache_entry {
+	uint64_t hash;                                       /**< Hash of the SDU.            */
+	size_t sdu_len;                                      /**< SDU length, 0 if empty.     */
+	uint16_t protocol_type;                              /**< SDU protocol type.          */
+	uint8_t alpdu_hdr_len;                               /**< ALPDU header length.        */
+	bool omit_vlan_ptype;                                /**< VLAN protocol type omitted. */
+	uint32_t crc;                                        /**< CRC of the SDU.             */
+	unsigned char alpdu_hdr[sizeof(rle_alpdu_hdr_t)];    /**< ALPDU header.               */
+	unsigned char sdu[RLE_ALPDU_CACHE_SDU_MAX_LEN];      /**< SDU, before encapsulation.  */
+};
+
+/** ALPDU cache of a transmitter. */
+struct alpdu_cache {
+	uint64_t counter_hits;                               /**< SDUs found in the cache.     */
+	uint64_t counter_misses;                             /**< SDUs not found in the cache. */
+	struct alpdu_cache_entry entries[RLE_ALPDU_CACHE_ENTRIES_NR];
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief  Create an empty ALPDU cache in a memory pool.
+ *
+ * @param[in,out] pool  The memory pool, NULL for the heap.
+ *
+ * @return  The cache, NULL in case of error.
+ *
+ * @ingroup RLE ALPDU cache
+ */
+struct alpdu_cache * alpdu_cache_new(struct rle_pool *const pool)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief  Destroy an ALPDU cache.
+ *
+ * @param[in,out] pool   The memory pool the cache was created in, NULL for the heap.
+ * @param[in,out] cache  The cache, set to NULL.
+ *
+ * @ingroup RLE ALPDU cache
+ */
+void alpdu_cache_del(struct rle_pool *const pool, struct alpdu_cache **const cache);
+
+/**
+ * @brief  Look for a SDU in an ALPDU cache, and count the hit or the miss.
+ *
+ * @param[in,out] cache  The cache.
+ * @param[in]     sdu    The SDU, of up to RLE_ALPDU_CACHE_SDU_MAX_LEN octets.
+ * @param[out]    hash   The hash of the SDU, to store it in the cache on a miss.
+ *
+ * @return  The slot of the SDU if found, NULL otherwise.
+ *
+ * @ingroup RLE ALPDU cache
+ */
+const struct alpdu_cache_entry * alpdu_cache_lookup(struct alpdu_cache *const cache,
+                                                    const struct rle_sdu *const sdu,
+                                                    uint64_t *const hash)
+__attribute__((warn_unused_result, nonnull(1, 2, 3)));
+
+/**
+ * @brief  Store the ALPDU header and the CRC of a SDU just encapsulated in an ALPDU cache.
+ *
+ *         The SDU replaces the one of its slot.
+ *
+ * @param[in,out] cache     The cache.
+ * @param[in]     hash      The hash of the SDU, given by alpdu_cache_lookup().
+ * @param[in]     sdu       The SDU, as given to the transmitter.
+ * @param[in]     frag_buf  The fragmentation buffer the SDU was encapsulated in.
+ *
+ * @ingroup RLE ALPDU cache
+ */
+void alpdu_cache_store(struct alpdu_cache *const cache, const uint64_t hash,
+                       const struct rle_sdu *const sdu,
+                       const struct rle_frag_buf *const frag_buf)
+__attribute__((nonnull(1, 3, 4)));
+
+/**
+ * @brief  Encapsulate a SDU found in an ALPDU cache with the ALPDU header and the CRC there.
+ *
+ * @param[in]     entry     The slot of the SDU.
+ * @param[in,out] frag_buf  The fragmentation buffer, with the SDU copied.
+ *
+ * @ingroup RLE ALPDU cache
+ */
+void alpdu_cache_push_alpdu_hdr(const struct alpdu_cache_entry *const entry,
+                                struct rle_frag_buf *const frag_buf)
+__attribute__((nonnull(1, 2)));
+
+#endif /* __ALPDU_CACHE_H__ */
@@ -65,6 +65,13 @@
 #define C_REASSEMBLY_OK 1
 #define C_ERROR         -1
 
+/**
+ * The size of a cache line, the alignment of the instances, of their contexts and of the buffers
+ * of the memory pools. The gain of this alignment when the instances are shared out between
+ * threads on several cores is not measured yet.
+ */
+#define RLE_CACHE_LINE_SIZE 64U
+
 /** Type of payload in RLE packet */
 enum {
 	RLE_PDU_COMPLETE,    /** Complete PDU */
@@ -73,16 +80,51 @@ enum {
 	RLE_PDU_END_FRAG,   /** END packet/fragment of PDU */
 };
 
-#define RLE_LOG(level, x, ...) \
+/** Hint the compiler that a condition is rarely true, to keep its branch out of the hot path */
+#define RLE_UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+
+/**
+ * The type of the trace callback, rle_trace_callback_t, declared again so this header does not
+ * depend on rle.h. rle_log.c defines the callback with rle_trace_callback_t, so the compiler
+ * checks that both types are the same.
+ */
+typedef void (*rle_trace_cb_t)(const int module_id,
+                               const int level,
+                               const char *const file,
+                               const int line,
+                               const char *const func,
+                               const char *const message,
+                               ...);
+
+/**
+ * The trace callback, read by the logging macros of the data path without a call to
+ * rle_get_trace_callback(). Hidden, so it is set only by rle_set_trace_callback().
+ */
+extern rle_trace_cb_t rle_trace_callback __attribute__((visibility("hidden")));
+
+/**
+ * @brief  Get the trace callback from an error or a warning path.
+ *
+ *         The function is cold: the compiler moves the branches that call it, with the error
+ *         handling they lead to, out of the hot text of the data path.
+ *
+ * @return  The trace callback, NULL if none is registered.
+ */
+rle_trace_cb_t rle_get_trace_callback_cold(void)
+__attribute__((cold, visibility("hidden")));
+
+#define RLE_LOG(get_cb, level, x, ...) \
 	do { \
-		rle_trace_callback_t the_cb = rle_get_trace_callback(); \
-		if (the_cb != NULL) { \
+		rle_trace_cb_t the_cb = (get_cb); \
+		if (RLE_UNLIKELY(the_cb != NULL)) { \
 			the_cb(MODULE_ID, level, __FILE__, __LINE__, __func__, x, ## __VA_ARGS__); \
 		} \
 	} while (0)
-#define RLE_DEBUG(x, ...) RLE_LOG(RLE_LOG_LEVEL_DEBUG, x, ## __VA_ARGS__)
-#define RLE_WARN(x, ...) RLE_LOG(RLE_LOG_LEVEL_WARNING, x, ## __VA_ARGS__)
-#define RLE_ERR(x, ...) RLE_LOG(RLE_LOG_LEVEL_ERROR, x, ## __VA_ARGS__)
+#define RLE_DEBUG(x, ...) RLE_LOG(rle_trace_callback, RLE_LOG_LEVEL_DEBUG, x, ## __VA_ARGS__)
+#define RLE_WARN(x, ...) \
+	RLE_LOG(rle_get_trace_callback_cold(), RLE_LOG_LEVEL_WARNING, x, ## __VA_ARGS__)
+#define RLE_ERR(x, ...) \
+	RLE_LOG(rle_get_trace_callback_cold(), RLE_LOG_LEVEL_ERROR, x, ## __VA_ARGS__)
 
 #ifndef __KERNEL__
 
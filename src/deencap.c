@@ -31,6 +31,8 @@
 #include "constants.h"
 #include "reassembly_buffer.h"
 #include "rle.h"
+#include "rle_copy.h"
+#include "reassembly.h"
 
 #ifndef __KERNEL__
 
@@ -54,27 +56,54 @@
 
 
 /*------------------------------------------------------------------------------------------------*/
-/*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
-enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
-                                      unsigned char *const fpdu,
-                                      const size_t fpdu_length,
-                                      struct rle_sdu sdus[],
-                                      const size_t sdus_max_nr,
-                                      size_t *const sdus_nr,
-                                      unsigned char *const payload_label,
-                                      const size_t payload_label_size)
-{
-	enum rle_decap_status status = RLE_DECAP_ERR;
-	int padding_detected = false;
-	size_t offset = 0;
+/**
+ * @brief  Check the arguments of a FPDU decapsulation.
+ *
+ * @param[in]  fpdu                The FPDU to decapsulate.
+ * @param[in]  fpdu_length         The size of the FPDU.
+ * @param[in]  sdus                The SDUs array to extract from the FPDU, preallocated.
+ * @param[in]  sdus_max_nr         The SDUs array size, max number of extractable SDUs.
+ * @param[in]  sdus_nr             The current number of SDUs in the SDUs array.
+ * @param[in]  payload_label       The identifier of the RCST, preallocated.
+ * @param[in]  payload_label_size  The size of the paylod label.
+ *
+ * @return  RLE_DECAP_OK if the arguments are valid, the decapsulation status otherwise.
+ */
+static enum rle_decap_status check_decap_args(const unsigned char *const fpdu,
+                                              const size_t fpdu_length,
+                                              const struct rle_sdu sdus[],
+                                              const size_t sdus_max_nr,
+                                              const size_t *const sdus_nr,
+                                              const unsigned char *const payload_label,
+                                              const size_t payload_label_size);
 
-	/* checks inputs */
-	if (receiver == NULL) {
-		status = RLE_DECAP_ERR_NULL_RCVR;
-		goto out;
-	}
+/**
+ * @brief  Check that the remaining octets of a FPDU are padding, warn if they are not.
+ *
+ * @param[in]  fpdu         The decapsulated FPDU.
+ * @param[in]  fpdu_length  The size of the FPDU.
+ * @param[in]  offset       The offset of the padding in the FPDU.
+ */
+static void check_padding(const unsigned char *const fpdu, const size_t fpdu_length,
+                          size_t offset);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static enum rle_decap_status check_decap_args(const unsigned char *const fpdu,
+                                              const size_t fpdu_length,
+                                              const struct rle_sdu sdus[],
+                                              const size_t sdus_max_nr,
+                                              const size_t *const sdus_nr,
+                                              const unsigned char *const payload_label,
+                                              const size_t payload_label_size)
+{
+	enum rle_decap_status status = RLE_DECAP_OK;
 
 	if ((fpdu == NULL) || (fpdu_length == 0)) {
 		status = RLE_DECAP_ERR_INV_FPDU;
@@ -85,8 +114,6 @@ enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
 		status = RLE_DECAP_ERR_INV_FPDU;
 		goto out;
 	}
-	RLE_DEBUG("decapsulate one %zu-byte FPDU with a %zu-byte Payload Label",
-	          fpdu_length, payload_label_size);
 
 	if (sdus == NULL || sdus_max_nr == 0 || sdus_nr == NULL) {
 		status = RLE_DECAP_ERR_INV_SDUS;
@@ -103,12 +130,62 @@ enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
 		goto out;
 	}
 
+out:
+	return status;
+}
+
+static void check_padding(const unsigned char *const fpdu, const size_t fpdu_length,
+                          size_t offset)
+{
+	/* remaining FPDU bytes are padding: they should be all zero, warn if it is not the case */
+	RLE_DEBUG("%zu-byte padding detected", fpdu_length - offset);
+	for (; offset < fpdu_length; offset++) {
+		if (fpdu[offset] != 0x00) {
+			RLE_WARN("FPDU padding contains octets non equal to 0x00 (at least byte "
+			         "#%zu of the %zu-byte FPDU)\n", offset + 1, fpdu_length);
+			break; /* stop padding verification after first error */
+		}
+	}
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
+                                      unsigned char *const fpdu,
+                                      const size_t fpdu_length,
+                                      struct rle_sdu sdus[],
+                                      const size_t sdus_max_nr,
+                                      size_t *const sdus_nr,
+                                      unsigned char *const payload_label,
+                                      const size_t payload_label_size)
+{
+	enum rle_decap_status status = RLE_DECAP_ERR;
+	int padding_detected = false;
+	size_t offset = 0;
+
+	/* checks inputs */
+	if (receiver == NULL) {
+		status = RLE_DECAP_ERR_NULL_RCVR;
+		goto out;
+	}
+
+	status = check_decap_args(fpdu, fpdu_length, sdus, sdus_max_nr, sdus_nr, payload_label,
+	                          payload_label_size);
+	if (status != RLE_DECAP_OK) {
+		goto out;
+	}
+	RLE_DEBUG("decapsulate one %zu-byte FPDU with a %zu-byte Payload Label",
+	          fpdu_length, payload_label_size);
+
 	/* no SDUs decapsulated yet */
 	*sdus_nr = 0;
 
 	/* copy payload label to user if present */
 	if (payload_label_size != 0) {
-		memcpy(payload_label, fpdu, payload_label_size);
+		rle_copy(payload_label, fpdu, payload_label_size);
 		offset += payload_label_size;
 	}
 
@@ -174,16 +251,108 @@ enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
 		RLE_DEBUG("%zu bytes remaining to be parsed in FPDU", fpdu_length - offset);
 	}
 
-	/* remaining FPDU bytes are padding: they should be all zero, warn if it is not the case */
-	RLE_DEBUG("%zu-byte padding detected", fpdu_length - offset);
-	for (; offset < fpdu_length; offset++) {
-		if (fpdu[offset] != 0x00) {
-			RLE_WARN("FPDU padding contains octets non equal to 0x00 (at least byte "
-			         "#%zu of the %zu-byte FPDU)\n", offset + 1, fpdu_length);
-			break; /* stop padding verification after first error */
+	check_padding(fpdu, fpdu_length, offset);
+
+	RLE_DEBUG("%zu SDU(s) decapsuled from FPDU", *sdus_nr);
+
+out:
+	return status;
+}
+
+enum rle_decap_status rle_decapsulate_complete(const struct rle_config *const conf,
+                                               unsigned char *const fpdu,
+                                               const size_t fpdu_length,
+                                               struct rle_sdu sdus[],
+                                               const size_t sdus_max_nr,
+                                               size_t *const sdus_nr,
+                                               unsigned char *const payload_label,
+                                               const size_t payload_label_size)
+{
+	enum rle_decap_status status = RLE_DECAP_ERR;
+	size_t offset;
+
+	/* checks inputs */
+	if (conf == NULL) {
+		goto out;
+	}
+
+	status = check_decap_args(fpdu, fpdu_length, sdus, sdus_max_nr, sdus_nr, payload_label,
+	                          payload_label_size);
+	if (status != RLE_DECAP_OK) {
+		goto out;
+	}
+	RLE_DEBUG("decapsulate one %zu-byte FPDU of COMPLETE PPDUs with a %zu-byte Payload Label",
+	          fpdu_length, payload_label_size);
+
+	/* no SDUs decapsulated yet */
+	*sdus_nr = 0;
+
+	/* walk through the PPDU headers first: the FPDU is left to the receiver as soon as one
+	 * PPDU is a fragment, so that no SDU is decapsulated twice */
+	for (offset = payload_label_size; (offset + 1) < fpdu_length;) {
+		const unsigned char *const ppdu = &fpdu[offset];
+		size_t ppdu_length;
+
+		if (ppdu[0] == 0x00 && ppdu[1] == 0x00) {
+			break;
+		}
+
+		ppdu_length = get_fragment_length(ppdu);
+		if (ppdu_length > (fpdu_length - offset)) {
+			RLE_ERR("Invalid fragment size, fragment length too big for FPDU "
+			        "(fragment length = %zu, remaining FPDU size = %zu)\n",
+			        ppdu_length, fpdu_length - offset);
+			status = RLE_DECAP_ERR;
+			goto out;
+		}
+
+		if (rle_ppdu_get_fragment_type((const rle_ppdu_hdr_t *)ppdu) != RLE_PDU_COMPLETE) {
+			RLE_DEBUG("PPDU fragment detected at byte #%zu in FPDU, receiver needed",
+			          offset + 1);
+			status = RLE_DECAP_NEED_RCVR;
+			goto out;
+		}
+
+		offset += ppdu_length;
+	}
+
+	/* copy payload label to user if present */
+	if (payload_label_size != 0) {
+		rle_copy(payload_label, fpdu, payload_label_size);
+	}
+
+	for (offset = payload_label_size; (offset + 1) < fpdu_length;) {
+		unsigned char *const ppdu = &fpdu[offset];
+		size_t ppdu_length;
+
+		if (ppdu[0] == 0x00 && ppdu[1] == 0x00) {
+			RLE_DEBUG("padding detected at byte #%zu in FPDU", offset + 1);
+			break;
 		}
+
+		ppdu_length = get_fragment_length(ppdu);
+
+		/* stop deencapulation if there is no more SDU buffers */
+		if ((*sdus_nr) == sdus_max_nr) {
+			RLE_ERR("failed to decapsulate all SDUs from the FPDU: all %zu "
+			        "SDU buffers are full, but FPDU is not fully parsed "
+			        "(%zu bytes of FPDU will be lost)\n", sdus_max_nr, fpdu_length - offset);
+			status = RLE_DECAP_ERR_SOME_DROP;
+			goto out;
+		}
+
+		if (reassembly_comp_ppdu(conf, ppdu, ppdu_length, &sdus[*sdus_nr]) == C_REASSEMBLY_OK) {
+			(*sdus_nr)++;
+		} else {
+			RLE_ERR("Error during reassembly\n");
+			status = RLE_DECAP_ERR;
+		}
+
+		offset += ppdu_length;
 	}
 
+	check_padding(fpdu, fpdu_length, offset);
+
 	RLE_DEBUG("%zu SDU(s) decapsuled from FPDU", *sdus_nr);
 
 out:
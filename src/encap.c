@@ -33,6 +33,9 @@
 #include "rle_header_proto_type_field.h"
 #include "rle.h"
 #include "fragmentation_buffer.h"
+#include "header.h"
+#include "rle_copy.h"
+#include "alpdu_cache.h"
 
 #ifndef __KERNEL__
 
@@ -115,6 +118,13 @@ enum rle_encap_status rle_encapsulate(struct rle_transmitter *const transmitter,
 		goto out;
 	}
 
+	if (transmitter->pool != NULL) {
+		if (rle_ctx_fit_frag_buf(rle_ctx, transmitter->pool, sdu->size) != C_OK) {
+			goto out;
+		}
+		frag_buf = (rle_frag_buf_t *)rle_ctx->buff;
+	}
+
 	/* set to 'used' the previously free frag context */
 	set_nonfree_frag_ctx(transmitter, frag_id);
 
@@ -124,8 +134,22 @@ enum rle_encap_status rle_encapsulate(struct rle_transmitter *const transmitter,
 	ret = rle_frag_buf_cpy_sdu(frag_buf, sdu);
 	assert(ret == 0); /* cannot fail since SDU length was already checked */
 
-	ret_encap = rle_encap_contextless(transmitter, frag_buf);
-	assert(ret_encap == RLE_ENCAP_OK); /* no way to fail here */
+	if (transmitter->alpdu_cache != NULL && sdu->size <= RLE_ALPDU_CACHE_SDU_MAX_LEN) {
+		const struct alpdu_cache_entry *entry;
+		uint64_t hash;
+
+		entry = alpdu_cache_lookup(transmitter->alpdu_cache, sdu, &hash);
+		if (entry != NULL) {
+			alpdu_cache_push_alpdu_hdr(entry, frag_buf);
+		} else {
+			ret_encap = rle_encap_contextless(transmitter, frag_buf);
+			assert(ret_encap == RLE_ENCAP_OK); /* no way to fail here */
+			alpdu_cache_store(transmitter->alpdu_cache, hash, sdu, frag_buf);
+		}
+	} else {
+		ret_encap = rle_encap_contextless(transmitter, frag_buf);
+		assert(ret_encap == RLE_ENCAP_OK); /* no way to fail here */
+	}
 
 	rle_ctx_incr_counter_in(rle_ctx);
 	rle_ctx_incr_counter_bytes_in(rle_ctx, sdu->size);
@@ -176,3 +200,94 @@ enum rle_encap_status rle_encap_contextless(struct rle_transmitter *const transm
 out:
 	return status;
 }
+
+enum rle_pack_status rle_encap_pack_complete(const struct rle_config *const conf,
+                                             const struct rle_sdu *const sdu,
+                                             const unsigned char *const label,
+                                             const size_t label_size,
+                                             unsigned char *const fpdu,
+                                             size_t *const fpdu_current_pos,
+                                             size_t *const fpdu_remaining_size)
+{
+	enum rle_pack_status status = RLE_PACK_ERR;
+	rle_alpdu_hdr_t alpdu_hdr;
+	size_t alpdu_hdr_len;
+	bool omit_vlan_ptype;
+	size_t alpdu_len;
+	size_t needed_len;
+	rle_ppdu_hdr_t ppdu_hdr;
+	unsigned char *pos;
+
+	if (!conf) {
+		goto out;
+	}
+	if (!sdu || !sdu->buffer || sdu->size == 0 || sdu->size > RLE_MAX_PDU_SIZE) {
+		status = RLE_PACK_ERR_INVALID_SDU;
+		goto out;
+	}
+	if ((label_size != 0 && label_size != 3 && label_size != 6) ||
+	    (label_size > 0 && label == NULL)) {
+		status = RLE_PACK_ERR_INVALID_LAB;
+		goto out;
+	}
+	if (fpdu == NULL || fpdu_current_pos == NULL || fpdu_remaining_size == NULL) {
+		goto out;
+	}
+
+	alpdu_hdr_len = get_alpdu_hdr(conf, sdu->protocol_type, sdu->buffer, sdu->size, &alpdu_hdr,
+	                              &omit_vlan_ptype);
+	alpdu_len = alpdu_hdr_len + sdu->size - (omit_vlan_ptype ? RLE_VLAN_PTYPE_LEN : 0);
+
+	/* the ALPDU shall fit in the payload of one COMPLETE PPDU, and the PPDU in the FPDU, after
+	 * the FPDU label if the FPDU is empty; otherwise the SDU is left to the caller */
+	needed_len = sizeof(rle_ppdu_hdr_comp_t) + alpdu_len;
+	if (*fpdu_current_pos == 0) {
+		needed_len += label_size;
+	}
+	if (alpdu_len > RLE_MAX_PPDU_PL_SIZE || *fpdu_remaining_size < needed_len) {
+		status = RLE_PACK_ERR_FPDU_TOO_SMALL;
+		goto out;
+	}
+
+	pos = fpdu + *fpdu_current_pos;
+
+	/* when FPDU is empty, copy the FPDU label before the first PPDU */
+	if (*fpdu_current_pos == 0 && label_size > 0) {
+		rle_copy(pos, label, label_size);
+		pos += label_size;
+	}
+
+	/* COMPLETE PPDU header */
+	memset(&ppdu_hdr, 0, sizeof(ppdu_hdr));
+	ppdu_hdr.comp.start_ind = 1;
+	ppdu_hdr.comp.end_ind = 1;
+	rle_ppdu_hdr_set_ppdu_len(&ppdu_hdr, alpdu_len);
+	ppdu_hdr.comp.label_type = get_alpdu_label_type(sdu->protocol_type, alpdu_hdr_len == 0,
+	                                                conf->type_0_alpdu_label_size);
+	ppdu_hdr.comp.proto_type_supp = (alpdu_hdr_len == 0);
+	memcpy(pos, &ppdu_hdr.comp, sizeof(rle_ppdu_hdr_comp_t));
+	pos += sizeof(rle_ppdu_hdr_comp_t);
+
+	/* ALPDU header, then SDU without the protocol type of its VLAN header if omitted */
+	memcpy(pos, &alpdu_hdr, alpdu_hdr_len);
+	pos += alpdu_hdr_len;
+	if (omit_vlan_ptype) {
+		const size_t vlan_hdr_len = RLE_ETH_VLAN_HDR_LEN - RLE_VLAN_PTYPE_LEN;
+
+		rle_copy(pos, sdu->buffer, vlan_hdr_len);
+		rle_copy(pos + vlan_hdr_len, sdu->buffer + RLE_ETH_VLAN_HDR_LEN,
+		         sdu->size - RLE_ETH_VLAN_HDR_LEN);
+	} else {
+		rle_copy(pos, sdu->buffer, sdu->size);
+	}
+
+	*fpdu_current_pos += needed_len;
+	*fpdu_remaining_size -= needed_len;
+
+	status = RLE_PACK_OK;
+	RLE_DEBUG("%zu-byte SDU encapsulated in a %zu-byte COMPLETE PPDU", sdu->size,
+	          sizeof(rle_ppdu_hdr_comp_t) + alpdu_len);
+
+out:
+	return status;
+}
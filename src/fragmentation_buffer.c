@@ -29,6 +29,8 @@
 #include "rle.h"
 #include "constants.h"
 #include "fragmentation_buffer.h"
+#include "rle_pool.h"
+#include "rle_copy.h"
 
 #ifndef __KERNEL__
 
@@ -55,16 +57,18 @@
 /*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
-struct rle_frag_buf * rle_frag_buf_new(void)
+rle_frag_buf_t * frag_buf_new_in_pool(struct rle_pool *const pool, const size_t sdu_capacity)
 {
 	struct rle_frag_buf *frag_buf =
-		(struct rle_frag_buf *)MALLOC(sizeof(struct rle_frag_buf));
+		(struct rle_frag_buf *)rle_pool_alloc(pool, sizeof(struct rle_frag_buf) +
+		                                      RLE_F_BUFF_LEN(sdu_capacity));
 
 	if (!frag_buf) {
 		RLE_ERR("fragmentation buffer not allocated");
 		goto out;
 	}
 
+	frag_buf->sdu_capacity = sdu_capacity;
 	frag_buf->sdu.frag_buf = frag_buf;
 	frag_buf->alpdu.frag_buf = frag_buf;
 	frag_buf->ppdu.frag_buf = frag_buf;
@@ -74,7 +78,7 @@ out:
 	return frag_buf;
 }
 
-void rle_frag_buf_del(struct rle_frag_buf **const frag_buf)
+void frag_buf_del_in_pool(struct rle_pool *const pool, rle_frag_buf_t **const frag_buf)
 {
 	if (!frag_buf) {
 		RLE_WARN("fragmentation buffer pointer NULL, nothing can be done");
@@ -86,7 +90,8 @@ void rle_frag_buf_del(struct rle_frag_buf **const frag_buf)
 		goto out;
 	}
 
-	FREE(*frag_buf);
+	rle_pool_free(pool, *frag_buf,
+	              sizeof(struct rle_frag_buf) + frag_buf_get_buffer_len(*frag_buf));
 	*frag_buf = NULL;
 
 out:
@@ -94,15 +99,36 @@ out:
 	return;
 }
 
+struct rle_frag_buf * rle_frag_buf_new(void)
+{
+	return frag_buf_new_in_pool(NULL, RLE_MAX_PDU_SIZE);
+}
+
+struct rle_frag_buf * rle_frag_buf_new_sized(const size_t sdu_max_size)
+{
+	if (sdu_max_size > RLE_MAX_PDU_SIZE) {
+		RLE_ERR("fragmentation buffer for %zu-byte SDUs requested, while %d bytes at most "
+		        "are supported", sdu_max_size, RLE_MAX_PDU_SIZE);
+		return NULL;
+	}
+
+	return frag_buf_new_in_pool(NULL, frag_buf_get_class_capacity(sdu_max_size));
+}
+
+void rle_frag_buf_del(struct rle_frag_buf **const frag_buf)
+{
+	frag_buf_del_in_pool(NULL, frag_buf);
+}
+
 int rle_frag_buf_init(struct rle_frag_buf *const frag_buf)
 {
 	if (frag_buf == NULL) {
 		return 1;
 	}
 
-	memset(frag_buf->buffer, '\0', RLE_F_BUFF_LEN);
+	memset(frag_buf->buffer, '\0', frag_buf_get_buffer_len(frag_buf));
 
-	frag_buf->cur_pos = frag_buf->buffer + sizeof(rle_ppdu_hdr_t) + sizeof(rle_alpdu_hdr_t);
+	frag_buf->cur_pos = frag_buf->buffer + RLE_F_BUFF_HEADROOM;
 
 	frag_buf_ptrs_set(&frag_buf->sdu, frag_buf->cur_pos);
 	frag_buf_ptrs_set(&frag_buf->alpdu, frag_buf->cur_pos);
@@ -113,7 +139,7 @@ int rle_frag_buf_init(struct rle_frag_buf *const frag_buf)
 
 int rle_frag_buf_cpy_sdu(struct rle_frag_buf *const frag_buf, const struct rle_sdu *const sdu)
 {
-	if (sdu->size > RLE_MAX_PDU_SIZE || frag_buf_in_use(frag_buf)) {
+	if (sdu->size > frag_buf->sdu_capacity || frag_buf_in_use(frag_buf)) {
 		return 1;
 	}
 
@@ -122,7 +148,7 @@ int rle_frag_buf_cpy_sdu(struct rle_frag_buf *const frag_buf, const struct rle_s
 	frag_buf->sdu_info.protocol_type = sdu->protocol_type;
 	frag_buf->sdu_info.size = sdu->size;
 
-	memcpy(frag_buf->sdu.start, sdu->buffer, sdu->size);
+	rle_copy(frag_buf->sdu.start, sdu->buffer, sdu->size);
 
 	return 0;
 }
@@ -41,10 +41,23 @@
 /*------------------------------------------------------------------------------------------------*/
 #define MODULE_ID RLE_MOD_ID_FRAGMENTATION_BUFFER
 
-/** Maximum size for a fragmentation buffer. */
-#define RLE_F_BUFF_LEN \
-	(sizeof(rle_ppdu_hdr_t) + sizeof(rle_alpdu_hdr_t) + \
-	 (RLE_MAX_PDU_SIZE) + sizeof(rle_alpdu_trailer_t))
+/**
+ * Room for the PPDU and ALPDU headers before the SDU in a fragmentation buffer, rounded up so
+ * the SDU is copied at the start of a cache line.
+ */
+#define RLE_F_BUFF_HEADROOM \
+	((sizeof(rle_ppdu_hdr_t) + sizeof(rle_alpdu_hdr_t) + RLE_CACHE_LINE_SIZE - 1) & \
+	 ~((size_t)RLE_CACHE_LINE_SIZE - 1))
+
+/** Size of the buffer of a fragmentation buffer for SDUs of up to sdu_capacity octets. */
+#define RLE_F_BUFF_LEN(sdu_capacity) \
+	(RLE_F_BUFF_HEADROOM + (sdu_capacity) + sizeof(rle_alpdu_trailer_t))
+
+/** SDU capacity of the small fragmentation buffers: signalling, keep-alives, VoIP, TCP ACKs. */
+#define RLE_F_BUFF_SMALL_SDU_LEN 256U
+
+/** SDU capacity of the medium fragmentation buffers. */
+#define RLE_F_BUFF_MEDIUM_SDU_LEN 2048U
 
 
 /*------------------------------------------------------------------------------------------------*/
@@ -111,16 +124,23 @@ struct fragmentation_buffer_ptrs {
 	unsigned char *end;   /** End pointer.                  */
 };
 
-/** Fragmentation buffer implementation. */
+/**
+ * Fragmentation buffer implementation.
+ *
+ * The buffer follows the pointers, sized by the size class of the fragmentation buffer: 256,
+ * 2048 or RLE_MAX_PDU_SIZE octets of SDU. It starts on a cache line, like the SDU copied in it.
+ */
 struct rle_frag_buf {
-	unsigned char buffer[RLE_F_BUFF_LEN]; /** Buffer itself.                                     */
 	unsigned char *cur_pos;               /** Current position.                                  */
 	struct rle_sdu sdu_info;              /** RLE SDU struct used without buffer to store infos. */
 	uint32_t crc;                         /**< The computed CRC if needed */
 	frag_buf_ptrs_t sdu;                  /** SDU after copying it.                              */
 	frag_buf_ptrs_t alpdu;                /** ALPDU after encapsulation.                         */
 	frag_buf_ptrs_t ppdu;                 /** PPDU after each fragmentation.                     */
-};
+	size_t sdu_capacity;                  /** Largest SDU, the size class of the buffer.         */
+	unsigned char buffer[]                /** Buffer itself.                                     */
+	__attribute__((aligned(RLE_CACHE_LINE_SIZE)));
+} __attribute__((aligned(RLE_CACHE_LINE_SIZE)));
 
 
 /*------------------------------------------------------------------------------------------------*/
@@ -128,6 +148,40 @@ struct rle_frag_buf {
 /*------------------------------------------------------------------------------------------------*/
 
 
+/**
+ * @brief         Get the SDU capacity of the smallest size class holding a SDU.
+ *
+ * @param[in]     sdu_len                  The length of the SDU, up to RLE_MAX_PDU_SIZE.
+ *
+ * @return        RLE_F_BUFF_SMALL_SDU_LEN, RLE_F_BUFF_MEDIUM_SDU_LEN or RLE_MAX_PDU_SIZE.
+ *
+ * @ingroup       RLE Fragmentation buffer.
+ */
+static inline size_t frag_buf_get_class_capacity(const size_t sdu_len);
+
+/**
+ * @brief         Create a new fragmentation buffer in a memory pool.
+ *
+ * @param[in,out] pool                     The memory pool, NULL for the heap.
+ * @param[in]     sdu_capacity             The SDU capacity of the buffer, one of the size
+ *                                         classes given by frag_buf_get_class_capacity().
+ *
+ * @return        The fragmentation buffer if OK, else NULL.
+ *
+ * @ingroup       RLE Fragmentation buffer.
+ */
+rle_frag_buf_t * frag_buf_new_in_pool(struct rle_pool *const pool, const size_t sdu_capacity);
+
+/**
+ * @brief         Destroy a fragmentation buffer created in a memory pool.
+ *
+ * @param[in,out] pool                     The memory pool, NULL for the heap.
+ * @param[in,out] frag_buf                 The fragmentation buffer to destroy.
+ *
+ * @ingroup       RLE Fragmentation buffer.
+ */
+void frag_buf_del_in_pool(struct rle_pool *const pool, rle_frag_buf_t **const frag_buf);
+
 /**
  * @brief         Set the start and end pointers of a fragmentation buffer pointers to an arbitraly
  *                choosen value (bound in the fragmentation buffer).
@@ -214,6 +268,17 @@ void frag_buf_sdu_push(rle_frag_buf_t *const frag_buf, const ssize_t size);
  */
 static inline void frag_buf_sdu_put(rle_frag_buf_t *const frag_buf, const size_t size);
 
+/**
+ * @brief         Get the length of the buffer of a fragmentation buffer.
+ *
+ * @param[in]     frag_buf                   The fragmentation buffer.
+ *
+ * @return        The length of the buffer, headroom and ALPDU trailer included.
+ *
+ * @ingroup       RLE Fragmentation buffer.
+ */
+static inline size_t frag_buf_get_buffer_len(const rle_frag_buf_t *const frag_buf);
+
 /**
  * @brief         Push the ALPDU and PPDU pointers.
  *
@@ -429,7 +494,7 @@ size_t frag_buf_get_current_ppdu_len(const rle_frag_buf_t *const frag_buf);
 static void frag_buf_ptrs_set(frag_buf_ptrs_t *const ptrs, unsigned char *const address)
 {
 	assert((address >= ptrs->frag_buf->buffer) &&
-	       (address < ptrs->frag_buf->buffer + sizeof(ptrs->frag_buf->buffer)));
+	       (address < ptrs->frag_buf->buffer + frag_buf_get_buffer_len(ptrs->frag_buf)));
 
 	ptrs->start = ptrs->end = address;
 }
@@ -444,13 +509,33 @@ static void frag_buf_ptrs_push(frag_buf_ptrs_t *const ptrs, const ssize_t size)
 static void frag_buf_ptrs_put(frag_buf_ptrs_t *const ptrs, const size_t size)
 {
 	const ptrdiff_t offset =
-		(ptrs->frag_buf->buffer + sizeof(ptrs->frag_buf->buffer)) - ptrs->end;
+		(ptrs->frag_buf->buffer + frag_buf_get_buffer_len(ptrs->frag_buf)) - ptrs->end;
 
 	assert(size <= (size_t)offset);
 
 	ptrs->end += size;
 }
 
+static inline size_t frag_buf_get_class_capacity(const size_t sdu_len)
+{
+	size_t sdu_capacity;
+
+	if (sdu_len <= RLE_F_BUFF_SMALL_SDU_LEN) {
+		sdu_capacity = RLE_F_BUFF_SMALL_SDU_LEN;
+	} else if (sdu_len <= RLE_F_BUFF_MEDIUM_SDU_LEN) {
+		sdu_capacity = RLE_F_BUFF_MEDIUM_SDU_LEN;
+	} else {
+		sdu_capacity = RLE_MAX_PDU_SIZE;
+	}
+
+	return sdu_capacity;
+}
+
+static inline size_t frag_buf_get_buffer_len(const rle_frag_buf_t *const frag_buf)
+{
+	return RLE_F_BUFF_LEN(frag_buf->sdu_capacity);
+}
+
 static inline void frag_buf_sdu_put(rle_frag_buf_t *const frag_buf, const size_t size)
 {
 	frag_buf_ptrs_put(&frag_buf->sdu, size);
@@ -515,9 +600,10 @@ static inline int frag_buf_dump_mem(const rle_frag_buf_t *const frag_buf,
 		goto out;
 	}
 
-	if ((start < frag_buf->buffer) || (end > (frag_buf->buffer + sizeof(frag_buf->buffer)))) {
+	if ((start < frag_buf->buffer) ||
+	    (end > (frag_buf->buffer + frag_buf_get_buffer_len(frag_buf)))) {
 		RLE_ERR("address out of buffer ([%p - %p]/[%p - %p])", start, end, frag_buf->buffer,
-		        frag_buf->buffer + sizeof(frag_buf->buffer));
+		        frag_buf->buffer + frag_buf_get_buffer_len(frag_buf));
 		goto out;
 	}
 
@@ -640,7 +726,7 @@ static inline int frag_buf_dump_full_frag_buf(const rle_frag_buf_t *const frag_b
 	}
 
 	ret = frag_buf_dump_mem(frag_buf, frag_buf->buffer, frag_buf->buffer +
-	                        sizeof(frag_buf->buffer));
+	                        frag_buf_get_buffer_len(frag_buf));
 
 	if (ret != -1) {
 		goto out;
@@ -61,42 +61,6 @@
 /*--------------------------------------- PRIVATE FUNCTIONS --------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
-/**
- *  @brief         create and push uncompressed ALPDU header into a fragmentation buffer.
- *
- *
- *  @param[in,out] frag_buf     the fragmentation buffer in use.
- *  @param[in]     ptype        the SDU protocol type
- *
- *  @ingroup
- */
-static void push_uncomp_alpdu_hdr(struct rle_frag_buf *const frag_buf,
-                                  const uint16_t ptype);
-
-/**
- *  @brief         create and push compressed supported ALPDU header into a fragmentation buffer.
- *
- *
- *  @param[in,out] frag_buf     the fragmentation buffer in use.
- *  @param[in]     ptype        the compressed SDU protocol type
- *
- *  @ingroup
- */
-static void push_comp_supported_alpdu_hdr(struct rle_frag_buf *const frag_buf,
-                                          const uint8_t ptype);
-
-/**
- *  @brief         create and push compressed fallback ALPDU header into a fragmentation buffer.
- *
- *
- *  @param[in,out] frag_buf     the fragmentation buffer in use.
- *  @param[in]     ptype        the SDU protocol type
- *
- *  @ingroup
- */
-static void push_comp_fallback_alpdu_hdr(struct rle_frag_buf *const frag_buf,
-                                         const uint16_t ptype);
-
 /**
  *  @brief         create and push COMPLETE PPDU header into a fragmentation buffer.
  *
@@ -169,44 +133,6 @@ __attribute__((warn_unused_result, nonnull(1, 3)));
 /*------------------------------------ PRIVATE FUNCTIONS CODE ------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
-static void push_uncomp_alpdu_hdr(struct rle_frag_buf *const frag_buf, const uint16_t ptype)
-{
-	rle_alpdu_hdr_uncomp_t **alpdu_hdr;
-
-	RLE_DEBUG("prepend a 2-byte ALPDU header with an uncompressed protocol type");
-
-	alpdu_hdr = (rle_alpdu_hdr_uncomp_t **)&frag_buf->alpdu.start;
-
-	frag_buf_alpdu_push(frag_buf, sizeof(**alpdu_hdr));
-	(*alpdu_hdr)->proto_type = ptype;
-}
-
-static void push_comp_supported_alpdu_hdr(struct rle_frag_buf *const frag_buf, const uint8_t ptype)
-{
-	rle_alpdu_hdr_comp_supported_t **alpdu_hdr;
-
-	RLE_DEBUG("prepend a 1-byte ALPDU header with a compressed protocol type");
-
-	alpdu_hdr = (rle_alpdu_hdr_comp_supported_t **)&frag_buf->alpdu.start;
-
-	frag_buf_alpdu_push(frag_buf, sizeof(**alpdu_hdr));
-	(*alpdu_hdr)->proto_type = ptype;
-}
-
-static void push_comp_fallback_alpdu_hdr(struct rle_frag_buf *const frag_buf, const uint16_t ptype)
-{
-	rle_alpdu_hdr_comp_fallback_t **alpdu_hdr;
-
-	RLE_DEBUG("prepend a 3-byte ALPDU header with an unknown compressed protocol "
-	          "type");
-
-	alpdu_hdr = (rle_alpdu_hdr_comp_fallback_t **)&frag_buf->alpdu.start;
-
-	frag_buf_alpdu_push(frag_buf, sizeof(**alpdu_hdr));
-	(*alpdu_hdr)->comp.proto_type = RLE_PROTO_TYPE_FALLBACK;
-	(*alpdu_hdr)->uncomp.proto_type = ptype;
-}
-
 static void push_comp_ppdu_hdr(struct rle_frag_buf *const frag_buf,
                                const uint8_t alpdu_label_type,
                                const uint8_t ptype_suppressed)
@@ -380,39 +306,48 @@ error:
 	return comp_ptype;
 }
 
-void push_alpdu_hdr(struct rle_frag_buf *const frag_buf, const struct rle_config *const rle_conf)
+size_t get_alpdu_hdr(const struct rle_config *const rle_conf,
+                     const uint16_t ptype,
+                     const unsigned char *const sdu,
+                     const size_t sdu_len,
+                     rle_alpdu_hdr_t *const alpdu_hdr,
+                     bool *const omit_vlan_ptype)
 {
-	uint16_t ptype;
-
-	RLE_DEBUG("prepend a ALPDU header");
+	size_t alpdu_hdr_len;
 
-	ptype = frag_buf->sdu_info.protocol_type;
+	*omit_vlan_ptype = false;
 
 	/* ALPDU: 4 cases, len € {0,1,2,3} */
 
 	/* don't fill ALPDU ptype field if given ptype is equal to the default one and suppression is
 	 * active, or if given ptype is for signalling packet */
-	if (!ptype_is_omissible(ptype, rle_conf, frag_buf)) {
+	if (!ptype_is_omissible(ptype, rle_conf, sdu, sdu_len)) {
 		const uint16_t net_ptype = ntohs(ptype);
 
 		/* suppression is not possible, is compression enabled? */
 		if (!rle_conf->use_compressed_ptype) {
 			/* No compression, no suppression, ALPDU len = 2 */
-			push_uncomp_alpdu_hdr(frag_buf, net_ptype);
+			RLE_DEBUG("prepend a 2-byte ALPDU header with an uncompressed protocol type");
+			alpdu_hdr->uncomp.proto_type = net_ptype;
+			alpdu_hdr_len = sizeof(alpdu_hdr->uncomp);
 		} else {
 			/* No suppression, compression is enabled */
 			uint8_t comp_ptype;
 
 			/* is protocol type compressible? */
 			if (rle_header_ptype_is_compressible(ptype) == C_OK) {
-				comp_ptype = rle_header_ptype_compression(ptype, frag_buf);
+				comp_ptype = ptype_compression(ptype, sdu, sdu_len);
 			} else {
 				comp_ptype = RLE_PROTO_TYPE_FALLBACK;
 			}
 
 			if (comp_ptype == RLE_PROTO_TYPE_FALLBACK) {
 				/* protocol type is NOT compressible, prepend the 3-byte ALPDU before the SDU */
-				push_comp_fallback_alpdu_hdr(frag_buf, net_ptype);
+				RLE_DEBUG("prepend a 3-byte ALPDU header with an unknown compressed protocol "
+				          "type");
+				alpdu_hdr->comp_fallback.comp.proto_type = RLE_PROTO_TYPE_FALLBACK;
+				alpdu_hdr->comp_fallback.uncomp.proto_type = net_ptype;
+				alpdu_hdr_len = sizeof(alpdu_hdr->comp_fallback);
 			} else {
 				/* protocol type is compressible, ALPDU len = 1 */
 
@@ -422,17 +357,13 @@ void push_alpdu_hdr(struct rle_frag_buf *const frag_buf, const struct rle_config
 				 *    embedded payload. */
 				if (ptype == RLE_PROTO_TYPE_VLAN_UNCOMP &&
 				    comp_ptype == RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD) {
-					RLE_DEBUG("omit the protocol field of the VLAN header "
-					          "making SDU 2 bytes less (%zu bytes in total)",
-					          frag_buf_get_sdu_len(frag_buf) - sizeof(ptype));
-					memmove(frag_buf->sdu.start + sizeof(ptype),
-					        frag_buf->sdu.start, sizeof(struct ether_header) +
-					        sizeof(struct vlan_hdr) - sizeof(ptype));
-					frag_buf_sdu_push(frag_buf, -(sizeof(ptype)));
+					*omit_vlan_ptype = true;
 				}
 
 				/* prepend the 1-byte ALPDU before the SDU */
-				push_comp_supported_alpdu_hdr(frag_buf, comp_ptype);
+				RLE_DEBUG("prepend a 1-byte ALPDU header with a compressed protocol type");
+				alpdu_hdr->comp_supported.proto_type = comp_ptype;
+				alpdu_hdr_len = sizeof(alpdu_hdr->comp_supported);
 			}
 		}
 	} else {
@@ -445,15 +376,46 @@ void push_alpdu_hdr(struct rle_frag_buf *const frag_buf, const struct rle_config
 		 *    embedded payload. */
 		if (ptype == RLE_PROTO_TYPE_VLAN_UNCOMP &&
 		    rle_conf->implicit_protocol_type == RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD) {
-			RLE_DEBUG("omit the protocol field of the VLAN header "
-			          "making SDU 2 bytes less (%zu bytes in total)",
-			          frag_buf_get_sdu_len(frag_buf) - sizeof(ptype));
-			memmove(frag_buf->sdu.start + sizeof(ptype), frag_buf->sdu.start,
-			        sizeof(struct ether_header) + sizeof(struct vlan_hdr) -
-			        sizeof(ptype));
-			frag_buf_sdu_push(frag_buf, -(sizeof(ptype)));
+			*omit_vlan_ptype = true;
 		}
+		alpdu_hdr_len = 0;
 	}
+
+	return alpdu_hdr_len;
+}
+
+void push_alpdu_hdr(struct rle_frag_buf *const frag_buf, const struct rle_config *const rle_conf)
+{
+	rle_alpdu_hdr_t alpdu_hdr;
+	size_t alpdu_hdr_len;
+	bool omit_vlan_ptype;
+
+	RLE_DEBUG("prepend a ALPDU header");
+
+	alpdu_hdr_len = get_alpdu_hdr(rle_conf, frag_buf->sdu_info.protocol_type,
+	                              frag_buf->sdu.start, frag_buf->sdu_info.size, &alpdu_hdr,
+	                              &omit_vlan_ptype);
+
+	push_alpdu_hdr_bytes(frag_buf, (const unsigned char *)&alpdu_hdr, alpdu_hdr_len,
+	                     omit_vlan_ptype);
+}
+
+void push_alpdu_hdr_bytes(struct rle_frag_buf *const frag_buf,
+                          const unsigned char *const alpdu_hdr,
+                          const size_t alpdu_hdr_len,
+                          const bool omit_vlan_ptype)
+{
+	if (omit_vlan_ptype) {
+		RLE_DEBUG("omit the protocol field of the VLAN header "
+		          "making SDU 2 bytes less (%zu bytes in total)",
+		          frag_buf_get_sdu_len(frag_buf) - RLE_VLAN_PTYPE_LEN);
+		memmove(frag_buf->sdu.start + RLE_VLAN_PTYPE_LEN, frag_buf->sdu.start,
+		        RLE_ETH_VLAN_HDR_LEN - RLE_VLAN_PTYPE_LEN);
+		frag_buf_sdu_push(frag_buf, -(RLE_VLAN_PTYPE_LEN));
+	}
+
+	frag_buf_alpdu_push(frag_buf, alpdu_hdr_len);
+	memcpy(frag_buf->alpdu.start, alpdu_hdr, alpdu_hdr_len);
 }
 
 bool push_ppdu_hdr(struct rle_frag_buf *const frag_buf,
@@ -59,6 +59,17 @@
 #include "rle_header_proto_type_field.h"
 
 
+/*------------------------------------------------------------------------------------------------*/
+/*---------------------------------- PUBLIC CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** The length of the protocol field of the VLAN header, omitted for VLAN/IPv4 and VLAN/IPv6 */
+#define RLE_VLAN_PTYPE_LEN (sizeof(uint16_t))
+
+/** The length of the Ethernet and VLAN headers, the protocol field of the VLAN header included */
+#define RLE_ETH_VLAN_HDR_LEN (sizeof(struct ether_header) + sizeof(struct vlan_hdr))
+
+
 /*------------------------------------------------------------------------------------------------*/
 /*-------------------------------- PROTECTED STRUCTS AND TYPEDEFS --------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
@@ -253,6 +264,32 @@ struct vlan_hdr {
 int is_eth_vlan_ip_frame(const uint8_t *const sdu, const size_t sdu_len)
 __attribute__((warn_unused_result, nonnull(1)));
 
+/**
+ *  @brief         build the ALPDU header of a SDU.
+ *
+ *                 The SDU is not modified: if the protocol field of its VLAN header shall be
+ *                 omitted, the caller removes it.
+ *
+ *  @param[in]     rle_conf             the RLE configuration
+ *  @param[in]     ptype                the SDU protocol type
+ *  @param[in]     sdu                  the SDU
+ *  @param[in]     sdu_len              the SDU length
+ *  @param[out]    alpdu_hdr            the ALPDU header
+ *  @param[out]    omit_vlan_ptype      whether the protocol field of the VLAN header of the SDU
+ *                                      shall be omitted
+ *
+ *  @return        the length of the ALPDU header, from 0 to 3 octets
+ *
+ *  @ingroup RLE header
+ */
+size_t get_alpdu_hdr(const struct rle_config *const rle_conf,
+                     const uint16_t ptype,
+                     const unsigned char *const sdu,
+                     const size_t sdu_len,
+                     rle_alpdu_hdr_t *const alpdu_hdr,
+                     bool *const omit_vlan_ptype)
+__attribute__((warn_unused_result, nonnull(1, 3, 5, 6)));
+
 /**
  *  @brief         create and push ALPDU header into a fragmentation buffer.
  *
@@ -265,6 +302,23 @@ __attribute__((warn_unused_result, nonnull(1)));
 void push_alpdu_hdr(struct rle_frag_buf *const frag_buf,
                     const struct rle_config *const rle_conf);
 
+/**
+ *  @brief         push an already built ALPDU header into a fragmentation buffer.
+ *
+ *  The protocol type of the VLAN header of the SDU is removed first if it is omitted.
+ *
+ *  @param[in,out] frag_buf             the fragmentation buffer in use, with the SDU copied.
+ *  @param[in]     alpdu_hdr            the ALPDU header
+ *  @param[in]     alpdu_hdr_len        the length of the ALPDU header, 0 if suppressed
+ *  @param[in]     omit_vlan_ptype      whether the protocol type of the VLAN header is omitted
+ *
+ *  @ingroup RLE header
+ */
+void push_alpdu_hdr_bytes(struct rle_frag_buf *const frag_buf,
+                          const unsigned char *const alpdu_hdr,
+                          const size_t alpdu_hdr_len,
+                          const bool omit_vlan_ptype);
+
 /**
  *  @brief         create and push PPDU header into a fragmentation buffer.
  *
@@ -28,6 +28,7 @@
 
 #include "constants.h"
 #include "rle.h"
+#include "rle_copy.h"
 
 #ifndef __KERNEL__
 
@@ -86,7 +87,7 @@ enum rle_pack_status rle_pack_init(const unsigned char *const label,
 	}
 
 	/* when FPDU is empty, copy the FPDU label before the first PPDU */
-	memcpy(fpdu, label, label_size);
+	rle_copy(fpdu, label, label_size);
 	(*fpdu_current_pos) += label_size;
 	(*fpdu_remaining_size) -= label_size;
 
@@ -131,13 +132,13 @@ enum rle_pack_status rle_pack(const unsigned char *const ppdu,
 
 	/* when FPDU is empty, copy the FPDU label before the first PPDU */
 	if ((*fpdu_current_pos) == 0 && label_size > 0) {
-		memcpy(fpdu, label, label_size);
+		rle_copy(fpdu, label, label_size);
 		(*fpdu_current_pos) += label_size;
 		(*fpdu_remaining_size) -= label_size;
 	}
 
 	/* copy the PPDU */
-	memcpy(fpdu + (*fpdu_current_pos), ppdu, ppdu_length);
+	rle_copy(fpdu + (*fpdu_current_pos), ppdu, ppdu_length);
 	(*fpdu_current_pos) += ppdu_length;
 	(*fpdu_remaining_size) -= ppdu_length;
 
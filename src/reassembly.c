@@ -33,6 +33,7 @@
 #include "trailer.h"
 #include "crc.h"
 #include "rle_header_proto_type_field.h"
+#include "rle_copy.h"
 
 #ifndef __KERNEL__
 
@@ -135,7 +136,7 @@ static bool reassembly_insert_vlan_ptype(const uint8_t *const sdu_frag,
 	reassembled_sdu->protocol_type = RLE_PROTO_TYPE_VLAN_UNCOMP;
 
 	/* copy the Ethernet header and the first part of the VLAN header */
-	memcpy(reassembled_sdu->buffer, sdu_frag, comp_eth_vlan_len);
+	rle_copy(reassembled_sdu->buffer, sdu_frag, comp_eth_vlan_len);
 
 	/* insert the protocol type field in the VLAN header */
 	{
@@ -146,8 +147,8 @@ static bool reassembly_insert_vlan_ptype(const uint8_t *const sdu_frag,
 	}
 
 	/* copy the VLAN payload */
-	memcpy(reassembled_sdu->buffer + sizeof(struct ether_header) + sizeof(struct vlan_hdr),
-	       sdu_frag + comp_eth_vlan_len, sdu_frag_len - comp_eth_vlan_len);
+	rle_copy(reassembled_sdu->buffer + sizeof(struct ether_header) + sizeof(struct vlan_hdr),
+	         sdu_frag + comp_eth_vlan_len, sdu_frag_len - comp_eth_vlan_len);
 
 	return true;
 
@@ -160,7 +161,7 @@ error:
 /*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
-int reassembly_comp_ppdu(struct rle_receiver *_this,
+int reassembly_comp_ppdu(const struct rle_config *const conf,
                          unsigned char *const ppdu,
                          const size_t ppdu_length,
                          struct rle_sdu *const reassembled_sdu)
@@ -201,10 +202,9 @@ int reassembly_comp_ppdu(struct rle_receiver *_this,
 			 * is given by the configuration */
 			ret = suppr_alpdu_extract_sdu_frag(alpdu_frag, alpdu_frag_len,
 			                                   &ptype, &comp_ptype,
-			                                   &sdu_frag, &sdu_frag_len,
-			                                   &_this->conf);
+			                                   &sdu_frag, &sdu_frag_len, conf);
 		}
-	} else if (_this->conf.use_compressed_ptype) {
+	} else if (conf->use_compressed_ptype) {
 		/* protocol type is not suppressed, but compressed */
 		ret = comp_alpdu_extract_sdu_frag(alpdu_frag, alpdu_frag_len,
 		                                  &ptype, &comp_ptype,
@@ -225,7 +225,7 @@ int reassembly_comp_ppdu(struct rle_receiver *_this,
 		/* SDU is complete */
 		reassembled_sdu->size = sdu_frag_len;
 		reassembled_sdu->protocol_type = ptype;
-		memcpy(reassembled_sdu->buffer, sdu_frag, sdu_frag_len);
+		rle_copy(reassembled_sdu->buffer, sdu_frag, sdu_frag_len);
 	} else {
 		assert(ptype == RLE_PROTO_TYPE_VLAN_UNCOMP);
 
@@ -581,7 +581,7 @@ int reassembly_end_ppdu(struct rle_receiver *_this,
 		/* SDU is complete */
 		reassembled_sdu->size = rasm_buf->sdu_info.size;
 		reassembled_sdu->protocol_type = rasm_buf->sdu_info.protocol_type;
-		memcpy(reassembled_sdu->buffer, rasm_buf->sdu_info.buffer, reassembled_sdu->size);
+		rle_copy(reassembled_sdu->buffer, rasm_buf->sdu_info.buffer, reassembled_sdu->size);
 		RLE_DEBUG("%zu-byte SDU with protocol 0x%04x is complete",
 		          reassembled_sdu->size, reassembled_sdu->protocol_type);
 	} else {
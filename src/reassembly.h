@@ -80,14 +80,18 @@ int reassembly_reassemble_pdu(struct rle_ctx_mngt *rle_ctx,
 /**
  * @brief Reassemble complete PPDU.
  *
- * @param[in,out] _this            The receiver module to use for reassembly.
+ *        A complete PPDU needs no reassembly context, so only the configuration of the
+ *        receiver is read: several threads may reassemble complete PPDUs with the same
+ *        configuration.
+ *
+ * @param[in]     conf             The configuration of the receiver.
  * @param[in]     ppdu             The PPDU containing ALPDU fragments to reassemble.
  * @param[in]     ppdu_length      The length of the PPDU.
  * @param[out]    reassembled_sdu  The reassembled SDU.
  *
  * @ingroup RLE receiver
  */
-int reassembly_comp_ppdu(struct rle_receiver *_this,
+int reassembly_comp_ppdu(const struct rle_config *const conf,
                          unsigned char *const ppdu,
                          const size_t ppdu_length,
                          struct rle_sdu *const reassembled_sdu);
@@ -27,6 +27,7 @@
  */
 
 #include "reassembly_buffer.h"
+#include "rle_copy.h"
 
 
 /*------------------------------------------------------------------------------------------------*/
@@ -52,17 +53,11 @@ void rasm_buf_cpy_sdu_frag(rle_rasm_buf_t *const rasm_buf, const unsigned char s
 	assert(rasm_buf_in_use(rasm_buf));
 
 	if (rasm_buf->sdu_frag.end != rasm_buf->sdu_frag.start) {
-		memcpy(rasm_buf->sdu_frag.start, sdu_frag,
-		       rasm_buf->sdu_frag.end - rasm_buf->sdu_frag.start);
+		rle_copy(rasm_buf->sdu_frag.start, sdu_frag,
+		         rasm_buf->sdu_frag.end - rasm_buf->sdu_frag.start);
 	}
 }
 
-size_t rasm_buf_get_sdu_len(const rle_rasm_buf_t *const rasm_buf)
-{
-	assert(rasm_buf->sdu.end >= rasm_buf->sdu.start);
-	return (rasm_buf->sdu.end - rasm_buf->sdu.start);
-}
-
 size_t rasm_buf_get_reassembled_sdu_len(const rle_rasm_buf_t *const rasm_buf)
 {
 	assert(rasm_buf->sdu_frag.end >= rasm_buf->sdu.start);
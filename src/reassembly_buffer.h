@@ -32,6 +32,7 @@
 #include "rle.h"
 
 #include "constants.h"
+#include "rle_pool.h"
 
 #ifndef __KERNEL__
 #       include <assert.h>
@@ -187,20 +188,23 @@ void rasm_buf_sdu_frag_put(rle_rasm_buf_t *const rasm_buf, const size_t size);
 /**
  * @brief         Create a new reassembly buffer.
  *
+ * @param[in,out] pool                     The memory pool, NULL for the heap.
+ *
  * @return        The reassembly buffer if OK, else NULL.
  *
  * @ingroup       RLE Reassembly buffer.
  */
-static inline rle_rasm_buf_t * rasm_buf_new(void);
+static inline rle_rasm_buf_t * rasm_buf_new(struct rle_pool *const pool);
 
 /**
  * @brief         Destroy a reassembly buffer.
  *
- * @param[in,out] rasm_buf                   The reassembly buffer to destroy.
+ * @param[in,out] pool                     The memory pool, NULL for the heap.
+ * @param[in,out] rasm_buf                 The reassembly buffer to destroy.
  *
  * @ingroup       RLE Reassembly buffer.
  */
-static inline void rasm_buf_del(rle_rasm_buf_t **const rasm_buf);
+static inline void rasm_buf_del(struct rle_pool *const pool, rle_rasm_buf_t **const rasm_buf);
 
 /**
  * @brief         Initialize (eventually reinitialize) a reassembly buffer.
@@ -244,7 +248,7 @@ void rasm_buf_cpy_sdu_frag(rle_rasm_buf_t *const rasm_buf,
  *
  * @ingroup       RLE Reassembly buffer.
  */
-size_t rasm_buf_get_sdu_len(const rle_rasm_buf_t *const rasm_buf);
+static inline size_t rasm_buf_get_sdu_len(const rle_rasm_buf_t *const rasm_buf);
 
 /**
  * @brief         Get the length of SDU currently reassembled.
@@ -343,21 +347,27 @@ static inline void rasm_buf_sdu_put(rle_rasm_buf_t *const rasm_buf, const size_t
 	rasm_buf_ptrs_put(&rasm_buf->sdu, size);
 }
 
+static inline size_t rasm_buf_get_sdu_len(const rle_rasm_buf_t *const rasm_buf)
+{
+	assert(rasm_buf->sdu.end >= rasm_buf->sdu.start);
+	return (rasm_buf->sdu.end - rasm_buf->sdu.start);
+}
+
 static inline void rasm_buf_init_sdu_frag(rle_rasm_buf_t *const rasm_buf)
 {
 	rasm_buf_ptrs_set(&rasm_buf->sdu_frag, rasm_buf->sdu_frag.end);
 }
 
-static inline rle_rasm_buf_t * rasm_buf_new(void)
+static inline rle_rasm_buf_t * rasm_buf_new(struct rle_pool *const pool)
 {
-	rle_rasm_buf_t *rasm_buf = (rle_rasm_buf_t *)MALLOC(sizeof(rle_rasm_buf_t));
+	rle_rasm_buf_t *rasm_buf = (rle_rasm_buf_t *)rle_pool_alloc(pool, sizeof(rle_rasm_buf_t));
 
 	if (!rasm_buf) {
 		RLE_ERR("reassembly buffer not allocated.");
 		goto error;
 	}
 
-	rasm_buf->buffer = (unsigned char *)MALLOC(RLE_R_BUFF_LEN);
+	rasm_buf->buffer = (unsigned char *)rle_pool_alloc(pool, RLE_R_BUFF_LEN);
 	if (!rasm_buf->buffer) {
 		RLE_ERR("reassembly buffer not allocated (2)");
 		goto free_rasm_buf;
@@ -369,22 +379,22 @@ static inline rle_rasm_buf_t * rasm_buf_new(void)
 	return rasm_buf;
 
 free_rasm_buf:
-	FREE(rasm_buf);
+	rle_pool_free(pool, rasm_buf, sizeof(rle_rasm_buf_t));
 error:
 	return NULL;
 }
 
-static inline void rasm_buf_del(rle_rasm_buf_t **const rasm_buf)
+static inline void rasm_buf_del(struct rle_pool *const pool, rle_rasm_buf_t **const rasm_buf)
 {
 	assert(rasm_buf != NULL);
 	assert((*rasm_buf) != NULL);
 
 	if ((*rasm_buf)->sdu_info.buffer) {
-		FREE((*rasm_buf)->sdu_info.buffer);
+		rle_pool_free(pool, (*rasm_buf)->sdu_info.buffer, RLE_R_BUFF_LEN);
 		(*rasm_buf)->sdu_info.buffer = NULL;
 	}
 
-	FREE(*rasm_buf);
+	rle_pool_free(pool, *rasm_buf, sizeof(rle_rasm_buf_t));
 	*rasm_buf = NULL;
 }
 
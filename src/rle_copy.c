@@ -0,0 +1,239 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_copy.c
+ * @brief  Copy kernels of the SDUs, PPDUs and labels, chosen by the features of the CPU.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#include "rle_copy.h"
+
+#ifndef __KERNEL__
+
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * The shortest copy given to memcpy() by the vector kernels: for longer copies, the libc uses
+ * the string instructions of the CPU, or larger unrolled loops, that are faster.
+ */
+#define RLE_COPY_LIBC_MIN 1024U
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#if defined(__x86_64__)
+
+/**
+ * @brief  Copy kernel with 16-octet SSE2 vectors, available on every x86-64 CPU.
+ *
+ * @param[out] dst  The destination.
+ * @param[in]  src  The source.
+ * @param[in]  len  The number of octets, at least 32.
+ */
+static void copy_sse2(unsigned char *const dst, const unsigned char *const src,
+                      const size_t len);
+
+/**
+ * @brief  Copy kernel with 32-octet AVX2 vectors.
+ *
+ * @param[out] dst  The destination.
+ * @param[in]  src  The source.
+ * @param[in]  len  The number of octets, at least 32.
+ */
+static void copy_avx2(unsigned char *const dst, const unsigned char *const src,
+                      const size_t len)
+__attribute__((target("avx2")));
+
+/** A copy kernel. */
+typedef void (*copy_kernel_t)(unsigned char *const dst, const unsigned char *const src,
+                              const size_t len);
+
+/**
+ * @brief  Choose the copy kernel of the CPU, when the library is loaded.
+ *
+ *         The resolver of the GNU indirect function rle_copy_large(): the dynamic loader calls
+ *         it once and binds rle_copy_large() to the kernel returned. It may run before the
+ *         runtimes of the sanitizers are set up, so it is not instrumented.
+ *
+ * @return  The copy kernel of the CPU.
+ */
+static copy_kernel_t copy_select_kernel(void)
+__attribute__((no_sanitize_address, no_sanitize_undefined));
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#if defined(__x86_64__)
+
+static void copy_sse2(unsigned char *const dst, const unsigned char *const src,
+                      const size_t len)
+{
+	const __m128i head = _mm_loadu_si128((const __m128i *)src);
+	const __m128i tail = _mm_loadu_si128((const __m128i *)(src + len - 16));
+	size_t pos;
+
+	if (len <= 64) {
+		const __m128i v1 = _mm_loadu_si128((const __m128i *)(src + 16));
+		const __m128i v2 = _mm_loadu_si128((const __m128i *)(src + len - 32));
+
+		_mm_storeu_si128((__m128i *)dst, head);
+		_mm_storeu_si128((__m128i *)(dst + 16), v1);
+		_mm_storeu_si128((__m128i *)(dst + len - 32), v2);
+		_mm_storeu_si128((__m128i *)(dst + len - 16), tail);
+		return;
+	}
+	if (len >= RLE_COPY_LIBC_MIN) {
+		memcpy(dst, src, len);
+		return;
+	}
+
+	/* the first vector is stored as is, the next ones on aligned addresses of the destination,
+	 * so no store crosses a cache line */
+	_mm_storeu_si128((__m128i *)dst, head);
+	pos = 16 - ((uintptr_t)dst & 15);
+	for (; pos + 32 < len; pos += 32) {
+		const __m128i v0 = _mm_loadu_si128((const __m128i *)(src + pos));
+		const __m128i v1 = _mm_loadu_si128((const __m128i *)(src + pos + 16));
+
+		_mm_store_si128((__m128i *)(dst + pos), v0);
+		_mm_store_si128((__m128i *)(dst + pos + 16), v1);
+	}
+	if (pos + 16 < len) {
+		_mm_store_si128((__m128i *)(dst + pos), _mm_loadu_si128((const __m128i *)(src + pos)));
+	}
+	/* the last vector overlaps the previous one rather than copying the tail octet per octet */
+	_mm_storeu_si128((__m128i *)(dst + len - 16), tail);
+}
+
+static void copy_avx2(unsigned char *const dst, const unsigned char *const src,
+                      const size_t len)
+{
+	const __m256i head = _mm256_loadu_si256((const __m256i *)src);
+	const __m256i tail = _mm256_loadu_si256((const __m256i *)(src + len - 32));
+	size_t pos;
+
+	if (len <= 64) {
+		_mm256_storeu_si256((__m256i *)dst, head);
+		_mm256_storeu_si256((__m256i *)(dst + len - 32), tail);
+		return;
+	}
+	if (len <= 128) {
+		const __m256i v1 = _mm256_loadu_si256((const __m256i *)(src + 32));
+		const __m256i v2 = _mm256_loadu_si256((const __m256i *)(src + len - 64));
+
+		_mm256_storeu_si256((__m256i *)dst, head);
+		_mm256_storeu_si256((__m256i *)(dst + 32), v1);
+		_mm256_storeu_si256((__m256i *)(dst + len - 64), v2);
+		_mm256_storeu_si256((__m256i *)(dst + len - 32), tail);
+		return;
+	}
+	if (len >= RLE_COPY_LIBC_MIN) {
+		memcpy(dst, src, len);
+		return;
+	}
+
+	/* the first vector is stored as is, the next ones on aligned addresses of the destination,
+	 * so no store crosses a cache line */
+	_mm256_storeu_si256((__m256i *)dst, head);
+	pos = 32 - ((uintptr_t)dst & 31);
+	for (; pos + 128 < len; pos += 128) {
+		const __m256i v0 = _mm256_loadu_si256((const __m256i *)(src + pos));
+		const __m256i v1 = _mm256_loadu_si256((const __m256i *)(src + pos + 32));
+		const __m256i v2 = _mm256_loadu_si256((const __m256i *)(src + pos + 64));
+		const __m256i v3 = _mm256_loadu_si256((const __m256i *)(src + pos + 96));
+
+		_mm256_store_si256((__m256i *)(dst + pos), v0);
+		_mm256_store_si256((__m256i *)(dst + pos + 32), v1);
+		_mm256_store_si256((__m256i *)(dst + pos + 64), v2);
+		_mm256_store_si256((__m256i *)(dst + pos + 96), v3);
+	}
+	for (; pos + 64 < len; pos += 64) {
+		const __m256i v0 = _mm256_loadu_si256((const __m256i *)(src + pos));
+		const __m256i v1 = _mm256_loadu_si256((const __m256i *)(src + pos + 32));
+
+		_mm256_store_si256((__m256i *)(dst + pos), v0);
+		_mm256_store_si256((__m256i *)(dst + pos + 32), v1);
+	}
+	if (pos + 32 < len) {
+		_mm256_store_si256((__m256i *)(dst + pos),
+		                   _mm256_loadu_si256((const __m256i *)(src + pos)));
+	}
+	/* the last vector overlaps the previous one rather than copying the tail octet per octet */
+	_mm256_storeu_si256((__m256i *)(dst + len - 32), tail);
+}
+
+static copy_kernel_t copy_select_kernel(void)
+{
+	/* called before the constructors, so the CPU features are not known yet */
+	__builtin_cpu_init();
+
+	return __builtin_cpu_supports("avx2") ? copy_avx2 : copy_sse2;
+}
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#if defined(__x86_64__)
+
+void rle_copy_large(unsigned char *const dst, const unsigned char *const src, const size_t len)
+__attribute__((ifunc("copy_select_kernel")));
+
+const char * rle_copy_get_kernel_name(void)
+{
+	return copy_select_kernel() == copy_avx2 ? "avx2" : "sse2";
+}
+
+#else
+
+void rle_copy_large(unsigned char *const dst, const unsigned char *const src, const size_t len)
+{
+	memcpy(dst, src, len);
+}
+
+const char * rle_copy_get_kernel_name(void)
+{
+	return "libc";
+}
+
+#endif
+
+#endif
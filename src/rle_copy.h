@@ -0,0 +1,162 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_copy.h
+ * @brief  Copy of the SDUs, PPDUs and labels in the data path.
+ *
+ *         The copies of the data path are of a few tens to a few hundreds of octets. Copies of
+ *         up to 32 octets are inlined, as two overlapping loads and stores. Longer ones go to a
+ *         vector kernel chosen once by the features of the CPU, which copies the last vector
+ *         over the previous one instead of looping on the tail. The kernel keeps memcpy(), as
+ *         vector registers may not be used there.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __RLE_COPY_H__
+#define __RLE_COPY_H__
+
+#ifndef __KERNEL__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#else
+
+#include <linux/stddef.h>
+#include <linux/types.h>
+#include <linux/string.h>
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*---------------------------------- PUBLIC CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** The longest copy inlined, longer ones are given to the copy kernel of the CPU. */
+#define RLE_COPY_INLINE_MAX 32U
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#ifndef __KERNEL__
+
+/**
+ * @brief  Copy more than RLE_COPY_INLINE_MAX octets with the copy kernel of the CPU.
+ *
+ *         The kernel is chosen when the library is loaded, through a GNU indirect function on
+ *         x86-64. The function is not exported by the library.
+ *
+ * @param[out] dst  The destination, not overlapping the source.
+ * @param[in]  src  The source.
+ * @param[in]  len  The number of octets, more than RLE_COPY_INLINE_MAX.
+ *
+ * @ingroup RLE copy
+ */
+void rle_copy_large(unsigned char *const dst, const unsigned char *const src, const size_t len)
+__attribute__((visibility("hidden")));
+
+/**
+ * @brief  Get the name of the copy kernel chosen for the CPU.
+ *
+ * @return  "avx2", "sse2" or "libc".
+ *
+ * @ingroup RLE copy
+ */
+const char * rle_copy_get_kernel_name(void);
+
+/**
+ * @brief  Copy a SDU, a PPDU or a label.
+ *
+ * @param[out] dst  The destination, not overlapping the source.
+ * @param[in]  src  The source.
+ * @param[in]  len  The number of octets.
+ *
+ * @ingroup RLE copy
+ */
+static inline void rle_copy(void *const dst, const void *const src, const size_t len)
+{
+	unsigned char *const d = (unsigned char *)dst;
+	const unsigned char *const s = (const unsigned char *)src;
+
+	if (len > RLE_COPY_INLINE_MAX) {
+		rle_copy_large(d, s, len);
+	} else if (len >= 16) {
+		uint64_t head[2];
+		uint64_t tail[2];
+
+		__builtin_memcpy(head, s, 16);
+		__builtin_memcpy(tail, s + len - 16, 16);
+		__builtin_memcpy(d, head, 16);
+		__builtin_memcpy(d + len - 16, tail, 16);
+	} else if (len >= 8) {
+		uint64_t head;
+		uint64_t tail;
+
+		__builtin_memcpy(&head, s, 8);
+		__builtin_memcpy(&tail, s + len - 8, 8);
+		__builtin_memcpy(d, &head, 8);
+		__builtin_memcpy(d + len - 8, &tail, 8);
+	} else if (len >= 4) {
+		uint32_t head;
+		uint32_t tail;
+
+		__builtin_memcpy(&head, s, 4);
+		__builtin_memcpy(&tail, s + len - 4, 4);
+		__builtin_memcpy(d, &head, 4);
+		__builtin_memcpy(d + len - 4, &tail, 4);
+	} else if (len > 0) {
+		/* 1 to 3 octets: first, middle and last ones, some may be the same */
+		const unsigned char first = s[0];
+		const unsigned char middle = s[len / 2];
+		const unsigned char last = s[len - 1];
+
+		d[0] = first;
+		d[len / 2] = middle;
+		d[len - 1] = last;
+	}
+}
+
+#else
+
+/**
+ * @brief  Copy a SDU, a PPDU or a label, with memcpy() as vector registers are not usable.
+ *
+ * @param[out] dst  The destination, not overlapping the source.
+ * @param[in]  src  The source.
+ * @param[in]  len  The number of octets.
+ *
+ * @ingroup RLE copy
+ */
+static inline void rle_copy(void *const dst, const void *const src, const size_t len)
+{
+	memcpy(dst, src, len);
+}
+
+#endif
+
+#endif /* __RLE_COPY_H__ */
@@ -118,13 +118,14 @@ static void flush_ctxt_rasm_buf(struct rle_ctx_mngt *_this)
 /*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
-int rle_ctx_init_frag_buf(struct rle_ctx_mngt *_this)
+int rle_ctx_init_frag_buf(struct rle_ctx_mngt *_this, struct rle_pool *const pool,
+                          const size_t sdu_capacity)
 {
 	int status = C_ERROR;
 
 	assert(_this != NULL);
 
-	_this->buff = (void *)rle_frag_buf_new();
+	_this->buff = (void *)frag_buf_new_in_pool(pool, sdu_capacity);
 
 	/* allocate enough memory space for the fragmentation */
 	if (!_this->buff) {
@@ -141,14 +142,44 @@ out:
 	return status;
 }
 
-int rle_ctx_init_rasm_buf(struct rle_ctx_mngt *_this)
+int rle_ctx_fit_frag_buf(struct rle_ctx_mngt *_this, struct rle_pool *const pool,
+                         const size_t sdu_len)
+{
+	rle_frag_buf_t *frag_buf = (rle_frag_buf_t *)_this->buff;
+	const size_t sdu_capacity = frag_buf_get_class_capacity(sdu_len);
+	rle_frag_buf_t *new_frag_buf;
+	int status = C_OK;
+
+	if (frag_buf->sdu_capacity == sdu_capacity) {
+		goto out;
+	}
+
+	new_frag_buf = frag_buf_new_in_pool(pool, sdu_capacity);
+	if (!new_frag_buf) {
+		/* a larger buffer still holds the SDU */
+		if (frag_buf->sdu_capacity < sdu_len) {
+			RLE_ERR("no %zu-byte SDU fragmentation buffer for a %zu-byte SDU", sdu_capacity,
+			        sdu_len);
+			status = C_ERROR;
+		}
+		goto out;
+	}
+
+	frag_buf_del_in_pool(pool, &frag_buf);
+	_this->buff = (void *)new_frag_buf;
+
+out:
+	return status;
+}
+
+int rle_ctx_init_rasm_buf(struct rle_ctx_mngt *_this, struct rle_pool *const pool)
 {
 	int status = C_ERROR;
 
 	assert(_this != NULL);
 
 	/* allocate enough memory space for the reassembly */
-	_this->buff = (void *)rasm_buf_new();
+	_this->buff = (void *)rasm_buf_new(pool);
 	if (!_this->buff) {
 		RLE_ERR("reassembly buffer allocation failed.");
 		goto out;
@@ -163,22 +194,22 @@ out:
 	return status;
 }
 
-void rle_ctx_destroy_frag_buf(struct rle_ctx_mngt *_this)
+void rle_ctx_destroy_frag_buf(struct rle_ctx_mngt *_this, struct rle_pool *const pool)
 {
 	assert(_this != NULL);
 	assert(_this->buff != NULL);
 
 	flush(_this);
 
-	rle_frag_buf_del((rle_frag_buf_t **)&_this->buff);
+	frag_buf_del_in_pool(pool, (rle_frag_buf_t **)&_this->buff);
 }
 
-void rle_ctx_destroy_rasm_buf(struct rle_ctx_mngt *_this)
+void rle_ctx_destroy_rasm_buf(struct rle_ctx_mngt *_this, struct rle_pool *const pool)
 {
 	assert(_this != NULL);
 	assert(_this->buff != NULL);
 
-	rasm_buf_del((rle_rasm_buf_t **)&_this->buff);
+	rasm_buf_del(pool, (rle_rasm_buf_t **)&_this->buff);
 }
 
 void rle_ctx_set_seq_nb(struct rle_ctx_mngt *_this, uint8_t val)
@@ -186,16 +217,6 @@ void rle_ctx_set_seq_nb(struct rle_ctx_mngt *_this, uint8_t val)
 	_this->next_seq_nb = val;
 }
 
-uint8_t rle_ctx_get_seq_nb(const struct rle_ctx_mngt *const _this)
-{
-	return _this->next_seq_nb;
-}
-
-void rle_ctx_incr_seq_nb(struct rle_ctx_mngt *_this)
-{
-	_this->next_seq_nb = (_this->next_seq_nb + 1) % RLE_MAX_SEQ_NO;
-}
-
 void rle_ctx_set_use_crc(struct rle_ctx_mngt *_this, bool val)
 {
 	_this->use_crc = val;
@@ -205,10 +226,3 @@ bool rle_ctx_get_use_crc(const struct rle_ctx_mngt *const _this)
 {
 	return _this->use_crc;
 }
-
-size_t get_fragment_length(const unsigned char *const buffer)
-{
-	const rle_ppdu_hdr_t *const ppdu_hdr = (rle_ppdu_hdr_t *)buffer;
-
-	return (rle_ppdu_hdr_get_ppdu_length(ppdu_hdr) + sizeof(ppdu_hdr->common));
-}
@@ -67,7 +67,10 @@ struct link_status {
 	uint64_t counter_bytes_dropped;
 };
 
-/** RLE context management structure */
+/**
+ * RLE context management structure.
+ * Aligned on cache lines, so the contexts of the different fragment IDs do not share one.
+ */
 struct rle_ctx_mngt {
 	/** specify fragment id the structure belongs to */
 	uint8_t frag_id;
@@ -83,7 +86,7 @@ struct rle_ctx_mngt {
 	int lk_type;
 	/** Fragmentation context status */
 	struct link_status lk_status;
-};
+} __attribute__((aligned(RLE_CACHE_LINE_SIZE)));
 
 
 /*------------------------------------------------------------------------------------------------*/
@@ -93,44 +96,69 @@ struct rle_ctx_mngt {
 /**
  * @brief  Initialize RLE context structure with fragmentation buffers.
  *
- * @param[out]    _this  Pointer to the RLE context structure
+ * @param[out]    _this         Pointer to the RLE context structure
+ * @param[in,out] pool          The memory pool of the buffers, NULL for the heap
+ * @param[in]     sdu_capacity  The size class of the fragmentation buffer
  *
  * @return  C_ERROR  If initilization went wrong
  *          C_OK     Otherwise
  *
  * @ingroup RLE context
  */
-int rle_ctx_init_frag_buf(struct rle_ctx_mngt *_this);
+int rle_ctx_init_frag_buf(struct rle_ctx_mngt *_this, struct rle_pool *const pool,
+                          const size_t sdu_capacity);
+
+/**
+ * @brief  Give a free RLE context the fragmentation buffer of the size class of a SDU.
+ *
+ *         The fragmentation buffer of the context is swapped in the memory pool for one of the
+ *         size class of the SDU, when the classes differ. The new buffer is not initialized,
+ *         rle_encapsulate() does it for every SDU.
+ *
+ * @param[in,out] _this    Pointer to the RLE context structure
+ * @param[in,out] pool     The memory pool of the buffers
+ * @param[in]     sdu_len  The length of the SDU to encapsulate, up to RLE_MAX_PDU_SIZE
+ *
+ * @return  C_ERROR  If the SDU does not fit in the buffer and no larger one was allocated
+ *          C_OK     Otherwise
+ *
+ * @ingroup RLE context
+ */
+int rle_ctx_fit_frag_buf(struct rle_ctx_mngt *_this, struct rle_pool *const pool,
+                         const size_t sdu_len);
 
 /**
  * @brief  Initialize RLE context structure with reassembly buffers.
  *
  * @param[out]    _this  Pointer to the RLE context structure
+ * @param[in,out] pool   The memory pool of the buffers, NULL for the heap
  *
  * @return  C_ERROR  If initilization went wrong
  *          C_OK     Otherwise
  *
  * @ingroup RLE context
  */
-int rle_ctx_init_rasm_buf(struct rle_ctx_mngt *_this);
+int rle_ctx_init_rasm_buf(struct rle_ctx_mngt *_this, struct rle_pool *const pool);
 
 /**
  * @brief  Destroy RLE context with fragmentation buffers structure and free memory
  *
- * @param[out]   _this  Pointer to the RLE context structure
+ * @param[out]    _this  Pointer to the RLE context structure
+ * @param[in,out] pool   The memory pool the buffers were allocated in, NULL for the heap
  *
  * @ingroup RLE context
  */
-void rle_ctx_destroy_frag_buf(struct rle_ctx_mngt *_this);
+void rle_ctx_destroy_frag_buf(struct rle_ctx_mngt *_this, struct rle_pool *const pool);
 
 /**
  * @brief  Destroy RLE context with reassembly buffers structure and free memory
  *
- * @param[out]   _this  Pointer to the RLE context structure
+ * @param[out]    _this  Pointer to the RLE context structure
+ * @param[in,out] pool   The memory pool the buffers were allocated in, NULL for the heap
  *
  * @ingroup RLE context
  */
-void rle_ctx_destroy_rasm_buf(struct rle_ctx_mngt *_this);
+void rle_ctx_destroy_rasm_buf(struct rle_ctx_mngt *_this, struct rle_pool *const pool);
 
 /**
  * @brief  Set sequence number
@@ -151,7 +179,10 @@ void rle_ctx_set_seq_nb(struct rle_ctx_mngt *const _this, const uint8_t val);
  *
  * @ingroup RLE context
  */
-uint8_t rle_ctx_get_seq_nb(const struct rle_ctx_mngt *const _this);
+static inline uint8_t rle_ctx_get_seq_nb(const struct rle_ctx_mngt *const _this)
+{
+	return _this->next_seq_nb;
+}
 
 /**
  * @brief  Increment by one current sequence number
@@ -160,7 +191,10 @@ uint8_t rle_ctx_get_seq_nb(const struct rle_ctx_mngt *const _this);
  *
  * @ingroup RLE context
  */
-void rle_ctx_incr_seq_nb(struct rle_ctx_mngt *const _this);
+static inline void rle_ctx_incr_seq_nb(struct rle_ctx_mngt *const _this)
+{
+	_this->next_seq_nb = (_this->next_seq_nb + 1) % RLE_MAX_SEQ_NO;
+}
 
 /**
  * @brief  Set CRC usage flag for a specific RLE context
@@ -722,7 +756,12 @@ static inline void rle_ctx_reset_counters(struct rle_ctx_mngt *const _this)
  *
  * @return        the fragment type @see enum frag_states
  */
-size_t get_fragment_length(const unsigned char *const buffer);
+static inline size_t get_fragment_length(const unsigned char *const buffer)
+{
+	const rle_ppdu_hdr_t *const ppdu_hdr = (rle_ppdu_hdr_t *)buffer;
+
+	return (rle_ppdu_hdr_get_ppdu_length(ppdu_hdr) + sizeof(ppdu_hdr->common));
+}
 
 /**
  * @brief         Get the state of the frag_id-nth context.
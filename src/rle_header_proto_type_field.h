@@ -29,11 +29,13 @@
 
 #ifndef __KERNEL__
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 #else
 
+#include <linux/stddef.h>
 #include <linux/types.h>
 
 #endif
@@ -73,6 +75,20 @@
 /*-------------------------------------- PUBLIC FUNCTIONS ----------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
+/**
+ * @brief Compress the protocol type of a SDU.
+ *
+ * @param uncompressed_ptype  The uncompressed protocol type
+ * @param sdu                 The SDU, for the VLAN protocol type that depends on the payload
+ * @param sdu_len             The length of the SDU
+ * @return                    The compressed protocol type, RLE_PROTO_TYPE_FALLBACK if the
+ *                            protocol type is not compressible
+ */
+uint8_t ptype_compression(const uint16_t uncompressed_ptype,
+                          const unsigned char *const sdu,
+                          const size_t sdu_len)
+__attribute__((warn_unused_result, nonnull(2)));
+
 /**
  * @brief Get the ALPDU label type depending on the protocol type.
  *
@@ -27,8 +27,9 @@
  */
 
 #include <rle.h>
+#include "constants.h"
 
-static rle_trace_callback_t rle_trace_callback = NULL;
+rle_trace_callback_t rle_trace_callback __attribute__((visibility("hidden"))) = NULL;
 
 void rle_set_trace_callback(rle_trace_callback_t callback)
 {
@@ -40,6 +41,11 @@ rle_trace_callback_t rle_get_trace_callback(void)
 	return rle_trace_callback;
 }
 
+rle_trace_callback_t rle_get_trace_callback_cold(void)
+{
+	return rle_trace_callback;
+}
+
 const rle_log_module_tuple_t * rle_get_log_modules_list(size_t *nb_modules)
 {
 	/* Declare a constant array describing the rle modules.
@@ -60,7 +66,8 @@ const rle_log_module_tuple_t * rle_get_log_modules_list(size_t *nb_modules)
 		{ RLE_MOD_ID_CTX, "RLE_CTX" },
 		{ RLE_MOD_ID_RECEIVER, "RLE_RECEIVER" },
 		{ RLE_MOD_ID_TRANSMITTER, "RLE_TRANSMITTER" },
-		{ RLE_MOD_ID_TRAILER, "RLE_TRAILER" }
+		{ RLE_MOD_ID_TRAILER, "RLE_TRAILER" },
+		{ RLE_MOD_ID_POOL, "RLE_POOL" }
 	};
 
 	/* if the pointer passed as argument is not null,
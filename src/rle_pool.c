@@ -0,0 +1,529 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_pool.c
+ * @brief  RLE memory pool, placed on a NUMA node and backed by huge pages.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#include "rle_pool.h"
+#include "constants.h"
+
+#ifndef __KERNEL__
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#else
+
+#include <linux/types.h>
+#include <linux/string.h>
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#define MODULE_ID RLE_MOD_ID_POOL
+
+/** The size of the chunks of memory mapped at once, one huge page. */
+#define RLE_POOL_CHUNK_SIZE (2U << 20)
+
+/** The maximal number of different buffer sizes in a pool. */
+#define RLE_POOL_CLASSES_NR 16U
+
+/**
+ * The number of generic buffer sizes, the powers of 2 from one cache line to one chunk, used
+ * once the pool has RLE_POOL_CLASSES_NR sizes.
+ */
+#define RLE_POOL_POW2_CLASSES_NR 16U
+
+/** The number of NUMA nodes of the node masks given to the kernel. */
+#define RLE_POOL_MAX_NODES 1024U
+
+/** The number of bits of a word of a node mask. */
+#define RLE_POOL_MASK_BITS (8U * sizeof(unsigned long))
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- HEAP FUNCTIONS CODE ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief  Allocate a buffer on the heap, aligned on a cache line.
+ *
+ *         The heap only guarantees the alignment of the largest scalar type, so two instances
+ *         allocated one after the other may share a cache line. The buffer is rather taken
+ *         one cache line further in a larger allocation, the address of which is kept just
+ *         before the buffer.
+ *
+ * @param[in] size  The size of the buffer.
+ *
+ * @return  The buffer, NULL in case of error.
+ */
+static void * pool_heap_alloc(const size_t size)
+{
+	unsigned char *const raw = (unsigned char *)MALLOC(size + RLE_CACHE_LINE_SIZE);
+	unsigned char *buf = NULL;
+
+	if (raw == NULL) {
+		goto out;
+	}
+
+	buf = raw + RLE_CACHE_LINE_SIZE - ((uintptr_t)raw & (RLE_CACHE_LINE_SIZE - 1));
+	memcpy(buf - sizeof(void *), &raw, sizeof(void *));
+
+out:
+	return buf;
+}
+
+/**
+ * @brief  Give back a buffer allocated by pool_heap_alloc() to the heap.
+ *
+ * @param[in] buf  The buffer.
+ */
+static void pool_heap_free(void *const buf)
+{
+	void *raw;
+
+	if (buf == NULL) {
+		goto out;
+	}
+
+	memcpy(&raw, (unsigned char *)buf - sizeof(void *), sizeof(void *));
+	FREE(raw);
+
+out:
+	return;
+}
+
+
+#ifndef __KERNEL__
+
+/*------------------------------------------------------------------------------------------------*/
+/*-------------------------------- PRIVATE STRUCTS AND TYPEDEFS ----------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** Header of a chunk of memory, in its first cache line. */
+struct rle_pool_chunk {
+	struct rle_pool_chunk *next;  /**< The chunk mapped before.                  */
+};
+
+/** A buffer given back to the pool. */
+struct rle_pool_free_buf {
+	struct rle_pool_free_buf *next;  /**< The buffer of the same size given back before. */
+};
+
+/** The buffers of one size. */
+struct rle_pool_class {
+	size_t size;                          /**< The size of the buffers, cache-aligned.    */
+	struct rle_pool_free_buf *free_bufs;  /**< The buffers given back, ready to be reused. */
+};
+
+/** Memory pool implementation. */
+struct rle_pool {
+	struct rle_pool_config conf;                      /**< The configuration.              */
+	struct rle_pool_chunk *chunks;                    /**< The last chunk mapped.          */
+	unsigned char *cur;                               /**< The free memory of the last chunk. */
+	unsigned char *end;                               /**< The end of the last chunk.      */
+	struct rle_pool_class classes[RLE_POOL_CLASSES_NR]; /**< The buffer sizes.             */
+	size_t classes_nr;                                /**< The number of buffer sizes.     */
+	struct rle_pool_class pow2_classes[RLE_POOL_POW2_CLASSES_NR]; /**< The generic sizes.  */
+	struct rle_pool_stats stats;                      /**< The statistics.                 */
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief  Round a size up to a multiple of the cache line size.
+ *
+ * @param[in] size  The size.
+ *
+ * @return  The rounded size.
+ */
+static size_t pool_align(const size_t size)
+{
+	return (size + RLE_CACHE_LINE_SIZE - 1) & ~((size_t)RLE_CACHE_LINE_SIZE - 1);
+}
+
+/**
+ * @brief  Get the NUMA node of the CPU the calling thread runs on.
+ *
+ * @return  The NUMA node, -1 if unknown.
+ */
+static int pool_get_cur_node(void)
+{
+	unsigned int cpu;
+	unsigned int node;
+
+	if (syscall(__NR_getcpu, &cpu, &node, NULL) != 0) {
+		return -1;
+	}
+
+	return (int)node;
+}
+
+/**
+ * @brief  Bind memory to a NUMA node before its pages are allocated.
+ *
+ *         The node is preferred rather than required, so the memory still comes from another
+ *         node once the node is full.
+ *
+ * @param[in] mem   The memory.
+ * @param[in] len   The length of the memory.
+ * @param[in] node  The NUMA node.
+ *
+ * @return  0 if OK, else -1.
+ */
+static int pool_bind(void *const mem, const size_t len, const int node)
+{
+	unsigned long nodemask[RLE_POOL_MAX_NODES / RLE_POOL_MASK_BITS];
+
+	if (node < 0 || (unsigned int)node >= RLE_POOL_MAX_NODES) {
+		errno = EINVAL;
+		return -1;
+	}
+	memset(nodemask, 0, sizeof(nodemask));
+	nodemask[node / RLE_POOL_MASK_BITS] = 1UL << (node % RLE_POOL_MASK_BITS);
+
+	/* the kernel reads maxnode - 1 bits */
+	return syscall(__NR_mbind, mem, len, MPOL_PREFERRED, nodemask, RLE_POOL_MAX_NODES + 1, 0);
+}
+
+/**
+ * @brief  Map a new chunk of memory in a pool, on its NUMA node.
+ *
+ *         The free memory left in the previous chunk is not used anymore.
+ *
+ * @param[in,out] pool  The memory pool.
+ *
+ * @return  0 if OK, else -1.
+ */
+static int pool_map_chunk(struct rle_pool *const pool)
+{
+	struct rle_pool_chunk *chunk;
+	void *mem = MAP_FAILED;
+	int is_hugepage = 0;
+
+	if (pool->conf.use_hugepages) {
+		mem = mmap(NULL, RLE_POOL_CHUNK_SIZE, PROT_READ | PROT_WRITE,
+		           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		is_hugepage = (mem != MAP_FAILED);
+	}
+	if (mem == MAP_FAILED) {
+		mem = mmap(NULL, RLE_POOL_CHUNK_SIZE, PROT_READ | PROT_WRITE,
+		           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mem == MAP_FAILED) {
+			RLE_ERR("failed to map a chunk of %u bytes", RLE_POOL_CHUNK_SIZE);
+			return -1;
+		}
+		if (pool->conf.use_hugepages) {
+			/* no huge page reserved, transparent huge pages may still back the chunk */
+			madvise(mem, RLE_POOL_CHUNK_SIZE, MADV_HUGEPAGE);
+		}
+	}
+
+	/* bind before the first write, that allocates the pages */
+	if (pool->stats.numa_node >= 0 &&
+	    pool_bind(mem, RLE_POOL_CHUNK_SIZE, pool->stats.numa_node) != 0) {
+		RLE_WARN("failed to bind the pool to NUMA node %d (%s), memory is allocated on "
+		         "the node of the first access", pool->stats.numa_node, strerror(errno));
+		pool->stats.numa_node = -1;
+	}
+
+	chunk = (struct rle_pool_chunk *)mem;
+	chunk->next = pool->chunks;
+	pool->chunks = chunk;
+	pool->cur = (unsigned char *)mem + pool_align(sizeof(struct rle_pool_chunk));
+	pool->end = (unsigned char *)mem + RLE_POOL_CHUNK_SIZE;
+
+	pool->stats.chunks_nr++;
+	pool->stats.bytes_mapped += RLE_POOL_CHUNK_SIZE;
+	if (is_hugepage) {
+		pool->stats.hugepage_chunks_nr++;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  Get the buffers of one size of a pool, create them if needed.
+ *
+ * @param[in,out] pool  The memory pool.
+ * @param[in]     size  The size of the buffers, aligned on cache lines.
+ * @param[in]     add   Whether the size is added if unknown.
+ *
+ * Once the pool has RLE_POOL_CLASSES_NR sizes, the other sizes are given the buffers of the
+ * next power of 2. Sizes are never removed, so a size gets the same buffers when allocated
+ * and when given back.
+ *
+ * @return  The buffers of the size, NULL if unknown while the pool has room for it, or if
+ *          larger than a chunk.
+ */
+static struct rle_pool_class * pool_get_class(struct rle_pool *const pool, const size_t size,
+                                              const bool add)
+{
+	struct rle_pool_class *class = NULL;
+	size_t pow2_size = RLE_CACHE_LINE_SIZE;
+	size_t i;
+
+	for (i = 0; i < pool->classes_nr; i++) {
+		if (pool->classes[i].size == size) {
+			class = &pool->classes[i];
+			goto out;
+		}
+	}
+	if (pool->classes_nr < RLE_POOL_CLASSES_NR) {
+		if (add) {
+			class = &pool->classes[pool->classes_nr];
+			class->size = size;
+			class->free_bufs = NULL;
+			pool->classes_nr++;
+		}
+		goto out;
+	}
+
+	/* all the sizes are taken, fall back on the generic sizes */
+	for (i = 0; pow2_size < size; i++) {
+		pow2_size <<= 1;
+	}
+	if (i >= RLE_POOL_POW2_CLASSES_NR ||
+	    pow2_size > RLE_POOL_CHUNK_SIZE - pool_align(sizeof(struct rle_pool_chunk))) {
+		goto out;
+	}
+	class = &pool->pow2_classes[i];
+	class->size = pow2_size;
+
+out:
+	return class;
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+struct rle_pool * rle_pool_new(const struct rle_pool_config *const conf)
+{
+	struct rle_pool *pool = NULL;
+
+	if (conf == NULL) {
+		RLE_ERR("NULL given as pool configuration");
+		goto error;
+	}
+	if (conf->use_hugepages != 0 && conf->use_hugepages != 1) {
+		RLE_ERR("configuration parameter use_hugepages set to %d while 0 or 1 expected",
+		        conf->use_hugepages);
+		goto error;
+	}
+
+	pool = (struct rle_pool *)MALLOC(sizeof(struct rle_pool));
+	if (!pool) {
+		RLE_ERR("allocating pool failed");
+		goto error;
+	}
+	memset(pool, 0, sizeof(struct rle_pool));
+	memcpy(&pool->conf, conf, sizeof(struct rle_pool_config));
+	pool->stats.numa_node = conf->numa_node >= 0 ? conf->numa_node : pool_get_cur_node();
+
+	/* map the first chunk now, so the placement is known before any instance is created */
+	if (pool_map_chunk(pool) != 0) {
+		goto free_pool;
+	}
+
+	return pool;
+
+free_pool:
+	FREE(pool);
+error:
+	return NULL;
+}
+
+void rle_pool_destroy(struct rle_pool **const pool)
+{
+	struct rle_pool_chunk *chunk;
+
+	if (!pool || !*pool) {
+		/* Nothing to do. */
+		goto out;
+	}
+
+	if ((*pool)->stats.bytes_used != 0) {
+		RLE_WARN("pool destroyed while %" PRIu64 " bytes are still in use",
+		         (*pool)->stats.bytes_used);
+	}
+
+	chunk = (*pool)->chunks;
+	while (chunk != NULL) {
+		struct rle_pool_chunk *const next = chunk->next;
+
+		munmap(chunk, RLE_POOL_CHUNK_SIZE);
+		chunk = next;
+	}
+
+	FREE(*pool);
+	*pool = NULL;
+
+out:
+	return;
+}
+
+void rle_pool_get_stats(const struct rle_pool *const pool, struct rle_pool_stats *const stats)
+{
+	if (pool == NULL || stats == NULL) {
+		RLE_ERR("NULL given as pool or as statistics");
+		goto out;
+	}
+
+	memcpy(stats, &pool->stats, sizeof(struct rle_pool_stats));
+
+out:
+	return;
+}
+
+void * rle_pool_alloc(struct rle_pool *const pool, const size_t size)
+{
+	struct rle_pool_class *class;
+	void *buf = NULL;
+	const size_t aligned_size = pool_align(size);
+
+	if (pool == NULL) {
+		buf = pool_heap_alloc(size);
+		goto out;
+	}
+
+	if (aligned_size == 0 ||
+	    aligned_size > RLE_POOL_CHUNK_SIZE - pool_align(sizeof(struct rle_pool_chunk))) {
+		RLE_ERR("buffer of %zu bytes not allocable in a pool", size);
+		goto out;
+	}
+	class = pool_get_class(pool, aligned_size, true);
+	if (class == NULL) {
+		RLE_ERR("buffer of %zu bytes not allocable in a pool", size);
+		goto out;
+	}
+
+	if (class->free_bufs != NULL) {
+		buf = class->free_bufs;
+		class->free_bufs = class->free_bufs->next;
+	} else {
+		if ((size_t)(pool->end - pool->cur) < class->size && pool_map_chunk(pool) != 0) {
+			goto out;
+		}
+		buf = pool->cur;
+		pool->cur += class->size;
+	}
+	pool->stats.bytes_used += class->size;
+
+out:
+	return buf;
+}
+
+void rle_pool_free(struct rle_pool *const pool, void *const buf, const size_t size)
+{
+	struct rle_pool_class *class;
+	struct rle_pool_free_buf *const free_buf = (struct rle_pool_free_buf *)buf;
+
+	if (pool == NULL) {
+		pool_heap_free(buf);
+		goto out;
+	}
+
+	class = pool_get_class(pool, pool_align(size), false);
+	if (class == NULL) {
+		RLE_ERR("buffer of %zu bytes not allocated in the pool, not given back", size);
+		goto out;
+	}
+	free_buf->next = class->free_bufs;
+	class->free_bufs = free_buf;
+	pool->stats.bytes_used -= class->size;
+
+out:
+	return;
+}
+
+#else
+
+/* the kernel has its own NUMA-aware allocators, instances are allocated on the heap */
+
+struct rle_pool * rle_pool_new(const struct rle_pool_config *const conf)
+{
+	RLE_ERR("memory pools are not supported in the kernel");
+	return NULL;
+}
+
+void rle_pool_destroy(struct rle_pool **const pool)
+{
+	return;
+}
+
+void rle_pool_get_stats(const struct rle_pool *const pool, struct rle_pool_stats *const stats)
+{
+	memset(stats, 0, sizeof(struct rle_pool_stats));
+	stats->numa_node = -1;
+}
+
+void * rle_pool_alloc(struct rle_pool *const pool, const size_t size)
+{
+	return pool_heap_alloc(size);
+}
+
+void rle_pool_free(struct rle_pool *const pool, void *const buf, const size_t size)
+{
+	pool_heap_free(buf);
+}
+
+#endif
+
+void * rle_pool_buf_new(struct rle_pool *const pool, const size_t size)
+{
+	if (pool == NULL) {
+		RLE_ERR("NULL given as pool");
+		return NULL;
+	}
+
+	return rle_pool_alloc(pool, size);
+}
+
+void rle_pool_buf_del(struct rle_pool *const pool, void **const buf, const size_t size)
+{
+	if (pool == NULL || buf == NULL || *buf == NULL) {
+		/* Nothing to do. */
+		return;
+	}
+
+	rle_pool_free(pool, *buf, size);
+	*buf = NULL;
+}
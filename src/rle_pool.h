@@ -0,0 +1,76 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_pool.h
+ * @brief  RLE memory pool, placed on a NUMA node and backed by huge pages.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __RLE_POOL_H__
+#define __RLE_POOL_H__
+
+#include "rle.h"
+
+#ifndef __KERNEL__
+
+#include <stddef.h>
+
+#else
+
+#include <linux/stddef.h>
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief  Allocate a buffer in a memory pool, or on the heap if no pool is given.
+ *
+ *         The buffers are aligned on cache lines, and the ones of a pool are recycled by
+ *         size.
+ *
+ * @param[in,out] pool  The memory pool, NULL for the heap.
+ * @param[in]     size  The size of the buffer.
+ *
+ * @return  The buffer, NULL in case of error.
+ *
+ * @ingroup RLE pool
+ */
+void * rle_pool_alloc(struct rle_pool *const pool, const size_t size)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief  Give back a buffer to the memory pool it was allocated in, or to the heap.
+ *
+ * @param[in,out] pool  The memory pool, NULL for the heap.
+ * @param[in]     buf   The buffer.
+ * @param[in]     size  The size of the buffer, as allocated.
+ *
+ * @ingroup RLE pool
+ */
+void rle_pool_free(struct rle_pool *const pool, void *const buf, const size_t size);
+
+#endif /* __RLE_POOL_H__ */
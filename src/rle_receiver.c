@@ -33,6 +33,7 @@
 #include "constants.h"
 #include "header.h"
 #include "trailer.h"
+#include "rle_pool.h"
 
 #ifndef __KERNEL__
 
@@ -70,6 +71,17 @@ static int get_receiver_context(const struct rle_receiver *const receiver,
                                 const uint8_t fragment_id,
                                 const struct rle_ctx_mngt **const ctx_man);
 
+/**
+ * @brief          Create a receiver, with its contexts, in a memory pool.
+ *
+ * @param[in]      conf                     The configuration of the receiver.
+ * @param[in,out]  pool                     The memory pool, NULL for the heap.
+ *
+ * @return         The receiver if OK, else NULL.
+ */
+static struct rle_receiver * receiver_new(const struct rle_config *const conf,
+                                          struct rle_pool *const pool);
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
@@ -96,12 +108,8 @@ error:
 	return status;
 }
 
-
-/*------------------------------------------------------------------------------------------------*/
-/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
-/*------------------------------------------------------------------------------------------------*/
-
-struct rle_receiver * rle_receiver_new(const struct rle_config *const conf)
+static struct rle_receiver * receiver_new(const struct rle_config *const conf,
+                                          struct rle_pool *const pool)
 {
 	struct rle_receiver *receiver = NULL;
 	size_t i;
@@ -111,7 +119,7 @@ struct rle_receiver * rle_receiver_new(const struct rle_config *const conf)
 		goto error;
 	}
 
-	receiver = (struct rle_receiver *)MALLOC(sizeof(struct rle_receiver));
+	receiver = (struct rle_receiver *)rle_pool_alloc(pool, sizeof(struct rle_receiver));
 	if (!receiver) {
 		RLE_ERR("allocating receiver module failed");
 		goto error;
@@ -122,7 +130,7 @@ struct rle_receiver * rle_receiver_new(const struct rle_config *const conf)
 	memset(receiver->rle_ctx_man, 0, RLE_MAX_FRAG_NUMBER * sizeof(struct rle_ctx_mngt));
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; i++) {
 		struct rle_ctx_mngt *const ctx_man = &receiver->rle_ctx_man[i];
-		if (rle_ctx_init_rasm_buf(ctx_man) != C_OK) {
+		if (rle_ctx_init_rasm_buf(ctx_man, pool) != C_OK) {
 			RLE_ERR("failed to allocate memory for reassembly context with ID %zu", i);
 			goto free_ctxts;
 		}
@@ -132,6 +140,7 @@ struct rle_receiver * rle_receiver_new(const struct rle_config *const conf)
 	}
 
 	receiver->free_ctx = 0;
+	receiver->pool = pool;
 
 	return receiver;
 
@@ -139,16 +148,43 @@ free_ctxts:
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; i++) {
 		struct rle_ctx_mngt *const ctx_man = &receiver->rle_ctx_man[i];
 		if (ctx_man->buff != NULL) {
-			rle_ctx_destroy_rasm_buf(ctx_man);
+			rle_ctx_destroy_rasm_buf(ctx_man, pool);
 		}
 	}
-	FREE(receiver);
+	rle_pool_free(pool, receiver, sizeof(struct rle_receiver));
 error:
 	return NULL;
 }
 
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+struct rle_receiver * rle_receiver_new(const struct rle_config *const conf)
+{
+	return receiver_new(conf, NULL);
+}
+
+struct rle_receiver * rle_receiver_new_in_pool(const struct rle_config *const conf,
+                                               struct rle_pool *const pool)
+{
+	struct rle_receiver *receiver = NULL;
+
+	if (!pool) {
+		RLE_ERR("failed to created RLE receiver: no memory pool");
+		goto error;
+	}
+
+	receiver = receiver_new(conf, pool);
+
+error:
+	return receiver;
+}
+
 void rle_receiver_destroy(struct rle_receiver **const receiver)
 {
+	struct rle_pool *pool;
 	size_t i;
 
 	if (!receiver) {
@@ -161,12 +197,14 @@ void rle_receiver_destroy(struct rle_receiver **const receiver)
 		goto out;
 	}
 
+	pool = (*receiver)->pool;
+
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
 		struct rle_ctx_mngt *const ctx_man = &(*receiver)->rle_ctx_man[i];
-		rle_ctx_destroy_rasm_buf(ctx_man);
+		rle_ctx_destroy_rasm_buf(ctx_man, pool);
 	}
 
-	FREE(*receiver);
+	rle_pool_free(pool, *receiver, sizeof(struct rle_receiver));
 	*receiver = NULL;
 
 out:
@@ -205,7 +243,7 @@ int rle_receiver_deencap_data(struct rle_receiver *_this,
 
 	switch (frag_type) {
 	case RLE_PDU_COMPLETE:
-		ret = reassembly_comp_ppdu(_this, ppdu, ppdu_length, potential_sdu);
+		ret = reassembly_comp_ppdu(&_this->conf, ppdu, ppdu_length, potential_sdu);
 		break;
 	case RLE_PDU_START_FRAG:
 		ret = reassembly_start_ppdu(_this, ppdu, ppdu_length, index_ctx);
@@ -50,6 +50,7 @@
 /**
  * @brief RLE receiver module used for reassembly & deencapsulation.
  *        Provides a context structure for each fragment_id.
+ *        Aligned on cache lines, so the receivers of different threads do not share one.
  *
  * @ingroup RLE receiver
  */
@@ -60,7 +61,8 @@ struct rle_receiver {
 	bool is_ctx_seqnum_init[RLE_MAX_FRAG_NUMBER];
 	struct rle_config conf;  /**< RLE configuration */
 	uint8_t free_ctx;        /**< List of free contexts */
-};
+	struct rle_pool *pool;   /**< The memory pool of the receiver, NULL for the heap */
+} __attribute__((aligned(RLE_CACHE_LINE_SIZE)));
 
 
 /*------------------------------------------------------------------------------------------------*/
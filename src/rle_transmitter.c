@@ -33,6 +33,7 @@
 #include "encap.h"
 #include "fragmentation.h"
 #include "trailer.h"
+#include "rle_pool.h"
 
 #ifndef __KERNEL__
 
@@ -70,6 +71,17 @@ static int get_transmitter_context(const struct rle_transmitter *const transmitt
                                    const uint8_t fragment_id,
                                    const struct rle_ctx_mngt **const ctx_man);
 
+/**
+ * @brief          Create a transmitter, with its contexts, in a memory pool.
+ *
+ * @param[in]      conf                     The configuration of the transmitter.
+ * @param[in,out]  pool                     The memory pool, NULL for the heap.
+ *
+ * @return         The transmitter if OK, else NULL.
+ */
+static struct rle_transmitter * transmitter_new(const struct rle_config *const conf,
+                                                struct rle_pool *const pool);
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
@@ -101,13 +113,12 @@ static void set_free_frag_ctx(struct rle_transmitter *const _this, const size_t
 	rle_ctx_set_free(&_this->free_ctx, ctx_index);
 }
 
-
-/*------------------------------------------------------------------------------------------------*/
-/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
-/*------------------------------------------------------------------------------------------------*/
-
-struct rle_transmitter * rle_transmitter_new(const struct rle_config *const conf)
+static struct rle_transmitter * transmitter_new(const struct rle_config *const conf,
+                                                struct rle_pool *const pool)
 {
+	/* the contexts of a transmitter in a pool take the buffer of the size class of every SDU,
+	 * the other ones keep a buffer for the longest SDUs */
+	const size_t sdu_capacity = pool != NULL ? RLE_F_BUFF_SMALL_SDU_LEN : RLE_MAX_PDU_SIZE;
 	struct rle_transmitter *transmitter = NULL;
 	size_t i;
 
@@ -116,7 +127,7 @@ struct rle_transmitter * rle_transmitter_new(const struct rle_config *const conf
 		goto error;
 	}
 
-	transmitter = (struct rle_transmitter *)MALLOC(sizeof(struct rle_transmitter));
+	transmitter = (struct rle_transmitter *)rle_pool_alloc(pool, sizeof(struct rle_transmitter));
 	if (!transmitter) {
 		RLE_ERR("allocating transmitter module failed\n");
 		goto error;
@@ -126,7 +137,7 @@ struct rle_transmitter * rle_transmitter_new(const struct rle_config *const conf
 	memset(transmitter->rle_ctx_man, 0, RLE_MAX_FRAG_NUMBER * sizeof(struct rle_ctx_mngt));
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
 		struct rle_ctx_mngt *const ctx_man = &transmitter->rle_ctx_man[i];
-		if (rle_ctx_init_frag_buf(ctx_man) != C_OK) {
+		if (rle_ctx_init_frag_buf(ctx_man, pool, sdu_capacity) != C_OK) {
 			RLE_ERR("failed to allocate memory for frag context with ID %zu", i);
 			goto free_ctxts;
 		}
@@ -135,6 +146,8 @@ struct rle_transmitter * rle_transmitter_new(const struct rle_config *const conf
 	}
 
 	transmitter->free_ctx = 0;
+	transmitter->pool = pool;
+	transmitter->alpdu_cache = NULL;
 
 	memcpy(&transmitter->conf, conf, sizeof(struct rle_config));
 
@@ -144,16 +157,43 @@ free_ctxts:
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
 		struct rle_ctx_mngt *const ctx_man = &transmitter->rle_ctx_man[i];
 		if (ctx_man->buff != NULL) {
-			rle_ctx_destroy_frag_buf(ctx_man);
+			rle_ctx_destroy_frag_buf(ctx_man, pool);
 		}
 	}
-	FREE(transmitter);
+	rle_pool_free(pool, transmitter, sizeof(struct rle_transmitter));
 error:
 	return NULL;
 }
 
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+struct rle_transmitter * rle_transmitter_new(const struct rle_config *const conf)
+{
+	return transmitter_new(conf, NULL);
+}
+
+struct rle_transmitter * rle_transmitter_new_in_pool(const struct rle_config *const conf,
+                                                     struct rle_pool *const pool)
+{
+	struct rle_transmitter *transmitter = NULL;
+
+	if (!pool) {
+		RLE_ERR("failed to created RLE transmitter: no memory pool");
+		goto error;
+	}
+
+	transmitter = transmitter_new(conf, pool);
+
+error:
+	return transmitter;
+}
+
 void rle_transmitter_destroy(struct rle_transmitter **const transmitter)
 {
+	struct rle_pool *pool;
 	size_t i;
 
 	if (!transmitter) {
@@ -165,13 +205,17 @@ void rle_transmitter_destroy(struct rle_transmitter **const transmitter)
 		goto exit_label;
 	}
 
+	pool = (*transmitter)->pool;
+
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; i++) {
 		struct rle_ctx_mngt *const ctx_man = &(*transmitter)->rle_ctx_man[i];
 
-		rle_ctx_destroy_frag_buf(ctx_man);
+		rle_ctx_destroy_frag_buf(ctx_man, pool);
 	}
 
-	FREE(*transmitter);
+	alpdu_cache_del(pool, &(*transmitter)->alpdu_cache);
+
+	rle_pool_free(pool, *transmitter, sizeof(struct rle_transmitter));
 	*transmitter = NULL;
 
 exit_label:
@@ -179,6 +223,35 @@ exit_label:
 	return;
 }
 
+int rle_transmitter_enable_alpdu_cache(struct rle_transmitter *const transmitter)
+{
+	int status = 1;
+
+	if (!transmitter) {
+		goto out;
+	}
+
+	/* with sequence numbers, there is no CRC for the cache to save */
+	if (transmitter->conf.allow_alpdu_sequence_number != 0 ||
+	    transmitter->conf.allow_alpdu_crc != 1) {
+		RLE_ERR("the ALPDU cache needs a transmitter protecting the ALPDUs with a CRC");
+		goto out;
+	}
+
+	if (transmitter->alpdu_cache == NULL) {
+		transmitter->alpdu_cache = alpdu_cache_new(transmitter->pool);
+		if (transmitter->alpdu_cache == NULL) {
+			RLE_ERR("failed to allocate the ALPDU cache of the transmitter");
+			goto out;
+		}
+	}
+
+	status = 0;
+
+out:
+	return status;
+}
+
 void rle_transmitter_free_context(struct rle_transmitter *const _this, const uint8_t fragment_id)
 {
 	/* set to idle this fragmentation context */
@@ -310,6 +383,29 @@ error:
 	return stat;
 }
 
+uint64_t rle_transmitter_stats_get_alpdu_cache_hits(const struct rle_transmitter *const transmitter)
+{
+	uint64_t stat = 0;
+
+	if (transmitter != NULL && transmitter->alpdu_cache != NULL) {
+		stat = transmitter->alpdu_cache->counter_hits;
+	}
+
+	return stat;
+}
+
+uint64_t rle_transmitter_stats_get_alpdu_cache_misses(
+	const struct rle_transmitter *const transmitter)
+{
+	uint64_t stat = 0;
+
+	if (transmitter != NULL && transmitter->alpdu_cache != NULL) {
+		stat = transmitter->alpdu_cache->counter_misses;
+	}
+
+	return stat;
+}
+
 int rle_transmitter_stats_get_counters(const struct rle_transmitter *const transmitter,
                                        const uint8_t fragment_id,
                                        struct rle_transmitter_stats *const stats)
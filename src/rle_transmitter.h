@@ -41,6 +41,7 @@
 
 #include "rle_ctx.h"
 #include "header.h"
+#include "alpdu_cache.h"
 
 
 /*------------------------------------------------------------------------------------------------*/
@@ -71,13 +72,17 @@ struct transmitter_link_status {
  * structure.
  * A mutex is used for synchronize
  * access to free contexts.
+ * Aligned on cache lines, so the transmitters
+ * of different threads do not share one.
  *
  */
 struct rle_transmitter {
 	struct rle_ctx_mngt rle_ctx_man[RLE_MAX_FRAG_NUMBER];
 	struct rle_config conf;
 	uint8_t free_ctx;
-};
+	struct rle_pool *pool; /**< The memory pool of the transmitter, NULL for the heap */
+	struct alpdu_cache *alpdu_cache; /**< The cache of the short SDUs, NULL if disabled */
+} __attribute__((aligned(RLE_CACHE_LINE_SIZE)));
 
 
 /*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,163 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_aio.h
+ * @brief  Asynchronous batched output of FPDUs or SDUs to a file or a socket.
+ *
+ *         The records are packed in a few large buffers allocated once. A buffer is handed
+ *         to the kernel once full, and the next one is filled meanwhile, so the caller does
+ *         not make one system call per record. The buffers are written through io_uring,
+ *         registered with the kernel once so they are not mapped again for every write, or
+ *         through non-blocking sockets driven by epoll if io_uring is not available.
+ *
+ *         In a file or a stream socket, the records are written back to back. On a
+ *         datagram socket, every record is sent in its own datagram.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __TEST_AIO_H__
+#define __TEST_AIO_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** The ways to hand the buffers to the kernel */
+enum aio_backend {
+	AIO_BACKEND_AUTO,   /**< io_uring if available, epoll otherwise */
+	AIO_BACKEND_URING,  /**< io_uring with registered buffers */
+	AIO_BACKEND_EPOLL,  /**< write(2) and sendmmsg(2), epoll to wait for sockets */
+};
+
+/** The configuration of a writer */
+struct aio_conf {
+	enum aio_backend backend;  /**< The way to hand the buffers to the kernel */
+	size_t bufs_nr;            /**< The number of buffers */
+	size_t buf_size;           /**< The size of every buffer */
+	size_t records_max_nr;     /**< The maximal number of records in one buffer */
+};
+
+/** The statistics of a writer */
+struct aio_stats {
+	uint64_t records_nr;   /**< The number of records written */
+	uint64_t bytes_nr;     /**< The number of bytes written */
+	uint64_t bufs_nr;      /**< The number of buffers handed to the kernel */
+	uint64_t syscalls_nr;  /**< The number of system calls made to write them */
+	uint64_t waits_nr;     /**< The number of times the caller waited for a free buffer */
+	uint64_t lost_nr;      /**< The number of datagrams dropped by the local stack */
+};
+
+struct aio_writer;
+
+/**
+ * @brief  Initialize a writer configuration with the default values
+ *
+ * @param[out] conf  The configuration
+ */
+void aio_conf_init(struct aio_conf *const conf);
+
+/**
+ * @brief  Parse the name of a backend: auto, uring or epoll
+ *
+ * @param[in]  name     The name of the backend
+ * @param[out] backend  The backend
+ * @return              0 in case of success, -1 if the name is unknown
+ */
+int aio_parse_backend(const char *const name, enum aio_backend *const backend);
+
+/**
+ * @brief  Open a writer on a destination
+ *
+ * @param[in] dest  The destination: udp:HOST:PORT, tcp:HOST:PORT or the name of a file,
+ *                  created or truncated
+ * @param[in] conf  The configuration of the writer
+ * @return          The writer, NULL in case of error
+ */
+struct aio_writer * aio_writer_open(const char *const dest, const struct aio_conf *const conf);
+
+/**
+ * @brief  Write the pending records, wait for them, then close a writer
+ *
+ * @param[in,out] writer  The writer
+ * @return                0 in case of success, -1 if some records could not be written
+ */
+int aio_writer_close(struct aio_writer *const writer);
+
+/**
+ * @brief  Get room for one record in the current buffer of a writer, to build the record
+ *         in place
+ *
+ *         The current buffer is handed to the kernel first if the record does not fit in.
+ *         The caller may wait for a buffer to be free.
+ *
+ * @param[in,out] writer  The writer
+ * @param[in]     len     The maximal length of the record, at most the size of a buffer
+ * @return                The room for the record, NULL in case of error
+ */
+unsigned char * aio_writer_get_buf(struct aio_writer *const writer, const size_t len);
+
+/**
+ * @brief  Add the record built in the room given by aio_writer_get_buf()
+ *
+ * @param[in,out] writer  The writer
+ * @param[in]     len     The length of the record, at most the length of the room
+ */
+void aio_writer_put(struct aio_writer *const writer, const size_t len);
+
+/**
+ * @brief  Copy one record in the current buffer of a writer
+ *
+ * @param[in,out] writer  The writer
+ * @param[in]     data    The record
+ * @param[in]     len     The length of the record, at most the size of a buffer
+ * @return                0 in case of success, -1 otherwise
+ */
+int aio_writer_add(struct aio_writer *const writer, const unsigned char *const data,
+                   const size_t len);
+
+/**
+ * @brief  Hand the current buffer of a writer to the kernel, then wait for all the buffers
+ *         to be written
+ *
+ * @param[in,out] writer  The writer
+ * @return                0 in case of success, -1 otherwise
+ */
+int aio_writer_sync(struct aio_writer *const writer);
+
+/**
+ * @brief  Get the name of the backend used by a writer
+ *
+ * @param[in] writer  The writer
+ * @return            "uring" or "epoll"
+ */
+const char * aio_writer_get_backend_name(const struct aio_writer *const writer);
+
+/**
+ * @brief  Get the statistics of a writer
+ *
+ * @param[in]  writer  The writer
+ * @param[out] stats   The statistics
+ */
+void aio_writer_get_stats(const struct aio_writer *const writer, struct aio_stats *const stats);
+
+#endif /* __TEST_AIO_H__ */
@@ -0,0 +1,131 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_channel.h
+ * @brief  Lossy channel emulator between the RLE transmitter and receiver of the tests.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __TEST_CHANNEL_H__
+#define __TEST_CHANNEL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** The maximum number of FPDUs held back by the channel at the same time */
+#define CHANNEL_MAX_HELD 16U
+
+/** The impairments of the channel */
+struct channel_conf {
+	double loss_rate;          /**< The probability that an FPDU is lost */
+	double bit_error_rate;     /**< The probability that a bit of an FPDU is flipped */
+	double dup_rate;           /**< The probability that an FPDU is delivered twice */
+	double reorder_rate;       /**< The probability that an FPDU is delayed */
+	unsigned int reorder_depth;  /**< The number of FPDUs a delayed FPDU is delivered after */
+	uint32_t seed;             /**< The seed of the pseudo-random generator */
+};
+
+/** The statistics of the channel */
+struct channel_stats {
+	uint64_t fpdus_nr;          /**< The number of FPDUs sent on the channel */
+	uint64_t lost_nr;           /**< The number of FPDUs lost */
+	uint64_t corrupted_nr;      /**< The number of FPDUs with at least one bit error */
+	uint64_t bit_errors_nr;     /**< The number of bits flipped */
+	uint64_t duplicated_nr;     /**< The number of FPDUs delivered twice */
+	uint64_t reordered_nr;      /**< The number of FPDUs delayed */
+};
+
+/**
+ * @brief  The function that receives the FPDUs at the output of the channel
+ *
+ * @param[in,out] arg       The context of the function
+ * @param[in]     fpdu      The FPDU
+ * @param[in]     fpdu_len  The length of the FPDU
+ * @return                  0 in case of success, -1 to stop the channel
+ */
+typedef int (*channel_deliver_t)(void *const arg, const unsigned char *const fpdu,
+                                 const size_t fpdu_len);
+
+/** A FPDU held back by the channel */
+struct channel_slot {
+	unsigned char *fpdu;  /**< The FPDU */
+	size_t fpdu_len;      /**< The length of the FPDU, 0 if the slot is free */
+	unsigned int delay;   /**< The number of FPDUs to deliver before this one */
+};
+
+/** The channel emulator */
+struct channel {
+	struct channel_conf conf;      /**< The impairments */
+	struct channel_stats stats;    /**< The statistics */
+	uint64_t rand_state;           /**< The state of the pseudo-random generator */
+	size_t fpdu_max_len;           /**< The maximal length of the FPDUs */
+	unsigned char *fpdu;           /**< The FPDU being impaired */
+	struct channel_slot held[CHANNEL_MAX_HELD];  /**< The FPDUs held back */
+	channel_deliver_t deliver;     /**< The function that receives the FPDUs */
+	void *deliver_arg;             /**< The context of the function */
+};
+
+/**
+ * @brief  Create a channel
+ *
+ * @param[out] channel       The channel to initialize
+ * @param[in]  conf          The impairments of the channel
+ * @param[in]  fpdu_max_len  The maximal length of the FPDUs
+ * @param[in]  deliver       The function that receives the FPDUs
+ * @param[in]  deliver_arg   The context of the function
+ * @return                   0 in case of success, -1 otherwise
+ */
+int channel_init(struct channel *const channel, const struct channel_conf *const conf,
+                 const size_t fpdu_max_len, const channel_deliver_t deliver,
+                 void *const deliver_arg);
+
+/**
+ * @brief  Send one FPDU on the channel
+ *
+ *         The FPDU, and the held back FPDUs that are due, are given to the delivery function
+ *         before the function returns.
+ *
+ * @param[in,out] channel   The channel
+ * @param[in]     fpdu      The FPDU
+ * @param[in]     fpdu_len  The length of the FPDU
+ * @return                  0 in case of success, -1 if the delivery function failed
+ */
+int channel_send(struct channel *const channel, const unsigned char *const fpdu,
+                 const size_t fpdu_len);
+
+/**
+ * @brief  Deliver all the FPDUs still held back by the channel
+ *
+ * @param[in,out] channel  The channel
+ * @return                 0 in case of success, -1 if the delivery function failed
+ */
+int channel_flush(struct channel *const channel);
+
+/**
+ * @brief  Release a channel
+ *
+ * @param[in,out] channel  The channel
+ */
+void channel_free(struct channel *const channel);
+
+#endif /* __TEST_CHANNEL_H__ */
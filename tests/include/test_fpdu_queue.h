@@ -0,0 +1,140 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_fpdu_queue.h
+ * @brief  Queue of FPDUs between a building thread and a transmitting thread.
+ *
+ *         All the FPDU buffers are allocated once. The builder takes a free buffer, packs
+ *         PPDUs in it with rle_pack_init() and rle_pack(), then pushes it once padded with
+ *         rle_pad(). The transmitter pops the FPDUs in order, sends them, then gives their
+ *         buffers back. The FPDUs and the free buffers go through two lock-free
+ *         single-producer single-consumer rings of buffer descriptors, so neither thread
+ *         allocates memory nor takes a lock.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __TEST_FPDU_QUEUE_H__
+#define __TEST_FPDU_QUEUE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rle.h"
+
+/** The descriptor of an FPDU buffer */
+struct fpdu_buf {
+	unsigned char *data;    /**< The FPDU */
+	size_t size;            /**< The size of the FPDU, i.e. of the burst */
+	size_t cur_pos;         /**< The position in the FPDU while it is built */
+	size_t remain_size;     /**< The room left in the FPDU while it is built */
+	uint32_t id;            /**< The index of the buffer in the queue */
+};
+
+/** The statistics of a queue */
+struct fpdu_queue_stats {
+	uint64_t pushed_nr;        /**< The number of FPDUs pushed by the builder */
+	uint64_t no_buf_nr;        /**< The number of times the builder found no free buffer */
+	uint64_t popped_nr;        /**< The number of FPDUs popped by the transmitter */
+	uint64_t empty_nr;         /**< The number of times the transmitter found no FPDU */
+};
+
+struct fpdu_queue;
+
+/**
+ * @brief  Create a queue and all its FPDU buffers
+ *
+ * @param[in] bufs_nr   The number of FPDU buffers, a power of 2
+ * @param[in] buf_size  The maximal size of the FPDUs
+ * @return              The queue, NULL in case of error
+ */
+struct fpdu_queue * fpdu_queue_new(const size_t bufs_nr, const size_t buf_size);
+
+/**
+ * @brief  Destroy a queue and all its FPDU buffers
+ *
+ * @param[in,out] queue  The queue
+ */
+void fpdu_queue_destroy(struct fpdu_queue *const queue);
+
+/**
+ * @brief  Take a free buffer and start an FPDU in it, by the builder
+ *
+ * @param[in,out] queue       The queue
+ * @param[in]     size        The size of the FPDU, at most the size of the buffers
+ * @param[in]     label       The payload label of the FPDU, NULL if none
+ * @param[in]     label_size  The length of the payload label
+ * @return                    The buffer, NULL if none is free or the FPDU is invalid
+ */
+struct fpdu_buf * fpdu_queue_start(struct fpdu_queue *const queue, const size_t size,
+                                   const unsigned char *const label, const size_t label_size);
+
+/**
+ * @brief  Pack a PPDU in an FPDU being built
+ *
+ * @param[in,out] buf          The buffer
+ * @param[in]     ppdu         The PPDU
+ * @param[in]     ppdu_length  The length of the PPDU
+ * @return                     The status of rle_pack()
+ */
+enum rle_pack_status fpdu_buf_pack(struct fpdu_buf *const buf, const unsigned char *const ppdu,
+                                   const size_t ppdu_length);
+
+/**
+ * @brief  Pad an FPDU then push it to the transmitter, by the builder
+ *
+ *         The queue never overflows, since it holds at most all the buffers.
+ *
+ * @param[in,out] queue  The queue
+ * @param[in]     buf    The buffer returned by fpdu_queue_start()
+ */
+void fpdu_queue_push(struct fpdu_queue *const queue, struct fpdu_buf *const buf);
+
+/**
+ * @brief  Get the oldest FPDU pushed, by the transmitter
+ *
+ * @param[in,out] queue  The queue
+ * @return               The FPDU, NULL if none, to give back with fpdu_queue_recycle()
+ */
+const struct fpdu_buf * fpdu_queue_pop(struct fpdu_queue *const queue);
+
+/**
+ * @brief  Give back the buffer of a sent FPDU, by the transmitter
+ *
+ * @param[in,out] queue  The queue
+ * @param[in]     buf    The buffer returned by fpdu_queue_pop()
+ */
+void fpdu_queue_recycle(struct fpdu_queue *const queue, const struct fpdu_buf *const buf);
+
+/**
+ * @brief  Get the statistics of a queue
+ *
+ *         The statistics of each side are written by its thread only.
+ *
+ * @param[in]  queue  The queue
+ * @param[out] stats  The statistics
+ */
+void fpdu_queue_get_stats(const struct fpdu_queue *const queue,
+                          struct fpdu_queue_stats *const stats);
+
+#endif /* __TEST_FPDU_QUEUE_H__ */
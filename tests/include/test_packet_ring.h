@@ -0,0 +1,133 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_packet_ring.h
+ * @brief  Ingest of the Ethernet frames of a network port through an AF_PACKET ring.
+ *
+ *         The kernel writes the frames received on the port in the blocks of a TPACKET_V3
+ *         ring mapped in the memory of the process, and hands over a block once it is full
+ *         or its timeout expires. The frames are read in place from the ring, without any
+ *         system call per frame, and the blocks are given back to the kernel once read.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __TEST_PACKET_RING_H__
+#define __TEST_PACKET_RING_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** The configuration of a ring */
+struct packet_ring_conf {
+	size_t blocks_nr;          /**< The number of blocks of the ring */
+	size_t block_size;         /**< The size of the blocks, a multiple of the page size */
+	size_t frame_size;         /**< The maximal size of a frame and its ring header */
+	unsigned int timeout_ms;   /**< The delay before a block that is not full is handed over */
+	int promisc;               /**< Whether the port is put in promiscuous mode */
+};
+
+/** The statistics of a ring */
+struct packet_ring_stats {
+	uint64_t blocks_nr;        /**< The number of blocks read */
+	uint64_t frames_nr;        /**< The number of frames read */
+	uint64_t vlan_nr;          /**< The number of frames whose VLAN tag was re-inserted */
+	uint64_t truncated_nr;     /**< The number of frames larger than a ring frame, skipped */
+	uint64_t csum_partial_nr;  /**< The number of frames read before their L4 checksum was
+	                                computed by the kernel, i.e. sent with checksum offload */
+	uint64_t kernel_nr;        /**< The number of frames seen by the kernel */
+	uint64_t drops_nr;         /**< The number of frames dropped by the kernel, ring full */
+	uint64_t freezes_nr;       /**< The number of times the kernel found the ring full */
+};
+
+/**
+ * @brief  The function called for every frame read from a ring
+ *
+ * @param[in,out] arg    The argument given to packet_ring_read()
+ * @param[in]     frame  The Ethernet frame, in the ring or in the VLAN buffer of the ring
+ * @param[in]     len    The length of the frame
+ * @return               0 to go on, 1 to stop reading the ring
+ */
+typedef int (*packet_ring_frame_t)(void *const arg, const unsigned char *const frame,
+                                   const size_t len);
+
+struct packet_ring;
+
+/**
+ * @brief  Initialize a ring configuration with the default values
+ *
+ * @param[out] conf  The configuration
+ */
+void packet_ring_conf_init(struct packet_ring_conf *const conf);
+
+/**
+ * @brief  Open an AF_PACKET socket on a port, and map its TPACKET_V3 receive ring
+ *
+ *         The frames sent on the socket are not read back from the ring.
+ *
+ * @param[in] ifname  The name of the port
+ * @param[in] conf    The configuration of the ring
+ * @return            The ring, NULL in case of error
+ */
+struct packet_ring * packet_ring_open(const char *const ifname,
+                                      const struct packet_ring_conf *const conf);
+
+/**
+ * @brief  Unmap a ring and close its socket
+ *
+ * @param[in,out] ring  The ring
+ */
+void packet_ring_close(struct packet_ring *const ring);
+
+/**
+ * @brief  Get the socket of a ring, to poll it or to send frames on the port
+ *
+ * @param[in] ring  The ring
+ * @return          The file descriptor of the socket
+ */
+int packet_ring_get_fd(const struct packet_ring *const ring);
+
+/**
+ * @brief  Read the frames of all the blocks handed over by the kernel, then give the blocks
+ *         back to the kernel
+ *
+ *         The frames are given in place, except the ones whose VLAN tag was stripped by the
+ *         kernel: they are rebuilt with their tag in a buffer of the ring.
+ *
+ * @param[in,out] ring      The ring
+ * @param[in]     frame_cb  The function called for every frame
+ * @param[in,out] arg       The argument of the function
+ * @return                  The number of frames read, -1 if the function stopped the read
+ */
+int packet_ring_read(struct packet_ring *const ring, const packet_ring_frame_t frame_cb,
+                     void *const arg);
+
+/**
+ * @brief  Get the statistics of a ring, and of the kernel for its socket
+ *
+ * @param[in,out] ring   The ring
+ * @param[out]    stats  The statistics
+ */
+void packet_ring_get_stats(struct packet_ring *const ring, struct packet_ring_stats *const stats);
+
+#endif /* __TEST_PACKET_RING_H__ */
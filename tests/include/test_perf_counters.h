@@ -0,0 +1,103 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perf_counters.h
+ * @brief  Hardware performance counters shared by the performances tools.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __TEST_PERF_COUNTERS_H__
+#define __TEST_PERF_COUNTERS_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** The hardware counters measured around the benchmark loops */
+enum perf_counter_id {
+	PERF_COUNTER_CYCLES,        /**< CPU cycles */
+	PERF_COUNTER_INSTRUCTIONS,  /**< Retired instructions */
+	PERF_COUNTER_L1D_MISSES,    /**< L1 data cache read misses */
+	PERF_COUNTER_LLC_MISSES,    /**< Last level cache misses */
+	PERF_COUNTER_BRANCH_MISSES, /**< Mispredicted branches */
+	PERF_COUNTERS_NR            /**< The number of counters */
+};
+
+/** A set of hardware counters */
+struct perf_counters {
+	int fds[PERF_COUNTERS_NR];          /**< The counter file descriptors, -1 if unavailable */
+	uint64_t values[PERF_COUNTERS_NR];  /**< The values read at last stop */
+};
+
+/**
+ * @brief  Open the hardware counters for the calling thread
+ *
+ *         Every counter is opened on its own, so that the counters that the CPU or the kernel
+ *         (perf_event_paranoid, virtual machines...) do not provide are just unavailable.
+ *
+ * @param[out] counters  The counters to open
+ * @return               The number of available counters, 0 if none
+ */
+int perf_counters_open(struct perf_counters *const counters);
+
+/**
+ * @brief  Close the hardware counters
+ *
+ * @param[in,out] counters  The counters to close
+ */
+void perf_counters_close(struct perf_counters *const counters);
+
+/**
+ * @brief  Reset then start the available hardware counters
+ *
+ * @param[in,out] counters  The counters to start
+ */
+void perf_counters_start(struct perf_counters *const counters);
+
+/**
+ * @brief  Stop the available hardware counters and read their values
+ *
+ *         Values are scaled if the kernel multiplexed the counters.
+ *
+ * @param[in,out] counters  The counters to stop
+ */
+void perf_counters_stop(struct perf_counters *const counters);
+
+/**
+ * @brief  Whether a hardware counter is available or not
+ *
+ * @param[in] counters  The counters
+ * @param[in] id        The counter
+ * @return              true if the counter is available, false otherwise
+ */
+bool perf_counters_is_available(const struct perf_counters *const counters,
+                                const enum perf_counter_id id);
+
+/**
+ * @brief  Get the short name of a hardware counter
+ *
+ * @param[in] id  The counter
+ * @return        The name of the counter
+ */
+const char * perf_counters_get_name(const enum perf_counter_id id);
+
+#endif /* __TEST_PERF_COUNTERS_H__ */
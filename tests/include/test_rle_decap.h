@@ -147,6 +147,16 @@ bool test_decap_wrong_crc(void);
  */
 bool test_decap_interlaced_reassembly(void);
 
+/**
+ * @brief Test the decapsulation of COMPLETE PPDUs without receiver
+ *
+ *        The SDUs packed in COMPLETE PPDUs shall be decapsulated from the configuration only,
+ *        and a FPDU with a START PPDU shall be left to the receiver.
+ *
+ * @return        true if OK, else false
+ */
+bool test_decap_complete(void);
+
 /**
  * @brief         All the Decapsulation tests
  *
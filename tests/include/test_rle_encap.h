@@ -74,4 +74,15 @@ bool test_encap_inv_config(void);
  */
 bool test_encap_all(void);
 
+/**
+ * @brief         ALPDU cache test
+ *
+ *                Send short SDUs again and again, and a longer one, with and without the ALPDU
+ *                cache, in CRC mode and with the protocol type of the VLAN header omitted. The
+ *                PPDUs shall be the same, and the hits and misses of the cache counted.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_encap_alpdu_cache(void);
+
 #endif /* __TEST_RLE_ENCAP_H__ */
@@ -72,5 +72,18 @@ bool test_encap_ctxtless_f_buff_not_init(void);
  */
 bool test_encap_ctxtless_too_big(void);
 
+/**
+ * @brief         Stateless encapsulation test of COMPLETE PPDUs straight in the FPDU.
+ *
+ *                This test packs SDUs of several protocol types with several configurations, and
+ *                compares the FPDUs with the ones built by the contextless encapsulation, the
+ *                contextless fragmentation and the packing. It then checks that a SDU is refused
+ *                with RLE_PACK_ERR_FPDU_TOO_SMALL, the FPDU untouched, when the FPDU is too small
+ *                or when the SDU needs fragmentation.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_encap_pack_complete(void);
+
 
 #endif /* __TEST_RLE_ENCAP_CTXTLESS_H__ */
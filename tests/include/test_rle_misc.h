@@ -102,6 +102,26 @@ bool test_rle_allocation_f_buff(void);
  */
 bool test_rle_destruction_f_buff(void);
 
+/**
+ * @brief         Test the fragmentation buffer allocation in size classes
+ *
+ *                The SDUs longer than the size class of a fragmentation buffer shall not be
+ *                copied in it.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_allocation_f_buff_sized(void);
+
+/**
+ * @brief         Test the allocation of a transmitter and a receiver in a memory pool
+ *
+ *                Also checks that all the memory is given back to the pool once they are
+ *                destroyed.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_allocation_pool(void);
+
 /* Further tests can be done here, especially to check fragmentation and reassembly buffers. */
 
 
@@ -0,0 +1,138 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_rx_pool.h
+ * @brief  Pool of hub receivers sharded on worker threads.
+ *
+ *         The library receivers are not thread-safe, so every terminal (identified by the
+ *         payload label of its FPDUs) is given to one worker thread, that owns the receivers
+ *         of its terminals. One dispatcher thread pushes the FPDUs into the single-producer
+ *         single-consumer ring of the worker of their terminal, one collector thread pops
+ *         the reassembled SDUs from the output ring of every worker. The rings are lock-free.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __TEST_RX_POOL_H__
+#define __TEST_RX_POOL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rle.h"
+
+/** The maximal length of the payload label of the FPDUs */
+#define RX_POOL_MAX_LABEL_LEN 6U
+
+/** The maximal length of the FPDUs given to the pool */
+#define RX_POOL_MAX_FPDU_LEN 2048U
+
+/** The configuration of a receivers pool */
+struct rx_pool_conf {
+	struct rle_config rle_conf;  /**< The configuration of the receivers */
+	size_t workers_nr;           /**< The number of worker threads */
+	size_t payload_label_size;   /**< The payload label length of the FPDUs: 3 or 6 */
+	size_t ring_len;             /**< The number of slots of every ring, a power of 2 */
+	size_t terminals_max_nr;     /**< The maximal number of terminals per worker */
+	const int *cpus;             /**< The CPU of every worker, NULL to not pin them */
+};
+
+/** A reassembled SDU in the output ring of a worker */
+struct rx_pool_sdu {
+	unsigned char label[RX_POOL_MAX_LABEL_LEN];  /**< The payload label of the terminal */
+	struct rle_sdu sdu;                          /**< The SDU, its buffer is in the ring */
+};
+
+/** The statistics of a worker */
+struct rx_pool_stats {
+	uint64_t fpdus_nr;        /**< The number of FPDUs decapsulated */
+	uint64_t sdus_nr;         /**< The number of SDUs reassembled */
+	uint64_t errors_nr;       /**< The number of FPDUs that failed to decapsulate */
+	uint64_t terminals_nr;    /**< The number of terminals of the worker */
+};
+
+struct rx_pool;
+
+/**
+ * @brief  Create a receivers pool and start its workers
+ *
+ * @param[in] conf  The configuration of the pool
+ * @return          The pool, NULL in case of error
+ */
+struct rx_pool * rx_pool_new(const struct rx_pool_conf *const conf);
+
+/**
+ * @brief  Push an FPDU to the worker of its terminal
+ *
+ *         Only one thread may push FPDUs. The FPDU is copied in the ring.
+ *
+ * @param[in,out] pool      The pool
+ * @param[in]     fpdu      The FPDU, beginning with its payload label
+ * @param[in]     fpdu_len  The length of the FPDU
+ * @return                  0 in case of success, 1 if the ring of the worker is full,
+ *                          -1 if the FPDU is invalid
+ */
+int rx_pool_push(struct rx_pool *const pool, const unsigned char *const fpdu,
+                 const size_t fpdu_len);
+
+/**
+ * @brief  Get the oldest SDU reassembled by a worker, without removing it
+ *
+ *         Only one thread may get the SDUs of all the workers.
+ *
+ * @param[in,out] pool       The pool
+ * @param[in]     worker_id  The worker
+ * @return                   The SDU, NULL if none, valid until rx_pool_release()
+ */
+const struct rx_pool_sdu * rx_pool_peek(struct rx_pool *const pool, const size_t worker_id);
+
+/**
+ * @brief  Remove the oldest SDU reassembled by a worker
+ *
+ * @param[in,out] pool       The pool
+ * @param[in]     worker_id  The worker, with an SDU returned by rx_pool_peek()
+ */
+void rx_pool_release(struct rx_pool *const pool, const size_t worker_id);
+
+/**
+ * @brief  Get the statistics of a worker
+ *
+ *         The statistics are updated by the worker while it runs.
+ *
+ * @param[in]  pool       The pool
+ * @param[in]  worker_id  The worker
+ * @param[out] stats      The statistics
+ */
+void rx_pool_get_stats(const struct rx_pool *const pool, const size_t worker_id,
+                       struct rx_pool_stats *const stats);
+
+/**
+ * @brief  Stop the workers, once they handled all the FPDUs pushed, then destroy the pool
+ *
+ *         The SDUs not collected are lost.
+ *
+ * @param[in,out] pool  The pool
+ */
+void rx_pool_destroy(struct rx_pool *const pool);
+
+#endif /* __TEST_RX_POOL_H__ */
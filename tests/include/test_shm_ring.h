@@ -0,0 +1,180 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_shm_ring.h
+ * @brief  Shared memory ring of SDUs between producer processes and an RLE transmitter.
+ *
+ *         The shared memory (memfd_create(2) or shm_open(3)) holds several lanes, one per
+ *         producer process. Every lane is a single-producer single-consumer ring of SDU
+ *         descriptors plus a payload arena: the producer writes the SDU directly in the
+ *         arena, then commits its descriptor; the transmitter gives the SDU in the arena to
+ *         rle_encapsulate() then releases it. The SDUs are not copied out of the shared
+ *         memory before the encapsulation.
+ *
+ *         Nothing but offsets is stored in the shared memory, so it may be mapped at any
+ *         address by every process.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __TEST_SHM_RING_H__
+#define __TEST_SHM_RING_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rle.h"
+
+/** The configuration of a shared memory ring */
+struct shm_ring_conf {
+	size_t lanes_nr;      /**< The number of lanes, i.e. of producers */
+	size_t descs_nr;      /**< The number of descriptors per lane, a power of 2 */
+	size_t arena_len;     /**< The length of the payload arena per lane */
+};
+
+/** The occupancy statistics of one lane */
+struct shm_ring_stats {
+	uint64_t sdus_nr;          /**< The number of SDUs released by the consumer */
+	uint64_t bytes_nr;         /**< The number of SDU bytes released by the consumer */
+	uint64_t full_nr;          /**< The number of reservations refused, ring full */
+	uint64_t descs_used;       /**< The number of descriptors in use */
+	uint64_t descs_max_used;   /**< The highest number of descriptors seen in use */
+	uint64_t arena_used;       /**< The number of arena bytes in use */
+	uint64_t arena_max_used;   /**< The highest number of arena bytes seen in use */
+	uint64_t peeks_nr;         /**< The number of SDUs peeked, to average the occupancy */
+	uint64_t descs_used_sum;   /**< The sum of the descriptors in use seen at every peek */
+};
+
+/** A shared memory ring mapped in one process */
+struct shm_ring {
+	unsigned char *map;   /**< The mapped shared memory */
+	size_t map_len;       /**< The length of the shared memory */
+	int fd;               /**< The file descriptor of the shared memory */
+};
+
+/**
+ * @brief  Create a shared memory ring
+ *
+ * @param[out] ring  The ring, mapped in the calling process
+ * @param[in]  name  The POSIX shared memory name (shm_open(3)), NULL for an anonymous
+ *                   memfd_create(2) memory, inherited by the children processes
+ * @param[in]  conf  The configuration
+ * @return           0 in case of success, -1 otherwise
+ */
+int shm_ring_create(struct shm_ring *const ring, const char *const name,
+                    const struct shm_ring_conf *const conf);
+
+/**
+ * @brief  Map a shared memory ring created by another process
+ *
+ * @param[out] ring  The ring, mapped in the calling process
+ * @param[in]  name  The POSIX shared memory name
+ * @return           0 in case of success, -1 otherwise
+ */
+int shm_ring_attach(struct shm_ring *const ring, const char *const name);
+
+/**
+ * @brief  Unmap a shared memory ring, and remove its name if given
+ *
+ * @param[in,out] ring  The ring
+ * @param[in]     name  The POSIX shared memory name to remove, NULL to keep it
+ */
+void shm_ring_close(struct shm_ring *const ring, const char *const name);
+
+/**
+ * @brief  Get the number of lanes of a ring
+ *
+ * @param[in] ring  The ring
+ * @return          The number of lanes
+ */
+size_t shm_ring_lanes_nr(const struct shm_ring *const ring);
+
+/**
+ * @brief  Take a free lane, for a producer process
+ *
+ * @param[in,out] ring  The ring
+ * @return              The lane, -1 if none is free
+ */
+int shm_ring_lane_acquire(struct shm_ring *const ring);
+
+/**
+ * @brief  Close a lane once its producer has committed its last SDU
+ *
+ * @param[in,out] ring  The ring
+ * @param[in]     lane  The lane of the producer
+ */
+void shm_ring_lane_close(struct shm_ring *const ring, const int lane);
+
+/**
+ * @brief  Reserve room for an SDU in the arena of a lane
+ *
+ * @param[in,out] ring  The ring
+ * @param[in]     lane  The lane of the producer
+ * @param[in]     len   The length of the SDU, at most RLE_MAX_PDU_SIZE
+ * @return              Where to write the SDU, NULL if the lane is full or the SDU too long
+ */
+unsigned char * shm_ring_reserve(struct shm_ring *const ring, const int lane, const size_t len);
+
+/**
+ * @brief  Commit the SDU written in the room reserved last, for the consumer
+ *
+ * @param[in,out] ring           The ring
+ * @param[in]     lane           The lane of the producer
+ * @param[in]     protocol_type  The uncompressed protocol type of the SDU
+ * @param[in]     frag_id        The frag_id to encapsulate the SDU with
+ */
+void shm_ring_commit(struct shm_ring *const ring, const int lane,
+                     const uint16_t protocol_type, const uint8_t frag_id);
+
+/**
+ * @brief  Get the oldest SDU of a lane, without removing it
+ *
+ * @param[in,out] ring     The ring
+ * @param[in]     lane     The lane
+ * @param[out]    sdu      The SDU, its buffer points in the shared memory
+ * @param[out]    frag_id  The frag_id of the SDU
+ * @return                 1 if an SDU is returned, 0 if the lane is empty,
+ *                         -1 if the lane is empty and closed
+ */
+int shm_ring_peek(struct shm_ring *const ring, const int lane, struct rle_sdu *const sdu,
+                  uint8_t *const frag_id);
+
+/**
+ * @brief  Give back the room of the oldest SDU of a lane to its producer
+ *
+ * @param[in,out] ring  The ring
+ * @param[in]     lane  The lane, with an SDU returned by shm_ring_peek()
+ */
+void shm_ring_release(struct shm_ring *const ring, const int lane);
+
+/**
+ * @brief  Get the occupancy statistics of a lane, in the consumer process
+ *
+ * @param[in]  ring   The ring
+ * @param[in]  lane   The lane
+ * @param[out] stats  The statistics
+ */
+void shm_ring_get_stats(const struct shm_ring *const ring, const int lane,
+                        struct shm_ring_stats *const stats);
+
+#endif /* __TEST_SHM_RING_H__ */
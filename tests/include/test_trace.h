@@ -0,0 +1,161 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_trace.h
+ * @brief  Indexed trace files of SDUs and FPDUs, read through mmap(2).
+ *
+ *         A trace file is a header, the records packed one after the other, then an index
+ *         with the offset of every record. Every record is a fixed header (timestamp, length,
+ *         protocol type, flags, frag_id and payload label length), the payload label then
+ *         the content, padded to 8 bytes. All the integers are in network byte order.
+ *
+ *         The reader maps the whole file, so the records are accessed in any order without
+ *         any copy nor read(2) call.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __TEST_TRACE_H__
+#define __TEST_TRACE_H__
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "test_traffic_gen.h"
+
+/** The record holds an FPDU, otherwise an SDU */
+#define TRACE_RECORD_FPDU 0x01U
+
+/** The maximal length of the payload label of a record */
+#define TRACE_MAX_LABEL_LEN 15U
+
+/** One record of a trace */
+struct trace_record {
+	uint64_t timestamp_ns;         /**< The timestamp of the record in nanoseconds */
+	const unsigned char *data;     /**< The content of the record */
+	size_t size;                   /**< The length of the content */
+	const unsigned char *label;    /**< The payload label of the FPDU, NULL if none */
+	size_t label_size;             /**< The length of the payload label */
+	uint16_t protocol_type;        /**< The uncompressed protocol type of the SDU */
+	uint8_t frag_id;               /**< The frag_id of the SDU */
+	uint8_t flags;                 /**< The flags of the record, see TRACE_RECORD_* */
+};
+
+/** A trace being written */
+struct trace_writer {
+	FILE *file;            /**< The trace file */
+	uint64_t *offsets;     /**< The offsets of the records written */
+	size_t records_nr;     /**< The number of records written */
+	size_t offsets_max_nr; /**< The number of offsets that may be stored */
+	uint64_t offset;       /**< The offset of the next record */
+};
+
+/** A trace mapped in memory */
+struct trace {
+	unsigned char *map;          /**< The whole trace file */
+	size_t map_len;              /**< The length of the trace file */
+	size_t records_nr;           /**< The number of records */
+	const unsigned char *index;  /**< The offsets of the records */
+};
+
+/**
+ * @brief  Create a trace file
+ *
+ * @param[out] writer    The trace writer
+ * @param[in]  filename  The name of the trace file
+ * @return               0 in case of success, -1 otherwise
+ */
+int trace_writer_open(struct trace_writer *const writer, const char *const filename);
+
+/**
+ * @brief  Append a record to a trace file
+ *
+ * @param[in,out] writer  The trace writer
+ * @param[in]     record  The record
+ * @return                0 in case of success, -1 otherwise
+ */
+int trace_writer_add(struct trace_writer *const writer, const struct trace_record *const record);
+
+/**
+ * @brief  Write the index of a trace file then close it
+ *
+ * @param[in,out] writer  The trace writer
+ * @return                0 in case of success, -1 otherwise
+ */
+int trace_writer_close(struct trace_writer *const writer);
+
+/**
+ * @brief  Write traffic in a trace file, one SDU record per SDU
+ *
+ *         The burst sizes schedule of the traffic is not written.
+ *
+ * @param[in] traffic   The traffic to write
+ * @param[in] filename  The name of the trace file
+ * @return              0 in case of success, -1 otherwise
+ */
+int trace_write_traffic(const struct traffic *const traffic, const char *const filename);
+
+/**
+ * @brief  Map a trace file in memory
+ *
+ *         All the records are checked once, so trace_get() does not fail afterwards.
+ *
+ * @param[in]  filename  The name of the trace file
+ * @param[out] trace     The mapped trace, to be released with trace_close()
+ * @return               0 in case of success, -1 in case of error,
+ *                       1 if the file is not a trace file
+ */
+int trace_open(const char *const filename, struct trace *const trace);
+
+/**
+ * @brief  Get one record of a mapped trace
+ *
+ * @param[in]  trace      The mapped trace
+ * @param[in]  record_id  The record, lower than trace->records_nr
+ * @param[out] record     The record, its content points in the mapped trace
+ */
+void trace_get(const struct trace *const trace, const size_t record_id,
+               struct trace_record *const record);
+
+/**
+ * @brief  Get the SDU records of a mapped trace as traffic
+ *
+ *         The SDUs point in the mapped trace, that shall not be closed before the traffic
+ *         is released with traffic_free(), so traffic->data is NULL while
+ *         traffic->data_len is the total length of the SDUs. The FPDU records are ignored.
+ *
+ * @param[in]  trace    The mapped trace
+ * @param[out] traffic  The traffic
+ * @return              0 in case of success, -1 otherwise
+ */
+int trace_to_traffic(const struct trace *const trace, struct traffic *const traffic);
+
+/**
+ * @brief  Unmap a trace
+ *
+ * @param[in,out] trace  The mapped trace
+ */
+void trace_close(struct trace *const trace);
+
+#endif /* __TEST_TRACE_H__ */
@@ -0,0 +1,177 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_traffic_gen.h
+ * @brief  Synthetic traffic generator shared by the benchmarks and stress tests.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __TEST_TRAFFIC_GEN_H__
+#define __TEST_TRAFFIC_GEN_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** The maximum number of bins of a size distribution */
+#define TRAFFIC_MAX_SIZE_BINS 16
+
+/** The kinds of SDUs that may be generated */
+enum traffic_ptype {
+	TRAFFIC_PTYPE_IPV4,    /**< IPv4 packets */
+	TRAFFIC_PTYPE_IPV6,    /**< IPv6 packets */
+	TRAFFIC_PTYPE_VLAN,    /**< Ethernet/VLAN frames carrying IPv4 */
+	TRAFFIC_PTYPE_ARP,     /**< ARP requests (fixed size) */
+	TRAFFIC_PTYPE_SIGNAL,  /**< Signalling SDUs */
+	TRAFFIC_PTYPES_NR      /**< The number of kinds of SDUs */
+};
+
+/** One bin of a size distribution: sizes drawn uniformly in [min ; max] */
+struct traffic_size_bin {
+	size_t min;           /**< The minimal size of the bin */
+	size_t max;           /**< The maximal size of the bin */
+	unsigned int weight;  /**< The relative weight of the bin */
+};
+
+/** The configuration of the traffic generator */
+struct traffic_gen_conf {
+	struct traffic_size_bin sizes[TRAFFIC_MAX_SIZE_BINS];  /**< The size distribution */
+	size_t sizes_nr;                                /**< The number of bins */
+	unsigned int ptype_weights[TRAFFIC_PTYPES_NR];  /**< The relative weights of the ptypes */
+	uint8_t flows_nr;         /**< The number of flows, one per frag_id (1 to 8) */
+	size_t burst_min;         /**< The minimal burst size of the schedule */
+	size_t burst_max;         /**< The maximal burst size of the schedule */
+	uint32_t seed;            /**< The seed of the pseudo-random generator */
+};
+
+/** One generated SDU */
+struct traffic_sdu {
+	unsigned char *data;     /**< The SDU content */
+	uint16_t size;           /**< The SDU size */
+	uint16_t protocol_type;  /**< The uncompressed protocol type */
+	uint8_t frag_id;         /**< The flow (frag_id) of the SDU */
+};
+
+/** A generated traffic, with all the SDUs contiguous in memory */
+struct traffic {
+	struct traffic_sdu *sdus;  /**< The SDUs */
+	size_t sdus_nr;            /**< The number of SDUs */
+	unsigned char *data;       /**< The memory that holds the content of all the SDUs */
+	size_t data_len;           /**< The length of the memory */
+	uint16_t *bursts;          /**< The burst sizes schedule */
+	size_t bursts_nr;          /**< The number of burst sizes in the schedule */
+};
+
+/**
+ * @brief  Get the initial state of the pseudo-random generator for a seed
+ *
+ * @param[in] seed  The seed
+ * @return          The initial state, never 0
+ */
+uint64_t traffic_rand_init(const uint32_t seed);
+
+/**
+ * @brief  Get the next number of the pseudo-random generator (xorshift64*)
+ *
+ *         The generator does not depend on the libc, so that a seed gives the same sequence
+ *         on every system.
+ *
+ * @param[in,out] state  The state of the generator
+ * @return               The next pseudo-random number
+ */
+uint32_t traffic_rand(uint64_t *const state);
+
+/**
+ * @brief  Initialize a generator configuration with the defaults
+ *
+ *         The defaults are IPv4 only IMIX traffic (7:4:1 of 40, 576 and 1500 bytes) on one
+ *         flow, with burst sizes between 14 and 599 bytes.
+ *
+ * @param[out] conf  The configuration to initialize
+ */
+void traffic_gen_conf_init(struct traffic_gen_conf *const conf);
+
+/**
+ * @brief  Parse a size distribution
+ *
+ *         The distribution is either "imix", or a comma-separated list of SIZE[-MAX][:WEIGHT]
+ *         bins, e.g. "40:7,576:4,1500:1" or "64-1500".
+ *
+ * @param[in]  spec  The distribution
+ * @param[out] conf  The configuration to update
+ * @return           0 in case of success, -1 if the distribution is malformed
+ */
+int traffic_gen_parse_sizes(const char *const spec, struct traffic_gen_conf *const conf);
+
+/**
+ * @brief  Parse a protocol types mix
+ *
+ *         The mix is a comma-separated list of NAME[:WEIGHT], with NAME among ipv4, ipv6,
+ *         vlan, arp and signal, e.g. "ipv4:8,ipv6:2,signal:1".
+ *
+ * @param[in]  spec  The mix
+ * @param[out] conf  The configuration to update
+ * @return           0 in case of success, -1 if the mix is malformed
+ */
+int traffic_gen_parse_ptypes(const char *const spec, struct traffic_gen_conf *const conf);
+
+/**
+ * @brief  Generate traffic in memory
+ *
+ *         The same configuration (seed included) always generates the same traffic.
+ *
+ * @param[in]  conf       The configuration of the generator
+ * @param[in]  sdus_nr    The number of SDUs to generate
+ * @param[in]  bursts_nr  The number of burst sizes to generate in the schedule
+ * @param[out] traffic    The generated traffic, to be released with traffic_free()
+ * @return                0 in case of success, -1 otherwise
+ */
+int traffic_gen(const struct traffic_gen_conf *const conf, const size_t sdus_nr,
+                const size_t bursts_nr, struct traffic *const traffic);
+
+/**
+ * @brief  Write traffic in a compact trace file
+ *
+ * @param[in] traffic   The traffic to write
+ * @param[in] filename  The name of the trace file
+ * @return              0 in case of success, -1 otherwise
+ */
+int traffic_write(const struct traffic *const traffic, const char *const filename);
+
+/**
+ * @brief  Read traffic from a compact trace file
+ *
+ * @param[in]  filename  The name of the trace file
+ * @param[out] traffic   The read traffic, to be released with traffic_free()
+ * @return               0 in case of success, -1 in case of error,
+ *                       1 if the file is not a trace file
+ */
+int traffic_read(const char *const filename, struct traffic *const traffic);
+
+/**
+ * @brief  Release traffic generated or read
+ *
+ * @param[in,out] traffic  The traffic to release
+ */
+void traffic_free(struct traffic *const traffic);
+
+#endif /* __TEST_TRAFFIC_GEN_H__ */
@@ -0,0 +1,103 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_tx_pool.h
+ * @brief  Work-stealing pool of threads to build the bursts of many transmitters.
+ *
+ *         A run is a batch of independent tasks, typically one per transmitter with all
+ *         its bursts of a superframe, so that a transmitter is used by one thread only
+ *         during the run. The tasks are split in contiguous ranges between the workers,
+ *         a worker that runs out of tasks steals the oldest ones of the others. The calling
+ *         thread is the first worker, and the run returns once all the tasks are done, so
+ *         the results may then be read in any order.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#ifndef __TEST_TX_POOL_H__
+#define __TEST_TX_POOL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief  A task of a run
+ *
+ * @param[in,out] arg        The argument given to tx_pool_run()
+ * @param[in]     task_id    The task, lower than the number of tasks of the run
+ * @param[in]     worker_id  The worker that runs the task
+ * @return                   0 in case of success, the run is aborted otherwise
+ */
+typedef int (*tx_pool_task_t)(void *const arg, const size_t task_id, const size_t worker_id);
+
+/** The statistics of a worker */
+struct tx_pool_stats {
+	uint64_t runs_nr;      /**< The number of runs */
+	uint64_t tasks_nr;     /**< The number of tasks done */
+	uint64_t steals_nr;    /**< The number of tasks stolen from other workers */
+};
+
+struct tx_pool;
+
+/**
+ * @brief  Create a pool and start its workers
+ *
+ * @param[in] workers_nr  The number of workers, including the calling thread
+ * @param[in] cpus        The CPU of every worker, NULL to not pin them. The calling
+ *                        thread is pinned on the first one.
+ * @return                The pool, NULL in case of error
+ */
+struct tx_pool * tx_pool_new(const size_t workers_nr, const int *const cpus);
+
+/**
+ * @brief  Run a batch of tasks on all the workers, and wait for them
+ *
+ *         Only the thread that created the pool may run tasks.
+ *
+ * @param[in,out] pool      The pool
+ * @param[in]     tasks_nr  The number of tasks
+ * @param[in]     task      The function that runs one task
+ * @param[in,out] arg       The argument of the function
+ * @return                  0 in case of success, -1 if a task failed
+ */
+int tx_pool_run(struct tx_pool *const pool, const size_t tasks_nr, const tx_pool_task_t task,
+                void *const arg);
+
+/**
+ * @brief  Get the statistics of a worker, between two runs
+ *
+ * @param[in]  pool       The pool
+ * @param[in]  worker_id  The worker
+ * @param[out] stats      The statistics
+ */
+void tx_pool_get_stats(const struct tx_pool *const pool, const size_t worker_id,
+                       struct tx_pool_stats *const stats);
+
+/**
+ * @brief  Stop the workers then destroy the pool
+ *
+ * @param[in,out] pool  The pool
+ */
+void tx_pool_destroy(struct tx_pool *const pool);
+
+#endif /* __TEST_TX_POOL_H__ */
@@ -0,0 +1,63 @@
+#!/usr/bin/env python
+#-*- coding: utf-8 -*-
+
+"""
+------------------------------------------------------------------------------
+About
+==============================================================================
+COMPARE BENCH
+
+Compare two JSON results of test_rle_bench (a reference and a new one) and
+print the evolution of the median time of every benchmark.
+
+Usage: compare_bench.py reference.json new.json [threshold_percent]
+
+Returns 1 if at least one benchmark is slower than the reference by more than
+the threshold (10% by default), 0 otherwise.
+------------------------------------------------------------------------------
+"""
+
+from __future__ import print_function
+
+import json
+from sys import argv
+from sys import exit as sys_exit
+
+
+def load(filename):
+    """Load the results of a benchmark file, indexed by (name, param)."""
+    with open(filename) as bench_file:
+        results = json.load(bench_file)["benchmarks"]
+    return dict(((r["name"], r["param"]), r) for r in results)
+
+
+def main():
+    """Compare the two benchmark files given on command line."""
+    if len(argv) not in (3, 4):
+        print("usage: %s reference.json new.json [threshold_percent]" % argv[0])
+        return 1
+    threshold = float(argv[3]) if len(argv) == 4 else 10.0
+
+    reference = load(argv[1])
+    new = load(argv[2])
+
+    regressions = 0
+    print("%-24s %-10s %12s %12s %8s" % ("name", "param", "ref (ns)", "new (ns)", "diff"))
+    for key in sorted(new):
+        if key not in reference:
+            continue
+        ref_ns = reference[key]["median_ns"]
+        new_ns = new[key]["median_ns"]
+        diff = (new_ns - ref_ns) * 100.0 / ref_ns if ref_ns else 0.0
+        flag = ""
+        if diff > threshold:
+            flag = "  <-- regression"
+            regressions += 1
+        print("%-24s %-10s %12.2f %12.2f %+7.1f%%%s" %
+              (key[0], key[1], ref_ns, new_ns, diff, flag))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys_exit(main())
@@ -0,0 +1,83 @@
+#!/bin/bash
+
+## PGO build -- Build the release profiles of the library and compare their benchmarks
+
+# Three build directories are configured from the same sources: the default build
+# (reference), the LTO release profile, and the LTO release profile optimized with the
+# profiles of a training run of the instrumented library on the perf samples and the
+# microbenchmarks. The microbenchmarks are then run in the three builds, and the evolution of
+# the LTO and PGO builds against the reference is printed by compare_bench.py.
+
+# Author:    agent <agent@local>
+# Date:      10/2026
+# Copyright: 2026, agent <agent@local>
+
+
+if [[ $# -lt 2 ]]; then
+	echo "NAME"
+	echo "	$(basename $0) - Build the release profiles of the library and compare them"
+	echo "USAGE"
+	echo "	$(basename $0) source_dir work_dir [cmake_args...]"
+	echo "	The builds are made in work_dir/ref, work_dir/lto and work_dir/pgo, the"
+	echo "	PGO one being installable with 'make install' in work_dir/pgo."
+	echo "RETURN"
+	echo "	0 if the builds and the benchmarks succeeded, 1 otherwise"
+	exit 1
+fi
+
+src_dir="$(realpath "$1")"
+work_dir="$(realpath -m "$2")"
+shift 2
+cmake_args=("-DBUILD_DOC=OFF" "$@")
+script_dir="$(dirname "$(realpath "$0")")"
+jobs="$(nproc 2>/dev/null || echo 1)"
+
+# build the library and the benchmarks of one profile
+#  $1: the name of the profile, the subdirectory of work_dir
+#  $@: the CMake options of the profile
+build()
+{
+	local name="$1"
+	shift
+
+	echo "=== ${name}: build"
+	mkdir -p "${work_dir}/${name}" || return 1
+	( cd "${work_dir}/${name}" && \
+	  cmake "${src_dir}" "${cmake_args[@]}" "$@" >/dev/null && \
+	  make -j"${jobs}" rle test_rle_bench test_perfs_offline >/dev/null ) || return 1
+}
+
+# run the microbenchmarks of one profile
+#  $1: the name of the profile, the subdirectory of work_dir
+bench()
+{
+	local name="$1"
+
+	echo "=== ${name}: benchmarks"
+	( cd "${work_dir}/${name}" && make bench >/dev/null ) || return 1
+}
+
+build ref -DLTO=OFF -DPGO=OFF || exit 1
+bench ref || exit 1
+
+build lto -DLTO=ON -DPGO=OFF || exit 1
+bench lto || exit 1
+
+# the profiles are named after the objects, so the training and the optimized builds are
+# made in the same directory
+rm -rf "${work_dir}/pgo/pgo"
+build pgo -DLTO=ON -DPGO=GENERATE || exit 1
+echo "=== pgo: training on the perf samples and the microbenchmarks"
+( cd "${work_dir}/pgo" && make pgo_train >/dev/null ) || exit 1
+build pgo -DLTO=ON -DPGO=USE || exit 1
+bench pgo || exit 1
+
+# compare_bench.py returns 1 on slower benchmarks, that is reported, not an error here
+echo
+echo "=== LTO against the reference"
+python3 "${script_dir}/compare_bench.py" "${work_dir}/ref/bench.json" "${work_dir}/lto/bench.json"
+echo
+echo "=== LTO + PGO against the reference"
+python3 "${script_dir}/compare_bench.py" "${work_dir}/ref/bench.json" "${work_dir}/pgo/bench.json"
+
+exit 0
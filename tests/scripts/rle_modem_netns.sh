@@ -0,0 +1,142 @@
+#!/bin/bash
+
+## RLE modem netns -- Connect two network namespaces through two RLE modems
+
+# Two namespaces are linked by a veth pair that carries the UDP FPDUs. In each
+# namespace, test_rle_modem bridges a TAP device to the veth, so that the IP
+# traffic between the TAP devices goes through RLE. The TAP devices are pinged
+# (if ping is available), then the given command (e.g. an iperf3 client) is run
+# in the first namespace.
+#
+# With --port, the modems rather ingest the frames of a veth port through their
+# AF_PACKET ring, and the hosts are two more namespaces on the other end of the
+# ports, with an untagged link and a VLAN 10 link (if the kernel supports VLANs).
+
+# Author:    agent <agent@local>
+# Date:      10/2026
+# Copyright: 2026, agent <agent@local>
+
+
+if [[ $# -lt 1 ]]; then
+	echo "NAME"
+	echo "	$(basename $0) - Connect two network namespaces through two RLE modems"
+	echo "USAGE"
+	echo "	$(basename $0) [--port] test_rle_modem [modem_args...] [-- command...]"
+	echo "	The first host is 192.168.100.1/24, the second one 192.168.100.2/24."
+	echo "	With --port, they are also 192.168.110.1/24 and 192.168.110.2/24 on VLAN 10."
+	echo "	Run as root."
+	echo "RETURN"
+	echo "	0 if the ping and the command succeeded, 1 otherwise"
+	exit 1
+fi
+
+use_port=0
+if [[ "$1" == "--port" ]]; then
+	use_port=1
+	shift
+fi
+modem="$1"
+shift
+modem_args=()
+while [[ $# -gt 0 && "$1" != "--" ]]; do
+	modem_args+=("$1")
+	shift
+done
+[[ "$1" == "--" ]] && shift
+
+ns_a="rle_modem_a"
+ns_b="rle_modem_b"
+ns_host_a="rle_host_a"
+ns_host_b="rle_host_b"
+pids=()
+
+cleanup() {
+	for pid in "${pids[@]}"; do
+		kill -TERM "${pid}" 2>/dev/null
+		wait "${pid}"
+	done
+	for ns in "${ns_a}" "${ns_b}" "${ns_host_a}" "${ns_host_b}"; do
+		ip netns del "${ns}" 2>/dev/null
+	done
+}
+trap cleanup EXIT
+
+ip netns add "${ns_a}" || exit 1
+ip netns add "${ns_b}" || exit 1
+ip link add veth_a netns "${ns_a}" type veth peer name veth_b netns "${ns_b}" || exit 1
+ip -n "${ns_a}" addr add 10.255.0.1/30 dev veth_a
+ip -n "${ns_b}" addr add 10.255.0.2/30 dev veth_b
+ip -n "${ns_a}" link set veth_a up
+ip -n "${ns_b}" link set veth_b up
+
+if [[ ${use_port} -eq 1 ]]; then
+	# the hosts are behind the ports of the modems
+	ip netns add "${ns_host_a}" || exit 1
+	ip netns add "${ns_host_b}" || exit 1
+	ip link add port0 netns "${ns_a}" type veth peer name eth0 netns "${ns_host_a}" || exit 1
+	ip link add port0 netns "${ns_b}" type veth peer name eth0 netns "${ns_host_b}" || exit 1
+	ip -n "${ns_a}" link set port0 up
+	ip -n "${ns_b}" link set port0 up
+	host_a="${ns_host_a}"
+	host_b="${ns_host_b}"
+	host_dev="eth0"
+	ifaces=(-P port0)
+else
+	host_a="${ns_a}"
+	host_b="${ns_b}"
+	host_dev="rle0"
+	ifaces=(-i rle0)
+fi
+
+ip netns exec "${ns_a}" "${modem}" "${ifaces[@]}" -L 10.255.0.1 -R 10.255.0.2 \
+	"${modem_args[@]}" &
+pids+=($!)
+ip netns exec "${ns_b}" "${modem}" "${ifaces[@]}" -L 10.255.0.2 -R 10.255.0.1 \
+	"${modem_args[@]}" &
+pids+=($!)
+
+# wait for the modems to create their TAP device
+for ns in "${host_a}" "${host_b}"; do
+	for i in $(seq 50); do
+		ip -n "${ns}" link show "${host_dev}" > /dev/null 2>&1 && break
+		sleep 0.1
+	done
+done
+ip -n "${host_a}" addr add 192.168.100.1/24 dev "${host_dev}" || exit 1
+ip -n "${host_b}" addr add 192.168.100.2/24 dev "${host_dev}" || exit 1
+ip -n "${host_a}" link set "${host_dev}" up
+ip -n "${host_b}" link set "${host_dev}" up
+if [[ ${use_port} -eq 1 ]]; then
+	# the modems read the frames before the L4 checksums offloaded to the veth are computed
+	if command -v ethtool > /dev/null; then
+		ip netns exec "${host_a}" ethtool -K eth0 tx off > /dev/null
+		ip netns exec "${host_b}" ethtool -K eth0 tx off > /dev/null
+	else
+		echo "no ethtool, the TCP and UDP checksums of the hosts may be wrong"
+	fi
+fi
+use_vlan=0
+if [[ ${use_port} -eq 1 ]] && \
+   ip -n "${host_a}" link add link eth0 name eth0.10 type vlan id 10 2>/dev/null; then
+	use_vlan=1
+	ip -n "${host_b}" link add link eth0 name eth0.10 type vlan id 10 || exit 1
+	ip -n "${host_a}" addr add 192.168.110.1/24 dev eth0.10
+	ip -n "${host_b}" addr add 192.168.110.2/24 dev eth0.10
+	ip -n "${host_a}" link set eth0.10 up
+	ip -n "${host_b}" link set eth0.10 up
+elif [[ ${use_port} -eq 1 ]]; then
+	echo "no VLAN support in the kernel, VLAN 10 link skipped"
+fi
+
+if command -v ping > /dev/null; then
+	ip netns exec "${host_a}" ping -c 3 -i 0.2 -W 2 192.168.100.2 || exit 1
+	if [[ ${use_vlan} -eq 1 ]]; then
+		ip netns exec "${host_a}" ping -c 3 -i 0.2 -W 2 192.168.110.2 || exit 1
+	fi
+fi
+
+if [[ $# -gt 0 ]]; then
+	ip netns exec "${host_a}" "$@" || exit 1
+fi
+
+exit 0
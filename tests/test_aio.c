@@ -0,0 +1,963 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_aio.c
+ * @brief  Asynchronous batched output of FPDUs or SDUs to a file or a socket.
+ *
+ *         io_uring is used through its system calls directly, so no library is required.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* for sendmmsg() */
+#define _GNU_SOURCE
+
+#include "test_aio.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+/** The default number of buffers of a writer */
+#define AIO_DEFAULT_BUFS_NR 16U
+
+/** The default size of the buffers, 256 KiB */
+#define AIO_DEFAULT_BUF_SIZE (256U * 1024U)
+
+/** The default maximal number of records in one buffer */
+#define AIO_DEFAULT_RECORDS_MAX_NR 1024U
+
+/** The number of submission queue entries of the io_uring */
+#define AIO_URING_ENTRIES 1024U
+
+/** The maximal number of datagrams given to one sendmmsg(2) call */
+#define AIO_SENDMMSG_MAX_NR 1024U
+
+/** The size of the socket send buffer requested */
+#define AIO_SOCKET_BUF_LEN (4 * 1024 * 1024)
+
+/** The kinds of destinations */
+enum aio_dest_type {
+	AIO_DEST_FILE,    /**< A file, written at increasing offsets */
+	AIO_DEST_STREAM,  /**< A stream socket, written in order */
+	AIO_DEST_DGRAM,   /**< A datagram socket, one datagram per record */
+};
+
+/** A buffer of records */
+struct aio_buf {
+	unsigned char *data;       /**< The records, back to back */
+	size_t len;                /**< The length of the records */
+	uint32_t *lens;            /**< The length of every record */
+	size_t records_nr;         /**< The number of records */
+	size_t done_len;           /**< The number of bytes written, or sent and lost */
+	size_t done_nr;            /**< The number of datagrams sent or lost */
+	uint64_t offset;           /**< The offset of the buffer in the file */
+	unsigned int inflight_nr;  /**< The number of io_uring requests in flight */
+	bool submitted;            /**< Whether the buffer was handed to the kernel */
+	bool done;                 /**< Whether the buffer was written */
+};
+
+/** The rings shared with the kernel by io_uring */
+struct aio_uring {
+	int fd;                       /**< The io_uring instance */
+	void *sq_ring;                /**< The submission ring */
+	size_t sq_ring_len;           /**< The length of the submission ring mapping */
+	void *cq_ring;                /**< The completion ring, maybe the submission mapping */
+	size_t cq_ring_len;           /**< The length of the completion ring mapping */
+	struct io_uring_sqe *sqes;    /**< The submission queue entries */
+	size_t sqes_len;              /**< The length of the entries mapping */
+	unsigned int *sq_head;        /**< The first entry not consumed yet by the kernel */
+	unsigned int *sq_tail;        /**< The next entry to fill */
+	unsigned int *sq_array;       /**< The indexes of the entries submitted */
+	unsigned int sq_mask;         /**< The mask of the submission ring indexes */
+	unsigned int sq_entries;      /**< The number of submission entries */
+	unsigned int *cq_head;        /**< The first completion not read yet */
+	unsigned int *cq_tail;        /**< The next completion to be written by the kernel */
+	struct io_uring_cqe *cqes;    /**< The completion queue entries */
+	unsigned int cq_mask;         /**< The mask of the completion ring indexes */
+	unsigned int cq_entries;      /**< The number of completion entries */
+	unsigned int to_submit_nr;    /**< The number of entries filled but not submitted */
+	unsigned int inflight_nr;     /**< The number of requests without completion yet */
+	bool fixed;                   /**< Whether the buffers are registered or not */
+};
+
+/** The writer */
+struct aio_writer {
+	enum aio_backend backend;     /**< io_uring or epoll, never auto */
+	enum aio_dest_type type;      /**< The kind of destination */
+	int fd;                       /**< The file or the socket */
+	int epoll_fd;                 /**< The epoll instance for a socket, -1 otherwise */
+	struct aio_uring uring;       /**< The io_uring instance */
+	unsigned char *mem;           /**< The memory of all the buffers */
+	struct aio_buf *bufs;         /**< The buffers */
+	size_t bufs_nr;               /**< The number of buffers */
+	size_t buf_size;              /**< The size of every buffer */
+	size_t records_max_nr;        /**< The maximal number of records in one buffer */
+	size_t head;                  /**< The oldest buffer handed to the kernel */
+	size_t busy_nr;               /**< The number of buffers handed to the kernel, the
+	                                   buffer being filled is the next one */
+	uint64_t offset;              /**< The offset of the next buffer in the file */
+	struct mmsghdr *msgs;         /**< The headers of the datagrams, epoll only */
+	struct iovec *iovs;           /**< The contents of the datagrams, epoll only */
+	bool failed;                  /**< Whether some records could not be written */
+	struct aio_stats stats;       /**< The statistics */
+};
+
+
+/**
+ * @brief  Get the buffer being filled
+ *
+ * @param[in] writer  The writer
+ * @return            The buffer
+ */
+static struct aio_buf * aio_cur_buf(const struct aio_writer *const writer)
+{
+	return &writer->bufs[(writer->head + writer->busy_nr) % writer->bufs_nr];
+}
+
+/**
+ * @brief  Open the file or the socket of a destination
+ *
+ * @param[in,out] writer  The writer
+ * @param[in]     dest    The destination: udp:HOST:PORT, tcp:HOST:PORT or a file
+ * @return                0 in case of success, -1 otherwise
+ */
+static int aio_dest_open(struct aio_writer *const writer, const char *const dest)
+{
+	const int buf_len = AIO_SOCKET_BUF_LEN;
+	struct addrinfo hints;
+	struct addrinfo *addrs;
+	char host[256];
+	const char *port;
+	size_t host_len;
+	int ret;
+
+	if (strncmp(dest, "udp:", 4) == 0) {
+		writer->type = AIO_DEST_DGRAM;
+	} else if (strncmp(dest, "tcp:", 4) == 0) {
+		writer->type = AIO_DEST_STREAM;
+	} else {
+		writer->type = AIO_DEST_FILE;
+		writer->fd = open(dest, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (writer->fd < 0) {
+			perror("failed to create the output file");
+			return -1;
+		}
+		return 0;
+	}
+
+	/* HOST:PORT, the port is after the last colon so that HOST may be an IPv6 address */
+	port = strrchr(dest + 4, ':');
+	if (port == NULL) {
+		fprintf(stderr, "no port in output '%s'\n", dest);
+		return -1;
+	}
+	host_len = port - (dest + 4);
+	if (host_len >= sizeof(host)) {
+		fprintf(stderr, "host too long in output '%s'\n", dest);
+		return -1;
+	}
+	memcpy(host, dest + 4, host_len);
+	host[host_len] = '\0';
+	port++;
+
+	memset(&hints, 0, sizeof(struct addrinfo));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = writer->type == AIO_DEST_DGRAM ? SOCK_DGRAM : SOCK_STREAM;
+	ret = getaddrinfo(host, port, &hints, &addrs);
+	if (ret != 0) {
+		fprintf(stderr, "failed to resolve output '%s': %s\n", dest, gai_strerror(ret));
+		return -1;
+	}
+	writer->fd = socket(addrs->ai_family, addrs->ai_socktype, addrs->ai_protocol);
+	if (writer->fd < 0) {
+		perror("failed to create the output socket");
+		goto free_addrs;
+	}
+	/* best effort, the batches are handed at once to the socket */
+	setsockopt(writer->fd, SOL_SOCKET, SO_SNDBUF, &buf_len, sizeof(int));
+	if (connect(writer->fd, addrs->ai_addr, addrs->ai_addrlen) != 0) {
+		perror("failed to connect the output socket");
+		goto free_addrs;
+	}
+	freeaddrinfo(addrs);
+
+	return 0;
+
+free_addrs:
+	freeaddrinfo(addrs);
+	return -1;
+}
+
+/**
+ * @brief  Create the io_uring instance of a writer, map its rings and register the buffers
+ *
+ * @param[in,out] writer  The writer
+ * @return                0 in case of success, -1 if io_uring is not available
+ */
+static int uring_open(struct aio_writer *const writer)
+{
+	struct aio_uring *const ring = &writer->uring;
+	struct io_uring_params params;
+	struct iovec *iovs;
+	size_t i;
+
+	memset(&params, 0, sizeof(struct io_uring_params));
+	ring->fd = syscall(__NR_io_uring_setup, AIO_URING_ENTRIES, &params);
+	if (ring->fd < 0) {
+		return -1;
+	}
+
+	ring->sq_ring_len = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+	ring->cq_ring_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+		/* both rings are in one mapping */
+		if (ring->cq_ring_len > ring->sq_ring_len) {
+			ring->sq_ring_len = ring->cq_ring_len;
+		}
+		ring->cq_ring_len = 0;
+	}
+	ring->sq_ring = mmap(NULL, ring->sq_ring_len, PROT_READ | PROT_WRITE,
+	                     MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	if (ring->sq_ring == MAP_FAILED) {
+		perror("failed to map the io_uring submission ring");
+		return -1;
+	}
+	if (ring->cq_ring_len == 0) {
+		ring->cq_ring = ring->sq_ring;
+	} else {
+		ring->cq_ring = mmap(NULL, ring->cq_ring_len, PROT_READ | PROT_WRITE,
+		                     MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+		if (ring->cq_ring == MAP_FAILED) {
+			perror("failed to map the io_uring completion ring");
+			return -1;
+		}
+	}
+	ring->sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+	ring->sqes = mmap(NULL, ring->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+	                  ring->fd, IORING_OFF_SQES);
+	if (ring->sqes == MAP_FAILED) {
+		perror("failed to map the io_uring submission entries");
+		return -1;
+	}
+
+	ring->sq_head = (unsigned int *)((unsigned char *)ring->sq_ring + params.sq_off.head);
+	ring->sq_tail = (unsigned int *)((unsigned char *)ring->sq_ring + params.sq_off.tail);
+	ring->sq_array = (unsigned int *)((unsigned char *)ring->sq_ring + params.sq_off.array);
+	ring->sq_mask = *(unsigned int *)((unsigned char *)ring->sq_ring + params.sq_off.ring_mask);
+	ring->sq_entries = params.sq_entries;
+	ring->cq_head = (unsigned int *)((unsigned char *)ring->cq_ring + params.cq_off.head);
+	ring->cq_tail = (unsigned int *)((unsigned char *)ring->cq_ring + params.cq_off.tail);
+	ring->cqes = (struct io_uring_cqe *)((unsigned char *)ring->cq_ring + params.cq_off.cqes);
+	ring->cq_mask = *(unsigned int *)((unsigned char *)ring->cq_ring + params.cq_off.ring_mask);
+	ring->cq_entries = params.cq_entries;
+
+	/* registered buffers are pinned once instead of at every write, they are an
+	 * optimization only since the locked memory of the process may be limited */
+	iovs = calloc(writer->bufs_nr, sizeof(struct iovec));
+	if (iovs == NULL) {
+		return -1;
+	}
+	for (i = 0; i < writer->bufs_nr; i++) {
+		iovs[i].iov_base = writer->bufs[i].data;
+		iovs[i].iov_len = writer->buf_size;
+	}
+	ring->fixed = (syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS, iovs,
+	                       writer->bufs_nr) == 0);
+	free(iovs);
+
+	return 0;
+}
+
+/**
+ * @brief  Unmap the rings of the io_uring instance of a writer then close it
+ *
+ * @param[in,out] writer  The writer
+ */
+static void uring_close(struct aio_writer *const writer)
+{
+	struct aio_uring *const ring = &writer->uring;
+
+	if (ring->sqes != MAP_FAILED) {
+		munmap(ring->sqes, ring->sqes_len);
+	}
+	if (ring->cq_ring != MAP_FAILED && ring->cq_ring != ring->sq_ring) {
+		munmap(ring->cq_ring, ring->cq_ring_len);
+	}
+	if (ring->sq_ring != MAP_FAILED) {
+		munmap(ring->sq_ring, ring->sq_ring_len);
+	}
+	if (ring->fd >= 0) {
+		close(ring->fd);
+	}
+	ring->fd = -1;
+}
+
+/**
+ * @brief  Submit the filled entries to the kernel, and wait for completions if requested
+ *
+ * @param[in,out] writer        The writer
+ * @param[in]     min_complete  The number of completions to wait for
+ * @return                      0 in case of success, -1 otherwise
+ */
+static int uring_enter(struct aio_writer *const writer, const unsigned int min_complete)
+{
+	struct aio_uring *const ring = &writer->uring;
+	int ret;
+
+	ret = syscall(__NR_io_uring_enter, ring->fd, ring->to_submit_nr, min_complete,
+	              min_complete > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+	writer->stats.syscalls_nr++;
+	if (ret < 0) {
+		if (errno == EINTR || errno == EAGAIN) {
+			return 0;
+		}
+		perror("failed to submit to io_uring");
+		return -1;
+	}
+	ring->to_submit_nr -= ret;
+
+	return 0;
+}
+
+/**
+ * @brief  Fill a submission entry for part of a buffer
+ *
+ *         The filled entries are submitted at once by uring_enter(), or here if the
+ *         submission ring is full.
+ *
+ * @param[in,out] writer  The writer
+ * @param[in]     buf_id  The buffer
+ * @param[in]     pos     The position of the data in the buffer
+ * @param[in]     len     The length of the data
+ * @return                0 in case of success, -1 otherwise
+ */
+static int uring_prep(struct aio_writer *const writer, const size_t buf_id, const size_t pos,
+                      const size_t len)
+{
+	struct aio_uring *const ring = &writer->uring;
+	struct aio_buf *const buf = &writer->bufs[buf_id];
+	struct io_uring_sqe *sqe;
+	unsigned int tail = *ring->sq_tail;
+	unsigned int index;
+
+	if (tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) >= ring->sq_entries &&
+	    uring_enter(writer, 0) != 0) {
+		return -1;
+	}
+	index = tail & ring->sq_mask;
+	sqe = &ring->sqes[index];
+	memset(sqe, 0, sizeof(struct io_uring_sqe));
+	sqe->fd = writer->fd;
+	sqe->addr = (uint64_t)(uintptr_t)(buf->data + pos);
+	sqe->len = len;
+	sqe->user_data = buf_id;
+	if (writer->type == AIO_DEST_DGRAM) {
+		/* a plain send does not use the registered buffers */
+		sqe->opcode = IORING_OP_SEND;
+	} else {
+		sqe->opcode = ring->fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+		sqe->buf_index = buf_id;
+		/* the offset of a socket is ignored */
+		sqe->off = writer->type == AIO_DEST_FILE ? buf->offset + pos : 0;
+	}
+	ring->sq_array[index] = index;
+	__atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+	ring->to_submit_nr++;
+	ring->inflight_nr++;
+	buf->inflight_nr++;
+
+	return 0;
+}
+
+/**
+ * @brief  Hand the queued buffers of a writer to io_uring, as long as there are completion
+ *         entries for all their requests
+ *
+ *         A stream socket is written one buffer at a time, so a short write is completed
+ *         before the next buffer.
+ *
+ * @param[in,out] writer  The writer
+ * @return                0 in case of success, -1 otherwise
+ */
+static int uring_kick(struct aio_writer *const writer)
+{
+	struct aio_uring *const ring = &writer->uring;
+	size_t i;
+
+	for (i = 0; i < writer->busy_nr; i++) {
+		const size_t buf_id = (writer->head + i) % writer->bufs_nr;
+		struct aio_buf *const buf = &writer->bufs[buf_id];
+		const size_t requests_nr = writer->type == AIO_DEST_DGRAM ? buf->records_nr : 1;
+
+		if (buf->submitted) {
+			continue;
+		}
+		if (writer->type == AIO_DEST_STREAM && i > 0) {
+			break;
+		}
+		if (ring->inflight_nr + requests_nr > ring->cq_entries) {
+			/* the completion ring could overflow, wait for some completions first */
+			break;
+		}
+		if (writer->type == AIO_DEST_DGRAM) {
+			size_t record_id;
+			size_t pos = 0;
+
+			for (record_id = 0; record_id < buf->records_nr; record_id++) {
+				if (uring_prep(writer, buf_id, pos, buf->lens[record_id]) != 0) {
+					return -1;
+				}
+				pos += buf->lens[record_id];
+			}
+		} else if (uring_prep(writer, buf_id, 0, buf->len) != 0) {
+			return -1;
+		}
+		buf->submitted = true;
+	}
+
+	if (ring->to_submit_nr > 0) {
+		return uring_enter(writer, 0);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  Account the completion of one request of a buffer, and write again the end of the
+ *         buffer after a short write
+ *
+ * @param[in,out] writer  The writer
+ * @param[in]     buf_id  The buffer
+ * @param[in]     res     The result of the request
+ * @return                0 in case of success, -1 otherwise
+ */
+static int uring_complete(struct aio_writer *const writer, const size_t buf_id,
+                          const int res)
+{
+	struct aio_buf *const buf = &writer->bufs[buf_id];
+
+	writer->uring.inflight_nr--;
+	buf->inflight_nr--;
+
+	if (writer->type == AIO_DEST_DGRAM) {
+		if (res == -ENOBUFS || res == -ECONNREFUSED) {
+			writer->stats.lost_nr++;
+		} else if (res < 0) {
+			fprintf(stderr, "failed to send a datagram: %s\n", strerror(-res));
+			writer->failed = true;
+		} else {
+			writer->stats.records_nr++;
+			writer->stats.bytes_nr += res;
+		}
+		buf->done_nr++;
+		buf->done = (buf->inflight_nr == 0);
+		return 0;
+	}
+
+	if (res == -EINTR || res == -EAGAIN) {
+		/* nothing written, try again */
+	} else if (res <= 0) {
+		fprintf(stderr, "failed to write the output: %s\n",
+		        res == 0 ? "nothing written" : strerror(-res));
+		writer->failed = true;
+		buf->done = true;
+		return 0;
+	} else {
+		buf->done_len += res;
+	}
+	if (buf->done_len < buf->len) {
+		return uring_prep(writer, buf_id, buf->done_len, buf->len - buf->done_len);
+	}
+	writer->stats.records_nr += buf->records_nr;
+	writer->stats.bytes_nr += buf->len;
+	buf->done = true;
+
+	return 0;
+}
+
+/**
+ * @brief  Read all the completions written by the kernel, without any system call
+ *
+ * @param[in,out] writer  The writer
+ * @return                0 in case of success, -1 otherwise
+ */
+static int uring_reap(struct aio_writer *const writer)
+{
+	struct aio_uring *const ring = &writer->uring;
+	unsigned int head = *ring->cq_head;
+
+	while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+		const struct io_uring_cqe *const cqe = &ring->cqes[head & ring->cq_mask];
+		const size_t buf_id = cqe->user_data;
+		const int res = cqe->res;
+
+		/* free the completion entry before a new request may be filled */
+		head++;
+		__atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+		if (uring_complete(writer, buf_id, res) != 0) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  Write the buffers of a writer, oldest first, until one would block
+ *
+ * @param[in,out] writer  The writer
+ * @return                0 if all the buffers were written, 1 if the socket is full,
+ *                        -1 in case of error
+ */
+static int epoll_write(struct aio_writer *const writer)
+{
+	size_t i;
+
+	for (i = 0; i < writer->busy_nr; i++) {
+		struct aio_buf *const buf = &writer->bufs[(writer->head + i) % writer->bufs_nr];
+
+		if (buf->done) {
+			continue;
+		}
+		buf->submitted = true;
+
+		while (writer->type == AIO_DEST_DGRAM && buf->done_nr < buf->records_nr) {
+			size_t msgs_nr = buf->records_nr - buf->done_nr;
+			size_t pos = buf->done_len;
+			size_t msg_id;
+			int ret;
+
+			if (msgs_nr > AIO_SENDMMSG_MAX_NR) {
+				msgs_nr = AIO_SENDMMSG_MAX_NR;
+			}
+			for (msg_id = 0; msg_id < msgs_nr; msg_id++) {
+				writer->iovs[msg_id].iov_base = buf->data + pos;
+				writer->iovs[msg_id].iov_len = buf->lens[buf->done_nr + msg_id];
+				pos += writer->iovs[msg_id].iov_len;
+			}
+			ret = sendmmsg(writer->fd, writer->msgs, msgs_nr, 0);
+			writer->stats.syscalls_nr++;
+			if (ret < 0 && errno == EINTR) {
+				continue;
+			} else if (ret < 0 && errno == EAGAIN) {
+				return 1;
+			} else if (ret < 0 && errno != ENOBUFS && errno != ECONNREFUSED) {
+				perror("failed to send datagrams");
+				return -1;
+			} else if (ret < 0) {
+				/* the first datagram was dropped */
+				writer->stats.lost_nr++;
+				ret = 1;
+			} else {
+				writer->stats.records_nr += ret;
+				for (msg_id = 0; msg_id < (size_t)ret; msg_id++) {
+					writer->stats.bytes_nr += buf->lens[buf->done_nr + msg_id];
+				}
+			}
+			for (msg_id = 0; msg_id < (size_t)ret; msg_id++) {
+				buf->done_len += buf->lens[buf->done_nr];
+				buf->done_nr++;
+			}
+		}
+
+		while (writer->type != AIO_DEST_DGRAM && buf->done_len < buf->len) {
+			const ssize_t ret = write(writer->fd, buf->data + buf->done_len,
+			                          buf->len - buf->done_len);
+
+			writer->stats.syscalls_nr++;
+			if (ret < 0 && errno == EINTR) {
+				continue;
+			} else if (ret < 0 && errno == EAGAIN) {
+				return 1;
+			} else if (ret <= 0) {
+				perror("failed to write the output");
+				return -1;
+			}
+			buf->done_len += ret;
+		}
+		if (writer->type != AIO_DEST_DGRAM) {
+			writer->stats.records_nr += buf->records_nr;
+			writer->stats.bytes_nr += buf->len;
+		}
+		buf->done = true;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  Give back the oldest buffers of a writer once written
+ *
+ * @param[in,out] writer  The writer
+ * @return                The number of buffers given back
+ */
+static size_t aio_retire(struct aio_writer *const writer)
+{
+	size_t retired_nr = 0;
+
+	while (writer->busy_nr > 0 && writer->bufs[writer->head].done) {
+		struct aio_buf *const buf = &writer->bufs[writer->head];
+
+		buf->len = 0;
+		buf->records_nr = 0;
+		buf->done_len = 0;
+		buf->done_nr = 0;
+		buf->submitted = false;
+		buf->done = false;
+		writer->head = (writer->head + 1) % writer->bufs_nr;
+		writer->busy_nr--;
+		retired_nr++;
+	}
+
+	return retired_nr;
+}
+
+/**
+ * @brief  Hand the queued buffers of a writer to the kernel, without waiting
+ *
+ * @param[in,out] writer  The writer
+ * @return                0 in case of success, -1 otherwise
+ */
+static int aio_progress(struct aio_writer *const writer)
+{
+	int ret;
+
+	if (writer->backend == AIO_BACKEND_URING) {
+		ret = uring_reap(writer);
+		aio_retire(writer);
+		if (ret == 0) {
+			ret = uring_kick(writer);
+		}
+	} else {
+		ret = epoll_write(writer);
+		aio_retire(writer);
+	}
+
+	return ret < 0 ? -1 : 0;
+}
+
+/**
+ * @brief  Wait until the oldest buffer handed to the kernel is written
+ *
+ * @param[in,out] writer  The writer
+ * @return                0 in case of success, -1 otherwise
+ */
+static int aio_wait(struct aio_writer *const writer)
+{
+	while (writer->busy_nr > 0) {
+		size_t retired_nr;
+		int ret;
+
+		if (writer->backend == AIO_BACKEND_URING) {
+			ret = uring_kick(writer);
+			if (ret == 0 && writer->uring.inflight_nr > 0) {
+				ret = uring_enter(writer, 1);
+			}
+			if (ret == 0) {
+				ret = uring_reap(writer);
+			}
+		} else {
+			ret = epoll_write(writer);
+			if (ret == 1) {
+				struct epoll_event event;
+
+				/* the socket is full, wait for room */
+				if (epoll_wait(writer->epoll_fd, &event, 1, -1) < 0 && errno != EINTR) {
+					perror("failed to wait for the output socket");
+					ret = -1;
+				}
+				writer->stats.syscalls_nr++;
+			}
+		}
+		retired_nr = aio_retire(writer);
+		if (ret < 0) {
+			return -1;
+		} else if (retired_nr > 0) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  Hand the buffer being filled to the kernel, then wait for a free buffer if none
+ *
+ * @param[in,out] writer  The writer
+ * @return                0 in case of success, -1 otherwise
+ */
+static int aio_flush(struct aio_writer *const writer)
+{
+	struct aio_buf *const buf = aio_cur_buf(writer);
+
+	if (buf->records_nr == 0) {
+		return 0;
+	}
+	buf->offset = writer->offset;
+	writer->offset += buf->len;
+	writer->busy_nr++;
+	writer->stats.bufs_nr++;
+
+	if (aio_progress(writer) != 0) {
+		writer->failed = true;
+		return -1;
+	}
+	if (writer->busy_nr == writer->bufs_nr) {
+		writer->stats.waits_nr++;
+		if (aio_wait(writer) != 0) {
+			writer->failed = true;
+			return -1;
+		}
+	}
+
+	return writer->failed ? -1 : 0;
+}
+
+
+void aio_conf_init(struct aio_conf *const conf)
+{
+	conf->backend = AIO_BACKEND_AUTO;
+	conf->bufs_nr = AIO_DEFAULT_BUFS_NR;
+	conf->buf_size = AIO_DEFAULT_BUF_SIZE;
+	conf->records_max_nr = AIO_DEFAULT_RECORDS_MAX_NR;
+}
+
+int aio_parse_backend(const char *const name, enum aio_backend *const backend)
+{
+	if (strcmp(name, "auto") == 0) {
+		*backend = AIO_BACKEND_AUTO;
+	} else if (strcmp(name, "uring") == 0) {
+		*backend = AIO_BACKEND_URING;
+	} else if (strcmp(name, "epoll") == 0) {
+		*backend = AIO_BACKEND_EPOLL;
+	} else {
+		fprintf(stderr, "unknown I/O backend '%s', expected auto, uring or epoll\n", name);
+		return -1;
+	}
+
+	return 0;
+}
+
+struct aio_writer * aio_writer_open(const char *const dest, const struct aio_conf *const conf)
+{
+	struct aio_writer *writer;
+	size_t i;
+
+	if (conf->bufs_nr < 2 || conf->buf_size == 0 || conf->records_max_nr == 0 ||
+	    conf->records_max_nr > AIO_URING_ENTRIES) {
+		fprintf(stderr, "invalid configuration of the output\n");
+		goto error;
+	}
+
+	writer = calloc(1, sizeof(struct aio_writer));
+	if (writer == NULL) {
+		goto error;
+	}
+	writer->fd = -1;
+	writer->epoll_fd = -1;
+	writer->uring.fd = -1;
+	writer->uring.sq_ring = MAP_FAILED;
+	writer->uring.cq_ring = MAP_FAILED;
+	writer->uring.sqes = MAP_FAILED;
+	writer->bufs_nr = conf->bufs_nr;
+	writer->buf_size = conf->buf_size;
+	writer->records_max_nr = conf->records_max_nr;
+
+	writer->bufs = calloc(writer->bufs_nr, sizeof(struct aio_buf));
+	if (writer->bufs == NULL ||
+	    posix_memalign((void **)&writer->mem, getpagesize(),
+	                   writer->bufs_nr * writer->buf_size) != 0) {
+		fprintf(stderr, "failed to allocate the output buffers\n");
+		goto close_writer;
+	}
+	for (i = 0; i < writer->bufs_nr; i++) {
+		writer->bufs[i].data = writer->mem + i * writer->buf_size;
+		writer->bufs[i].lens = malloc(writer->records_max_nr * sizeof(uint32_t));
+		if (writer->bufs[i].lens == NULL) {
+			goto close_writer;
+		}
+	}
+
+	if (aio_dest_open(writer, dest) != 0) {
+		goto close_writer;
+	}
+
+	writer->backend = AIO_BACKEND_EPOLL;
+	if (conf->backend != AIO_BACKEND_EPOLL) {
+		if (uring_open(writer) == 0) {
+			writer->backend = AIO_BACKEND_URING;
+		} else if (conf->backend == AIO_BACKEND_URING) {
+			perror("io_uring is not available");
+			goto close_writer;
+		} else {
+			uring_close(writer);
+		}
+	}
+
+	if (writer->backend == AIO_BACKEND_EPOLL && writer->type != AIO_DEST_FILE) {
+		struct epoll_event event;
+
+		/* regular files cannot be polled, they are written synchronously */
+		if (fcntl(writer->fd, F_SETFL, fcntl(writer->fd, F_GETFL) | O_NONBLOCK) != 0) {
+			perror("failed to make the output socket non-blocking");
+			goto close_writer;
+		}
+		writer->epoll_fd = epoll_create1(0);
+		if (writer->epoll_fd < 0) {
+			perror("failed to create the epoll instance");
+			goto close_writer;
+		}
+		memset(&event, 0, sizeof(struct epoll_event));
+		event.events = EPOLLOUT;
+		if (epoll_ctl(writer->epoll_fd, EPOLL_CTL_ADD, writer->fd, &event) != 0) {
+			perror("failed to poll the output socket");
+			goto close_writer;
+		}
+	}
+	if (writer->backend == AIO_BACKEND_EPOLL && writer->type == AIO_DEST_DGRAM) {
+		writer->msgs = calloc(AIO_SENDMMSG_MAX_NR, sizeof(struct mmsghdr));
+		writer->iovs = calloc(AIO_SENDMMSG_MAX_NR, sizeof(struct iovec));
+		if (writer->msgs == NULL || writer->iovs == NULL) {
+			goto close_writer;
+		}
+		for (i = 0; i < AIO_SENDMMSG_MAX_NR; i++) {
+			writer->msgs[i].msg_hdr.msg_iov = &writer->iovs[i];
+			writer->msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+	}
+
+	return writer;
+
+close_writer:
+	aio_writer_close(writer);
+error:
+	return NULL;
+}
+
+int aio_writer_close(struct aio_writer *const writer)
+{
+	int status = 0;
+	size_t i;
+
+	if (writer->fd >= 0 && (aio_writer_sync(writer) != 0 || writer->failed)) {
+		status = -1;
+	}
+
+	uring_close(writer);
+	if (writer->epoll_fd >= 0) {
+		close(writer->epoll_fd);
+	}
+	if (writer->fd >= 0) {
+		close(writer->fd);
+	}
+	if (writer->bufs != NULL) {
+		for (i = 0; i < writer->bufs_nr; i++) {
+			free(writer->bufs[i].lens);
+		}
+	}
+	free(writer->bufs);
+	free(writer->mem);
+	free(writer->msgs);
+	free(writer->iovs);
+	free(writer);
+
+	return status;
+}
+
+unsigned char * aio_writer_get_buf(struct aio_writer *const writer, const size_t len)
+{
+	struct aio_buf *buf = aio_cur_buf(writer);
+
+	if (len > writer->buf_size) {
+		fprintf(stderr, "record of %zu bytes larger than the output buffers\n", len);
+		return NULL;
+	}
+	if (buf->len + len > writer->buf_size || buf->records_nr >= writer->records_max_nr) {
+		if (aio_flush(writer) != 0) {
+			return NULL;
+		}
+		buf = aio_cur_buf(writer);
+	}
+
+	return buf->data + buf->len;
+}
+
+void aio_writer_put(struct aio_writer *const writer, const size_t len)
+{
+	struct aio_buf *const buf = aio_cur_buf(writer);
+
+	buf->lens[buf->records_nr] = len;
+	buf->records_nr++;
+	buf->len += len;
+}
+
+int aio_writer_add(struct aio_writer *const writer, const unsigned char *const data,
+                   const size_t len)
+{
+	unsigned char *const room = aio_writer_get_buf(writer, len);
+
+	if (room == NULL) {
+		return -1;
+	}
+	memcpy(room, data, len);
+	aio_writer_put(writer, len);
+
+	return 0;
+}
+
+int aio_writer_sync(struct aio_writer *const writer)
+{
+	if (aio_flush(writer) != 0) {
+		return -1;
+	}
+	while (writer->busy_nr > 0) {
+		if (aio_wait(writer) != 0) {
+			writer->failed = true;
+			return -1;
+		}
+	}
+
+	return writer->failed ? -1 : 0;
+}
+
+const char * aio_writer_get_backend_name(const struct aio_writer *const writer)
+{
+	return writer->backend == AIO_BACKEND_URING ? "uring" : "epoll";
+}
+
+void aio_writer_get_stats(const struct aio_writer *const writer, struct aio_stats *const stats)
+{
+	memcpy(stats, &writer->stats, sizeof(struct aio_stats));
+}
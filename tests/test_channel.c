@@ -0,0 +1,220 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_channel.c
+ * @brief  Lossy channel emulator between the RLE transmitter and receiver of the tests.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#include "test_channel.h"
+#include "test_traffic_gen.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PRIVATE FUNCTIONS CODE ------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief  Draw a number uniformly in ]0 ; 1[
+ *
+ * @param[in,out] channel  The channel
+ * @return                 The drawn number
+ */
+static double channel_uniform(struct channel *const channel)
+{
+	return (traffic_rand(&channel->rand_state) + 0.5) / 4294967296.0;
+}
+
+/**
+ * @brief  Flip random bits of an FPDU according to the bit error rate
+ *
+ *         The distance between two errors follows a geometric law, so that the cost does not
+ *         depend on the FPDU length for low error rates.
+ *
+ * @param[in,out] channel   The channel
+ * @param[in,out] fpdu      The FPDU
+ * @param[in]     fpdu_len  The length of the FPDU
+ */
+static void channel_flip_bits(struct channel *const channel, unsigned char *const fpdu,
+                              const size_t fpdu_len)
+{
+	const double bits_nr = fpdu_len * 8.0;
+	const double log_no_error = log1p(-channel->conf.bit_error_rate);
+	double bit = 0;
+	uint64_t errors_nr = 0;
+
+	if (channel->conf.bit_error_rate <= 0) {
+		return;
+	}
+
+	while (1) {
+		bit += floor(log(channel_uniform(channel)) / log_no_error);
+		if (bit >= bits_nr) {
+			break;
+		}
+		fpdu[(size_t)bit / 8] ^= 0x80 >> ((size_t)bit % 8);
+		errors_nr++;
+		bit++;
+	}
+
+	if (errors_nr > 0) {
+		channel->stats.corrupted_nr++;
+		channel->stats.bit_errors_nr += errors_nr;
+	}
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+int channel_init(struct channel *const channel, const struct channel_conf *const conf,
+                 const size_t fpdu_max_len, const channel_deliver_t deliver,
+                 void *const deliver_arg)
+{
+	size_t i;
+
+	memset(channel, 0, sizeof(struct channel));
+	channel->conf = *conf;
+	channel->rand_state = traffic_rand_init(conf->seed);
+	channel->fpdu_max_len = fpdu_max_len;
+	channel->deliver = deliver;
+	channel->deliver_arg = deliver_arg;
+
+	/* the FPDU being impaired, then the held back FPDUs */
+	channel->fpdu = malloc((CHANNEL_MAX_HELD + 1) * fpdu_max_len);
+	if (channel->fpdu == NULL) {
+		fprintf(stderr, "failed to allocate the channel buffers\n");
+		return -1;
+	}
+	for (i = 0; i < CHANNEL_MAX_HELD; i++) {
+		channel->held[i].fpdu = channel->fpdu + (i + 1) * fpdu_max_len;
+	}
+
+	return 0;
+}
+
+int channel_send(struct channel *const channel, const unsigned char *const fpdu,
+                 const size_t fpdu_len)
+{
+	const struct channel_slot *just_held = NULL;
+	size_t i;
+
+	if (fpdu_len > channel->fpdu_max_len) {
+		fprintf(stderr, "FPDU of %zu bytes is larger than the %zu bytes of the channel\n",
+		        fpdu_len, channel->fpdu_max_len);
+		return -1;
+	}
+
+	channel->stats.fpdus_nr++;
+
+	if (channel_uniform(channel) < channel->conf.loss_rate) {
+		channel->stats.lost_nr++;
+		goto age_held;
+	}
+
+	memcpy(channel->fpdu, fpdu, fpdu_len);
+	channel_flip_bits(channel, channel->fpdu, fpdu_len);
+
+	if (channel->conf.reorder_depth > 0 &&
+	    channel_uniform(channel) < channel->conf.reorder_rate) {
+		for (i = 0; i < CHANNEL_MAX_HELD; i++) {
+			struct channel_slot *const slot = &channel->held[i];
+
+			if (slot->fpdu_len == 0) {
+				memcpy(slot->fpdu, channel->fpdu, fpdu_len);
+				slot->fpdu_len = fpdu_len;
+				slot->delay = channel->conf.reorder_depth;
+				channel->stats.reordered_nr++;
+				just_held = slot;
+				goto age_held;
+			}
+		}
+		/* no free slot, deliver the FPDU in order */
+	}
+
+	if (channel->deliver(channel->deliver_arg, channel->fpdu, fpdu_len) != 0) {
+		return -1;
+	}
+	if (channel_uniform(channel) < channel->conf.dup_rate) {
+		channel->stats.duplicated_nr++;
+		if (channel->deliver(channel->deliver_arg, channel->fpdu, fpdu_len) != 0) {
+			return -1;
+		}
+	}
+
+age_held:
+	for (i = 0; i < CHANNEL_MAX_HELD; i++) {
+		struct channel_slot *const slot = &channel->held[i];
+
+		if (slot->fpdu_len == 0 || slot == just_held) {
+			continue;
+		}
+		slot->delay--;
+		if (slot->delay == 0) {
+			const size_t held_len = slot->fpdu_len;
+
+			slot->fpdu_len = 0;
+			if (channel->deliver(channel->deliver_arg, slot->fpdu, held_len) != 0) {
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+int channel_flush(struct channel *const channel)
+{
+	unsigned int delay;
+	size_t i;
+
+	/* deliver the held back FPDUs in the order they are due */
+	for (delay = 1; delay <= channel->conf.reorder_depth; delay++) {
+		for (i = 0; i < CHANNEL_MAX_HELD; i++) {
+			struct channel_slot *const slot = &channel->held[i];
+
+			if (slot->fpdu_len != 0 && slot->delay == delay) {
+				const size_t held_len = slot->fpdu_len;
+
+				slot->fpdu_len = 0;
+				if (channel->deliver(channel->deliver_arg, slot->fpdu, held_len) != 0) {
+					return -1;
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+void channel_free(struct channel *const channel)
+{
+	free(channel->fpdu);
+	channel->fpdu = NULL;
+}
@@ -46,6 +46,9 @@
 #include <pcap/pcap.h>
 #include <pcap.h>
 #include <linux/limits.h>
+#include <sys/time.h>
+
+#include "test_trace.h"
 
 /** The program version */
 #define TEST_VERSION  "RLE dump FPDUs test application, version 0.0.1\n"
@@ -89,6 +92,7 @@ static void packet_handler(pcap_dumper_t *const dumpfile,
 static void usage(void);
 static void test_interrupt(int signum);
 static void dump_buffer(const unsigned char *const buffer, const size_t buffer_length);
+static uint64_t timeval_to_ns(const struct timeval *const tv);
 static int test_encap(const char device_name[], const char output[], const size_t ppdu_size,
                       const size_t fpdu_size);
 static void dump_fpdu(unsigned char *const fpdu, const size_t fpdu_size,
@@ -120,6 +124,9 @@ static int stop_program = 0;
 /** Counter for packet processed */
 static size_t packets_counter = 0;
 
+/** The indexed trace the SDUs and FPDUs are also written to, if its file is not NULL */
+static struct trace_writer trace_out;
+
 /**
  * @brief Main function for the RLE test program
  *
@@ -135,6 +142,7 @@ int main(int argc, char *argv[])
 {
 	char *device_name = NULL;
 	char *output = NULL;
+	char *trace_output = NULL;
 	int status = EXIT_FAILURE;
 	size_t ppdu_size = DEFAULT_PPDU_SIZE;
 	size_t fpdu_size = DEFAULT_FPDU_SIZE;
@@ -148,7 +156,7 @@ int main(int argc, char *argv[])
 	while (1) {
 		int c;
 
-		const char short_options[] = "vhp:f:o:";
+		const char short_options[] = "vhp:f:o:t:";
 
 		const struct option long_options[] =
 		{
@@ -157,6 +165,7 @@ int main(int argc, char *argv[])
 			{ "ppdu_size", required_argument, NULL, 'p' },
 			{ "fpdu_size", required_argument, NULL, 'f' },
 			{ "output", required_argument, NULL, 'o' },
+			{ "trace", required_argument, NULL, 't' },
 			{ NULL, 0, NULL, 0 }
 		};
 
@@ -231,6 +240,12 @@ int main(int argc, char *argv[])
 			strncpy(output, optarg, strlen(optarg) + 1);
 			break;
 
+		case 't': /* Indexed trace output */
+			assert(optarg != NULL);
+			printf("Indexed trace set to `%s'\n", optarg);
+			trace_output = optarg;
+			break;
+
 		case 'v': /* Version */
 			printf(TEST_VERSION);
 			status = EXIT_SUCCESS;
@@ -284,9 +299,19 @@ int main(int argc, char *argv[])
 		sigaction(SIGHUP, &action, NULL);
 	}
 
+	if (trace_output != NULL) {
+		if (trace_writer_open(&trace_out, trace_output) != 0) {
+			goto error;
+		}
+	}
+
 	/* test RLE encap with the packets from the file with a given ppdu size */
 	status = test_encap(device_name, output, ppdu_size, fpdu_size);
 
+	if (trace_out.file != NULL && trace_writer_close(&trace_out) != 0) {
+		status = EXIT_FAILURE;
+	}
+
 	printf("=== exit test with code %d\n", status);
 
 error:
@@ -391,6 +416,8 @@ static void usage(void)
 	        "\t--ppdu_size, -p         Change the PPDU size (default %d octets)\n"
 	        "\t--fpdu_size, -f         Change the FPDU size (default %d octets)\n"
 	        "\t--output, -o            Change the output (default %s)\n"
+	        "\t--trace, -t             Also write the SDUs and the FPDUs in an indexed trace,\n"
+	        "\t                        that test_perfs_offline maps in memory\n"
 	        "\t--ignore-malformed      Ignore malformed packets for test\n"
 	        "\t--verbose               Run the test in verbose mode\n"
 	        "\n",
@@ -451,6 +478,17 @@ static void dump_buffer(const unsigned char *const buffer, const size_t buffer_l
 }
 
 
+/**
+ * @brief      Convert a time of day in nanoseconds
+ * @param[in]  tv  The time of day
+ * @return         The time of day in nanoseconds
+ */
+static uint64_t timeval_to_ns(const struct timeval *const tv)
+{
+	return ((uint64_t)tv->tv_sec) * 1000000000ULL + ((uint64_t)tv->tv_usec) * 1000ULL;
+}
+
+
 /**
  * IP Checksum Init
  *
@@ -569,6 +607,23 @@ static void dump_fpdu(unsigned char *const fpdu,
 		gettimeofday(&header.ts, NULL);
 		packet_handler(dumpfile, &header, frame);
 
+		if (trace_out.file != NULL) {
+			const struct trace_record record = {
+				.timestamp_ns = timeval_to_ns(&header.ts),
+				.data = fpdu,
+				.size = fpdu_size,
+				.label = NULL,
+				.label_size = 0,
+				.protocol_type = 0,
+				.frag_id = 0,
+				.flags = TRACE_RECORD_FPDU,
+			};
+
+			if (trace_writer_add(&trace_out, &record) != 0) {
+				stop_program = 1;
+			}
+		}
+
 
 		++ip_id;
 	}
@@ -634,6 +689,26 @@ static int encap(struct rle_transmitter *const transmitter,
 	printf_verbose("=== %zu-byte SDU\n", sdu_in.size);
 	dump_buffer(sdu_in.buffer, sdu_in.size);
 
+	if (trace_out.file != NULL) {
+		struct timeval now;
+		struct trace_record record;
+
+		gettimeofday(&now, NULL);
+		record.timestamp_ns = timeval_to_ns(&now);
+		record.data = sdu_in.buffer;
+		record.size = sdu_in.size;
+		record.label = NULL;
+		record.label_size = 0;
+		record.protocol_type = sdu_in.protocol_type;
+		record.frag_id = frag_id;
+		record.flags = 0;
+		if (trace_writer_add(&trace_out, &record) != 0) {
+			stop_program = 1;
+			status = -1;
+			goto exit;
+		}
+	}
+
 	/* Encapsulate the IP packet into a RLE packet */
 	printf_verbose("=== RLE encapsulation: start\n");
 	ret_encap = rle_encapsulate(transmitter, &sdu_in, frag_id);
@@ -0,0 +1,242 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_fpdu_queue.c
+ * @brief  Queue of FPDUs between a building thread and a transmitting thread.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#include "test_fpdu_queue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** The length of a cache line, the indexes of the rings are kept on their own lines */
+#define FPDU_QUEUE_CACHE_LINE 64U
+
+/** A single-producer single-consumer ring of buffer ids, the producer and consumer indexes
+ *  are free running and each one is written by one thread only. The ring has one slot per
+ *  buffer, so it never overflows. */
+struct fpdu_ring {
+	size_t tail;                                          /**< Written by the producer */
+	unsigned char pad_tail[FPDU_QUEUE_CACHE_LINE - sizeof(size_t)];
+	size_t head;                                          /**< Written by the consumer */
+	unsigned char pad_head[FPDU_QUEUE_CACHE_LINE - sizeof(size_t)];
+	size_t mask;                                          /**< The number of slots - 1 */
+	uint32_t *ids;                                        /**< The buffer ids */
+};
+
+/** The queue */
+struct fpdu_queue {
+	struct fpdu_ring ready;        /**< The FPDUs, from the builder to the transmitter */
+	struct fpdu_ring free;         /**< The free buffers, from the transmitter to the builder */
+	uint64_t pushed_nr;            /**< The number of FPDUs pushed, written by the builder */
+	uint64_t no_buf_nr;            /**< The number of buffer shortages, written by the builder */
+	unsigned char pad_builder[FPDU_QUEUE_CACHE_LINE - 2 * sizeof(uint64_t)];
+	uint64_t popped_nr;            /**< The number of FPDUs popped, written by the transmitter */
+	uint64_t empty_nr;             /**< The number of empty pops, written by the transmitter */
+	unsigned char pad_io[FPDU_QUEUE_CACHE_LINE - 2 * sizeof(uint64_t)];
+	size_t buf_size;               /**< The size of the buffers */
+	struct fpdu_buf *bufs;         /**< The descriptors of the buffers */
+	unsigned char *data;           /**< The memory of all the buffers */
+};
+
+/* prototypes of private functions */
+static int fpdu_ring_init(struct fpdu_ring *const ring, const size_t len);
+static int fpdu_ring_get(struct fpdu_ring *const ring, uint32_t *const id);
+static void fpdu_ring_put(struct fpdu_ring *const ring, const uint32_t id);
+
+
+/**
+ * @brief  Allocate the slots of a ring
+ *
+ * @param[out] ring  The ring
+ * @param[in]  len   The number of slots, a power of 2
+ * @return           0 in case of success, -1 otherwise
+ */
+static int fpdu_ring_init(struct fpdu_ring *const ring, const size_t len)
+{
+	ring->tail = 0;
+	ring->head = 0;
+	ring->mask = len - 1;
+	ring->ids = malloc(len * sizeof(uint32_t));
+
+	return ring->ids == NULL ? -1 : 0;
+}
+
+/**
+ * @brief  Take the oldest buffer id of a ring, by its consumer
+ *
+ * @param[in,out] ring  The ring
+ * @param[out]    id    The buffer id
+ * @return              1 if an id is returned, 0 if the ring is empty
+ */
+static int fpdu_ring_get(struct fpdu_ring *const ring, uint32_t *const id)
+{
+	const size_t head = ring->head;
+
+	if (head == __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE)) {
+		return 0;
+	}
+	*id = ring->ids[head & ring->mask];
+	__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+
+	return 1;
+}
+
+/**
+ * @brief  Add a buffer id to a ring, by its producer
+ *
+ * @param[in,out] ring  The ring
+ * @param[in]     id    The buffer id
+ */
+static void fpdu_ring_put(struct fpdu_ring *const ring, const uint32_t id)
+{
+	const size_t tail = ring->tail;
+
+	ring->ids[tail & ring->mask] = id;
+	__atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+struct fpdu_queue * fpdu_queue_new(const size_t bufs_nr, const size_t buf_size)
+{
+	struct fpdu_queue *queue;
+	size_t i;
+
+	if (bufs_nr < 2 || (bufs_nr & (bufs_nr - 1)) != 0 || bufs_nr > UINT32_MAX ||
+	    buf_size == 0) {
+		fprintf(stderr, "invalid configuration of the FPDU queue\n");
+		goto error;
+	}
+
+	if (posix_memalign((void **)&queue, FPDU_QUEUE_CACHE_LINE,
+	                   sizeof(struct fpdu_queue)) != 0) {
+		goto error;
+	}
+	memset(queue, 0, sizeof(struct fpdu_queue));
+	queue->buf_size = buf_size;
+	queue->bufs = calloc(bufs_nr, sizeof(struct fpdu_buf));
+	if (queue->bufs == NULL ||
+	    posix_memalign((void **)&queue->data, FPDU_QUEUE_CACHE_LINE, bufs_nr * buf_size) != 0) {
+		queue->data = NULL;
+		goto destroy;
+	}
+	if (fpdu_ring_init(&queue->ready, bufs_nr) != 0 ||
+	    fpdu_ring_init(&queue->free, bufs_nr) != 0) {
+		goto destroy;
+	}
+
+	/* all the buffers are free */
+	for (i = 0; i < bufs_nr; i++) {
+		queue->bufs[i].data = queue->data + i * buf_size;
+		queue->bufs[i].id = i;
+		fpdu_ring_put(&queue->free, i);
+	}
+
+	return queue;
+
+destroy:
+	fpdu_queue_destroy(queue);
+error:
+	return NULL;
+}
+
+void fpdu_queue_destroy(struct fpdu_queue *const queue)
+{
+	free(queue->ready.ids);
+	free(queue->free.ids);
+	free(queue->data);
+	free(queue->bufs);
+	free(queue);
+}
+
+struct fpdu_buf * fpdu_queue_start(struct fpdu_queue *const queue, const size_t size,
+                                   const unsigned char *const label, const size_t label_size)
+{
+	struct fpdu_buf *buf;
+	uint32_t id;
+
+	if (size > queue->buf_size) {
+		return NULL;
+	}
+	if (!fpdu_ring_get(&queue->free, &id)) {
+		__atomic_store_n(&queue->no_buf_nr, queue->no_buf_nr + 1, __ATOMIC_RELAXED);
+		return NULL;
+	}
+
+	buf = &queue->bufs[id];
+	buf->size = size;
+	buf->cur_pos = 0;
+	buf->remain_size = size;
+	if (label_size > 0 &&
+	    rle_pack_init(label, label_size, buf->data, &buf->cur_pos,
+	                  &buf->remain_size) != RLE_PACK_OK) {
+		/* give the buffer back: the builder is the consumer of the free ring, and the
+		 * slot cannot be reused before since the ring has one slot per buffer */
+		__atomic_store_n(&queue->free.head, queue->free.head - 1, __ATOMIC_RELEASE);
+		return NULL;
+	}
+
+	return buf;
+}
+
+enum rle_pack_status fpdu_buf_pack(struct fpdu_buf *const buf, const unsigned char *const ppdu,
+                                   const size_t ppdu_length)
+{
+	return rle_pack(ppdu, ppdu_length, NULL, 0, buf->data, &buf->cur_pos, &buf->remain_size);
+}
+
+void fpdu_queue_push(struct fpdu_queue *const queue, struct fpdu_buf *const buf)
+{
+	rle_pad(buf->data, buf->cur_pos, buf->remain_size);
+	fpdu_ring_put(&queue->ready, buf->id);
+	__atomic_store_n(&queue->pushed_nr, queue->pushed_nr + 1, __ATOMIC_RELAXED);
+}
+
+const struct fpdu_buf * fpdu_queue_pop(struct fpdu_queue *const queue)
+{
+	uint32_t id;
+
+	if (!fpdu_ring_get(&queue->ready, &id)) {
+		__atomic_store_n(&queue->empty_nr, queue->empty_nr + 1, __ATOMIC_RELAXED);
+		return NULL;
+	}
+	__atomic_store_n(&queue->popped_nr, queue->popped_nr + 1, __ATOMIC_RELAXED);
+
+	return &queue->bufs[id];
+}
+
+void fpdu_queue_recycle(struct fpdu_queue *const queue, const struct fpdu_buf *const buf)
+{
+	fpdu_ring_put(&queue->free, buf->id);
+}
+
+void fpdu_queue_get_stats(const struct fpdu_queue *const queue,
+                          struct fpdu_queue_stats *const stats)
+{
+	stats->pushed_nr = __atomic_load_n(&queue->pushed_nr, __ATOMIC_RELAXED);
+	stats->no_buf_nr = __atomic_load_n(&queue->no_buf_nr, __ATOMIC_RELAXED);
+	stats->popped_nr = __atomic_load_n(&queue->popped_nr, __ATOMIC_RELAXED);
+	stats->empty_nr = __atomic_load_n(&queue->empty_nr, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,289 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_packet_ring.c
+ * @brief  Ingest of the Ethernet frames of a network port through an AF_PACKET ring.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#include "test_packet_ring.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+
+/** The default number of blocks of a ring */
+#define PACKET_RING_DEFAULT_BLOCKS_NR 8U
+
+/** The default size of the blocks, 1 MiB */
+#define PACKET_RING_DEFAULT_BLOCK_SIZE (1U << 20)
+
+/** The default maximal size of a frame and its ring header */
+#define PACKET_RING_DEFAULT_FRAME_SIZE 4096U
+
+/** The default delay before a block that is not full is handed over */
+#define PACKET_RING_DEFAULT_TIMEOUT_MS 1U
+
+/** The length of the MAC addresses of an Ethernet header */
+#define PACKET_RING_ETH_ADDRS_LEN 12U
+
+/** The length of a VLAN tag */
+#define PACKET_RING_VLAN_TAG_LEN 4U
+
+/** The ring */
+struct packet_ring {
+	int fd;                            /**< The AF_PACKET socket */
+	unsigned char *map;                /**< The blocks mapped from the kernel */
+	size_t map_len;                    /**< The length of the mapping */
+	size_t blocks_nr;                  /**< The number of blocks */
+	size_t block_size;                 /**< The size of the blocks */
+	size_t block_id;                   /**< The next block to read */
+	unsigned char *vlan_buf;           /**< The frame rebuilt with its VLAN tag */
+	size_t vlan_buf_len;               /**< The length of the VLAN buffer */
+	struct packet_ring_stats stats;    /**< The statistics of the ring */
+};
+
+
+void packet_ring_conf_init(struct packet_ring_conf *const conf)
+{
+	conf->blocks_nr = PACKET_RING_DEFAULT_BLOCKS_NR;
+	conf->block_size = PACKET_RING_DEFAULT_BLOCK_SIZE;
+	conf->frame_size = PACKET_RING_DEFAULT_FRAME_SIZE;
+	conf->timeout_ms = PACKET_RING_DEFAULT_TIMEOUT_MS;
+	conf->promisc = 1;
+}
+
+struct packet_ring * packet_ring_open(const char *const ifname,
+                                      const struct packet_ring_conf *const conf)
+{
+	const int version = TPACKET_V3;
+	const int ignore_outgoing = 1;
+	struct packet_ring *ring;
+	struct tpacket_req3 req;
+	struct sockaddr_ll addr;
+	unsigned int ifindex;
+
+	ifindex = if_nametoindex(ifname);
+	if (ifindex == 0) {
+		perror("failed to find the port");
+		goto error;
+	}
+	if (conf->blocks_nr == 0 || conf->frame_size < TPACKET_ALIGNMENT ||
+	    conf->block_size < conf->frame_size ||
+	    (conf->block_size % (size_t) getpagesize()) != 0) {
+		fprintf(stderr, "invalid configuration of the packet ring\n");
+		goto error;
+	}
+
+	ring = calloc(1, sizeof(struct packet_ring));
+	if (ring == NULL) {
+		goto error;
+	}
+	ring->fd = -1;
+	ring->map = MAP_FAILED;
+	ring->blocks_nr = conf->blocks_nr;
+	ring->block_size = conf->block_size;
+	ring->vlan_buf_len = conf->frame_size + PACKET_RING_VLAN_TAG_LEN;
+	ring->vlan_buf = malloc(ring->vlan_buf_len);
+	if (ring->vlan_buf == NULL) {
+		goto close_ring;
+	}
+
+	ring->fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+	if (ring->fd < 0) {
+		perror("failed to create the AF_PACKET socket");
+		goto close_ring;
+	}
+	if (setsockopt(ring->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(int)) != 0) {
+		perror("failed to use TPACKET_V3");
+		goto close_ring;
+	}
+	/* the frames sent back to the port shall not be ingested again, best effort since old
+	 * kernels do not know the option: the outgoing frames are also skipped when read */
+	setsockopt(ring->fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &ignore_outgoing, sizeof(int));
+
+	memset(&req, 0, sizeof(struct tpacket_req3));
+	req.tp_block_size = conf->block_size;
+	req.tp_block_nr = conf->blocks_nr;
+	req.tp_frame_size = conf->frame_size;
+	req.tp_frame_nr = (conf->block_size / conf->frame_size) * conf->blocks_nr;
+	req.tp_retire_blk_tov = conf->timeout_ms;
+	if (setsockopt(ring->fd, SOL_PACKET, PACKET_RX_RING, &req,
+	               sizeof(struct tpacket_req3)) != 0) {
+		perror("failed to create the packet ring");
+		goto close_ring;
+	}
+	ring->map_len = conf->block_size * conf->blocks_nr;
+	ring->map = mmap(NULL, ring->map_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED,
+	                 ring->fd, 0);
+	if (ring->map == MAP_FAILED) {
+		/* locking the ring in memory is an optimization only */
+		ring->map = mmap(NULL, ring->map_len, PROT_READ | PROT_WRITE, MAP_SHARED, ring->fd, 0);
+		if (ring->map == MAP_FAILED) {
+			perror("failed to map the packet ring");
+			goto close_ring;
+		}
+	}
+
+	memset(&addr, 0, sizeof(struct sockaddr_ll));
+	addr.sll_family = AF_PACKET;
+	addr.sll_protocol = htons(ETH_P_ALL);
+	addr.sll_ifindex = ifindex;
+	if (bind(ring->fd, (const struct sockaddr *)&addr, sizeof(struct sockaddr_ll)) != 0) {
+		perror("failed to bind the AF_PACKET socket to the port");
+		goto close_ring;
+	}
+	if (conf->promisc) {
+		struct packet_mreq mreq;
+
+		memset(&mreq, 0, sizeof(struct packet_mreq));
+		mreq.mr_ifindex = ifindex;
+		mreq.mr_type = PACKET_MR_PROMISC;
+		if (setsockopt(ring->fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq,
+		               sizeof(struct packet_mreq)) != 0) {
+			perror("failed to put the port in promiscuous mode");
+			goto close_ring;
+		}
+	}
+
+	return ring;
+
+close_ring:
+	packet_ring_close(ring);
+error:
+	return NULL;
+}
+
+void packet_ring_close(struct packet_ring *const ring)
+{
+	if (ring->map != MAP_FAILED) {
+		munmap(ring->map, ring->map_len);
+	}
+	if (ring->fd >= 0) {
+		close(ring->fd);
+	}
+	free(ring->vlan_buf);
+	free(ring);
+}
+
+int packet_ring_get_fd(const struct packet_ring *const ring)
+{
+	return ring->fd;
+}
+
+int packet_ring_read(struct packet_ring *const ring, const packet_ring_frame_t frame_cb,
+                     void *const arg)
+{
+	int frames_nr = 0;
+
+	while (1) {
+		struct tpacket_block_desc *const block =
+			(struct tpacket_block_desc *)(ring->map + ring->block_id * ring->block_size);
+		const struct tpacket3_hdr *hdr;
+		uint32_t pkts_nr;
+		uint32_t i;
+		int stop = 0;
+
+		/* the kernel writes the whole block before it hands it over */
+		if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) &
+		     TP_STATUS_USER) == 0) {
+			break;
+		}
+
+		pkts_nr = block->hdr.bh1.num_pkts;
+		hdr = (const struct tpacket3_hdr *)((unsigned char *)block +
+		                                    block->hdr.bh1.offset_to_first_pkt);
+		for (i = 0; i < pkts_nr && !stop; i++) {
+			const struct sockaddr_ll *const addr = (const struct sockaddr_ll *)
+				((const unsigned char *)hdr + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+			const unsigned char *frame = (const unsigned char *)hdr + hdr->tp_mac;
+			size_t len = hdr->tp_snaplen;
+
+			if (addr->sll_pkttype == PACKET_OUTGOING) {
+				/* sent on the socket */
+			} else if (hdr->tp_snaplen != hdr->tp_len || len < PACKET_RING_ETH_ADDRS_LEN ||
+			           len + PACKET_RING_VLAN_TAG_LEN > ring->vlan_buf_len) {
+				ring->stats.truncated_nr++;
+			} else {
+				if ((hdr->tp_status & TP_STATUS_VLAN_VALID) != 0) {
+					/* the kernel stripped the VLAN tag of the frame, put it back
+					 * between the MAC addresses and the EtherType */
+					const uint16_t tpid = (hdr->tp_status & TP_STATUS_VLAN_TPID_VALID) != 0 ?
+					                      hdr->hv1.tp_vlan_tpid : ETH_P_8021Q;
+					const uint16_t tci = hdr->hv1.tp_vlan_tci;
+					unsigned char *const tag = ring->vlan_buf + PACKET_RING_ETH_ADDRS_LEN;
+
+					memcpy(ring->vlan_buf, frame, PACKET_RING_ETH_ADDRS_LEN);
+					tag[0] = tpid >> 8;
+					tag[1] = tpid & 0xff;
+					tag[2] = tci >> 8;
+					tag[3] = tci & 0xff;
+					memcpy(tag + PACKET_RING_VLAN_TAG_LEN, frame + PACKET_RING_ETH_ADDRS_LEN,
+					       len - PACKET_RING_ETH_ADDRS_LEN);
+					frame = ring->vlan_buf;
+					len += PACKET_RING_VLAN_TAG_LEN;
+					ring->stats.vlan_nr++;
+				}
+				if ((hdr->tp_status & TP_STATUS_CSUMNOTREADY) != 0) {
+					ring->stats.csum_partial_nr++;
+				}
+				ring->stats.frames_nr++;
+				frames_nr++;
+				stop = frame_cb(arg, frame, len);
+			}
+			hdr = (const struct tpacket3_hdr *)((const unsigned char *)hdr +
+			                                    hdr->tp_next_offset);
+		}
+
+		/* give the block back to the kernel */
+		__atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+		ring->block_id = (ring->block_id + 1) % ring->blocks_nr;
+		ring->stats.blocks_nr++;
+		if (stop) {
+			return -1;
+		}
+	}
+
+	return frames_nr;
+}
+
+void packet_ring_get_stats(struct packet_ring *const ring, struct packet_ring_stats *const stats)
+{
+	struct tpacket_stats_v3 kernel_stats;
+	socklen_t len = sizeof(struct tpacket_stats_v3);
+
+	/* the kernel resets its counters once read */
+	if (getsockopt(ring->fd, SOL_PACKET, PACKET_STATISTICS, &kernel_stats, &len) == 0) {
+		ring->stats.kernel_nr += kernel_stats.tp_packets;
+		ring->stats.drops_nr += kernel_stats.tp_drops;
+		ring->stats.freezes_nr += kernel_stats.tp_freeze_q_cnt;
+	}
+	memcpy(stats, &ring->stats, sizeof(struct packet_ring_stats));
+}
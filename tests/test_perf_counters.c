@@ -0,0 +1,151 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perf_counters.c
+ * @brief  Hardware performance counters shared by the performances tools.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#include "test_perf_counters.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/** The perf type and config of every counter */
+static const struct {
+	uint32_t type;
+	uint64_t config;
+	const char *name;
+} perf_counters_desc[PERF_COUNTERS_NR] = {
+	[PERF_COUNTER_CYCLES] = {
+		PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles"
+	},
+	[PERF_COUNTER_INSTRUCTIONS] = {
+		PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions"
+	},
+	[PERF_COUNTER_L1D_MISSES] = {
+		PERF_TYPE_HW_CACHE,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+		(PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+		"l1d_misses"
+	},
+	[PERF_COUNTER_LLC_MISSES] = {
+		PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "llc_misses"
+	},
+	[PERF_COUNTER_BRANCH_MISSES] = {
+		PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch_misses"
+	},
+};
+
+int perf_counters_open(struct perf_counters *const counters)
+{
+	int available_nr = 0;
+	int id;
+
+	for (id = 0; id < PERF_COUNTERS_NR; id++) {
+		struct perf_event_attr attr;
+
+		memset(&attr, 0, sizeof(struct perf_event_attr));
+		attr.size = sizeof(struct perf_event_attr);
+		attr.type = perf_counters_desc[id].type;
+		attr.config = perf_counters_desc[id].config;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		counters->fds[id] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+		counters->values[id] = 0;
+		if (counters->fds[id] >= 0) {
+			available_nr++;
+		}
+	}
+
+	return available_nr;
+}
+
+void perf_counters_close(struct perf_counters *const counters)
+{
+	int id;
+
+	for (id = 0; id < PERF_COUNTERS_NR; id++) {
+		if (counters->fds[id] >= 0) {
+			close(counters->fds[id]);
+			counters->fds[id] = -1;
+		}
+	}
+}
+
+void perf_counters_start(struct perf_counters *const counters)
+{
+	int id;
+
+	for (id = 0; id < PERF_COUNTERS_NR; id++) {
+		if (counters->fds[id] >= 0) {
+			ioctl(counters->fds[id], PERF_EVENT_IOC_RESET, 0);
+			ioctl(counters->fds[id], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+}
+
+void perf_counters_stop(struct perf_counters *const counters)
+{
+	int id;
+
+	for (id = 0; id < PERF_COUNTERS_NR; id++) {
+		if (counters->fds[id] >= 0) {
+			ioctl(counters->fds[id], PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+
+	for (id = 0; id < PERF_COUNTERS_NR; id++) {
+		/* value, time enabled, time running */
+		uint64_t data[3];
+
+		counters->values[id] = 0;
+		if (counters->fds[id] < 0 ||
+		    read(counters->fds[id], data, sizeof(data)) != sizeof(data)) {
+			continue;
+		}
+		if (data[2] != 0 && data[2] < data[1]) {
+			/* the counter was multiplexed, extrapolate to the whole duration */
+			counters->values[id] = (uint64_t)((double)data[0] * data[1] / data[2]);
+		} else {
+			counters->values[id] = data[0];
+		}
+	}
+}
+
+bool perf_counters_is_available(const struct perf_counters *const counters,
+                                const enum perf_counter_id id)
+{
+	return (counters->fds[id] >= 0);
+}
+
+const char * perf_counters_get_name(const enum perf_counter_id id)
+{
+	return perf_counters_desc[id].name;
+}
@@ -0,0 +1,765 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_channel.c
+ * @brief  Measure the RLE goodput and CPU cost through a lossy channel.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* system includes */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <getopt.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "rle.h"
+#include "rle_receiver.h"
+#include "test_traffic_gen.h"
+#include "test_trace.h"
+#include "test_channel.h"
+
+/** The program version */
+#define TEST_VERSION  "RLE lossy channel performances test application, version 0.0.1\n"
+
+/** Min and max burst sizes for fragmentation in the test. */
+#define MIN_BURST_SIZE 14
+#define MAX_BURST_SIZE 599
+
+/** The maximum number of burst sizes that may be given on command line */
+#define MAX_BURST_SIZES_NR 8
+
+/** The default number of SDUs of the synthetic traffic */
+#define DEFAULT_SDUS_NR 100000U
+
+/** The default number of FPDUs a reordered FPDU is delivered after */
+#define DEFAULT_REORDER_DEPTH 3U
+
+/** The length of the SDU buffers given to the receiver (room for VLAN ptype re-insertion) */
+#define SDU_BUF_LEN  (RLE_MAX_PDU_SIZE + 4U)
+
+/** The length of the SDU index written at the end of every SDU */
+#define SDU_ID_LEN 4U
+
+/** The FPDUs built by the transmitter */
+struct fpdus {
+	unsigned char *data;  /**< All the FPDUs */
+	size_t fpdu_size;     /**< The size of one FPDU */
+	size_t max_nr;        /**< The number of FPDUs that may be stored */
+	size_t nr;            /**< The number of FPDUs completed */
+	size_t cur_pos;       /**< The current position in the current FPDU */
+	size_t remain_size;   /**< The remaining size in the current FPDU */
+};
+
+/** The result of one run through the channel */
+struct channel_result {
+	uint64_t enc_cycles;        /**< The CPU cycles spent to build the FPDUs */
+	uint64_t dec_cycles;        /**< The CPU cycles spent in rle_decapsulate() */
+	uint64_t fpdus_nr;          /**< The number of FPDUs received */
+	uint64_t decap_errors_nr;   /**< The number of FPDUs rle_decapsulate() reported errors for */
+	uint64_t sdus_ok_nr;        /**< The number of distinct SDUs delivered intact */
+	uint64_t sdus_ok_bytes;     /**< The number of bytes of the SDUs delivered intact */
+	uint64_t sdus_corrupted_nr; /**< The number of SDUs delivered with a wrong content */
+	uint64_t sdus_duplicated_nr; /**< The number of intact SDUs delivered more than once */
+	uint64_t ctx_busy_sum;      /**< The sum of the busy reassembly contexts after every FPDU */
+	unsigned int ctx_busy_max;  /**< The maximal number of busy reassembly contexts */
+	uint64_t counted_lost_nr;   /**< The SDUs lost according to the receiver */
+	uint64_t counted_dropped_nr; /**< The SDUs dropped according to the receiver */
+};
+
+/** The context of the receiver at the output of the channel */
+struct rx_ctx {
+	struct rle_receiver *receiver;   /**< The receiver */
+	struct rle_sdu *sdus;            /**< The SDUs given to rle_decapsulate() */
+	size_t sdus_max_nr;              /**< The number of SDUs given to rle_decapsulate() */
+	const struct traffic *traffic;   /**< The traffic sent */
+	uint8_t *delivered;              /**< Whether every SDU sent was already delivered */
+	struct channel_result *result;   /**< The result of the run */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static uint64_t get_cycles(void);
+static int build_fpdus(const struct rle_config *const conf,
+                       const struct traffic *const traffic,
+                       struct fpdus *const fpdus,
+                       uint64_t *const cycles);
+static int receive_fpdu(void *const arg, const unsigned char *const fpdu,
+                        const size_t fpdu_len);
+static int run_channel(const struct rle_config *const conf,
+                       const struct channel_conf *const channel_conf,
+                       const struct traffic *const traffic,
+                       const size_t burst_size,
+                       struct channel_result *const result);
+static void print_result(const struct rle_config *const conf,
+                         const size_t burst_size,
+                         const struct traffic *const traffic,
+                         const struct channel_result *const result);
+static int test_perfs_channel(const struct traffic *const traffic,
+                              const struct channel_conf *const channel_conf,
+                              const size_t *const burst_sizes,
+                              const size_t burst_sizes_nr);
+
+/** Whether the application runs in verbose mode or not */
+static int is_verbose = 0;
+
+#define TRACE(x ...) do { \
+		if (is_verbose) { printf(x); } \
+} while (0)
+
+
+/**
+ * @brief Main function for the RLE lossy channel performances test program
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	size_t burst_sizes[MAX_BURST_SIZES_NR] = { MAX_BURST_SIZE };
+	size_t burst_sizes_nr = 1;
+	bool burst_sizes_given = false;
+	size_t sdus_nr = DEFAULT_SDUS_NR;
+	struct traffic_gen_conf gen_conf;
+	struct channel_conf channel_conf = {
+		.loss_rate = 0,
+		.bit_error_rate = 0,
+		.dup_rate = 0,
+		.reorder_rate = 0,
+		.reorder_depth = DEFAULT_REORDER_DEPTH,
+		.seed = 0,
+	};
+	struct traffic traffic;
+	struct trace trace;
+	size_t i;
+
+	traffic_gen_conf_init(&gen_conf);
+	memset(&trace, 0, sizeof(struct trace));
+
+	while (1) {
+		int c;
+
+		static struct option long_options[] =
+		{
+			{ "verbose", no_argument, &is_verbose, 1 },
+			{ "count", required_argument, 0, 'n' },
+			{ "sizes", required_argument, 0, 'S' },
+			{ "ptypes", required_argument, 0, 'p' },
+			{ "flows", required_argument, 0, 'f' },
+			{ "seed", required_argument, 0, 'r' },
+			{ "burst_size", required_argument, 0, 'b' },
+			{ "loss", required_argument, 0, 'l' },
+			{ "ber", required_argument, 0, 'e' },
+			{ "dup", required_argument, 0, 'D' },
+			{ "reorder", required_argument, 0, 'o' },
+			{ "reorder_depth", required_argument, 0, 'k' },
+			{ "channel_seed", required_argument, 0, 'c' },
+			{ 0, 0, 0, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, "vhn:S:p:f:r:b:l:e:D:o:k:c:", long_options,
+		                &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 0:
+			/* If this option set a flag, do nothing else now. */
+			break;
+		case 'n': /* Number of SDUs */
+			assert(optarg != NULL);
+			sdus_nr = strtoul(optarg, NULL, 10);
+			if (sdus_nr == 0) {
+				printf("ERROR: at least one SDU is required\n");
+				goto error;
+			}
+			break;
+		case 'S': /* Size distribution */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_sizes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'p': /* Protocol types mix */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_ptypes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'f': /* Number of flows */
+			assert(optarg != NULL);
+			gen_conf.flows_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'r': /* Seed of the traffic */
+			assert(optarg != NULL);
+			gen_conf.seed = strtoul(optarg, NULL, 10);
+			break;
+		case 'b': /* Burst Size */
+		{
+			size_t burst_size;
+
+			assert(optarg != NULL);
+			burst_size = strtoul(optarg, NULL, 10);
+
+			if (burst_size < MIN_BURST_SIZE || burst_size > MAX_BURST_SIZE) {
+				printf("ERROR: %zu burst size shall be within [%d ; %d] octets.\n",
+				       burst_size, MIN_BURST_SIZE, MAX_BURST_SIZE);
+				goto error;
+			}
+			if (!burst_sizes_given) {
+				burst_sizes_given = true;
+				burst_sizes_nr = 0;
+			}
+			if (burst_sizes_nr >= MAX_BURST_SIZES_NR) {
+				printf("ERROR: too many burst sizes. Maximum = %d.\n", MAX_BURST_SIZES_NR);
+				goto error;
+			}
+			burst_sizes[burst_sizes_nr++] = burst_size;
+			break;
+		}
+		case 'l': /* FPDU loss rate */
+			assert(optarg != NULL);
+			channel_conf.loss_rate = strtod(optarg, NULL);
+			break;
+		case 'e': /* Bit error rate */
+			assert(optarg != NULL);
+			channel_conf.bit_error_rate = strtod(optarg, NULL);
+			break;
+		case 'D': /* FPDU duplication rate */
+			assert(optarg != NULL);
+			channel_conf.dup_rate = strtod(optarg, NULL);
+			break;
+		case 'o': /* FPDU reordering rate */
+			assert(optarg != NULL);
+			channel_conf.reorder_rate = strtod(optarg, NULL);
+			break;
+		case 'k': /* FPDU reordering depth */
+			assert(optarg != NULL);
+			channel_conf.reorder_depth = strtoul(optarg, NULL, 10);
+			break;
+		case 'c': /* Seed of the channel */
+			assert(optarg != NULL);
+			channel_conf.seed = strtoul(optarg, NULL, 10);
+			break;
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (channel_conf.loss_rate < 0 || channel_conf.loss_rate > 1 ||
+	    channel_conf.bit_error_rate < 0 || channel_conf.bit_error_rate > 1 ||
+	    channel_conf.dup_rate < 0 || channel_conf.dup_rate > 1 ||
+	    channel_conf.reorder_rate < 0 || channel_conf.reorder_rate > 1) {
+		printf("ERROR: rates shall be within [0 ; 1]\n");
+		goto error;
+	}
+
+	if (optind == argc) {
+		printf("=== initialization:\n");
+		if (traffic_gen(&gen_conf, sdus_nr, 0, &traffic) != 0) {
+			goto error;
+		}
+		printf("===\t%zu synthetic packets generated (seed %u)\n", traffic.sdus_nr,
+		       gen_conf.seed);
+	} else if (optind == argc - 1) {
+		printf("=== initialization:\n");
+		status = traffic_read(argv[optind], &traffic);
+		if (status == 1) {
+			/* not a compact trace file, try an indexed one */
+			status = trace_open(argv[optind], &trace);
+			if (status == 0 && trace_to_traffic(&trace, &traffic) != 0) {
+				trace_close(&trace);
+				status = -1;
+			}
+		}
+		if (status != 0) {
+			printf("failed to read trace file '%s'\n", argv[optind]);
+			status = EXIT_FAILURE;
+			goto error;
+		}
+		printf("===\t%zu packets loaded from trace %s\n", traffic.sdus_nr, argv[optind]);
+	} else {
+		usage();
+		goto error;
+	}
+
+	/* write the index of every SDU at its end, to recognize it at the output */
+	for (i = 0; i < traffic.sdus_nr; i++) {
+		struct traffic_sdu *const sdu = &traffic.sdus[i];
+
+		if (sdu->size < SDU_ID_LEN) {
+			printf("SDU #%zu is too short (%u bytes) to be tracked\n", i + 1, sdu->size);
+			goto free_traffic;
+		}
+		sdu->data[sdu->size - 4] = (i >> 24) & 0xff;
+		sdu->data[sdu->size - 3] = (i >> 16) & 0xff;
+		sdu->data[sdu->size - 2] = (i >> 8) & 0xff;
+		sdu->data[sdu->size - 1] = i & 0xff;
+	}
+
+	status = test_perfs_channel(&traffic, &channel_conf, burst_sizes, burst_sizes_nr);
+
+	printf("=== exit test with code %d\n", status);
+free_traffic:
+	traffic_free(&traffic);
+	trace_close(&trace);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the lossy channel performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE lossy channel performances test tool: measure the RLE goodput, the loss\n"
+	        "accounting and the CPU cost when the FPDUs go through an impaired channel.\n"
+	        "\n"
+	        "usage: test_perfs_channel [OPTIONS] [TRACE]\n"
+	        "\n"
+	        "with:\n"
+	        "  TRACE                   A compact or indexed trace file written by\n"
+	        "                          test_traffic_gen, synthetic traffic is generated if\n"
+	        "                          not given\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --count, -n             Number of synthetic SDUs (default 100000)\n"
+	        "  --sizes, -S             Size distribution of the synthetic traffic (default\n"
+	        "                          'imix'), see test_traffic_gen\n"
+	        "  --ptypes, -p            Protocol types mix of the synthetic traffic (default\n"
+	        "                          'ipv4'), see test_traffic_gen\n"
+	        "  --flows, -f             Number of flows (frag_ids) of the synthetic traffic\n"
+	        "                          (default 1)\n"
+	        "  --seed, -r              Seed of the synthetic traffic (default 0)\n"
+	        "  --burst_size, -b        Add a burst size to test (default 599 octets), may be\n"
+	        "                          given several times\n"
+	        "  --loss, -l              Probability that an FPDU is lost (default 0)\n"
+	        "  --ber, -e               Probability that a bit is flipped (default 0)\n"
+	        "  --dup, -D               Probability that an FPDU is duplicated (default 0)\n"
+	        "  --reorder, -o           Probability that an FPDU is delayed (default 0)\n"
+	        "  --reorder_depth, -k     Number of FPDUs a delayed FPDU is delivered after\n"
+	        "                          (default 3)\n"
+	        "  --channel_seed, -c      Seed of the channel (default 0)\n"
+	        "  --verbose               Run the test in verbose mode\n");
+
+	return;
+}
+
+
+/**
+ * @brief  Get the CPU timestamp counter
+ *
+ * @return the current number of CPU cycles, 0 if not available on the architecture
+ */
+static uint64_t get_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+
+/**
+ * @brief Encapsulate, fragment and pack the whole traffic in FPDUs
+ *
+ * @param[in]     conf     The RLE configuration
+ * @param[in]     traffic  The traffic to encapsulate
+ * @param[in,out] fpdus    The FPDUs, allocated by the function
+ * @param[out]    cycles   The CPU cycles spent in the library
+ * @return                 0 in case of success, 1 otherwise
+ */
+static int build_fpdus(const struct rle_config *const conf,
+                       const struct traffic *const traffic,
+                       struct fpdus *const fpdus,
+                       uint64_t *const cycles)
+{
+	struct rle_transmitter *transmitter;
+	uint64_t start_cycles;
+	size_t pkt_id;
+	int status = 1;
+
+	/* every FPDU carries at least (FPDU size - 4) bytes of an ALPDU that is at most 6 bytes
+	 * larger than its SDU, plus one FPDU that may be left too short for the first PPDU */
+	fpdus->max_nr = 1;
+	for (pkt_id = 0; pkt_id < traffic->sdus_nr; pkt_id++) {
+		fpdus->max_nr += (traffic->sdus[pkt_id].size + 6) / (fpdus->fpdu_size - 4) + 2;
+	}
+	fpdus->data = calloc(fpdus->max_nr, fpdus->fpdu_size);
+	if (fpdus->data == NULL) {
+		printf("failed to allocate %zu FPDUs\n", fpdus->max_nr);
+		goto error;
+	}
+	fpdus->nr = 0;
+	fpdus->cur_pos = 0;
+	fpdus->remain_size = fpdus->fpdu_size;
+
+	transmitter = rle_transmitter_new(conf);
+	if (transmitter == NULL) {
+		printf("failed to create the transmitter.\n");
+		goto error;
+	}
+
+	start_cycles = get_cycles();
+	for (pkt_id = 0; pkt_id < traffic->sdus_nr; pkt_id++) {
+		const struct traffic_sdu *const sdu = &traffic->sdus[pkt_id];
+		struct rle_sdu sdu_in;
+
+		sdu_in.buffer = sdu->data;
+		sdu_in.size = sdu->size;
+		sdu_in.protocol_type = sdu->protocol_type;
+
+		if (rle_encapsulate(transmitter, &sdu_in, sdu->frag_id) != RLE_ENCAP_OK) {
+			printf("failed to encapsulate SDU #%zu\n", pkt_id + 1);
+			goto destroy;
+		}
+
+		while (rle_transmitter_stats_get_queue_size(transmitter, sdu->frag_id) != 0) {
+			unsigned char *const fpdu = fpdus->data + fpdus->nr * fpdus->fpdu_size;
+			enum rle_frag_status ret_frag;
+			unsigned char *ppdu;
+			size_t ppdu_length = 0;
+
+			ret_frag = rle_fragment(transmitter, sdu->frag_id, fpdus->remain_size, &ppdu,
+			                        &ppdu_length);
+			if (ret_frag == RLE_FRAG_OK) {
+				if (rle_pack(ppdu, ppdu_length, NULL, 0, fpdu, &fpdus->cur_pos,
+				             &fpdus->remain_size) != RLE_PACK_OK) {
+					printf("failed to pack SDU #%zu\n", pkt_id + 1);
+					goto destroy;
+				}
+				continue;
+			}
+			if (ret_frag != RLE_FRAG_ERR_BURST_TOO_SMALL || fpdus->cur_pos == 0) {
+				printf("failed to fragment SDU #%zu\n", pkt_id + 1);
+				goto destroy;
+			}
+			/* not enough room for a PPDU in the current FPDU, use the next one */
+			rle_pad(fpdu, fpdus->cur_pos, fpdus->remain_size);
+			fpdus->nr++;
+			fpdus->cur_pos = 0;
+			fpdus->remain_size = fpdus->fpdu_size;
+			if (fpdus->nr >= fpdus->max_nr) {
+				printf("too few FPDUs to store the traffic\n");
+				goto destroy;
+			}
+		}
+	}
+	if (fpdus->cur_pos != 0) {
+		rle_pad(fpdus->data + fpdus->nr * fpdus->fpdu_size, fpdus->cur_pos, fpdus->remain_size);
+		fpdus->nr++;
+	}
+	*cycles = get_cycles() - start_cycles;
+
+	status = 0;
+
+destroy:
+	rle_transmitter_destroy(&transmitter);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Decapsulate one FPDU at the output of the channel, then check its SDUs
+ *
+ * @param[in,out] arg       The receiver context
+ * @param[in]     fpdu      The FPDU
+ * @param[in]     fpdu_len  The length of the FPDU
+ * @return                  0 in case of success, -1 otherwise
+ */
+static int receive_fpdu(void *const arg, const unsigned char *const fpdu,
+                        const size_t fpdu_len)
+{
+	struct rx_ctx *const rx = arg;
+	struct channel_result *const result = rx->result;
+	enum rle_decap_status ret;
+	uint64_t start_cycles;
+	size_t sdus_nr = 0;
+	size_t sdu_id;
+	unsigned int ctx_busy;
+
+	start_cycles = get_cycles();
+	ret = rle_decapsulate(rx->receiver, (unsigned char *)fpdu, fpdu_len, rx->sdus,
+	                      rx->sdus_max_nr, &sdus_nr, NULL, 0);
+	result->dec_cycles += get_cycles() - start_cycles;
+	result->fpdus_nr++;
+
+	if (ret == RLE_DECAP_ERR_NULL_RCVR || ret == RLE_DECAP_ERR_INV_SDUS ||
+	    ret == RLE_DECAP_ERR_INV_PL) {
+		printf("failed to decapsulate FPDU #%" PRIu64 " (%d)\n", result->fpdus_nr, ret);
+		return -1;
+	} else if (ret != RLE_DECAP_OK) {
+		TRACE("FPDU #%" PRIu64 " partially decapsulated (%d)\n", result->fpdus_nr, ret);
+		result->decap_errors_nr++;
+	}
+
+	for (sdu_id = 0; sdu_id < sdus_nr; sdu_id++) {
+		const struct rle_sdu *const sdu = &rx->sdus[sdu_id];
+		const struct traffic_sdu *sent;
+		uint32_t index;
+
+		if (sdu->size < SDU_ID_LEN) {
+			result->sdus_corrupted_nr++;
+			continue;
+		}
+		index = (sdu->buffer[sdu->size - 4] << 24) | (sdu->buffer[sdu->size - 3] << 16) |
+		        (sdu->buffer[sdu->size - 2] << 8) | sdu->buffer[sdu->size - 1];
+		if (index >= rx->traffic->sdus_nr) {
+			result->sdus_corrupted_nr++;
+			continue;
+		}
+		sent = &rx->traffic->sdus[index];
+		if (sdu->size != sent->size || sdu->protocol_type != sent->protocol_type ||
+		    memcmp(sdu->buffer, sent->data, sent->size) != 0) {
+			result->sdus_corrupted_nr++;
+		} else if (rx->delivered[index]) {
+			result->sdus_duplicated_nr++;
+		} else {
+			rx->delivered[index] = 1;
+			result->sdus_ok_nr++;
+			result->sdus_ok_bytes += sdu->size;
+		}
+	}
+
+	/* the contexts with a bit set in free_ctx wait for the next fragments */
+	ctx_busy = __builtin_popcount(rx->receiver->free_ctx);
+	result->ctx_busy_sum += ctx_busy;
+	if (ctx_busy > result->ctx_busy_max) {
+		result->ctx_busy_max = ctx_busy;
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Send the whole traffic through the channel, and measure what is delivered
+ *
+ * @param[in]  conf          The RLE configuration
+ * @param[in]  channel_conf  The impairments of the channel
+ * @param[in]  traffic       The traffic to send
+ * @param[in]  burst_size    The size of the FPDUs
+ * @param[out] result        The result of the run
+ * @return                   0 in case of success, 1 otherwise
+ */
+static int run_channel(const struct rle_config *const conf,
+                       const struct channel_conf *const channel_conf,
+                       const struct traffic *const traffic,
+                       const size_t burst_size,
+                       struct channel_result *const result)
+{
+	struct fpdus fpdus = {
+		.data = NULL,
+		.fpdu_size = burst_size,
+	};
+	struct rx_ctx rx = {
+		.traffic = traffic,
+		.result = result,
+	};
+	struct channel channel;
+	unsigned char *sdus_buf;
+	size_t i;
+	int status = 1;
+
+	memset(result, 0, sizeof(struct channel_result));
+
+	if (build_fpdus(conf, traffic, &fpdus, &result->enc_cycles) != 0) {
+		goto free_fpdus;
+	}
+
+	rx.sdus_max_nr = burst_size / 2 + 1;
+	rx.sdus = calloc(rx.sdus_max_nr, sizeof(struct rle_sdu));
+	sdus_buf = malloc(rx.sdus_max_nr * SDU_BUF_LEN);
+	rx.delivered = calloc(traffic->sdus_nr, sizeof(uint8_t));
+	if (rx.sdus == NULL || sdus_buf == NULL || rx.delivered == NULL) {
+		printf("failed to allocate the receiver buffers.\n");
+		goto free_rx;
+	}
+	for (i = 0; i < rx.sdus_max_nr; i++) {
+		rx.sdus[i].buffer = sdus_buf + i * SDU_BUF_LEN;
+	}
+
+	rx.receiver = rle_receiver_new(conf);
+	if (rx.receiver == NULL) {
+		printf("failed to create the receiver.\n");
+		goto free_rx;
+	}
+
+	if (channel_init(&channel, channel_conf, burst_size, receive_fpdu, &rx) != 0) {
+		goto destroy;
+	}
+
+	for (i = 0; i < fpdus.nr; i++) {
+		if (channel_send(&channel, fpdus.data + i * fpdus.fpdu_size, fpdus.fpdu_size) != 0) {
+			goto free_channel;
+		}
+	}
+	if (channel_flush(&channel) != 0) {
+		goto free_channel;
+	}
+
+	for (i = 0; i < RLE_MAX_FRAG_NUMBER; i++) {
+		result->counted_lost_nr += rle_receiver_stats_get_counter_sdus_lost(rx.receiver, i);
+		result->counted_dropped_nr +=
+			rle_receiver_stats_get_counter_sdus_dropped(rx.receiver, i);
+	}
+
+	TRACE("channel: %" PRIu64 " FPDUs, %" PRIu64 " lost, %" PRIu64 " corrupted (%" PRIu64
+	      " bits), %" PRIu64 " duplicated, %" PRIu64 " reordered\n", channel.stats.fpdus_nr,
+	      channel.stats.lost_nr, channel.stats.corrupted_nr, channel.stats.bit_errors_nr,
+	      channel.stats.duplicated_nr, channel.stats.reordered_nr);
+
+	status = 0;
+
+free_channel:
+	channel_free(&channel);
+destroy:
+	rle_receiver_destroy(&rx.receiver);
+free_rx:
+	free(rx.delivered);
+	free(sdus_buf);
+	free(rx.sdus);
+free_fpdus:
+	free(fpdus.data);
+	return status;
+}
+
+
+/**
+ * @brief Print the result of one run
+ *
+ * @param[in] conf        The RLE configuration
+ * @param[in] burst_size  The size of the FPDUs
+ * @param[in] traffic     The traffic sent
+ * @param[in] result      The result of the run
+ */
+static void print_result(const struct rle_config *const conf,
+                         const size_t burst_size,
+                         const struct traffic *const traffic,
+                         const struct channel_result *const result)
+{
+	const uint64_t lost_nr = traffic->sdus_nr - result->sdus_ok_nr;
+
+	printf("%-5s %5zu %8zu %8" PRIu64 " %7.2f %7" PRIu64 " %5" PRIu64 " %8" PRIu64 " %8"
+	       PRIu64 " %8" PRIu64 " %7.3f %7u ", conf->allow_alpdu_sequence_number ? "SeqNo" : "CRC",
+	       burst_size, traffic->sdus_nr, result->sdus_ok_nr,
+	       traffic->data_len == 0 ? 0.0 : 100.0 * result->sdus_ok_bytes / traffic->data_len,
+	       result->sdus_corrupted_nr, result->sdus_duplicated_nr, lost_nr,
+	       result->counted_lost_nr, result->counted_dropped_nr,
+	       result->fpdus_nr == 0 ? 0.0 : (double)result->ctx_busy_sum / result->fpdus_nr,
+	       result->ctx_busy_max);
+	if (result->enc_cycles != 0 && result->sdus_ok_bytes != 0) {
+		printf("%9.2f %9.2f\n", (double)result->enc_cycles / result->sdus_ok_bytes,
+		       (double)result->dec_cycles / result->sdus_ok_bytes);
+	} else {
+		printf("%9s %9s\n", "n/a", "n/a");
+	}
+}
+
+
+/**
+ * @brief Measure the RLE goodput through the channel for both protections and every burst size
+ *
+ * @param[in] traffic         The traffic to send
+ * @param[in] channel_conf    The impairments of the channel
+ * @param[in] burst_sizes     The burst sizes to test
+ * @param[in] burst_sizes_nr  The number of burst sizes to test
+ * @return                    0 in case of success, 1 otherwise
+ */
+static int test_perfs_channel(const struct traffic *const traffic,
+                              const struct channel_conf *const channel_conf,
+                              const size_t *const burst_sizes,
+                              const size_t burst_sizes_nr)
+{
+	size_t burst_id;
+	int protection;
+	int status = 1;
+
+	printf("=== channel: loss %g, BER %g, duplication %g, reordering %g (depth %u), "
+	       "seed %u\n", channel_conf->loss_rate, channel_conf->bit_error_rate,
+	       channel_conf->dup_rate, channel_conf->reorder_rate, channel_conf->reorder_depth,
+	       channel_conf->seed);
+
+	printf("\n=== test: \n");
+	printf("%-5s %5s %8s %8s %7s %7s %5s %8s %8s %8s %7s %7s %9s %9s\n", "prot", "burst",
+	       "SDUs", "ok", "good%", "corrupt", "dup", "lost", "cnt_lost", "dropped", "ctx_avg",
+	       "ctx_max", "enc_cyc/B", "dec_cyc/B");
+
+	for (burst_id = 0; burst_id < burst_sizes_nr; burst_id++) {
+		for (protection = 0; protection < 2; protection++) {
+			const struct rle_config conf = {
+				.allow_ptype_omission = 0,
+				.use_compressed_ptype = 0,
+				.allow_alpdu_crc = protection,
+				.allow_alpdu_sequence_number = !protection,
+				.use_explicit_payload_header_map = 0,
+				.implicit_protocol_type = 0x00,
+				.implicit_ppdu_label_size = 0,
+				.implicit_payload_label_size = 0,
+				.type_0_alpdu_label_size = 0,
+			};
+			struct channel_result result;
+
+			if (run_channel(&conf, channel_conf, traffic, burst_sizes[burst_id],
+			                &result) != 0) {
+				goto error;
+			}
+			print_result(&conf, burst_sizes[burst_id], traffic, &result);
+		}
+	}
+
+	printf("\n=== shutdown:\n");
+	status = 0;
+
+error:
+	return status;
+}
@@ -544,6 +544,8 @@ static char * str_decap_error(const enum rle_decap_status status)
 	case RLE_DECAP_ERR_INV_PL:
 		return "[RLE_DECAP_ERR_INV_PL] Error. Given preallocated payload label array is "
 		       "invalid";
+	case RLE_DECAP_NEED_RCVR:
+		return "[RLE_DECAP_NEED_RCVR] The FPDU contains PPDU fragments, a receiver is needed.";
 	default:
 		return "[Unknwon RLE_DECAP status]";
 	}
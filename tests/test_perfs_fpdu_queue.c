@@ -0,0 +1,594 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_fpdu_queue.c
+ * @brief  Measure the FPDU throughput when building and transmitting on separate threads.
+ *
+ *         The main thread encapsulates the traffic and packs the PPDUs in the buffers of an
+ *         FPDU queue, an I/O thread pops the FPDUs, sends them (or decapsulates them to check
+ *         them) then recycles their buffers.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* for sched_getaffinity() and pthread_setaffinity_np() */
+#define _GNU_SOURCE
+
+/* system includes */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <getopt.h>
+
+#include "rle.h"
+#include "test_traffic_gen.h"
+#include "test_fpdu_queue.h"
+
+/** The program version */
+#define TEST_VERSION  "RLE FPDU queue performances test application, version 0.0.1\n"
+
+/** The default number of FPDU buffers */
+#define DEFAULT_BUFS_NR 64U
+
+/** The default number of SDUs of the traffic */
+#define DEFAULT_SDUS_NR 200000U
+
+/** Min, max and default burst sizes */
+#define MIN_BURST_SIZE 14
+#define MAX_BURST_SIZE 599
+#define DEFAULT_BURST_SIZE 599U
+
+/** The maximal number of SDUs in one FPDU */
+#define BURST_SDUS_MAX_NR 300U
+
+/** The length of the SDU buffers given to the receiver (room for VLAN ptype re-insertion) */
+#define SDU_BUF_LEN  (RLE_MAX_PDU_SIZE + 4U)
+
+/** The I/O thread */
+struct io_thread {
+	struct fpdu_queue *queue;        /**< The queue of FPDUs */
+	struct rle_receiver *receiver;   /**< The receiver to check the FPDUs, NULL if none */
+	size_t label_size;               /**< The payload label length of the FPDUs */
+	int cpu;                         /**< The CPU of the thread, -1 if not pinned */
+	int done;                        /**< Set by the builder after its last FPDU */
+	uint64_t fpdus_nr;               /**< The number of FPDUs sent */
+	uint64_t sdus_nr;                /**< The number of SDUs decapsulated */
+	uint64_t sdus_bytes;             /**< The number of SDU bytes decapsulated */
+	uint64_t checksum;               /**< The sum of the first byte of the FPDUs sent */
+	int errors_nr;                   /**< The number of FPDUs that failed to decapsulate */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static uint64_t get_time_ns(void);
+static void * io_thread_run(void *const arg);
+static int build_fpdus(struct rle_transmitter *const transmitter,
+                       struct fpdu_queue *const queue,
+                       const struct traffic *const traffic,
+                       const size_t burst_size,
+                       const unsigned char *const label,
+                       const size_t label_size);
+static int test_perfs_fpdu_queue(const struct traffic *const traffic,
+                                 const size_t bufs_nr,
+                                 const size_t burst_size,
+                                 const size_t label_size);
+
+/** Whether the application runs in verbose mode or not */
+static int is_verbose = 0;
+
+/** Whether the ALPDUs are protected by CRC or SeqNo */
+static int use_crc = 0;
+
+/** Whether the I/O thread decapsulates the FPDUs to check them */
+static int verify = 0;
+
+/** Whether the threads are pinned on CPUs or not */
+static int use_pin = 0;
+
+#define TRACE(x ...) do { \
+		if (is_verbose) { printf(x); } \
+} while (0)
+
+
+/**
+ * @brief Main function for the RLE FPDU queue performances test program
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	size_t bufs_nr = DEFAULT_BUFS_NR;
+	size_t burst_size = DEFAULT_BURST_SIZE;
+	size_t sdus_nr = DEFAULT_SDUS_NR;
+	size_t label_size = 0;
+	struct traffic_gen_conf gen_conf;
+	struct traffic traffic;
+
+	traffic_gen_conf_init(&gen_conf);
+
+	while (1) {
+		int c;
+
+		static struct option long_options[] =
+		{
+			{ "verbose", no_argument, &is_verbose, 1 },
+			{ "crc", no_argument, &use_crc, 1 },
+			{ "verify", no_argument, &verify, 1 },
+			{ "pin", no_argument, &use_pin, 1 },
+			{ "bufs", required_argument, 0, 'q' },
+			{ "burst_size", required_argument, 0, 'b' },
+			{ "label", required_argument, 0, 'l' },
+			{ "count", required_argument, 0, 'n' },
+			{ "sizes", required_argument, 0, 'S' },
+			{ "ptypes", required_argument, 0, 'p' },
+			{ "flows", required_argument, 0, 'f' },
+			{ "seed", required_argument, 0, 'r' },
+			{ 0, 0, 0, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, "vhq:b:l:n:S:p:f:r:", long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 0:
+			/* If this option set a flag, do nothing else now. */
+			break;
+		case 'q': /* Number of FPDU buffers */
+			assert(optarg != NULL);
+			bufs_nr = strtoul(optarg, NULL, 10);
+			if (bufs_nr < 2 || (bufs_nr & (bufs_nr - 1)) != 0) {
+				printf("ERROR: the number of buffers shall be a power of 2, at least 2\n");
+				goto error;
+			}
+			break;
+		case 'b': /* Burst Size */
+			assert(optarg != NULL);
+			burst_size = strtoul(optarg, NULL, 10);
+			if (burst_size < MIN_BURST_SIZE || burst_size > MAX_BURST_SIZE) {
+				printf("ERROR: %zu burst size shall be within [%d ; %d] octets.\n",
+				       burst_size, MIN_BURST_SIZE, MAX_BURST_SIZE);
+				goto error;
+			}
+			break;
+		case 'l': /* Payload label length */
+			assert(optarg != NULL);
+			label_size = strtoul(optarg, NULL, 10);
+			if (label_size != 0 && label_size != 3 && label_size != 6) {
+				printf("ERROR: the payload label length shall be 0, 3 or 6 octets\n");
+				goto error;
+			}
+			break;
+		case 'n': /* Number of SDUs */
+			assert(optarg != NULL);
+			sdus_nr = strtoul(optarg, NULL, 10);
+			if (sdus_nr == 0) {
+				printf("ERROR: at least one SDU is required\n");
+				goto error;
+			}
+			break;
+		case 'S': /* Size distribution */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_sizes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'p': /* Protocol types mix */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_ptypes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'f': /* Number of flows */
+			assert(optarg != NULL);
+			gen_conf.flows_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'r': /* Seed of the traffic */
+			assert(optarg != NULL);
+			gen_conf.seed = strtoul(optarg, NULL, 10);
+			break;
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc) {
+		usage();
+		goto error;
+	}
+
+	printf("=== initialization:\n");
+	if (traffic_gen(&gen_conf, sdus_nr, 0, &traffic) != 0) {
+		goto error;
+	}
+	printf("===\t%zu synthetic packets generated (seed %u)\n", traffic.sdus_nr, gen_conf.seed);
+
+	status = test_perfs_fpdu_queue(&traffic, bufs_nr, burst_size, label_size);
+
+	printf("=== exit test with code %d\n", status);
+	traffic_free(&traffic);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the FPDU queue performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE FPDU queue performances test tool: build the FPDUs on one thread in the\n"
+	        "recycled buffers of a lock-free queue, and send them on another thread.\n"
+	        "\n"
+	        "usage: test_perfs_fpdu_queue [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --bufs, -q              Number of FPDU buffers, a power of 2 (default 64)\n"
+	        "  --burst_size, -b        Burst size (default 599 octets)\n"
+	        "  --label, -l             Payload label length of the FPDUs: 0, 3 or 6\n"
+	        "                          (default 0)\n"
+	        "  --verify                Decapsulate the FPDUs on the I/O thread to check them\n"
+	        "  --pin                   Pin the builder and the I/O thread on the first two CPUs\n"
+	        "                          the test may run on\n"
+	        "  --crc                   Protect the ALPDUs with CRC instead of SeqNo\n"
+	        "  --count, -n             Number of SDUs (default 200000)\n"
+	        "  --sizes, -S             Size distribution of the SDUs (default 'imix'),\n"
+	        "                          see test_traffic_gen\n"
+	        "  --ptypes, -p            Protocol types mix of the SDUs (default 'ipv4'),\n"
+	        "                          see test_traffic_gen\n"
+	        "  --flows, -f             Number of flows (frag_ids) (default 1)\n"
+	        "  --seed, -r              Seed of the traffic (default 0)\n"
+	        "  --verbose               Run the test in verbose mode\n");
+
+	return;
+}
+
+
+/**
+ * @brief  Get a monotonic timestamp
+ *
+ * @return the current time in nanoseconds
+ */
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/**
+ * @brief The I/O thread: pop, send then recycle the FPDUs until the builder is done
+ *
+ * @param[in,out] arg  The I/O thread
+ * @return             NULL
+ */
+static void * io_thread_run(void *const arg)
+{
+	struct io_thread *const io = arg;
+	struct rle_sdu sdus[BURST_SDUS_MAX_NR];
+	unsigned char *sdus_buf = NULL;
+	size_t i;
+
+	if (io->cpu >= 0) {
+		cpu_set_t cpu_set;
+
+		CPU_ZERO(&cpu_set);
+		CPU_SET(io->cpu, &cpu_set);
+		pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+	}
+	if (io->receiver != NULL) {
+		sdus_buf = malloc(BURST_SDUS_MAX_NR * SDU_BUF_LEN);
+		if (sdus_buf == NULL) {
+			io->errors_nr++;
+			return NULL;
+		}
+		for (i = 0; i < BURST_SDUS_MAX_NR; i++) {
+			sdus[i].buffer = sdus_buf + i * SDU_BUF_LEN;
+			sdus[i].size = 0;
+			sdus[i].protocol_type = 0;
+		}
+	}
+
+	while (1) {
+		const struct fpdu_buf *buf = fpdu_queue_pop(io->queue);
+
+		if (buf == NULL) {
+			if (!__atomic_load_n(&io->done, __ATOMIC_ACQUIRE)) {
+				sched_yield();
+				continue;
+			}
+			/* the done flag is set after the last FPDU is pushed, check the queue again */
+			buf = fpdu_queue_pop(io->queue);
+			if (buf == NULL) {
+				break;
+			}
+		}
+
+		if (io->receiver != NULL) {
+			unsigned char label[6];
+			size_t sdus_nr = 0;
+
+			if (rle_decapsulate(io->receiver, buf->data, buf->size, sdus, BURST_SDUS_MAX_NR,
+			                    &sdus_nr, io->label_size > 0 ? label : NULL,
+			                    io->label_size) != RLE_DECAP_OK) {
+				io->errors_nr++;
+			}
+			for (i = 0; i < sdus_nr; i++) {
+				io->sdus_bytes += sdus[i].size;
+				sdus[i].size = 0;
+				sdus[i].protocol_type = 0;
+			}
+			io->sdus_nr += sdus_nr;
+		} else {
+			/* the modem would read the FPDU */
+			io->checksum += buf->data[0] + buf->data[buf->size - 1];
+		}
+		io->fpdus_nr++;
+		fpdu_queue_recycle(io->queue, buf);
+	}
+
+	free(sdus_buf);
+	return NULL;
+}
+
+
+/**
+ * @brief Encapsulate the traffic, and pack the PPDUs in the buffers of the queue
+ *
+ * @param[in,out] transmitter  The transmitter
+ * @param[in,out] queue        The queue of FPDUs
+ * @param[in]     traffic      The SDUs
+ * @param[in]     burst_size   The size of the FPDUs
+ * @param[in]     label        The payload label of the FPDUs
+ * @param[in]     label_size   The length of the payload label
+ * @return                     0 in case of success, 1 otherwise
+ */
+static int build_fpdus(struct rle_transmitter *const transmitter,
+                       struct fpdu_queue *const queue,
+                       const struct traffic *const traffic,
+                       const size_t burst_size,
+                       const unsigned char *const label,
+                       const size_t label_size)
+{
+	struct fpdu_buf *buf = NULL;
+	size_t sdu_id;
+
+	for (sdu_id = 0; sdu_id < traffic->sdus_nr; sdu_id++) {
+		const struct traffic_sdu *const sdu = &traffic->sdus[sdu_id];
+		struct rle_sdu sdu_in;
+
+		sdu_in.buffer = sdu->data;
+		sdu_in.size = sdu->size;
+		sdu_in.protocol_type = sdu->protocol_type;
+		if (rle_encapsulate(transmitter, &sdu_in, sdu->frag_id) != RLE_ENCAP_OK) {
+			printf("failed to encapsulate SDU #%zu\n", sdu_id + 1);
+			return 1;
+		}
+
+		while (rle_transmitter_stats_get_queue_size(transmitter, sdu->frag_id) != 0) {
+			enum rle_frag_status ret_frag;
+			unsigned char *ppdu;
+			size_t ppdu_length = 0;
+
+			/* wait for the I/O thread to recycle a buffer */
+			while (buf == NULL) {
+				buf = fpdu_queue_start(queue, burst_size, label, label_size);
+				if (buf == NULL) {
+					sched_yield();
+				}
+			}
+
+			ret_frag = rle_fragment(transmitter, sdu->frag_id, buf->remain_size, &ppdu,
+			                        &ppdu_length);
+			if (ret_frag == RLE_FRAG_ERR_BURST_TOO_SMALL && buf->cur_pos != label_size) {
+				/* not enough room for a PPDU in the current FPDU, send it */
+				fpdu_queue_push(queue, buf);
+				buf = NULL;
+				continue;
+			} else if (ret_frag != RLE_FRAG_OK) {
+				printf("failed to fragment SDU #%zu\n", sdu_id + 1);
+				return 1;
+			}
+			if (fpdu_buf_pack(buf, ppdu, ppdu_length) != RLE_PACK_OK) {
+				printf("failed to pack PPDU\n");
+				return 1;
+			}
+			if (buf->remain_size == 0) {
+				fpdu_queue_push(queue, buf);
+				buf = NULL;
+			}
+		}
+	}
+	if (buf != NULL) {
+		fpdu_queue_push(queue, buf);
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Measure the FPDU throughput with a builder and an I/O thread
+ *
+ * @param[in] traffic     The SDUs
+ * @param[in] bufs_nr     The number of FPDU buffers
+ * @param[in] burst_size  The size of the FPDUs
+ * @param[in] label_size  The payload label length of the FPDUs
+ * @return                0 in case of success, 1 otherwise
+ */
+static int test_perfs_fpdu_queue(const struct traffic *const traffic,
+                                 const size_t bufs_nr,
+                                 const size_t burst_size,
+                                 const size_t label_size)
+{
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = use_crc,
+		.allow_alpdu_sequence_number = !use_crc,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const unsigned char label[6] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05 };
+	struct rle_transmitter *transmitter;
+	struct fpdu_queue_stats stats;
+	struct io_thread io;
+	pthread_t io_thread;
+	uint64_t sdus_bytes = 0;
+	uint64_t start_ns;
+	uint64_t elapsed_ns;
+	size_t i;
+	int status = 1;
+
+	memset(&io, 0, sizeof(struct io_thread));
+	io.label_size = label_size;
+	io.cpu = -1;
+	if (use_pin) {
+		cpu_set_t cpu_set;
+		int cpus[2] = { -1, -1 };
+		int cpus_nr = 0;
+		int cpu;
+
+		if (sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set) != 0) {
+			perror("failed to get the CPUs of the test");
+			goto error;
+		}
+		for (cpu = 0; cpu < CPU_SETSIZE && cpus_nr < 2; cpu++) {
+			if (CPU_ISSET(cpu, &cpu_set)) {
+				cpus[cpus_nr++] = cpu;
+			}
+		}
+		io.cpu = cpus_nr > 1 ? cpus[1] : cpus[0];
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cpus[0], &cpu_set);
+		if (sched_setaffinity(0, sizeof(cpu_set_t), &cpu_set) != 0) {
+			perror("failed to pin the builder");
+			goto error;
+		}
+	}
+
+	transmitter = rle_transmitter_new(&conf);
+	if (transmitter == NULL) {
+		printf("failed to create transmitter\n");
+		goto error;
+	}
+	io.queue = fpdu_queue_new(bufs_nr, burst_size);
+	if (io.queue == NULL) {
+		goto destroy_transmitter;
+	}
+	if (verify) {
+		io.receiver = rle_receiver_new(&conf);
+		if (io.receiver == NULL) {
+			printf("failed to create receiver\n");
+			goto destroy_queue;
+		}
+	}
+	for (i = 0; i < traffic->sdus_nr; i++) {
+		sdus_bytes += traffic->sdus[i].size;
+	}
+
+	printf("\n=== test: \n");
+	printf("===\t%zu %zu-byte FPDU buffers, %zu-byte payload label, %s%s\n", bufs_nr,
+	       burst_size, label_size, use_crc ? "CRC" : "SeqNo",
+	       verify ? ", FPDUs decapsulated" : "");
+
+	start_ns = get_time_ns();
+	if (pthread_create(&io_thread, NULL, io_thread_run, &io) != 0) {
+		printf("failed to start the I/O thread\n");
+		goto destroy_receiver;
+	}
+	status = build_fpdus(transmitter, io.queue, traffic, burst_size, label, label_size);
+	__atomic_store_n(&io.done, 1, __ATOMIC_RELEASE);
+	pthread_join(io_thread, NULL);
+	elapsed_ns = get_time_ns() - start_ns;
+	if (status != 0) {
+		goto destroy_receiver;
+	}
+	status = 1;
+
+	fpdu_queue_get_stats(io.queue, &stats);
+	printf("%" PRIu64 " FPDUs: %.0f FPDU/s, %.3f Gbit/s of SDUs\n", io.fpdus_nr,
+	       io.fpdus_nr * 1e9 / elapsed_ns, sdus_bytes * 8.0 / elapsed_ns);
+	printf("builder found no free buffer %" PRIu64 " times, I/O thread found no FPDU %"
+	       PRIu64 " times\n", stats.no_buf_nr, stats.empty_nr);
+	TRACE("checksum 0x%" PRIx64 "\n", io.checksum);
+
+	if (io.fpdus_nr != stats.pushed_nr || io.errors_nr != 0) {
+		printf("%" PRIu64 " FPDUs sent instead of %" PRIu64 ", %d errors\n", io.fpdus_nr,
+		       stats.pushed_nr, io.errors_nr);
+		goto destroy_receiver;
+	}
+	if (verify && (io.sdus_nr != traffic->sdus_nr || io.sdus_bytes != sdus_bytes)) {
+		printf("%" PRIu64 " SDUs (%" PRIu64 " bytes) decapsulated instead of %zu (%" PRIu64
+		       " bytes)\n", io.sdus_nr, io.sdus_bytes, traffic->sdus_nr, sdus_bytes);
+		goto destroy_receiver;
+	}
+
+	printf("\n=== shutdown:\n");
+	status = 0;
+
+destroy_receiver:
+	if (io.receiver != NULL) {
+		rle_receiver_destroy(&io.receiver);
+	}
+destroy_queue:
+	fpdu_queue_destroy(io.queue);
+destroy_transmitter:
+	rle_transmitter_destroy(&transmitter);
+error:
+	return status;
+}
@@ -0,0 +1,1362 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_offline.c
+ * @brief  Offline performances test: the traffic is loaded in memory before the measures
+ *
+ * Contrary to test_perfs and test_perfs_fpdu, no live capture is involved: the SDUs are
+ * read once from a PCAP file (or generated) then the encapsulation and decapsulation
+ * loops are run during a fixed time for every configuration, so the measures are
+ * repeatable and do not include the capture cost.
+ *
+ * The FPDUs built and the SDUs decapsulated may also be written to a file or a socket in
+ * large batches through io_uring (or epoll), so the measures include a realistic output
+ * rather than one system call per packet.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* for sched_setaffinity() */
+#define _GNU_SOURCE
+
+/* system includes */
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <arpa/inet.h>
+#include <assert.h>
+#include <time.h>
+#include <pcap/pcap.h>
+#include <pcap.h>
+#include <getopt.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "rle.h"
+#include "test_perf_counters.h"
+#include "test_traffic_gen.h"
+#include "test_trace.h"
+#include "test_aio.h"
+
+/** The program version */
+#define TEST_VERSION  "RLE offline performances test application, version 0.0.1\n"
+
+/** The length (in bytes) of the Ethernet header */
+#define ETHER_HDR_LEN  14U
+
+/** Min and max burst sizes for fragmentation in the test. */
+#define MIN_BURST_SIZE 14
+#define MAX_BURST_SIZE 599
+
+/** The maximum number of burst sizes that may be given on command line */
+#define MAX_BURST_SIZES_NR 8
+
+/** The default duration (in seconds) of every measure */
+#define DEFAULT_DURATION 1.0
+
+/** The default number of SDUs of the synthetic traffic */
+#define DEFAULT_SYNTHETIC_NR 10000U
+
+/** The length of the SDU buffers given to the receiver (room for VLAN ptype re-insertion) */
+#define SDU_BUF_LEN  (RLE_MAX_PDU_SIZE + 4U)
+
+/** The maximal number of latencies recorded per measure */
+#define LATENCY_MAX_SAMPLES (1U << 22)
+
+/** Number of SDUs (or FPDUs) processed between two checks of the elapsed time */
+#define CLOCK_CHECK_PERIOD 32U
+
+/** The kinds of PPDUs carried by an FPDU */
+enum ppdu_mix {
+	PPDU_MIX_COMPLETE,  /**< COMPLETE PPDUs only */
+	PPDU_MIX_FRAG,      /**< At least one START, CONT or END PPDU */
+	PPDU_MIXES_NR       /**< The number of PPDU mixes */
+};
+
+/** The latencies recorded during one measure */
+struct latency_samples {
+	uint64_t *ns;     /**< The latencies in nanoseconds */
+	uint8_t *mixes;   /**< The PPDU mix of the FPDU of every latency */
+	size_t nr;        /**< The number of latencies recorded */
+	size_t max_nr;    /**< The number of latencies that may be recorded */
+};
+
+/** The destination of the FPDUs built by the encapsulation loop */
+struct fpdu_sink {
+	unsigned char *fpdus;  /**< One FPDU, or all the FPDUs if stored */
+	size_t fpdu_size;      /**< The size of one FPDU */
+	size_t fpdus_max_nr;   /**< The number of FPDUs that may be stored */
+	size_t fpdus_nr;       /**< The number of FPDUs completed */
+	bool store;            /**< Whether FPDUs are kept for later decapsulation or not */
+	size_t cur_pos;        /**< The current position in the current FPDU */
+	size_t remain_size;    /**< The remaining size in the current FPDU */
+	bool cur_frag;         /**< Whether the current FPDU carries a fragment or not */
+	uint8_t *mixes;        /**< The PPDU mix of every stored FPDU, NULL if not recorded */
+	uint64_t cur_start_ns; /**< When the build of the current FPDU started */
+};
+
+/** The result of one measure */
+struct bench_result {
+	uint64_t sdus_nr;     /**< The number of SDUs processed */
+	uint64_t sdus_bytes;  /**< The number of SDU bytes processed */
+	uint64_t fpdus_nr;    /**< The number of FPDUs processed */
+	uint64_t elapsed_ns;  /**< The measure duration in nanoseconds */
+	uint64_t cycles;      /**< The measure duration in CPU cycles, 0 if unavailable */
+	uint64_t counters[PERF_COUNTERS_NR];  /**< The hardware counters, if enabled */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static uint64_t get_time_ns(void);
+static uint64_t get_cycles(void);
+static int load_pcap(const char *const src_filename, struct traffic *const traffic);
+static unsigned char * sink_cur_fpdu(const struct fpdu_sink *const sink);
+static int sink_flush(struct fpdu_sink *const sink);
+static void latency_add(const uint64_t latency_ns, const enum ppdu_mix mix);
+static int latency_cmp(const void *const a, const void *const b);
+static void print_latencies(const struct rle_config *const conf,
+                            const size_t burst_size,
+                            const char *const step);
+static int pin_cpu(const int cpu);
+static int encap_sdu(struct rle_transmitter *const transmitter,
+                     struct fpdu_sink *const sink,
+                     const struct traffic_sdu *const sdu);
+static int bench_encap(const struct rle_config *const conf,
+                       const struct traffic *const traffic,
+                       const size_t burst_size,
+                       const uint64_t duration_ns,
+                       struct bench_result *const result);
+static int build_fpdus(const struct rle_config *const conf,
+                       const struct traffic *const traffic,
+                       struct fpdu_sink *const sink);
+static int bench_decap(const struct rle_config *const conf,
+                       const struct fpdu_sink *const sink,
+                       const uint64_t duration_ns,
+                       struct bench_result *const result);
+static void print_result(const struct rle_config *const conf,
+                         const size_t burst_size,
+                         const char *const step,
+                         const struct bench_result *const result);
+static void print_aio_stats(const char *const what, const char *const dest,
+                            const struct aio_writer *const writer);
+static int test_perfs_offline(const struct traffic *const traffic,
+                              const size_t *const burst_sizes,
+                              const size_t burst_sizes_nr,
+                              const double duration);
+
+/** Whether the application runs in verbose mode or not */
+static int is_verbose = 0;
+
+/** Whether the hardware counters are requested or not */
+static int use_perf_counters = 0;
+
+/** The hardware counters measured around every loop */
+static struct perf_counters perf_counters;
+
+/** Whether the latency of every FPDU build and decapsulation is measured or not */
+static int measure_latency = 0;
+
+/** The latencies of the current measure */
+static struct latency_samples latencies;
+
+/** The output of the FPDUs built by the encapsulation measures, NULL if none */
+static struct aio_writer *fpdus_writer = NULL;
+
+/** The output of the SDUs decapsulated by the decapsulation measures, NULL if none */
+static struct aio_writer *sdus_writer = NULL;
+
+/** The names of the PPDU mixes */
+static const char *const ppdu_mix_names[PPDU_MIXES_NR] = {
+	[PPDU_MIX_COMPLETE] = "complete",
+	[PPDU_MIX_FRAG] = "frag",
+};
+
+#define TRACE(x ...) do { \
+		if (is_verbose) { printf(x); } \
+} while (0)
+
+
+/**
+ * @brief Main function for the RLE offline performances test program
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure,
+ *                 \li 77 in case test is skipped
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	size_t burst_sizes[MAX_BURST_SIZES_NR] = { MIN_BURST_SIZE, 123, MAX_BURST_SIZE };
+	size_t burst_sizes_nr = 3;
+	bool burst_sizes_given = false;
+	double duration = DEFAULT_DURATION;
+	int synthetic = 0;
+	int cpu = -1;
+	size_t synthetic_nr = DEFAULT_SYNTHETIC_NR;
+	const char *fpdus_dest = NULL;
+	const char *sdus_dest = NULL;
+	struct aio_conf aio_conf;
+	struct traffic_gen_conf gen_conf;
+	struct traffic traffic;
+	struct trace trace;
+
+	traffic_gen_conf_init(&gen_conf);
+	aio_conf_init(&aio_conf);
+	memset(&traffic, 0, sizeof(struct traffic));
+	memset(&trace, 0, sizeof(struct trace));
+
+	while (1) {
+		int c;
+
+		static struct option long_options[] =
+		{
+			{ "verbose", no_argument, &is_verbose, 1 },
+			{ "perf-counters", no_argument, &use_perf_counters, 1 },
+			{ "latency", no_argument, &measure_latency, 1 },
+			{ "cpu", required_argument, 0, 'c' },
+			{ "synthetic", no_argument, 0, 's' },
+			{ "count", required_argument, 0, 'n' },
+			{ "seed", required_argument, 0, 'r' },
+			{ "sizes", required_argument, 0, 'S' },
+			{ "ptypes", required_argument, 0, 'p' },
+			{ "flows", required_argument, 0, 'f' },
+			{ "burst_size", required_argument, 0, 'b' },
+			{ "duration", required_argument, 0, 'd' },
+			{ "fpdus-out", required_argument, 0, 'F' },
+			{ "sdus-out", required_argument, 0, 'O' },
+			{ "io", required_argument, 0, 'I' },
+			{ 0, 0, 0, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, "vhsn:r:S:p:f:b:d:c:", long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 0:
+			/* If this option set a flag, do nothing else now. */
+			break;
+
+		case 's': /* Synthetic traffic */
+			synthetic = 1;
+			break;
+
+		case 'n': /* Number of synthetic SDUs */
+			assert(optarg != NULL);
+			synthetic_nr = strtoul(optarg, NULL, 10);
+			if (synthetic_nr == 0) {
+				printf("ERROR: at least one synthetic SDU is required\n");
+				goto error;
+			}
+			break;
+
+		case 'r': /* Seed of the synthetic traffic */
+			assert(optarg != NULL);
+			gen_conf.seed = strtoul(optarg, NULL, 10);
+			break;
+
+		case 'S': /* Size distribution of the synthetic traffic */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_sizes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+
+		case 'p': /* Protocol types mix of the synthetic traffic */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_ptypes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+
+		case 'f': /* Number of flows of the synthetic traffic */
+			assert(optarg != NULL);
+			gen_conf.flows_nr = strtoul(optarg, NULL, 10);
+			break;
+
+		case 'b': /* Burst Size */
+		{
+			size_t burst_size;
+
+			assert(optarg != NULL);
+			burst_size = strtoul(optarg, NULL, 10);
+
+			if (burst_size < MIN_BURST_SIZE) {
+				printf("ERROR: %zu burst size is too small. Minimum = %d octets.\n",
+				       burst_size, MIN_BURST_SIZE);
+				goto error;
+			} else if (burst_size > MAX_BURST_SIZE) {
+				printf("ERROR: %zu burst size is too big. Maximum = %d octets.\n",
+				       burst_size, MAX_BURST_SIZE);
+				goto error;
+			}
+
+			if (!burst_sizes_given) {
+				burst_sizes_given = true;
+				burst_sizes_nr = 0;
+			}
+			if (burst_sizes_nr >= MAX_BURST_SIZES_NR) {
+				printf("ERROR: too many burst sizes. Maximum = %d.\n", MAX_BURST_SIZES_NR);
+				goto error;
+			}
+			burst_sizes[burst_sizes_nr++] = burst_size;
+			break;
+		}
+
+		case 'd': /* Duration of every measure */
+			assert(optarg != NULL);
+			duration = strtod(optarg, NULL);
+			if (duration <= 0) {
+				printf("ERROR: duration shall be strictly positive\n");
+				goto error;
+			}
+			break;
+
+		case 'c': /* CPU to run on */
+			assert(optarg != NULL);
+			cpu = atoi(optarg);
+			if (cpu < 0 || cpu >= CPU_SETSIZE) {
+				printf("ERROR: invalid CPU %s\n", optarg);
+				goto error;
+			}
+			break;
+
+		case 'F': /* Output of the FPDUs */
+			assert(optarg != NULL);
+			fpdus_dest = optarg;
+			break;
+
+		case 'O': /* Output of the SDUs */
+			assert(optarg != NULL);
+			sdus_dest = optarg;
+			break;
+
+		case 'I': /* I/O backend of the outputs */
+			assert(optarg != NULL);
+			if (aio_parse_backend(optarg, &aio_conf.backend) != 0) {
+				goto error;
+			}
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (synthetic) {
+		if (optind != argc) {
+			fprintf(stderr, "FLOW shall not be given with synthetic traffic\n\n");
+			usage();
+			goto error;
+		}
+		printf("=== initialization:\n");
+		if (traffic_gen(&gen_conf, synthetic_nr, 0, &traffic) != 0) {
+			goto error;
+		}
+		printf("===\t%zu synthetic packets generated (seed %u)\n", traffic.sdus_nr,
+		       gen_conf.seed);
+	} else {
+		if (optind != argc - 1) {
+			fprintf(stderr, "FLOW is a mandatory parameter\n\n");
+			usage();
+			goto error;
+		}
+		printf("=== initialization:\n");
+		status = traffic_read(argv[optind], &traffic);
+		if (status == 0) {
+			printf("===\t%zu packets loaded from trace %s\n", traffic.sdus_nr, argv[optind]);
+		} else if (status == 1) {
+			/* not a compact trace file, try an indexed one, mapped without any copy */
+			status = trace_open(argv[optind], &trace);
+			if (status == 0) {
+				if (trace_to_traffic(&trace, &traffic) != 0) {
+					status = EXIT_FAILURE;
+				} else if (traffic.sdus_nr == 0) {
+					printf("no packet to test\n");
+					status = 77;
+				} else {
+					printf("===\t%zu packets mapped from indexed trace %s\n",
+					       traffic.sdus_nr, argv[optind]);
+				}
+			} else if (status == 1) {
+				/* not a trace file written by test_traffic_gen, try PCAP */
+				status = load_pcap(argv[optind], &traffic);
+			} else {
+				status = EXIT_FAILURE;
+			}
+		} else {
+			status = EXIT_FAILURE;
+		}
+		if (status != 0) {
+			goto free_traffic;
+		}
+	}
+
+	if (cpu >= 0 && pin_cpu(cpu) != 0) {
+		status = EXIT_FAILURE;
+		goto free_traffic;
+	}
+
+	if (measure_latency) {
+		latencies.max_nr = LATENCY_MAX_SAMPLES;
+		latencies.ns = malloc(latencies.max_nr * sizeof(uint64_t));
+		latencies.mixes = malloc(latencies.max_nr * sizeof(uint8_t));
+		if (latencies.ns == NULL || latencies.mixes == NULL) {
+			printf("failed to allocate %zu latencies\n", latencies.max_nr);
+			status = EXIT_FAILURE;
+			goto free_latencies;
+		}
+	}
+
+	if (fpdus_dest != NULL) {
+		fpdus_writer = aio_writer_open(fpdus_dest, &aio_conf);
+		if (fpdus_writer == NULL) {
+			status = EXIT_FAILURE;
+			goto free_latencies;
+		}
+		printf("===\tFPDUs written to %s through %s\n", fpdus_dest,
+		       aio_writer_get_backend_name(fpdus_writer));
+	}
+	if (sdus_dest != NULL) {
+		sdus_writer = aio_writer_open(sdus_dest, &aio_conf);
+		if (sdus_writer == NULL) {
+			status = EXIT_FAILURE;
+			goto close_writers;
+		}
+		printf("===\tSDUs written to %s through %s\n", sdus_dest,
+		       aio_writer_get_backend_name(sdus_writer));
+	}
+
+	if (use_perf_counters) {
+		if (perf_counters_open(&perf_counters) == 0) {
+			printf("WARNING: no hardware counter available (check "
+			       "/proc/sys/kernel/perf_event_paranoid), counters are disabled\n");
+			use_perf_counters = 0;
+		}
+	}
+
+	status = test_perfs_offline(&traffic, burst_sizes, burst_sizes_nr, duration);
+
+	if (use_perf_counters) {
+		perf_counters_close(&perf_counters);
+	}
+
+	if (fpdus_writer != NULL) {
+		print_aio_stats("FPDUs", fpdus_dest, fpdus_writer);
+	}
+	if (sdus_writer != NULL) {
+		print_aio_stats("SDUs", sdus_dest, sdus_writer);
+	}
+
+	printf("=== exit test with code %d\n", status);
+close_writers:
+	if (fpdus_writer != NULL && aio_writer_close(fpdus_writer) != 0) {
+		status = EXIT_FAILURE;
+	}
+	if (sdus_writer != NULL && aio_writer_close(sdus_writer) != 0) {
+		status = EXIT_FAILURE;
+	}
+free_latencies:
+	free(latencies.ns);
+	free(latencies.mixes);
+free_traffic:
+	traffic_free(&traffic);
+	trace_close(&trace);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the offline performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE offline performances test tool:  measure the RLE library throughput with\n"
+	        "traffic preloaded in memory.\n"
+	        "\n"
+	        "usage: test_perfs_offline [OPTIONS] FLOW\n"
+	        "       test_perfs_offline [OPTIONS] --synthetic\n"
+	        "\n"
+	        "with:\n"
+	        "  FLOW                    The PCAP file that contains the SDUs (Ethernet frames),\n"
+	        "                          or a compact or indexed trace file written by\n"
+	        "                          test_traffic_gen, or an indexed trace file written by\n"
+	        "                          test_dump_fpdus --trace\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --burst_size, -b        Add a burst size to test (default 14, 123 and 599\n"
+	        "                          octets), may be given several times\n"
+	        "  --duration, -d          Duration of every measure in seconds (default 1)\n"
+	        "  --synthetic, -s         Use synthetic traffic instead of a PCAP file\n"
+	        "  --count, -n             Number of synthetic SDUs (default 10000)\n"
+	        "  --seed, -r              Seed of the synthetic traffic (default 0)\n"
+	        "  --sizes, -S             Size distribution of the synthetic traffic (default\n"
+	        "                          'imix'), see test_traffic_gen\n"
+	        "  --ptypes, -p            Protocol types mix of the synthetic traffic (default\n"
+	        "                          'ipv4'), see test_traffic_gen\n"
+	        "  --flows, -f             Number of flows (frag_ids) of the synthetic traffic\n"
+	        "                          (default 1)\n"
+	        "  --perf-counters         Measure hardware counters (cycles, instructions,\n"
+	        "                          cache and branch misses) per SDU and per FPDU\n"
+	        "  --latency               Measure the latency of every FPDU build and every\n"
+	        "                          decapsulation, print p50/p99/p99.9/max per PPDU mix\n"
+	        "  --cpu, -c               Pin the test to the given CPU\n"
+	        "  --fpdus-out DEST        Write the FPDUs built by the encapsulation measures to\n"
+	        "                          DEST: a file, udp:HOST:PORT (one datagram per FPDU)\n"
+	        "                          or tcp:HOST:PORT\n"
+	        "  --sdus-out DEST         Write the SDUs decapsulated by the decapsulation\n"
+	        "                          measures to DEST, as --fpdus-out\n"
+	        "  --io BACKEND            The I/O backend of the outputs: uring, epoll or auto\n"
+	        "                          (default, uring if available)\n"
+	        "  --verbose               Run the test in verbose mode\n");
+
+	return;
+}
+
+
+/**
+ * @brief  Get a monotonic timestamp
+ *
+ * @return the current time in nanoseconds
+ */
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/**
+ * @brief  Get the CPU timestamp counter
+ *
+ * @return the current number of CPU cycles, 0 if not available on the architecture
+ */
+static uint64_t get_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+
+/**
+ * @brief Load all the Ethernet frames of a PCAP file in memory
+ *
+ * @param[in]  src_filename  The name of the PCAP file
+ * @param[out] traffic       The loaded SDUs (Ethernet headers removed)
+ * @return                   0 in case of success,
+ *                           1 in case of failure,
+ *                           77 if the file is not supported
+ */
+static int load_pcap(const char *const src_filename, struct traffic *const traffic)
+{
+	char errbuf[PCAP_ERRBUF_SIZE];
+	pcap_t *handle;
+	struct pcap_pkthdr header;
+	const unsigned char *packet;
+	size_t data_max_len = 0;
+	size_t skipped_nr = 0;
+	size_t offset;
+	size_t pkt_id;
+	int status = 1;
+
+	/* open the source dump file */
+	handle = pcap_open_offline(src_filename, errbuf);
+	if (handle == NULL) {
+		printf("failed to open the source pcap file: %s\n", errbuf);
+		goto error;
+	}
+
+	/* link layer in the source dump must be Ethernet */
+	if (pcap_datalink(handle) != DLT_EN10MB) {
+		printf("link layer type %d not supported in source dump (supported = %d)\n",
+		       pcap_datalink(handle), DLT_EN10MB);
+		status = 77;
+		goto close_input;
+	}
+
+	while ((packet = pcap_next(handle, &header)) != NULL) {
+		const size_t sdu_len = header.len - ETHER_HDR_LEN;
+		struct traffic_sdu *sdu;
+		void *realloc_ret;
+
+		/* SDUs that the library refuses are not part of the measure */
+		if (header.len <= ETHER_HDR_LEN || header.len != header.caplen ||
+		    sdu_len > RLE_MAX_PDU_SIZE) {
+			skipped_nr++;
+			continue;
+		}
+
+		realloc_ret = realloc(traffic->sdus,
+		                      (traffic->sdus_nr + 1) * sizeof(struct traffic_sdu));
+		if (realloc_ret == NULL) {
+			printf("failed to copy the packets.\n");
+			goto close_input;
+		}
+		traffic->sdus = realloc_ret;
+
+		/* all the SDUs are copied in the same memory, that may move while it grows */
+		if (traffic->data_len + sdu_len > data_max_len) {
+			data_max_len = 2 * (traffic->data_len + sdu_len);
+			realloc_ret = realloc(traffic->data, data_max_len);
+			if (realloc_ret == NULL) {
+				printf("failed to copy a packet.\n");
+				goto close_input;
+			}
+			traffic->data = realloc_ret;
+		}
+
+		sdu = &traffic->sdus[traffic->sdus_nr];
+		sdu->data = NULL;
+		sdu->size = sdu_len;
+		sdu->protocol_type = (packet[ETHER_HDR_LEN - 2] << 8) | packet[ETHER_HDR_LEN - 1];
+		sdu->frag_id = 0;
+		memcpy(traffic->data + traffic->data_len, packet + ETHER_HDR_LEN, sdu_len);
+		traffic->data_len += sdu_len;
+		traffic->sdus_nr++;
+	}
+
+	offset = 0;
+	for (pkt_id = 0; pkt_id < traffic->sdus_nr; pkt_id++) {
+		traffic->sdus[pkt_id].data = traffic->data + offset;
+		offset += traffic->sdus[pkt_id].size;
+	}
+
+	printf("===\t%zu packets loaded from %s (%zu skipped)\n", traffic->sdus_nr,
+	       src_filename, skipped_nr);
+
+	if (traffic->sdus_nr == 0) {
+		printf("no packet to test\n");
+		status = 77;
+		goto close_input;
+	}
+
+	status = 0;
+
+close_input:
+	pcap_close(handle);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Get the FPDU currently being built in a sink
+ *
+ * @param[in] sink  The FPDU sink
+ * @return          The current FPDU
+ */
+static unsigned char * sink_cur_fpdu(const struct fpdu_sink *const sink)
+{
+	if (sink->store) {
+		return sink->fpdus + sink->fpdus_nr * sink->fpdu_size;
+	}
+
+	return sink->fpdus;
+}
+
+
+/**
+ * @brief Pad the current FPDU of a sink, then start a new one
+ *
+ * @param[in,out] sink  The FPDU sink
+ * @return              0 in case of success, -1 if no more FPDU may be stored or written
+ */
+static int sink_flush(struct fpdu_sink *const sink)
+{
+	const enum ppdu_mix mix = sink->cur_frag ? PPDU_MIX_FRAG : PPDU_MIX_COMPLETE;
+
+	rle_pad(sink_cur_fpdu(sink), sink->cur_pos, sink->remain_size);
+	if (sink->mixes != NULL) {
+		sink->mixes[sink->fpdus_nr] = mix;
+	}
+	if (measure_latency && !sink->store) {
+		const uint64_t now_ns = get_time_ns();
+
+		latency_add(now_ns - sink->cur_start_ns, mix);
+		sink->cur_start_ns = now_ns;
+	}
+	sink->cur_frag = false;
+	sink->fpdus_nr++;
+	sink->cur_pos = 0;
+	sink->remain_size = sink->fpdu_size;
+
+	if (!sink->store && fpdus_writer != NULL) {
+		/* the FPDU was built in place in the output, build the next one after it */
+		aio_writer_put(fpdus_writer, sink->fpdu_size);
+		sink->fpdus = aio_writer_get_buf(fpdus_writer, sink->fpdu_size);
+		if (sink->fpdus == NULL) {
+			TRACE("failed to write the FPDUs\n");
+			return -1;
+		}
+	}
+
+	if (sink->store && sink->fpdus_nr >= sink->fpdus_max_nr) {
+		TRACE("too few FPDUs to store the traffic\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Record one latency of the current measure
+ *
+ * The latencies beyond the capacity of the record are ignored, the measure stops before.
+ *
+ * @param[in] latency_ns  The latency in nanoseconds
+ * @param[in] mix         The PPDU mix of the FPDU built or decapsulated
+ */
+static void latency_add(const uint64_t latency_ns, const enum ppdu_mix mix)
+{
+	if (latencies.nr < latencies.max_nr) {
+		latencies.ns[latencies.nr] = latency_ns;
+		latencies.mixes[latencies.nr] = mix;
+		latencies.nr++;
+	}
+}
+
+
+/**
+ * @brief Compare two latencies for qsort()
+ *
+ * @param[in] a  The first latency
+ * @param[in] b  The second latency
+ * @return       -1, 0 or 1 if the first latency is lower, equal or greater
+ */
+static int latency_cmp(const void *const a, const void *const b)
+{
+	const uint64_t latency_a = *(const uint64_t *)a;
+	const uint64_t latency_b = *(const uint64_t *)b;
+
+	return (latency_a > latency_b) - (latency_a < latency_b);
+}
+
+
+/**
+ * @brief Print the latency percentiles of the current measure, for all the FPDUs then per
+ *        PPDU mix
+ *
+ * @param[in] conf        The RLE configuration
+ * @param[in] burst_size  The size of the FPDUs
+ * @param[in] step        The name of the measured step
+ */
+static void print_latencies(const struct rle_config *const conf,
+                            const size_t burst_size,
+                            const char *const step)
+{
+	size_t mixes_nr[PPDU_MIXES_NR] = { 0 };
+	bool is_mixed;
+	uint64_t *sorted;
+	size_t i;
+	int mix;
+
+	sorted = malloc(latencies.nr * sizeof(uint64_t) + 1);
+	if (sorted == NULL) {
+		printf("failed to allocate %zu latencies\n", latencies.nr);
+		return;
+	}
+	for (i = 0; i < latencies.nr; i++) {
+		mixes_nr[latencies.mixes[i]]++;
+	}
+	is_mixed = (mixes_nr[PPDU_MIX_COMPLETE] != 0 && mixes_nr[PPDU_MIX_FRAG] != 0);
+
+	/* mix -1 stands for all the FPDUs, only useful if they carry different mixes */
+	for (mix = -1; mix < PPDU_MIXES_NR; mix++) {
+		size_t sorted_nr = 0;
+
+		if ((mix < 0 && !is_mixed) || (mix >= 0 && mixes_nr[mix] == 0)) {
+			continue;
+		}
+		for (i = 0; i < latencies.nr; i++) {
+			if (mix < 0 || latencies.mixes[i] == mix) {
+				sorted[sorted_nr++] = latencies.ns[i];
+			}
+		}
+		qsort(sorted, sorted_nr, sizeof(uint64_t), latency_cmp);
+
+		printf("%-6s %-5s %-4s %-4s %5zu %-8s %9zu %8" PRIu64 " %8" PRIu64 " %8" PRIu64
+		       " %8" PRIu64 "\n", step, conf->allow_alpdu_sequence_number ? "SeqNo" : "CRC",
+		       conf->use_compressed_ptype ? "On" : "Off",
+		       conf->allow_ptype_omission ? "On" : "Off", burst_size,
+		       mix < 0 ? "all" : ppdu_mix_names[mix], sorted_nr,
+		       sorted[(sorted_nr - 1) * 50 / 100], sorted[(sorted_nr - 1) * 99 / 100],
+		       sorted[(sorted_nr - 1) * 999 / 1000], sorted[sorted_nr - 1]);
+	}
+
+	free(sorted);
+}
+
+
+/**
+ * @brief Pin the calling thread on one CPU to reduce the measures noise
+ *
+ * @param[in] cpu  The CPU
+ * @return         0 in case of success, -1 otherwise
+ */
+static int pin_cpu(const int cpu)
+{
+	cpu_set_t cpus;
+
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	if (sched_setaffinity(0, sizeof(cpu_set_t), &cpus) != 0) {
+		perror("failed to pin the test on the CPU");
+		return -1;
+	}
+	printf("===\ttest pinned on CPU %d\n", cpu);
+
+	return 0;
+}
+
+
+/**
+ * @brief Encapsulate, fragment and pack one SDU with a given transmitter.
+ *
+ * @param[in,out] transmitter    The transmitter to use
+ * @param[in,out] sink           The FPDUs to pack the PPDUs in
+ * @param[in]     sdu            The SDU to encapsulate
+ * @return                       0 if the process is successful, -1 otherwise
+ */
+static int encap_sdu(struct rle_transmitter *const transmitter,
+                     struct fpdu_sink *const sink,
+                     const struct traffic_sdu *const sdu)
+{
+	const uint8_t frag_id = sdu->frag_id;
+	struct rle_sdu sdu_in;
+
+	sdu_in.buffer = sdu->data;
+	sdu_in.size = sdu->size;
+	sdu_in.protocol_type = sdu->protocol_type;
+
+	if (rle_encapsulate(transmitter, &sdu_in, frag_id) != RLE_ENCAP_OK) {
+		TRACE("RLE encapsulation failed\n");
+		return -1;
+	}
+
+	while (rle_transmitter_stats_get_queue_size(transmitter, frag_id) != 0) {
+		enum rle_frag_status ret_frag;
+		unsigned char *ppdu;
+		size_t ppdu_length = 0;
+
+		ret_frag = rle_fragment(transmitter, frag_id, sink->remain_size, &ppdu, &ppdu_length);
+		if (ret_frag == RLE_FRAG_ERR_BURST_TOO_SMALL && sink->cur_pos != 0) {
+			/* not enough room for a PPDU in the current FPDU, use the next one */
+			if (sink_flush(sink) != 0) {
+				return -1;
+			}
+			continue;
+		} else if (ret_frag != RLE_FRAG_OK) {
+			TRACE("RLE fragmentation failed\n");
+			return -1;
+		}
+
+		if (rle_pack(ppdu, ppdu_length, NULL, 0, sink_cur_fpdu(sink), &sink->cur_pos,
+		             &sink->remain_size) != RLE_PACK_OK) {
+			TRACE("RLE packing failed\n");
+			return -1;
+		}
+		/* the start and end indicators are the 2 first bits of the PPDU header */
+		if ((ppdu[0] & 0xc0) != 0xc0) {
+			sink->cur_frag = true;
+		}
+
+		if (sink->remain_size == 0 && sink_flush(sink) != 0) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Measure the encapsulation, fragmentation and packing throughput
+ *
+ * The traffic is encapsulated in loop until the given duration elapses.
+ *
+ * @param[in]  conf         The RLE configuration
+ * @param[in]  traffic      The traffic to encapsulate
+ * @param[in]  burst_size   The size of the FPDUs
+ * @param[in]  duration_ns  The duration of the measure in nanoseconds
+ * @param[out] result       The result of the measure
+ * @return                  0 in case of success, 1 otherwise
+ */
+static int bench_encap(const struct rle_config *const conf,
+                       const struct traffic *const traffic,
+                       const size_t burst_size,
+                       const uint64_t duration_ns,
+                       struct bench_result *const result)
+{
+	struct rle_transmitter *transmitter;
+	unsigned char fpdu[burst_size];
+	struct fpdu_sink sink = {
+		.fpdus = fpdu,
+		.fpdu_size = burst_size,
+		.fpdus_max_nr = 1,
+		.fpdus_nr = 0,
+		.store = false,
+		.cur_pos = 0,
+		.remain_size = burst_size,
+		.cur_frag = false,
+		.mixes = NULL,
+		.cur_start_ns = 0,
+	};
+	uint64_t start_ns;
+	uint64_t start_cycles;
+	uint64_t now_ns;
+	size_t pkt_id = 0;
+	int status = 1;
+
+	memset(result, 0, sizeof(struct bench_result));
+
+	transmitter = rle_transmitter_new(conf);
+	if (transmitter == NULL) {
+		printf("failed to create the transmitter.\n");
+		goto error;
+	}
+
+	if (fpdus_writer != NULL) {
+		sink.fpdus = aio_writer_get_buf(fpdus_writer, burst_size);
+		if (sink.fpdus == NULL) {
+			printf("failed to write the FPDUs\n");
+			goto destroy;
+		}
+	}
+
+	latencies.nr = 0;
+	start_ns = get_time_ns();
+	sink.cur_start_ns = start_ns;
+	if (use_perf_counters) {
+		perf_counters_start(&perf_counters);
+	}
+	start_cycles = get_cycles();
+	do {
+		size_t i;
+
+		for (i = 0; i < CLOCK_CHECK_PERIOD; i++) {
+			if (encap_sdu(transmitter, &sink, &traffic->sdus[pkt_id]) != 0) {
+				printf("failed to encapsulate SDU #%zu\n", pkt_id + 1);
+				goto destroy;
+			}
+			result->sdus_bytes += traffic->sdus[pkt_id].size;
+			pkt_id = (pkt_id + 1) % traffic->sdus_nr;
+		}
+		result->sdus_nr += CLOCK_CHECK_PERIOD;
+		now_ns = get_time_ns();
+	} while ((now_ns - start_ns) < duration_ns &&
+	         (!measure_latency || latencies.nr < latencies.max_nr));
+	if (fpdus_writer != NULL) {
+		/* the FPDUs are counted once written, the last one is not complete */
+		if (aio_writer_sync(fpdus_writer) != 0) {
+			printf("failed to write the FPDUs\n");
+			goto destroy;
+		}
+		now_ns = get_time_ns();
+	}
+	result->cycles = get_cycles() - start_cycles;
+	result->elapsed_ns = now_ns - start_ns;
+	if (use_perf_counters) {
+		perf_counters_stop(&perf_counters);
+		memcpy(result->counters, perf_counters.values, sizeof(result->counters));
+	}
+	result->fpdus_nr = sink.fpdus_nr;
+
+	status = 0;
+
+destroy:
+	rle_transmitter_destroy(&transmitter);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Build and store the FPDUs of the whole traffic for the decapsulation measure
+ *
+ * @param[in]     conf     The RLE configuration
+ * @param[in]     traffic  The traffic to encapsulate
+ * @param[in,out] sink     The FPDUs, allocated by the function
+ * @return                 0 in case of success, 1 otherwise
+ */
+static int build_fpdus(const struct rle_config *const conf,
+                       const struct traffic *const traffic,
+                       struct fpdu_sink *const sink)
+{
+	struct rle_transmitter *transmitter;
+	size_t pkt_id;
+	int status = 1;
+
+	/* every FPDU carries at least (FPDU size - 4) bytes of an ALPDU that is at most 6 bytes
+	 * larger than its SDU, plus one FPDU that may be left too short for the first PPDU */
+	sink->fpdus_max_nr = 1;
+	for (pkt_id = 0; pkt_id < traffic->sdus_nr; pkt_id++) {
+		sink->fpdus_max_nr += (traffic->sdus[pkt_id].size + 6) / (sink->fpdu_size - 4) + 2;
+	}
+	sink->fpdus = calloc(sink->fpdus_max_nr, sink->fpdu_size);
+	if (sink->fpdus == NULL) {
+		printf("failed to allocate %zu FPDUs\n", sink->fpdus_max_nr);
+		goto error;
+	}
+	if (measure_latency) {
+		sink->mixes = calloc(sink->fpdus_max_nr, sizeof(uint8_t));
+		if (sink->mixes == NULL) {
+			printf("failed to allocate the PPDU mixes of %zu FPDUs\n", sink->fpdus_max_nr);
+			goto error;
+		}
+	}
+	sink->fpdus_nr = 0;
+	sink->store = true;
+	sink->cur_pos = 0;
+	sink->remain_size = sink->fpdu_size;
+	sink->cur_frag = false;
+
+	transmitter = rle_transmitter_new(conf);
+	if (transmitter == NULL) {
+		printf("failed to create the transmitter.\n");
+		goto error;
+	}
+
+	for (pkt_id = 0; pkt_id < traffic->sdus_nr; pkt_id++) {
+		if (encap_sdu(transmitter, sink, &traffic->sdus[pkt_id]) != 0) {
+			printf("failed to encapsulate SDU #%zu\n", pkt_id + 1);
+			goto destroy;
+		}
+	}
+
+	/* pad the last FPDU */
+	if (sink->cur_pos != 0 && sink_flush(sink) != 0) {
+		goto destroy;
+	}
+
+	status = 0;
+
+destroy:
+	rle_transmitter_destroy(&transmitter);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Measure the decapsulation throughput
+ *
+ * The FPDUs are decapsulated in loop until the given duration elapses. The sequence
+ * numbers restart from 0 at every loop, which the receiver accepts as a relog.
+ *
+ * @param[in]  conf         The RLE configuration
+ * @param[in]  sink         The FPDUs to decapsulate
+ * @param[in]  duration_ns  The duration of the measure in nanoseconds
+ * @param[out] result       The result of the measure
+ * @return                  0 in case of success, 1 otherwise
+ */
+static int bench_decap(const struct rle_config *const conf,
+                       const struct fpdu_sink *const sink,
+                       const uint64_t duration_ns,
+                       struct bench_result *const result)
+{
+	struct rle_receiver *receiver;
+	const size_t sdus_max_nr = sink->fpdu_size / 2 + 1;
+	struct rle_sdu sdus[sdus_max_nr];
+	unsigned char *sdus_buf;
+	uint64_t start_ns;
+	uint64_t start_cycles;
+	uint64_t now_ns;
+	size_t fpdu_id = 0;
+	size_t i;
+	int status = 1;
+
+	memset(result, 0, sizeof(struct bench_result));
+
+	sdus_buf = malloc(sdus_max_nr * SDU_BUF_LEN);
+	if (sdus_buf == NULL) {
+		printf("failed to allocate the SDU buffers.\n");
+		goto error;
+	}
+	for (i = 0; i < sdus_max_nr; i++) {
+		sdus[i].buffer = sdus_buf + i * SDU_BUF_LEN;
+	}
+
+	receiver = rle_receiver_new(conf);
+	if (receiver == NULL) {
+		printf("failed to create the receiver.\n");
+		goto free_buf;
+	}
+
+	latencies.nr = 0;
+	start_ns = get_time_ns();
+	if (use_perf_counters) {
+		perf_counters_start(&perf_counters);
+	}
+	start_cycles = get_cycles();
+	do {
+		for (i = 0; i < CLOCK_CHECK_PERIOD; i++) {
+			size_t sdus_nr = 0;
+			size_t sdu_id;
+			uint64_t decap_start_ns = 0;
+
+			if (measure_latency) {
+				decap_start_ns = get_time_ns();
+			}
+			if (rle_decapsulate(receiver, sink->fpdus + fpdu_id * sink->fpdu_size,
+			                    sink->fpdu_size, sdus, sdus_max_nr, &sdus_nr, NULL,
+			                    0) != RLE_DECAP_OK) {
+				printf("failed to decapsulate FPDU #%zu\n", fpdu_id + 1);
+				goto destroy;
+			}
+			if (measure_latency) {
+				latency_add(get_time_ns() - decap_start_ns, sink->mixes[fpdu_id]);
+			}
+			for (sdu_id = 0; sdu_id < sdus_nr; sdu_id++) {
+				result->sdus_bytes += sdus[sdu_id].size;
+				if (sdus_writer != NULL &&
+				    aio_writer_add(sdus_writer, (const unsigned char *)sdus[sdu_id].buffer,
+				                   sdus[sdu_id].size) != 0) {
+					printf("failed to write the SDUs\n");
+					goto destroy;
+				}
+			}
+			result->sdus_nr += sdus_nr;
+			fpdu_id = (fpdu_id + 1) % sink->fpdus_nr;
+		}
+		result->fpdus_nr += CLOCK_CHECK_PERIOD;
+		now_ns = get_time_ns();
+	} while ((now_ns - start_ns) < duration_ns &&
+	         (!measure_latency || latencies.nr < latencies.max_nr));
+	if (sdus_writer != NULL) {
+		if (aio_writer_sync(sdus_writer) != 0) {
+			printf("failed to write the SDUs\n");
+			goto destroy;
+		}
+		now_ns = get_time_ns();
+	}
+	result->cycles = get_cycles() - start_cycles;
+	result->elapsed_ns = now_ns - start_ns;
+	if (use_perf_counters) {
+		perf_counters_stop(&perf_counters);
+		memcpy(result->counters, perf_counters.values, sizeof(result->counters));
+	}
+
+	status = 0;
+
+destroy:
+	rle_receiver_destroy(&receiver);
+free_buf:
+	free(sdus_buf);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print the result of one measure
+ *
+ * @param[in] conf        The RLE configuration
+ * @param[in] burst_size  The size of the FPDUs
+ * @param[in] step        The name of the measured step
+ * @param[in] result      The result of the measure
+ */
+static void print_result(const struct rle_config *const conf,
+                         const size_t burst_size,
+                         const char *const step,
+                         const struct bench_result *const result)
+{
+	const double elapsed_ns = result->elapsed_ns;
+
+	printf("%-6s %-5s %-4s %-4s %5zu %12.0f %8.3f %10.1f ",
+	       step, conf->allow_alpdu_sequence_number ? "SeqNo" : "CRC",
+	       conf->use_compressed_ptype ? "On" : "Off",
+	       conf->allow_ptype_omission ? "On" : "Off", burst_size,
+	       result->sdus_nr * 1e9 / elapsed_ns, result->sdus_bytes * 8 / elapsed_ns,
+	       result->sdus_nr == 0 ? 0.0 : elapsed_ns / result->sdus_nr);
+	if (result->cycles != 0 && result->sdus_bytes != 0) {
+		printf("%10.2f\n", (double)result->cycles / result->sdus_bytes);
+	} else {
+		printf("%10s\n", "n/a");
+	}
+
+	if (use_perf_counters) {
+		int id;
+
+		for (id = 0; id < PERF_COUNTERS_NR; id++) {
+			printf("    %-14s", perf_counters_get_name(id));
+			if (!perf_counters_is_available(&perf_counters, id)) {
+				printf(" %12s %12s\n", "n/a", "n/a");
+				continue;
+			}
+			if (result->sdus_nr != 0) {
+				printf(" %12.2f", (double)result->counters[id] / result->sdus_nr);
+			} else {
+				printf(" %12s", "n/a");
+			}
+			if (result->fpdus_nr != 0) {
+				printf(" %12.2f\n", (double)result->counters[id] / result->fpdus_nr);
+			} else {
+				printf(" %12s\n", "n/a");
+			}
+		}
+	}
+}
+
+
+/**
+ * @brief Print the statistics of an output
+ *
+ * @param[in] what    The records written, FPDUs or SDUs
+ * @param[in] dest    The destination of the output
+ * @param[in] writer  The output
+ */
+static void print_aio_stats(const char *const what, const char *const dest,
+                            const struct aio_writer *const writer)
+{
+	struct aio_stats stats;
+
+	aio_writer_get_stats(writer, &stats);
+	printf("===\t%" PRIu64 " %s (%" PRIu64 " bytes) written to %s through %s, in %" PRIu64
+	       " buffers with %" PRIu64 " system calls, %" PRIu64 " waits for a free buffer, %"
+	       PRIu64 " lost\n", stats.records_nr, what, stats.bytes_nr, dest,
+	       aio_writer_get_backend_name(writer), stats.bufs_nr, stats.syscalls_nr,
+	       stats.waits_nr, stats.lost_nr);
+}
+
+
+/**
+ * @brief Measure the RLE library throughput for every configuration and burst size
+ *
+ * @param[in] traffic         The traffic loaded in memory
+ * @param[in] burst_sizes     The burst sizes to test
+ * @param[in] burst_sizes_nr  The number of burst sizes to test
+ * @param[in] duration        The duration of every measure in seconds
+ * @return                    0 in case of success, 1 otherwise
+ */
+static int test_perfs_offline(const struct traffic *const traffic,
+                              const size_t *const burst_sizes,
+                              const size_t burst_sizes_nr,
+                              const double duration)
+{
+	const uint64_t duration_ns = duration * 1e9;
+	size_t burst_id;
+	int protection;
+	int compression;
+	int omission;
+	int status = 1;
+
+	printf("\n=== test: \n");
+	if (measure_latency) {
+		printf("%-6s %-5s %-4s %-4s %5s %-8s %9s %8s %8s %8s %8s\n", "step", "prot", "comp",
+		       "omit", "burst", "mix", "samples", "p50 ns", "p99 ns", "p99.9 ns", "max ns");
+	} else {
+		printf("%-6s %-5s %-4s %-4s %5s %12s %8s %10s %10s\n", "step", "prot", "comp",
+		       "omit", "burst", "SDU/s", "Gbit/s", "ns/SDU", "cycles/B");
+	}
+	if (use_perf_counters) {
+		printf("    %-14s %12s %12s\n", "counter", "per SDU", "per FPDU");
+	}
+
+	for (burst_id = 0; burst_id < burst_sizes_nr; burst_id++) {
+		for (protection = 0; protection < 2; protection++) {
+			for (compression = 0; compression < 2; compression++) {
+				for (omission = 0; omission < 2; omission++) {
+					const struct rle_config conf = {
+						.allow_ptype_omission = omission,
+						.use_compressed_ptype = compression,
+						.allow_alpdu_crc = protection,
+						.allow_alpdu_sequence_number = !protection,
+						.use_explicit_payload_header_map = 0,
+						.implicit_protocol_type = omission ? 0x30 : 0x00,
+						.implicit_ppdu_label_size = 0,
+						.implicit_payload_label_size = 0,
+						.type_0_alpdu_label_size = 0,
+					};
+					struct fpdu_sink sink = {
+						.fpdus = NULL,
+						.fpdu_size = burst_sizes[burst_id],
+						.mixes = NULL,
+					};
+					struct bench_result result;
+
+					if (bench_encap(&conf, traffic, burst_sizes[burst_id], duration_ns,
+					                &result) != 0) {
+						goto error;
+					}
+					if (measure_latency) {
+						print_latencies(&conf, burst_sizes[burst_id], "encap");
+					} else {
+						print_result(&conf, burst_sizes[burst_id], "encap", &result);
+					}
+
+					if (build_fpdus(&conf, traffic, &sink) != 0 ||
+					    bench_decap(&conf, &sink, duration_ns, &result) != 0) {
+						free(sink.fpdus);
+						free(sink.mixes);
+						goto error;
+					}
+					free(sink.fpdus);
+					free(sink.mixes);
+					if (measure_latency) {
+						print_latencies(&conf, burst_sizes[burst_id], "decap");
+					} else {
+						print_result(&conf, burst_sizes[burst_id], "decap", &result);
+					}
+				}
+			}
+		}
+	}
+
+	printf("\n=== shutdown:\n");
+	status = 0;
+
+error:
+	return status;
+}
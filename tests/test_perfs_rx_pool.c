@@ -0,0 +1,793 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_rx_pool.c
+ * @brief  Measure how the hub receivers pool scales with its number of worker threads.
+ *
+ *         The FPDUs of many terminals, each one with its payload label, are built once in
+ *         memory, interleaved as in a superframe. They are then pushed in receivers pools
+ *         of 1 to 32 workers, and the reassembled SDUs are collected by the same thread.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* for sched_getaffinity() */
+#define _GNU_SOURCE
+
+/* system includes */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <time.h>
+#include <sched.h>
+#include <getopt.h>
+
+#include "rle.h"
+#include "test_traffic_gen.h"
+#include "test_rx_pool.h"
+
+/** The program version */
+#define TEST_VERSION  "RLE receivers pool performances test application, version 0.0.1\n"
+
+/** The maximum number of worker counts that may be given on command line */
+#define MAX_WORKERS_NRS 16
+
+/** The default number of terminals */
+#define DEFAULT_TERMINALS_NR 1024U
+
+/** The default number of SDUs of the traffic */
+#define DEFAULT_SDUS_NR 200000U
+
+/** Min, max and default burst sizes */
+#define MIN_BURST_SIZE 14
+#define MAX_BURST_SIZE 599
+#define DEFAULT_BURST_SIZE 123U
+
+/** The length of the payload label of the FPDUs, it holds the terminal number */
+#define LABEL_LEN 3U
+
+/** The number of slots of the rings of the pool */
+#define RING_LEN 1024U
+
+/** The maximal number of SDUs in one FPDU */
+#define BURST_SDUS_MAX_NR 300U
+
+/** The FPDUs of all the terminals, interleaved */
+struct fpdus {
+	unsigned char *data;   /**< The FPDUs, one after the other */
+	size_t fpdu_size;      /**< The size of every FPDU */
+	size_t fpdus_nr;       /**< The number of FPDUs */
+	size_t fpdus_max_nr;   /**< The number of FPDUs that may be stored */
+	uint64_t sdus_nr;      /**< The number of SDUs in the FPDUs */
+	uint64_t sdus_bytes;   /**< The number of SDU bytes in the FPDUs */
+};
+
+/** The result of one measure */
+struct pool_result {
+	uint64_t sdus_nr;          /**< The number of SDUs collected */
+	uint64_t sdus_bytes;       /**< The number of SDU bytes collected */
+	uint64_t errors_nr;        /**< The number of FPDUs the workers failed to decapsulate */
+	uint64_t elapsed_ns;       /**< The measure duration in nanoseconds */
+	uint64_t terminals_min;    /**< The lowest number of terminals of a worker */
+	uint64_t terminals_max;    /**< The highest number of terminals of a worker */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static uint64_t get_time_ns(void);
+static int parse_cpus(const char *const spec, int *const cpus, size_t *const cpus_nr);
+static int build_fpdus(const struct traffic *const traffic,
+                       const struct rle_config *const conf,
+                       const size_t terminals_nr,
+                       struct fpdus *const fpdus);
+static void pool_collect(struct rx_pool *const pool, const size_t workers_nr,
+                         struct pool_result *const result);
+static int bench_pool(const struct fpdus *const fpdus,
+                      const struct rle_config *const conf,
+                      const size_t terminals_nr,
+                      const size_t workers_nr,
+                      const int *const cpus,
+                      const size_t cpus_nr,
+                      struct pool_result *const result);
+static int test_perfs_rx_pool(const struct traffic *const traffic,
+                              const size_t terminals_nr,
+                              const size_t burst_size,
+                              const size_t *const workers_nrs,
+                              const size_t workers_nrs_nr,
+                              const int *const cpus,
+                              const size_t cpus_nr);
+
+/** Whether the application runs in verbose mode or not */
+static int is_verbose = 0;
+
+/** Whether the threads are pinned on CPUs or not */
+static int use_pin = 0;
+
+/** Whether the ALPDUs are protected by CRC or SeqNo */
+static int use_crc = 0;
+
+#define TRACE(x ...) do { \
+		if (is_verbose) { printf(x); } \
+} while (0)
+
+
+/**
+ * @brief Main function for the RLE receivers pool performances test program
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	size_t workers_nrs[MAX_WORKERS_NRS] = { 1, 2, 4, 8, 16, 32 };
+	size_t workers_nrs_nr = 6;
+	bool workers_nrs_given = false;
+	size_t terminals_nr = DEFAULT_TERMINALS_NR;
+	size_t burst_size = DEFAULT_BURST_SIZE;
+	size_t sdus_nr = DEFAULT_SDUS_NR;
+	int cpus[CPU_SETSIZE];
+	size_t cpus_nr = 0;
+	struct traffic_gen_conf gen_conf;
+	struct traffic traffic;
+
+	traffic_gen_conf_init(&gen_conf);
+
+	while (1) {
+		int c;
+
+		static struct option long_options[] =
+		{
+			{ "verbose", no_argument, &is_verbose, 1 },
+			{ "pin", no_argument, &use_pin, 1 },
+			{ "crc", no_argument, &use_crc, 1 },
+			{ "workers", required_argument, 0, 'w' },
+			{ "cpus", required_argument, 0, 'c' },
+			{ "terminals", required_argument, 0, 't' },
+			{ "burst_size", required_argument, 0, 'b' },
+			{ "count", required_argument, 0, 'n' },
+			{ "sizes", required_argument, 0, 'S' },
+			{ "ptypes", required_argument, 0, 'p' },
+			{ "flows", required_argument, 0, 'f' },
+			{ "seed", required_argument, 0, 'r' },
+			{ 0, 0, 0, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, "vhw:c:t:b:n:S:p:f:r:", long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 0:
+			/* If this option set a flag, do nothing else now. */
+			break;
+		case 'w': /* Number of workers */
+			assert(optarg != NULL);
+			if (!workers_nrs_given) {
+				workers_nrs_given = true;
+				workers_nrs_nr = 0;
+			}
+			if (workers_nrs_nr >= MAX_WORKERS_NRS) {
+				printf("ERROR: too many worker counts. Maximum = %d.\n", MAX_WORKERS_NRS);
+				goto error;
+			}
+			workers_nrs[workers_nrs_nr] = strtoul(optarg, NULL, 10);
+			if (workers_nrs[workers_nrs_nr] == 0) {
+				printf("ERROR: at least one worker is required\n");
+				goto error;
+			}
+			workers_nrs_nr++;
+			break;
+		case 'c': /* CPUs to pin the threads on */
+			assert(optarg != NULL);
+			if (parse_cpus(optarg, cpus, &cpus_nr) != 0) {
+				goto error;
+			}
+			use_pin = 1;
+			break;
+		case 't': /* Number of terminals */
+			assert(optarg != NULL);
+			terminals_nr = strtoul(optarg, NULL, 10);
+			if (terminals_nr == 0 || terminals_nr > (1U << (8 * LABEL_LEN))) {
+				printf("ERROR: the number of terminals shall be within [1 ; %u]\n",
+				       1U << (8 * LABEL_LEN));
+				goto error;
+			}
+			break;
+		case 'b': /* Burst Size */
+			assert(optarg != NULL);
+			burst_size = strtoul(optarg, NULL, 10);
+			if (burst_size < MIN_BURST_SIZE || burst_size > MAX_BURST_SIZE) {
+				printf("ERROR: %zu burst size shall be within [%d ; %d] octets.\n",
+				       burst_size, MIN_BURST_SIZE, MAX_BURST_SIZE);
+				goto error;
+			}
+			break;
+		case 'n': /* Number of SDUs */
+			assert(optarg != NULL);
+			sdus_nr = strtoul(optarg, NULL, 10);
+			if (sdus_nr == 0) {
+				printf("ERROR: at least one SDU is required\n");
+				goto error;
+			}
+			break;
+		case 'S': /* Size distribution */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_sizes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'p': /* Protocol types mix */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_ptypes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'f': /* Number of flows */
+			assert(optarg != NULL);
+			gen_conf.flows_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'r': /* Seed of the traffic */
+			assert(optarg != NULL);
+			gen_conf.seed = strtoul(optarg, NULL, 10);
+			break;
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc) {
+		usage();
+		goto error;
+	}
+
+	/* without CPU list, the threads are pinned on the CPUs the test may run on */
+	if (use_pin && cpus_nr == 0) {
+		cpu_set_t cpu_set;
+		int cpu;
+
+		if (sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set) != 0) {
+			perror("failed to get the CPUs of the test");
+			goto error;
+		}
+		for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &cpu_set)) {
+				cpus[cpus_nr++] = cpu;
+			}
+		}
+	}
+
+	printf("=== initialization:\n");
+	if (traffic_gen(&gen_conf, sdus_nr, 0, &traffic) != 0) {
+		goto error;
+	}
+	printf("===\t%zu synthetic packets generated (seed %u)\n", traffic.sdus_nr, gen_conf.seed);
+
+	status = test_perfs_rx_pool(&traffic, terminals_nr, burst_size, workers_nrs, workers_nrs_nr,
+	                            cpus, cpus_nr);
+
+	printf("=== exit test with code %d\n", status);
+	traffic_free(&traffic);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the receivers pool performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE receivers pool performances test tool: measure the hub decapsulation\n"
+	        "throughput when the terminals are sharded on 1 to 32 worker threads.\n"
+	        "\n"
+	        "usage: test_perfs_rx_pool [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --workers, -w           Add a number of worker threads to test (default 1, 2,\n"
+	        "                          4, 8, 16 and 32), may be given several times\n"
+	        "  --pin                   Pin the dispatcher then every worker on its own CPU,\n"
+	        "                          among the CPUs the test may run on\n"
+	        "  --cpus, -c              Pin the dispatcher then the workers on the CPUs of the\n"
+	        "                          given list, e.g. '0,2,4-7' (implies --pin)\n"
+	        "  --terminals, -t         Number of terminals (default 1024)\n"
+	        "  --burst_size, -b        Burst size (default 123 octets)\n"
+	        "  --crc                   Protect the ALPDUs with CRC instead of SeqNo\n"
+	        "  --count, -n             Number of SDUs (default 200000)\n"
+	        "  --sizes, -S             Size distribution of the SDUs (default 'imix'),\n"
+	        "                          see test_traffic_gen\n"
+	        "  --ptypes, -p            Protocol types mix of the SDUs (default 'ipv4'),\n"
+	        "                          see test_traffic_gen\n"
+	        "  --flows, -f             Number of flows (frag_ids) per terminal (default 1)\n"
+	        "  --seed, -r              Seed of the traffic (default 0)\n"
+	        "  --verbose               Run the test in verbose mode\n");
+
+	return;
+}
+
+
+/**
+ * @brief  Get a monotonic timestamp
+ *
+ * @return the current time in nanoseconds
+ */
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/**
+ * @brief  Parse a list of CPUs
+ *
+ *         The list is comma-separated CPU[-LAST], e.g. "0,2,4-7".
+ *
+ * @param[in]  spec     The list
+ * @param[out] cpus     The CPUs
+ * @param[out] cpus_nr  The number of CPUs
+ * @return              0 in case of success, -1 if the list is malformed
+ */
+static int parse_cpus(const char *const spec, int *const cpus, size_t *const cpus_nr)
+{
+	const char *pos = spec;
+
+	*cpus_nr = 0;
+	while (*pos != '\0') {
+		char *end;
+		long first;
+		long last;
+
+		first = strtol(pos, &end, 10);
+		last = first;
+		if (end == pos) {
+			goto malformed;
+		}
+		if (*end == '-') {
+			pos = end + 1;
+			last = strtol(pos, &end, 10);
+			if (end == pos) {
+				goto malformed;
+			}
+		}
+		if (first < 0 || last < first || last >= CPU_SETSIZE ||
+		    *cpus_nr + (last - first + 1) > CPU_SETSIZE) {
+			goto malformed;
+		}
+		for ( ; first <= last; first++) {
+			cpus[(*cpus_nr)++] = first;
+		}
+		if (*end == ',') {
+			end++;
+		} else if (*end != '\0') {
+			goto malformed;
+		}
+		pos = end;
+	}
+	if (*cpus_nr == 0) {
+		goto malformed;
+	}
+
+	return 0;
+
+malformed:
+	printf("ERROR: malformed CPU list '%s'\n", spec);
+	return -1;
+}
+
+
+/**
+ * @brief Build the FPDUs of all the terminals
+ *
+ * The SDUs are given in turn to the terminals, then every terminal builds one FPDU in
+ * turn, as long as it has SDUs to send. The FPDUs begin with the payload label of their
+ * terminal.
+ *
+ * @param[in]  traffic       The SDUs
+ * @param[in]  conf          The RLE configuration
+ * @param[in]  terminals_nr  The number of terminals
+ * @param[out] fpdus         The FPDUs, fpdus->fpdu_size shall be set by the caller
+ * @return                   0 in case of success, 1 otherwise
+ */
+static int build_fpdus(const struct traffic *const traffic,
+                       const struct rle_config *const conf,
+                       const size_t terminals_nr,
+                       struct fpdus *const fpdus)
+{
+	struct rle_transmitter **transmitters;
+	size_t *next_sdus;
+	uint8_t *frag_ids;
+	size_t busy_nr = terminals_nr;
+	size_t i;
+	int status = 1;
+
+	transmitters = calloc(terminals_nr, sizeof(struct rle_transmitter *));
+	next_sdus = calloc(terminals_nr, sizeof(size_t));
+	frag_ids = calloc(terminals_nr, sizeof(uint8_t));
+	if (transmitters == NULL || next_sdus == NULL || frag_ids == NULL) {
+		printf("failed to allocate %zu terminals\n", terminals_nr);
+		goto free;
+	}
+	for (i = 0; i < terminals_nr; i++) {
+		transmitters[i] = rle_transmitter_new(conf);
+		if (transmitters[i] == NULL) {
+			printf("failed to create transmitter #%zu\n", i + 1);
+			goto destroy;
+		}
+		next_sdus[i] = i;
+	}
+
+	fpdus->fpdus_nr = 0;
+	fpdus->sdus_nr = 0;
+	fpdus->sdus_bytes = 0;
+	while (busy_nr > 0) {
+		busy_nr = 0;
+		for (i = 0; i < terminals_nr; i++) {
+			const unsigned char label[LABEL_LEN] = { (i >> 16) & 0xff, (i >> 8) & 0xff, i & 0xff };
+			unsigned char *fpdu;
+			size_t fpdu_cur_pos = 0;
+			size_t fpdu_remain_size = fpdus->fpdu_size;
+
+			if (next_sdus[i] >= traffic->sdus_nr &&
+			    rle_transmitter_stats_get_queue_size(transmitters[i], frag_ids[i]) == 0) {
+				continue;
+			}
+			busy_nr++;
+
+			if (fpdus->fpdus_nr == fpdus->fpdus_max_nr) {
+				const size_t max_nr = fpdus->fpdus_max_nr == 0 ? 1024 : 2 * fpdus->fpdus_max_nr;
+				unsigned char *const data = realloc(fpdus->data, max_nr * fpdus->fpdu_size);
+
+				if (data == NULL) {
+					printf("failed to allocate %zu FPDUs\n", max_nr);
+					goto destroy;
+				}
+				fpdus->data = data;
+				fpdus->fpdus_max_nr = max_nr;
+			}
+			fpdu = fpdus->data + fpdus->fpdus_nr * fpdus->fpdu_size;
+
+			if (rle_pack_init(label, LABEL_LEN, fpdu, &fpdu_cur_pos,
+			                  &fpdu_remain_size) != RLE_PACK_OK) {
+				printf("failed to start FPDU\n");
+				goto destroy;
+			}
+			while (fpdu_remain_size > 0) {
+				enum rle_frag_status frag_status;
+				unsigned char *ppdu;
+				size_t ppdu_length = 0;
+
+				if (rle_transmitter_stats_get_queue_size(transmitters[i], frag_ids[i]) == 0) {
+					const struct traffic_sdu *sdu;
+					struct rle_sdu sdu_in;
+
+					if (next_sdus[i] >= traffic->sdus_nr) {
+						break;
+					}
+					sdu = &traffic->sdus[next_sdus[i]];
+					sdu_in.buffer = sdu->data;
+					sdu_in.size = sdu->size;
+					sdu_in.protocol_type = sdu->protocol_type;
+					if (rle_encapsulate(transmitters[i], &sdu_in, sdu->frag_id) != RLE_ENCAP_OK) {
+						printf("failed to encapsulate SDU #%zu\n", next_sdus[i] + 1);
+						goto destroy;
+					}
+					frag_ids[i] = sdu->frag_id;
+					next_sdus[i] += terminals_nr;
+					fpdus->sdus_nr++;
+					fpdus->sdus_bytes += sdu->size;
+				}
+
+				frag_status = rle_fragment(transmitters[i], frag_ids[i], fpdu_remain_size,
+				                           &ppdu, &ppdu_length);
+				if (frag_status == RLE_FRAG_ERR_BURST_TOO_SMALL) {
+					break;
+				} else if (frag_status != RLE_FRAG_OK) {
+					printf("failed to fragment SDU\n");
+					goto destroy;
+				}
+				if (rle_pack(ppdu, ppdu_length, NULL, 0, fpdu, &fpdu_cur_pos,
+				             &fpdu_remain_size) != RLE_PACK_OK) {
+					printf("failed to pack PPDU\n");
+					goto destroy;
+				}
+			}
+			rle_pad(fpdu, fpdu_cur_pos, fpdu_remain_size);
+			fpdus->fpdus_nr++;
+		}
+	}
+	status = 0;
+
+destroy:
+	for (i = 0; i < terminals_nr; i++) {
+		if (transmitters[i] != NULL) {
+			rle_transmitter_destroy(&transmitters[i]);
+		}
+	}
+free:
+	free(frag_ids);
+	free(next_sdus);
+	free(transmitters);
+	return status;
+}
+
+
+/**
+ * @brief Collect the SDUs reassembled by all the workers of a pool
+ *
+ * @param[in,out] pool        The pool
+ * @param[in]     workers_nr  The number of workers of the pool
+ * @param[in,out] result      The result of the measure
+ */
+static void pool_collect(struct rx_pool *const pool, const size_t workers_nr,
+                         struct pool_result *const result)
+{
+	size_t i;
+
+	for (i = 0; i < workers_nr; i++) {
+		const struct rx_pool_sdu *sdu;
+
+		while ((sdu = rx_pool_peek(pool, i)) != NULL) {
+			result->sdus_nr++;
+			result->sdus_bytes += sdu->sdu.size;
+			rx_pool_release(pool, i);
+		}
+	}
+}
+
+
+/**
+ * @brief Decapsulate all the FPDUs with a receivers pool
+ *
+ * @param[in]  fpdus         The FPDUs
+ * @param[in]  conf          The RLE configuration
+ * @param[in]  terminals_nr  The number of terminals
+ * @param[in]  workers_nr    The number of workers of the pool
+ * @param[in]  cpus          The CPUs to pin the dispatcher then the workers on
+ * @param[in]  cpus_nr       The number of CPUs, 0 to not pin the threads
+ * @param[out] result        The result of the measure
+ * @return                   0 in case of success, 1 otherwise
+ */
+static int bench_pool(const struct fpdus *const fpdus,
+                      const struct rle_config *const conf,
+                      const size_t terminals_nr,
+                      const size_t workers_nr,
+                      const int *const cpus,
+                      const size_t cpus_nr,
+                      struct pool_result *const result)
+{
+	int *workers_cpus = NULL;
+	struct rx_pool_conf pool_conf = {
+		.rle_conf = *conf,
+		.workers_nr = workers_nr,
+		.payload_label_size = LABEL_LEN,
+		.ring_len = RING_LEN,
+		.terminals_max_nr = terminals_nr,
+		.cpus = NULL,
+	};
+	struct rx_pool *pool;
+	uint64_t start_ns;
+	size_t fpdu_id;
+	size_t i;
+	int status = 1;
+
+	memset(result, 0, sizeof(struct pool_result));
+
+	if (cpus_nr > 0) {
+		workers_cpus = malloc(workers_nr * sizeof(int));
+		if (workers_cpus == NULL) {
+			goto error;
+		}
+		for (i = 0; i < workers_nr; i++) {
+			workers_cpus[i] = cpus[(i + 1) % cpus_nr];
+		}
+		pool_conf.cpus = workers_cpus;
+	}
+
+	pool = rx_pool_new(&pool_conf);
+	if (pool == NULL) {
+		goto free_cpus;
+	}
+
+	start_ns = get_time_ns();
+	for (fpdu_id = 0; fpdu_id < fpdus->fpdus_nr; fpdu_id++) {
+		const unsigned char *const fpdu = fpdus->data + fpdu_id * fpdus->fpdu_size;
+		int ret;
+
+		/* the dispatcher collects the SDUs while the ring of the worker is full */
+		while ((ret = rx_pool_push(pool, fpdu, fpdus->fpdu_size)) == 1) {
+			pool_collect(pool, workers_nr, result);
+			sched_yield();
+		}
+		if (ret != 0) {
+			printf("failed to push FPDU #%zu\n", fpdu_id + 1);
+			goto destroy;
+		}
+	}
+
+	/* wait for the workers to handle all the FPDUs */
+	while (1) {
+		uint64_t fpdus_nr = 0;
+
+		pool_collect(pool, workers_nr, result);
+		for (i = 0; i < workers_nr; i++) {
+			struct rx_pool_stats stats;
+
+			rx_pool_get_stats(pool, i, &stats);
+			fpdus_nr += stats.fpdus_nr;
+		}
+		if (fpdus_nr == fpdus->fpdus_nr) {
+			break;
+		}
+		sched_yield();
+	}
+	pool_collect(pool, workers_nr, result);
+	result->elapsed_ns = get_time_ns() - start_ns;
+
+	result->terminals_min = UINT64_MAX;
+	for (i = 0; i < workers_nr; i++) {
+		struct rx_pool_stats stats;
+
+		rx_pool_get_stats(pool, i, &stats);
+		result->errors_nr += stats.errors_nr;
+		if (stats.terminals_nr < result->terminals_min) {
+			result->terminals_min = stats.terminals_nr;
+		}
+		if (stats.terminals_nr > result->terminals_max) {
+			result->terminals_max = stats.terminals_nr;
+		}
+	}
+	status = 0;
+
+destroy:
+	rx_pool_destroy(pool);
+free_cpus:
+	free(workers_cpus);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Measure the receivers pool throughput for every number of workers
+ *
+ * @param[in] traffic         The SDUs
+ * @param[in] terminals_nr    The number of terminals
+ * @param[in] burst_size      The size of the FPDUs
+ * @param[in] workers_nrs     The numbers of workers to test
+ * @param[in] workers_nrs_nr  The number of numbers of workers
+ * @param[in] cpus            The CPUs to pin the threads on
+ * @param[in] cpus_nr         The number of CPUs, 0 to not pin the threads
+ * @return                    0 in case of success, 1 otherwise
+ */
+static int test_perfs_rx_pool(const struct traffic *const traffic,
+                              const size_t terminals_nr,
+                              const size_t burst_size,
+                              const size_t *const workers_nrs,
+                              const size_t workers_nrs_nr,
+                              const int *const cpus,
+                              const size_t cpus_nr)
+{
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = use_crc,
+		.allow_alpdu_sequence_number = !use_crc,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	struct fpdus fpdus = {
+		.data = NULL,
+		.fpdu_size = burst_size,
+		.fpdus_nr = 0,
+		.fpdus_max_nr = 0,
+	};
+	double base_rate = 0;
+	size_t i;
+	int status = 1;
+
+	if (cpus_nr > 0) {
+		cpu_set_t cpu_set;
+
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cpus[0], &cpu_set);
+		if (sched_setaffinity(0, sizeof(cpu_set_t), &cpu_set) != 0) {
+			perror("failed to pin the dispatcher");
+			goto error;
+		}
+	}
+
+	if (build_fpdus(traffic, &conf, terminals_nr, &fpdus) != 0) {
+		goto free_fpdus;
+	}
+	printf("===\t%zu %zu-byte FPDUs built for %zu terminals (%" PRIu64 " SDUs)\n",
+	       fpdus.fpdus_nr, burst_size, terminals_nr, fpdus.sdus_nr);
+
+	printf("\n=== test: \n");
+	printf("%7s %12s %12s %8s %8s %11s\n", "workers", "FPDU/s", "SDU/s", "Gbit/s",
+	       "speedup", "terminals");
+	for (i = 0; i < workers_nrs_nr; i++) {
+		struct pool_result result;
+		double rate;
+
+		if (bench_pool(&fpdus, &conf, terminals_nr, workers_nrs[i], cpus, cpus_nr,
+		               &result) != 0) {
+			goto free_fpdus;
+		}
+		if (result.errors_nr != 0 || result.sdus_nr != fpdus.sdus_nr ||
+		    result.sdus_bytes != fpdus.sdus_bytes) {
+			printf("%zu workers: %" PRIu64 " SDUs (%" PRIu64 " bytes) collected instead of %"
+			       PRIu64 " (%" PRIu64 " bytes), %" PRIu64 " errors\n", workers_nrs[i],
+			       result.sdus_nr, result.sdus_bytes, fpdus.sdus_nr, fpdus.sdus_bytes,
+			       result.errors_nr);
+			goto free_fpdus;
+		}
+
+		rate = fpdus.fpdus_nr * 1e9 / result.elapsed_ns;
+		if (i == 0) {
+			base_rate = rate;
+		}
+		printf("%7zu %12.0f %12.0f %8.3f %8.2f %5" PRIu64 "-%-5" PRIu64 "\n", workers_nrs[i],
+		       rate, result.sdus_nr * 1e9 / result.elapsed_ns,
+		       result.sdus_bytes * 8.0 / result.elapsed_ns, rate / base_rate,
+		       result.terminals_min, result.terminals_max);
+		TRACE("%zu workers: %" PRIu64 " ns\n", workers_nrs[i], result.elapsed_ns);
+	}
+
+	printf("\n=== shutdown:\n");
+	status = 0;
+
+free_fpdus:
+	free(fpdus.data);
+error:
+	return status;
+}
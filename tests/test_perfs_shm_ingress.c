@@ -0,0 +1,815 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_shm_ingress.c
+ * @brief  Measure the SDU ingress of an RLE transmitter fed by other processes.
+ *
+ *         Producer processes send their SDUs to the transmitter process either through the
+ *         lanes of a shared memory ring, where the transmitter encapsulates the SDUs in place,
+ *         or through sockets, where the transmitter receives every SDU in a buffer before
+ *         encapsulating it. The SDU throughput of the transmitter and the occupancy of the
+ *         ring are reported.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* system includes */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+
+#include "rle.h"
+#include "test_traffic_gen.h"
+#include "test_shm_ring.h"
+
+/** The program version */
+#define TEST_VERSION  "RLE shared memory ingress performances test application, version 0.0.1\n"
+
+/** The maximal number of producers */
+#define MAX_PRODUCERS_NR 64U
+
+/** The default number of producers */
+#define DEFAULT_PRODUCERS_NR 2U
+
+/** The default number of SDUs per producer */
+#define DEFAULT_SDUS_NR 100000U
+
+/** The default number of descriptors per lane */
+#define DEFAULT_DESCS_NR 1024U
+
+/** The default length of the arena of every lane */
+#define DEFAULT_ARENA_LEN (1024U * 1024U)
+
+/** Min, max and default burst sizes */
+#define MIN_BURST_SIZE 14
+#define MAX_BURST_SIZE 599
+#define DEFAULT_BURST_SIZE 599U
+
+/** The length of the header of the SDUs sent on sockets: protocol type and frag_id */
+#define SOCKET_HDR_LEN 3U
+
+/** The ingress modes to measure */
+enum ingress_mode {
+	INGRESS_SHM    = 0x01,   /**< Shared memory ring */
+	INGRESS_SOCKET = 0x02,   /**< One socket per producer */
+};
+
+/** The FPDUs built by the transmitter, only counted */
+struct modem {
+	struct rle_transmitter *transmitter;  /**< The transmitter */
+	unsigned char fpdu[MAX_BURST_SIZE];   /**< The FPDU being filled */
+	size_t burst_size;                    /**< The size of the FPDUs */
+	size_t cur_pos;                       /**< The position in the FPDU */
+	size_t remain_size;                   /**< The room left in the FPDU */
+	uint64_t fpdus_nr;                    /**< The number of FPDUs sent */
+	uint64_t sdus_nr;                     /**< The number of SDUs encapsulated */
+	uint64_t sdus_bytes;                  /**< The number of SDU bytes encapsulated */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static uint64_t get_time_ns(void);
+static int modem_send(struct modem *const modem, const struct rle_sdu *const sdu,
+                      const uint8_t frag_id);
+static int shm_producer(struct shm_ring *const ring, const struct traffic *const traffic,
+                        const size_t producer, const size_t producers_nr);
+static int bench_shm(struct modem *const modem, const struct traffic *const traffic,
+                     const size_t producers_nr, const struct shm_ring_conf *const ring_conf,
+                     const char *const shm_name);
+static int socket_producer(const int sock, const struct traffic *const traffic,
+                           const size_t producer, const size_t producers_nr);
+static int bench_socket(struct modem *const modem, const struct traffic *const traffic,
+                        const size_t producers_nr);
+static int wait_producers(const pid_t *const pids, const size_t producers_nr,
+                          const bool abort);
+static int test_perfs_shm_ingress(const struct traffic *const traffic,
+                                  const size_t producers_nr,
+                                  const size_t burst_size,
+                                  const int modes,
+                                  const struct shm_ring_conf *const ring_conf,
+                                  const char *const shm_name);
+
+/** Whether the application runs in verbose mode or not */
+static int is_verbose = 0;
+
+/** Whether the ALPDUs are protected by CRC or SeqNo */
+static int use_crc = 0;
+
+#define TRACE(x ...) do { \
+		if (is_verbose) { printf(x); } \
+} while (0)
+
+
+/**
+ * @brief Main function for the RLE shared memory ingress performances test program
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	size_t producers_nr = DEFAULT_PRODUCERS_NR;
+	size_t sdus_nr = DEFAULT_SDUS_NR;
+	size_t burst_size = DEFAULT_BURST_SIZE;
+	int modes = INGRESS_SHM | INGRESS_SOCKET;
+	const char *shm_name = NULL;
+	struct shm_ring_conf ring_conf = {
+		.lanes_nr = DEFAULT_PRODUCERS_NR,
+		.descs_nr = DEFAULT_DESCS_NR,
+		.arena_len = DEFAULT_ARENA_LEN,
+	};
+	struct traffic_gen_conf gen_conf;
+	struct traffic traffic;
+
+	traffic_gen_conf_init(&gen_conf);
+
+	while (1) {
+		int c;
+
+		static struct option long_options[] =
+		{
+			{ "verbose", no_argument, &is_verbose, 1 },
+			{ "crc", no_argument, &use_crc, 1 },
+			{ "producers", required_argument, 0, 'P' },
+			{ "count", required_argument, 0, 'n' },
+			{ "burst_size", required_argument, 0, 'b' },
+			{ "mode", required_argument, 0, 'm' },
+			{ "name", required_argument, 0, 'N' },
+			{ "descs", required_argument, 0, 'd' },
+			{ "arena", required_argument, 0, 'a' },
+			{ "sizes", required_argument, 0, 'S' },
+			{ "ptypes", required_argument, 0, 'p' },
+			{ "flows", required_argument, 0, 'f' },
+			{ "seed", required_argument, 0, 'r' },
+			{ 0, 0, 0, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, "vhP:n:b:m:N:d:a:S:p:f:r:", long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 0:
+			/* If this option set a flag, do nothing else now. */
+			break;
+		case 'P': /* Number of producers */
+			assert(optarg != NULL);
+			producers_nr = strtoul(optarg, NULL, 10);
+			if (producers_nr == 0 || producers_nr > MAX_PRODUCERS_NR) {
+				printf("ERROR: the number of producers shall be within [1 ; %u]\n",
+				       MAX_PRODUCERS_NR);
+				goto error;
+			}
+			break;
+		case 'n': /* Number of SDUs per producer */
+			assert(optarg != NULL);
+			sdus_nr = strtoul(optarg, NULL, 10);
+			if (sdus_nr == 0) {
+				printf("ERROR: at least one SDU is required\n");
+				goto error;
+			}
+			break;
+		case 'b': /* Burst Size */
+			assert(optarg != NULL);
+			burst_size = strtoul(optarg, NULL, 10);
+			if (burst_size < MIN_BURST_SIZE || burst_size > MAX_BURST_SIZE) {
+				printf("ERROR: %zu burst size shall be within [%d ; %d] octets.\n",
+				       burst_size, MIN_BURST_SIZE, MAX_BURST_SIZE);
+				goto error;
+			}
+			break;
+		case 'm': /* Ingress modes */
+			assert(optarg != NULL);
+			if (strcmp(optarg, "shm") == 0) {
+				modes = INGRESS_SHM;
+			} else if (strcmp(optarg, "socket") == 0) {
+				modes = INGRESS_SOCKET;
+			} else if (strcmp(optarg, "both") == 0) {
+				modes = INGRESS_SHM | INGRESS_SOCKET;
+			} else {
+				printf("ERROR: unknown mode '%s'\n", optarg);
+				goto error;
+			}
+			break;
+		case 'N': /* POSIX shared memory name */
+			assert(optarg != NULL);
+			shm_name = optarg;
+			break;
+		case 'd': /* Number of descriptors per lane */
+			assert(optarg != NULL);
+			ring_conf.descs_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'a': /* Length of the arena of every lane */
+			assert(optarg != NULL);
+			ring_conf.arena_len = strtoul(optarg, NULL, 10);
+			break;
+		case 'S': /* Size distribution */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_sizes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'p': /* Protocol types mix */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_ptypes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'f': /* Number of flows */
+			assert(optarg != NULL);
+			gen_conf.flows_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'r': /* Seed of the traffic */
+			assert(optarg != NULL);
+			gen_conf.seed = strtoul(optarg, NULL, 10);
+			break;
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc) {
+		usage();
+		goto error;
+	}
+	ring_conf.lanes_nr = producers_nr;
+
+	printf("=== initialization:\n");
+	if (traffic_gen(&gen_conf, producers_nr * sdus_nr, 0, &traffic) != 0) {
+		goto error;
+	}
+	printf("===\t%zu synthetic packets generated (seed %u)\n", traffic.sdus_nr, gen_conf.seed);
+
+	status = test_perfs_shm_ingress(&traffic, producers_nr, burst_size, modes, &ring_conf,
+	                                shm_name);
+
+	printf("=== exit test with code %d\n", status);
+	traffic_free(&traffic);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the shared memory ingress performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE shared memory ingress performances test tool: producer processes send SDUs\n"
+	        "to the transmitter process through a shared memory ring, encapsulated in place,\n"
+	        "or through sockets. Report the SDU throughput and the ring occupancy.\n"
+	        "\n"
+	        "usage: test_perfs_shm_ingress [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --producers, -P         Number of producer processes (default 2)\n"
+	        "  --count, -n             Number of SDUs per producer (default 100000)\n"
+	        "  --burst_size, -b        Burst size (default 599 octets)\n"
+	        "  --mode, -m              Ingress to measure: shm, socket or both (default both)\n"
+	        "  --name, -N              Name of the POSIX shared memory (shm_open), an anonymous\n"
+	        "                          memfd is used otherwise\n"
+	        "  --descs, -d             Number of SDU descriptors per producer lane, a power\n"
+	        "                          of 2 (default 1024)\n"
+	        "  --arena, -a             Length of the payload arena per producer lane\n"
+	        "                          (default 1048576 octets)\n"
+	        "  --crc                   Protect the ALPDUs with CRC instead of SeqNo\n"
+	        "  --sizes, -S             Size distribution of the SDUs (default 'imix'),\n"
+	        "                          see test_traffic_gen\n"
+	        "  --ptypes, -p            Protocol types mix of the SDUs (default 'ipv4'),\n"
+	        "                          see test_traffic_gen\n"
+	        "  --flows, -f             Number of flows (frag_ids) (default 1)\n"
+	        "  --seed, -r              Seed of the traffic (default 0)\n"
+	        "  --verbose               Run the test in verbose mode\n");
+
+	return;
+}
+
+
+/**
+ * @brief  Get a monotonic timestamp
+ *
+ * @return the current time in nanoseconds
+ */
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/**
+ * @brief Encapsulate one SDU, then fragment and pack it in the FPDUs of the modem
+ *
+ * The SDU is copied by rle_encapsulate(), so its buffer may be reused once the function
+ * returns.
+ *
+ * @param[in,out] modem    The modem
+ * @param[in]     sdu      The SDU
+ * @param[in]     frag_id  The frag_id of the SDU
+ * @return                 0 in case of success, -1 otherwise
+ */
+static int modem_send(struct modem *const modem, const struct rle_sdu *const sdu,
+                      const uint8_t frag_id)
+{
+	if (rle_encapsulate(modem->transmitter, sdu, frag_id) != RLE_ENCAP_OK) {
+		printf("failed to encapsulate SDU\n");
+		return -1;
+	}
+	modem->sdus_nr++;
+	modem->sdus_bytes += sdu->size;
+
+	while (rle_transmitter_stats_get_queue_size(modem->transmitter, frag_id) != 0) {
+		enum rle_frag_status ret_frag;
+		unsigned char *ppdu;
+		size_t ppdu_length = 0;
+
+		ret_frag = rle_fragment(modem->transmitter, frag_id, modem->remain_size, &ppdu,
+		                        &ppdu_length);
+		if (ret_frag == RLE_FRAG_ERR_BURST_TOO_SMALL && modem->cur_pos != 0) {
+			/* not enough room for a PPDU in the current FPDU, send it */
+			rle_pad(modem->fpdu, modem->cur_pos, modem->remain_size);
+			modem->fpdus_nr++;
+			modem->cur_pos = 0;
+			modem->remain_size = modem->burst_size;
+			continue;
+		} else if (ret_frag != RLE_FRAG_OK) {
+			printf("failed to fragment SDU\n");
+			return -1;
+		}
+		if (rle_pack(ppdu, ppdu_length, NULL, 0, modem->fpdu, &modem->cur_pos,
+		             &modem->remain_size) != RLE_PACK_OK) {
+			printf("failed to pack PPDU\n");
+			return -1;
+		}
+		if (modem->remain_size == 0) {
+			modem->fpdus_nr++;
+			modem->cur_pos = 0;
+			modem->remain_size = modem->burst_size;
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Write the SDUs of a producer in its lane of the shared memory ring
+ *
+ * The producer takes one SDU of the traffic out of producers_nr. The function is run by a
+ * child process.
+ *
+ * @param[in,out] ring          The shared memory ring
+ * @param[in]     traffic       The SDUs of all the producers
+ * @param[in]     producer      The producer
+ * @param[in]     producers_nr  The number of producers
+ * @return                      0 in case of success, 1 otherwise
+ */
+static int shm_producer(struct shm_ring *const ring, const struct traffic *const traffic,
+                        const size_t producer, const size_t producers_nr)
+{
+	const int lane = shm_ring_lane_acquire(ring);
+	size_t i;
+
+	if (lane < 0) {
+		printf("producer #%zu: no free lane\n", producer + 1);
+		return 1;
+	}
+
+	for (i = producer; i < traffic->sdus_nr; i += producers_nr) {
+		const struct traffic_sdu *const sdu = &traffic->sdus[i];
+		unsigned char *buf;
+
+		while ((buf = shm_ring_reserve(ring, lane, sdu->size)) == NULL) {
+			sched_yield();
+		}
+		/* a real producer would build its packet here, directly in the shared memory */
+		memcpy(buf, sdu->data, sdu->size);
+		shm_ring_commit(ring, lane, sdu->protocol_type, sdu->frag_id);
+	}
+	shm_ring_lane_close(ring, lane);
+
+	return 0;
+}
+
+
+/**
+ * @brief Measure the ingress through the shared memory ring
+ *
+ * @param[in,out] modem         The modem
+ * @param[in]     traffic       The SDUs of all the producers
+ * @param[in]     producers_nr  The number of producers
+ * @param[in]     ring_conf     The configuration of the ring
+ * @param[in]     shm_name      The POSIX shared memory name, NULL for a memfd
+ * @return                      0 in case of success, 1 otherwise
+ */
+static int bench_shm(struct modem *const modem, const struct traffic *const traffic,
+                     const size_t producers_nr, const struct shm_ring_conf *const ring_conf,
+                     const char *const shm_name)
+{
+	pid_t pids[MAX_PRODUCERS_NR];
+	struct shm_ring ring;
+	size_t closed_nr = 0;
+	bool closed[MAX_PRODUCERS_NR] = { false };
+	uint64_t start_ns;
+	uint64_t elapsed_ns;
+	size_t i;
+	int status = 1;
+
+	if (shm_ring_create(&ring, shm_name, ring_conf) != 0) {
+		goto error;
+	}
+
+	start_ns = get_time_ns();
+	for (i = 0; i < producers_nr; i++) {
+		pids[i] = fork();
+		if (pids[i] < 0) {
+			perror("failed to start producer");
+			break;
+		} else if (pids[i] == 0) {
+			struct shm_ring producer_ring;
+			int ret = 1;
+
+			/* the producer maps the ring by its name if any, as an independent process */
+			if (shm_name == NULL) {
+				ret = shm_producer(&ring, traffic, i, producers_nr);
+			} else if (shm_ring_attach(&producer_ring, shm_name) == 0) {
+				ret = shm_producer(&producer_ring, traffic, i, producers_nr);
+				shm_ring_close(&producer_ring, NULL);
+			}
+			_exit(ret);
+		}
+	}
+	if (i < producers_nr) {
+		wait_producers(pids, i, true);
+		goto close;
+	}
+
+	/* the transmitter takes the SDUs of the lanes in turn, and encapsulates them in place */
+	while (closed_nr < producers_nr) {
+		bool idle = true;
+
+		for (i = 0; i < producers_nr; i++) {
+			struct rle_sdu sdu;
+			uint8_t frag_id;
+			int ret;
+
+			if (closed[i]) {
+				continue;
+			}
+			ret = shm_ring_peek(&ring, i, &sdu, &frag_id);
+			if (ret < 0) {
+				closed[i] = true;
+				closed_nr++;
+			} else if (ret > 0) {
+				if (modem_send(modem, &sdu, frag_id) != 0) {
+					wait_producers(pids, producers_nr, true);
+					goto close;
+				}
+				shm_ring_release(&ring, i);
+				idle = false;
+			}
+		}
+		if (idle) {
+			sched_yield();
+		}
+	}
+	elapsed_ns = get_time_ns() - start_ns;
+
+	if (wait_producers(pids, producers_nr, false) != 0) {
+		goto close;
+	}
+
+	printf("shm:    %10.0f SDU/s %8.3f Gbit/s  %" PRIu64 " FPDUs\n",
+	       modem->sdus_nr * 1e9 / elapsed_ns, modem->sdus_bytes * 8.0 / elapsed_ns,
+	       modem->fpdus_nr);
+	for (i = 0; i < producers_nr; i++) {
+		struct shm_ring_stats stats;
+
+		shm_ring_get_stats(&ring, i, &stats);
+		printf("  lane #%zu: %" PRIu64 " SDUs, descriptors mean %.1f max %" PRIu64 "/%zu, "
+		       "arena max %" PRIu64 "/%zu, %" PRIu64 " full\n", i + 1, stats.sdus_nr,
+		       stats.peeks_nr > 0 ? (double)stats.descs_used_sum / stats.peeks_nr : 0.0,
+		       stats.descs_max_used, ring_conf->descs_nr, stats.arena_max_used,
+		       ring_conf->arena_len, stats.full_nr);
+	}
+	status = 0;
+
+close:
+	shm_ring_close(&ring, shm_name);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Send the SDUs of a producer on its socket
+ *
+ * Every SDU is sent as one message, after its protocol type and frag_id. The function is
+ * run by a child process.
+ *
+ * @param[in] sock          The socket of the producer
+ * @param[in] traffic       The SDUs of all the producers
+ * @param[in] producer      The producer
+ * @param[in] producers_nr  The number of producers
+ * @return                  0 in case of success, 1 otherwise
+ */
+static int socket_producer(const int sock, const struct traffic *const traffic,
+                           const size_t producer, const size_t producers_nr)
+{
+	size_t i;
+
+	for (i = producer; i < traffic->sdus_nr; i += producers_nr) {
+		const struct traffic_sdu *const sdu = &traffic->sdus[i];
+		unsigned char hdr[SOCKET_HDR_LEN] = {
+			sdu->protocol_type >> 8, sdu->protocol_type & 0xff, sdu->frag_id
+		};
+		struct iovec iov[2] = {
+			{ .iov_base = hdr, .iov_len = SOCKET_HDR_LEN },
+			{ .iov_base = sdu->data, .iov_len = sdu->size },
+		};
+		struct msghdr msg;
+
+		memset(&msg, 0, sizeof(struct msghdr));
+		msg.msg_iov = iov;
+		msg.msg_iovlen = 2;
+		if (sendmsg(sock, &msg, 0) < 0) {
+			perror("failed to send SDU");
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Measure the ingress through sockets
+ *
+ * @param[in,out] modem         The modem
+ * @param[in]     traffic       The SDUs of all the producers
+ * @param[in]     producers_nr  The number of producers
+ * @return                      0 in case of success, 1 otherwise
+ */
+static int bench_socket(struct modem *const modem, const struct traffic *const traffic,
+                        const size_t producers_nr)
+{
+	unsigned char buf[SOCKET_HDR_LEN + RLE_MAX_PDU_SIZE];
+	pid_t pids[MAX_PRODUCERS_NR];
+	int socks[MAX_PRODUCERS_NR];
+	size_t closed_nr = 0;
+	uint64_t start_ns;
+	uint64_t elapsed_ns;
+	size_t socks_nr;
+	size_t i;
+	int status = 1;
+
+	start_ns = get_time_ns();
+	for (socks_nr = 0; socks_nr < producers_nr; socks_nr++) {
+		int pair[2];
+
+		if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, pair) != 0) {
+			perror("failed to create socket");
+			goto close;
+		}
+		socks[socks_nr] = pair[0];
+
+		pids[socks_nr] = fork();
+		if (pids[socks_nr] < 0) {
+			perror("failed to start producer");
+			close(pair[1]);
+			close(pair[0]);
+			goto close;
+		} else if (pids[socks_nr] == 0) {
+			close(pair[0]);
+			_exit(socket_producer(pair[1], traffic, socks_nr, producers_nr));
+		}
+		close(pair[1]);
+	}
+
+	/* the transmitter receives the SDUs of the sockets in turn, then encapsulates them */
+	while (closed_nr < producers_nr) {
+		bool idle = true;
+
+		for (i = 0; i < producers_nr; i++) {
+			struct rle_sdu sdu;
+			ssize_t len;
+
+			if (socks[i] < 0) {
+				continue;
+			}
+			len = recv(socks[i], buf, sizeof(buf), MSG_DONTWAIT);
+			if (len == 0) {
+				close(socks[i]);
+				socks[i] = -1;
+				closed_nr++;
+				continue;
+			} else if (len < 0) {
+				if (errno == EAGAIN || errno == EWOULDBLOCK) {
+					continue;
+				}
+				perror("failed to receive SDU");
+				goto close;
+			} else if (len < SOCKET_HDR_LEN) {
+				printf("truncated SDU received\n");
+				goto close;
+			}
+			sdu.buffer = buf + SOCKET_HDR_LEN;
+			sdu.size = len - SOCKET_HDR_LEN;
+			sdu.protocol_type = (buf[0] << 8) | buf[1];
+			if (modem_send(modem, &sdu, buf[2]) != 0) {
+				goto close;
+			}
+			idle = false;
+		}
+		if (idle) {
+			sched_yield();
+		}
+	}
+	elapsed_ns = get_time_ns() - start_ns;
+
+	printf("socket: %10.0f SDU/s %8.3f Gbit/s  %" PRIu64 " FPDUs\n",
+	       modem->sdus_nr * 1e9 / elapsed_ns, modem->sdus_bytes * 8.0 / elapsed_ns,
+	       modem->fpdus_nr);
+	status = 0;
+
+close:
+	for (i = 0; i < socks_nr; i++) {
+		if (socks[i] >= 0) {
+			close(socks[i]);
+		}
+	}
+	if (wait_producers(pids, socks_nr, status != 0) != 0) {
+		status = 1;
+	}
+	return status;
+}
+
+
+/**
+ * @brief Wait for the end of the producer processes
+ *
+ * @param[in] pids          The producers
+ * @param[in] producers_nr  The number of producers
+ * @param[in] abort         Whether to kill the producers first, that may wait for room
+ * @return                  0 if all of them succeeded, -1 otherwise
+ */
+static int wait_producers(const pid_t *const pids, const size_t producers_nr,
+                          const bool abort)
+{
+	int status = 0;
+	size_t i;
+
+	for (i = 0; i < producers_nr; i++) {
+		int wstatus;
+
+		if (abort) {
+			kill(pids[i], SIGKILL);
+		}
+
+		if (waitpid(pids[i], &wstatus, 0) != pids[i] || !WIFEXITED(wstatus) ||
+		    WEXITSTATUS(wstatus) != 0) {
+			printf("producer #%zu failed\n", i + 1);
+			status = -1;
+		}
+	}
+
+	return status;
+}
+
+
+/**
+ * @brief Measure the ingress of the transmitter in the given modes
+ *
+ * @param[in] traffic       The SDUs of all the producers
+ * @param[in] producers_nr  The number of producers
+ * @param[in] burst_size    The size of the FPDUs
+ * @param[in] modes         The ingress modes to measure, see enum ingress_mode
+ * @param[in] ring_conf     The configuration of the shared memory ring
+ * @param[in] shm_name      The POSIX shared memory name, NULL for a memfd
+ * @return                  0 in case of success, 1 otherwise
+ */
+static int test_perfs_shm_ingress(const struct traffic *const traffic,
+                                  const size_t producers_nr,
+                                  const size_t burst_size,
+                                  const int modes,
+                                  const struct shm_ring_conf *const ring_conf,
+                                  const char *const shm_name)
+{
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = use_crc,
+		.allow_alpdu_sequence_number = !use_crc,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const int all_modes[] = { INGRESS_SHM, INGRESS_SOCKET };
+	size_t i;
+	int status = 1;
+
+	printf("\n=== test: \n");
+	printf("===\t%zu producers, %zu-byte FPDUs, %s\n", producers_nr, burst_size,
+	       use_crc ? "CRC" : "SeqNo");
+
+	for (i = 0; i < sizeof(all_modes) / sizeof(all_modes[0]); i++) {
+		struct modem modem;
+		int ret;
+
+		if ((modes & all_modes[i]) == 0) {
+			continue;
+		}
+
+		memset(&modem, 0, sizeof(struct modem));
+		modem.burst_size = burst_size;
+		modem.remain_size = burst_size;
+		modem.transmitter = rle_transmitter_new(&conf);
+		if (modem.transmitter == NULL) {
+			printf("failed to create transmitter\n");
+			goto error;
+		}
+
+		/* the output is flushed, not to be duplicated by the producer processes */
+		fflush(stdout);
+		if (all_modes[i] == INGRESS_SHM) {
+			ret = bench_shm(&modem, traffic, producers_nr, ring_conf, shm_name);
+		} else {
+			ret = bench_socket(&modem, traffic, producers_nr);
+		}
+		rle_transmitter_destroy(&modem.transmitter);
+		if (ret != 0) {
+			goto error;
+		}
+		if (modem.sdus_nr != traffic->sdus_nr) {
+			printf("%" PRIu64 " SDUs encapsulated instead of %zu\n", modem.sdus_nr,
+			       traffic->sdus_nr);
+			goto error;
+		}
+		TRACE("%" PRIu64 " SDU bytes encapsulated\n", modem.sdus_bytes);
+	}
+
+	printf("\n=== shutdown:\n");
+	status = 0;
+
+error:
+	return status;
+}
@@ -0,0 +1,1079 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_superframe.c
+ * @brief  Simulate the RLE traffic of a DVB-RCS2 return link superframe.
+ *
+ *         Terminals with their own waveform (MODCOD) receive bursts from a burst time plan.
+ *         Every terminal fills its bursts with its queued SDUs, then the hub decapsulates all
+ *         the bursts of the superframe. The bytes on air efficiency, the SDU latency in
+ *         timeslots and the CPU time per superframe are reported.
+ *
+ *         The bursts may be built by a work-stealing pool of threads, every terminal with all
+ *         its bursts of the superframe being one task, to measure how the build time scales
+ *         with the number of cores.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* for sched_getaffinity() */
+#define _GNU_SOURCE
+
+/* system includes */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <time.h>
+#include <sched.h>
+#include <getopt.h>
+
+#include "rle.h"
+#include "test_traffic_gen.h"
+#include "test_tx_pool.h"
+
+/** The program version */
+#define TEST_VERSION  "RLE superframe simulation test application, version 0.0.1\n"
+
+/** The default number of terminals */
+#define DEFAULT_TERMINALS_NR 32U
+
+/** The default number of carriers of the superframe */
+#define DEFAULT_CARRIERS_NR 4U
+
+/** The default number of timeslots of every carrier in one superframe */
+#define DEFAULT_SLOTS_NR 32U
+
+/** The default number of superframes to simulate */
+#define DEFAULT_SUPERFRAMES_NR 1000U
+
+/** The default offered load, relative to the capacity of the terminal */
+#define DEFAULT_LOAD 0.8
+
+/** The default probability that the waveform of a terminal changes at a superframe */
+#define DEFAULT_FADE_RATE 0.05
+
+/** The number of SDUs of the traffic shared by the terminals */
+#define SDUS_NR 4096U
+
+/** The number of SDUs that may wait in the queue of a terminal (power of 2) */
+#define QUEUE_LEN 4096U
+
+/** The number of bins of the latency histogram, in timeslots */
+#define LATENCY_HIST_LEN 65536U
+
+/** The maximal number of SDUs in one burst */
+#define BURST_SDUS_MAX_NR 300U
+
+/** The length of the SDU buffers given to the receiver (room for VLAN ptype re-insertion) */
+#define SDU_BUF_LEN  (RLE_MAX_PDU_SIZE + 4U)
+
+/** A waveform of the burst time plan */
+struct waveform {
+	const char *name;   /**< The modulation and coding */
+	uint16_t symbols;   /**< The length of the burst in symbols */
+	uint16_t payload;   /**< The payload of the burst in bytes */
+};
+
+/** An SDU waiting in the queue of a terminal, or being sent */
+struct queue_entry {
+	uint32_t sdu_id;   /**< The SDU of the traffic */
+	uint32_t arrival;  /**< The timeslot of arrival of the SDU */
+};
+
+/** One terminal and its receiver at the hub */
+struct terminal {
+	struct rle_transmitter *transmitter;  /**< The transmitter of the terminal */
+	struct rle_receiver *receiver;        /**< The receiver of the terminal at the hub */
+	size_t wf_id;                         /**< The current waveform of the terminal */
+	struct queue_entry queue[QUEUE_LEN];  /**< The SDUs queued or being sent */
+	size_t head;                          /**< The oldest SDU not delivered yet */
+	size_t sent;                          /**< The next SDU to encapsulate */
+	size_t tail;                          /**< The next free entry of the queue */
+	uint8_t frag_id;                      /**< The frag_id of the SDU being fragmented */
+	uint64_t next_arrival_slot;           /**< The next timeslot to generate arrivals for */
+	double credit;                        /**< The bytes offered but not queued yet */
+	size_t next_sdu;                      /**< The next SDU of the traffic to arrive */
+};
+
+/** One burst of the superframe */
+struct burst {
+	struct terminal *terminal;  /**< The terminal the burst is allocated to */
+	uint64_t slot;              /**< The timeslot of the burst */
+	size_t size;                /**< The payload of the burst */
+	unsigned char *fpdu;        /**< The FPDU sent in the burst */
+};
+
+/** The statistics of the simulation */
+struct superframe_stats {
+	uint64_t bursts_nr;             /**< The number of bursts */
+	uint64_t idle_bursts_nr;        /**< The number of bursts without any PPDU */
+	uint64_t air_bytes;             /**< The payload bytes of all the bursts */
+	uint64_t padding_bytes;         /**< The padding bytes of all the bursts */
+	uint64_t sdu_bytes;             /**< The bytes of the SDUs delivered */
+	uint64_t sdus_offered;          /**< The number of SDUs arrived at the terminals */
+	uint64_t sdus_overflow;         /**< The number of SDUs dropped because of full queues */
+	uint64_t sdus_delivered;        /**< The number of SDUs delivered by the hub */
+	uint64_t latency_hist[LATENCY_HIST_LEN];  /**< The latencies in timeslots */
+	uint64_t tx_ns;                 /**< The time spent by the transmitters */
+	uint64_t tx_ns_max;             /**< The maximal time spent by the transmitters in a SF */
+	uint64_t hub_ns;                /**< The time spent by the hub */
+	uint64_t hub_ns_max;            /**< The maximal time spent by the hub in a superframe */
+};
+
+/** The parameters of the simulation */
+struct superframe_conf {
+	size_t terminals_nr;       /**< The number of terminals */
+	size_t carriers_nr;        /**< The number of carriers */
+	size_t slots_nr;           /**< The number of timeslots per carrier and superframe */
+	size_t superframes_nr;     /**< The number of superframes */
+	double load;               /**< The offered load, relative to the capacity */
+	double fade_rate;          /**< The probability of a waveform change per superframe */
+	const struct waveform *wfs;  /**< The waveforms the terminals may use */
+	size_t wfs_nr;             /**< The number of waveforms */
+	int use_crc;               /**< Whether the ALPDUs are protected by CRC or SeqNo */
+	size_t threads_nr;         /**< The number of threads building the bursts, 0 for none */
+	int pin;                   /**< Whether the threads are pinned on CPUs or not */
+};
+
+/** The bursts of a superframe to build with the pool of threads */
+struct tx_job {
+	const struct superframe_conf *conf;   /**< The parameters of the simulation */
+	const struct traffic *traffic;        /**< The SDUs */
+	struct burst *bursts;                 /**< The bursts of the superframe */
+	size_t *tasks;                        /**< The first burst of every task, plus the end */
+	size_t *order;                        /**< The bursts, grouped by terminal */
+	size_t *counts;                       /**< The number of bursts of every terminal */
+	struct superframe_stats *stats;       /**< The statistics of every worker */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static uint64_t get_time_ns(void);
+static double rand_uniform(uint64_t *const state);
+static void terminal_arrivals(struct terminal *const terminal,
+                              const struct superframe_conf *const conf,
+                              const struct traffic *const traffic,
+                              const uint64_t slot,
+                              struct superframe_stats *const stats);
+static int terminal_build_burst(struct terminal *const terminal,
+                                const struct traffic *const traffic,
+                                struct burst *const burst,
+                                struct superframe_stats *const stats);
+static int terminal_build_bursts(void *const arg, const size_t task_id,
+                                 const size_t worker_id);
+static size_t tx_job_tasks(struct tx_job *const job, const struct terminal *const terminals,
+                           const size_t bursts_nr);
+static void tx_job_merge_stats(struct tx_job *const job, struct superframe_stats *const stats);
+static int hub_receive_burst(const struct burst *const burst,
+                             const struct traffic *const traffic,
+                             struct rle_sdu *const sdus,
+                             struct superframe_stats *const stats);
+static uint64_t latency_percentile(const struct superframe_stats *const stats,
+                                   const double percentile);
+static void print_stats(const struct superframe_conf *const conf,
+                        const struct superframe_stats *const stats,
+                        const struct terminal *const terminals);
+static int test_perfs_superframe(const struct superframe_conf *const conf,
+                                 const struct traffic *const traffic,
+                                 const uint32_t seed);
+
+/** Whether the application runs in verbose mode or not */
+static int is_verbose = 0;
+
+/** The payloads of the DVB-RCS2 reference waveforms with short (536 symbols) and long
+ *  (1616 symbols) bursts, from the most robust to the most efficient */
+static const struct waveform waveforms[] = {
+	{ "BPSK 1/3", 536, 14 },
+	{ "QPSK 1/3", 536, 38 },
+	{ "QPSK 1/2", 536, 59 },
+	{ "QPSK 2/3", 536, 80 },
+	{ "QPSK 3/4", 536, 90 },
+	{ "QPSK 5/6", 536, 99 },
+	{ "8PSK 2/3", 536, 123 },
+	{ "8PSK 3/4", 536, 138 },
+	{ "8PSK 5/6", 536, 155 },
+	{ "16QAM 3/4", 536, 188 },
+	{ "16QAM 5/6", 536, 209 },
+	{ "QPSK 1/3", 1616, 120 },
+	{ "QPSK 1/2", 1616, 179 },
+	{ "QPSK 2/3", 1616, 240 },
+	{ "QPSK 3/4", 1616, 270 },
+	{ "QPSK 5/6", 1616, 301 },
+	{ "8PSK 2/3", 1616, 363 },
+	{ "8PSK 3/4", 1616, 411 },
+	{ "8PSK 5/6", 1616, 458 },
+	{ "16QAM 3/4", 1616, 550 },
+	{ "16QAM 5/6", 1616, 599 },
+};
+
+/** The number of waveforms with short bursts */
+#define SHORT_WFS_NR 11U
+
+#define TRACE(x ...) do { \
+		if (is_verbose) { printf(x); } \
+} while (0)
+
+
+/**
+ * @brief Main function for the RLE superframe simulation test program
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	struct superframe_conf conf = {
+		.terminals_nr = DEFAULT_TERMINALS_NR,
+		.carriers_nr = DEFAULT_CARRIERS_NR,
+		.slots_nr = DEFAULT_SLOTS_NR,
+		.superframes_nr = DEFAULT_SUPERFRAMES_NR,
+		.load = DEFAULT_LOAD,
+		.fade_rate = DEFAULT_FADE_RATE,
+		.wfs = waveforms + SHORT_WFS_NR,
+		.wfs_nr = sizeof(waveforms) / sizeof(waveforms[0]) - SHORT_WFS_NR,
+		.use_crc = 0,
+		.threads_nr = 0,
+		.pin = 0,
+	};
+	struct traffic_gen_conf gen_conf;
+	struct traffic traffic;
+
+	traffic_gen_conf_init(&gen_conf);
+
+	while (1) {
+		int c;
+
+		static struct option long_options[] =
+		{
+			{ "verbose", no_argument, &is_verbose, 1 },
+			{ "crc", no_argument, 0, 'C' },
+			{ "threads", required_argument, 0, 'T' },
+			{ "pin", no_argument, 0, 'P' },
+			{ "terminals", required_argument, 0, 't' },
+			{ "carriers", required_argument, 0, 'c' },
+			{ "slots", required_argument, 0, 's' },
+			{ "superframes", required_argument, 0, 'n' },
+			{ "load", required_argument, 0, 'l' },
+			{ "fade", required_argument, 0, 'F' },
+			{ "waveforms", required_argument, 0, 'w' },
+			{ "sizes", required_argument, 0, 'S' },
+			{ "ptypes", required_argument, 0, 'p' },
+			{ "flows", required_argument, 0, 'f' },
+			{ "seed", required_argument, 0, 'r' },
+			{ 0, 0, 0, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, "vhCPT:t:c:s:n:l:F:w:S:p:f:r:", long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 0:
+			/* If this option set a flag, do nothing else now. */
+			break;
+		case 'C': /* CRC protection */
+			conf.use_crc = 1;
+			break;
+		case 'T': /* Number of threads building the bursts */
+			assert(optarg != NULL);
+			conf.threads_nr = strtoul(optarg, NULL, 10);
+			if (conf.threads_nr > CPU_SETSIZE) {
+				printf("ERROR: %zu threads requested, maximum = %d\n", conf.threads_nr,
+				       CPU_SETSIZE);
+				goto error;
+			}
+			break;
+		case 'P': /* Pin the threads */
+			conf.pin = 1;
+			break;
+		case 't': /* Number of terminals */
+			assert(optarg != NULL);
+			conf.terminals_nr = strtoul(optarg, NULL, 10);
+			if (conf.terminals_nr == 0) {
+				printf("ERROR: at least one terminal is required\n");
+				goto error;
+			}
+			break;
+		case 'c': /* Number of carriers */
+			assert(optarg != NULL);
+			conf.carriers_nr = strtoul(optarg, NULL, 10);
+			if (conf.carriers_nr == 0) {
+				printf("ERROR: at least one carrier is required\n");
+				goto error;
+			}
+			break;
+		case 's': /* Number of timeslots per carrier */
+			assert(optarg != NULL);
+			conf.slots_nr = strtoul(optarg, NULL, 10);
+			if (conf.slots_nr == 0) {
+				printf("ERROR: at least one timeslot is required\n");
+				goto error;
+			}
+			break;
+		case 'n': /* Number of superframes */
+			assert(optarg != NULL);
+			conf.superframes_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'l': /* Offered load */
+			assert(optarg != NULL);
+			conf.load = strtod(optarg, NULL);
+			if (conf.load < 0) {
+				printf("ERROR: load shall be positive\n");
+				goto error;
+			}
+			break;
+		case 'F': /* Probability of waveform change */
+			assert(optarg != NULL);
+			conf.fade_rate = strtod(optarg, NULL);
+			if (conf.fade_rate < 0 || conf.fade_rate > 1) {
+				printf("ERROR: fade rate shall be within [0 ; 1]\n");
+				goto error;
+			}
+			break;
+		case 'w': /* Waveforms */
+			assert(optarg != NULL);
+			if (strcmp(optarg, "short") == 0) {
+				conf.wfs = waveforms;
+				conf.wfs_nr = SHORT_WFS_NR;
+			} else if (strcmp(optarg, "long") == 0) {
+				conf.wfs = waveforms + SHORT_WFS_NR;
+				conf.wfs_nr = sizeof(waveforms) / sizeof(waveforms[0]) - SHORT_WFS_NR;
+			} else if (strcmp(optarg, "all") == 0) {
+				conf.wfs = waveforms;
+				conf.wfs_nr = sizeof(waveforms) / sizeof(waveforms[0]);
+			} else {
+				printf("ERROR: unknown waveforms '%s'\n", optarg);
+				goto error;
+			}
+			break;
+		case 'S': /* Size distribution */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_sizes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'p': /* Protocol types mix */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_ptypes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'f': /* Number of flows per terminal */
+			assert(optarg != NULL);
+			gen_conf.flows_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'r': /* Seed of the traffic and of the burst time plan */
+			assert(optarg != NULL);
+			gen_conf.seed = strtoul(optarg, NULL, 10);
+			break;
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc) {
+		usage();
+		goto error;
+	}
+
+	printf("=== initialization:\n");
+	if (traffic_gen(&gen_conf, SDUS_NR, 0, &traffic) != 0) {
+		goto error;
+	}
+	printf("===\t%u synthetic packets generated (seed %u)\n", SDUS_NR, gen_conf.seed);
+
+	status = test_perfs_superframe(&conf, &traffic, gen_conf.seed);
+
+	printf("=== exit test with code %d\n", status);
+	traffic_free(&traffic);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the superframe simulation test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE superframe simulation test tool: terminals send their traffic in the bursts of\n"
+	        "a DVB-RCS2 return link superframe, a hub decapsulates all of them. Report the bytes\n"
+	        "on air efficiency, the SDU latency in timeslots and the CPU time per superframe.\n"
+	        "\n"
+	        "usage: test_perfs_superframe [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --terminals, -t         Number of terminals (default 32)\n"
+	        "  --carriers, -c          Number of carriers (default 4)\n"
+	        "  --slots, -s             Number of timeslots per carrier and superframe\n"
+	        "                          (default 32)\n"
+	        "  --superframes, -n       Number of superframes to simulate (default 1000)\n"
+	        "  --load, -l              Offered load relative to the capacity of every terminal\n"
+	        "                          (default 0.8)\n"
+	        "  --fade, -F              Probability that the waveform of a terminal changes\n"
+	        "                          for the next or previous one at every superframe\n"
+	        "                          (default 0.05)\n"
+	        "  --waveforms, -w         Waveforms of the terminals: short (536 symbols),\n"
+	        "                          long (1616 symbols) or all (default long)\n"
+	        "  --crc, -C               Protect the ALPDUs with CRC instead of SeqNo\n"
+	        "  --threads, -T           Build the bursts with a work-stealing pool of the given\n"
+	        "                          number of threads, every terminal being owned by one\n"
+	        "                          thread for the superframe (default 0: no pool)\n"
+	        "  --pin, -P               Pin the threads of the pool on the CPUs the test may\n"
+	        "                          run on\n"
+	        "  --sizes, -S             Size distribution of the SDUs (default 'imix'),\n"
+	        "                          see test_traffic_gen\n"
+	        "  --ptypes, -p            Protocol types mix of the SDUs (default 'ipv4'),\n"
+	        "                          see test_traffic_gen\n"
+	        "  --flows, -f             Number of flows (frag_ids) per terminal (default 1)\n"
+	        "  --seed, -r              Seed of the traffic and burst time plan (default 0)\n"
+	        "  --verbose               Run the test in verbose mode\n");
+
+	return;
+}
+
+
+/**
+ * @brief  Get a monotonic timestamp
+ *
+ * @return the current time in nanoseconds
+ */
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/**
+ * @brief  Draw a number uniformly in [0 ; 1[
+ *
+ * @param[in,out] state  The state of the pseudo-random generator
+ * @return               The drawn number
+ */
+static double rand_uniform(uint64_t *const state)
+{
+	return traffic_rand(state) / 4294967296.0;
+}
+
+
+/**
+ * @brief Queue the SDUs arrived at a terminal up to a timeslot
+ *
+ * The terminal is offered a constant rate, the given load of its share of the superframe
+ * with its current waveform. The SDUs are taken in turn from the traffic.
+ *
+ * @param[in,out] terminal  The terminal
+ * @param[in]     conf      The parameters of the simulation
+ * @param[in]     traffic   The SDUs
+ * @param[in]     slot      The timeslot
+ * @param[in,out] stats     The statistics of the simulation
+ */
+static void terminal_arrivals(struct terminal *const terminal,
+                              const struct superframe_conf *const conf,
+                              const struct traffic *const traffic,
+                              const uint64_t slot,
+                              struct superframe_stats *const stats)
+{
+	const double rate = conf->load * conf->carriers_nr * conf->wfs[terminal->wf_id].payload /
+	                    conf->terminals_nr;
+
+	for ( ; terminal->next_arrival_slot <= slot; terminal->next_arrival_slot++) {
+		terminal->credit += rate;
+		while (terminal->credit >= traffic->sdus[terminal->next_sdu].size) {
+			terminal->credit -= traffic->sdus[terminal->next_sdu].size;
+			stats->sdus_offered++;
+			if (terminal->tail - terminal->head >= QUEUE_LEN) {
+				stats->sdus_overflow++;
+			} else {
+				struct queue_entry *const entry = &terminal->queue[terminal->tail % QUEUE_LEN];
+
+				entry->sdu_id = terminal->next_sdu;
+				entry->arrival = terminal->next_arrival_slot;
+				terminal->tail++;
+			}
+			terminal->next_sdu = (terminal->next_sdu + 1) % traffic->sdus_nr;
+		}
+	}
+}
+
+
+/**
+ * @brief Fill a burst with the queued SDUs of a terminal
+ *
+ * @param[in,out] terminal  The terminal
+ * @param[in]     traffic   The SDUs
+ * @param[in,out] burst     The burst
+ * @param[in,out] stats     The statistics of the simulation
+ * @return                  0 in case of success, 1 otherwise
+ */
+static int terminal_build_burst(struct terminal *const terminal,
+                                const struct traffic *const traffic,
+                                struct burst *const burst,
+                                struct superframe_stats *const stats)
+{
+	size_t fpdu_cur_pos = 0;
+	size_t fpdu_remain_size = burst->size;
+
+	while (fpdu_remain_size > 0) {
+		enum rle_frag_status frag_status;
+		unsigned char *ppdu;
+		size_t ppdu_length = 0;
+
+		if (rle_transmitter_stats_get_queue_size(terminal->transmitter, terminal->frag_id) == 0) {
+			const struct traffic_sdu *sdu;
+			struct rle_sdu sdu_in;
+
+			if (terminal->sent == terminal->tail) {
+				/* nothing more to send */
+				break;
+			}
+			sdu = &traffic->sdus[terminal->queue[terminal->sent % QUEUE_LEN].sdu_id];
+			sdu_in.buffer = sdu->data;
+			sdu_in.size = sdu->size;
+			sdu_in.protocol_type = sdu->protocol_type;
+			if (rle_encapsulate(terminal->transmitter, &sdu_in, sdu->frag_id) != RLE_ENCAP_OK) {
+				printf("failed to encapsulate SDU\n");
+				return 1;
+			}
+			terminal->frag_id = sdu->frag_id;
+			terminal->sent++;
+		}
+
+		frag_status = rle_fragment(terminal->transmitter, terminal->frag_id, fpdu_remain_size,
+		                           &ppdu, &ppdu_length);
+		if (frag_status == RLE_FRAG_ERR_BURST_TOO_SMALL) {
+			/* not enough room left for a PPDU, the SDU goes on in the next burst */
+			break;
+		} else if (frag_status != RLE_FRAG_OK) {
+			printf("failed to fragment SDU\n");
+			return 1;
+		}
+		if (rle_pack(ppdu, ppdu_length, NULL, 0, burst->fpdu, &fpdu_cur_pos,
+		             &fpdu_remain_size) != RLE_PACK_OK) {
+			printf("failed to pack PPDU\n");
+			return 1;
+		}
+	}
+	rle_pad(burst->fpdu, fpdu_cur_pos, fpdu_remain_size);
+
+	stats->bursts_nr++;
+	stats->air_bytes += burst->size;
+	stats->padding_bytes += fpdu_remain_size;
+	if (fpdu_cur_pos == 0) {
+		stats->idle_bursts_nr++;
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Fill all the bursts of one terminal in the superframe, task of the pool
+ *
+ * The bursts are filled in time order, with the SDUs arrived before each one of them.
+ *
+ * @param[in,out] arg        The bursts of the superframe
+ * @param[in]     task_id    The terminal, as an index of the tasks of the job
+ * @param[in]     worker_id  The worker, that accounts the statistics of the task
+ * @return                   0 in case of success, 1 otherwise
+ */
+static int terminal_build_bursts(void *const arg, const size_t task_id,
+                                 const size_t worker_id)
+{
+	struct tx_job *const job = arg;
+	struct superframe_stats *const stats = &job->stats[worker_id];
+	size_t i;
+
+	for (i = job->tasks[task_id]; i < job->tasks[task_id + 1]; i++) {
+		struct burst *const burst = &job->bursts[job->order[i]];
+
+		terminal_arrivals(burst->terminal, job->conf, job->traffic, burst->slot, stats);
+		if (terminal_build_burst(burst->terminal, job->traffic, burst, stats) != 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Group the bursts of the superframe by terminal, one task per terminal
+ *
+ * @param[in,out] job        The bursts of the superframe
+ * @param[in]     terminals  The terminals
+ * @param[in]     bursts_nr  The number of bursts of the superframe
+ * @return                   The number of tasks
+ */
+static size_t tx_job_tasks(struct tx_job *const job, const struct terminal *const terminals,
+                           const size_t bursts_nr)
+{
+	size_t tasks_nr = 0;
+	size_t pos = 0;
+	size_t i;
+
+	memset(job->counts, 0, job->conf->terminals_nr * sizeof(size_t));
+	for (i = 0; i < bursts_nr; i++) {
+		job->counts[job->bursts[i].terminal - terminals]++;
+	}
+
+	/* counts becomes the next position of every terminal in order */
+	for (i = 0; i < job->conf->terminals_nr; i++) {
+		const size_t count = job->counts[i];
+
+		if (count > 0) {
+			job->tasks[tasks_nr] = pos;
+			tasks_nr++;
+		}
+		job->counts[i] = pos;
+		pos += count;
+	}
+	job->tasks[tasks_nr] = pos;
+
+	/* the bursts of every terminal stay in time order */
+	for (i = 0; i < bursts_nr; i++) {
+		job->order[job->counts[job->bursts[i].terminal - terminals]++] = i;
+	}
+
+	return tasks_nr;
+}
+
+
+/**
+ * @brief Add the statistics of the terminals of every worker to the ones of the simulation
+ *
+ * @param[in,out] job    The bursts of the superframe, its statistics are reset
+ * @param[in,out] stats  The statistics of the simulation
+ */
+static void tx_job_merge_stats(struct tx_job *const job, struct superframe_stats *const stats)
+{
+	size_t i;
+
+	for (i = 0; i < job->conf->threads_nr; i++) {
+		struct superframe_stats *const worker_stats = &job->stats[i];
+
+		stats->bursts_nr += worker_stats->bursts_nr;
+		stats->idle_bursts_nr += worker_stats->idle_bursts_nr;
+		stats->air_bytes += worker_stats->air_bytes;
+		stats->padding_bytes += worker_stats->padding_bytes;
+		stats->sdus_offered += worker_stats->sdus_offered;
+		stats->sdus_overflow += worker_stats->sdus_overflow;
+		worker_stats->bursts_nr = 0;
+		worker_stats->idle_bursts_nr = 0;
+		worker_stats->air_bytes = 0;
+		worker_stats->padding_bytes = 0;
+		worker_stats->sdus_offered = 0;
+		worker_stats->sdus_overflow = 0;
+	}
+}
+
+
+/**
+ * @brief Decapsulate a burst at the hub, and account the latency of the delivered SDUs
+ *
+ * @param[in]     burst    The burst
+ * @param[in]     traffic  The SDUs
+ * @param[out]    sdus     The SDUs given to rle_decapsulate()
+ * @param[in,out] stats    The statistics of the simulation
+ * @return                 0 in case of success, 1 otherwise
+ */
+static int hub_receive_burst(const struct burst *const burst,
+                             const struct traffic *const traffic,
+                             struct rle_sdu *const sdus,
+                             struct superframe_stats *const stats)
+{
+	struct terminal *const terminal = burst->terminal;
+	size_t sdus_nr = 0;
+	size_t i;
+
+	if (rle_decapsulate(terminal->receiver, burst->fpdu, burst->size, sdus, BURST_SDUS_MAX_NR,
+	                    &sdus_nr, NULL, 0) != RLE_DECAP_OK) {
+		printf("failed to decapsulate burst\n");
+		return 1;
+	}
+
+	/* the SDUs of a terminal are fragmented one after the other, so they are delivered in
+	 * the order of their queue */
+	for (i = 0; i < sdus_nr; i++) {
+		const struct queue_entry *const entry = &terminal->queue[terminal->head % QUEUE_LEN];
+		uint64_t latency;
+
+		if (terminal->head == terminal->sent ||
+		    sdus[i].size != traffic->sdus[entry->sdu_id].size) {
+			printf("unexpected SDU of %zu bytes delivered\n", sdus[i].size);
+			return 1;
+		}
+		latency = burst->slot - entry->arrival;
+		if (latency >= LATENCY_HIST_LEN) {
+			latency = LATENCY_HIST_LEN - 1;
+		}
+		stats->latency_hist[latency]++;
+		stats->sdu_bytes += sdus[i].size;
+		stats->sdus_delivered++;
+		terminal->head++;
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Get a percentile of the SDU latency
+ *
+ * @param[in] stats       The statistics of the simulation
+ * @param[in] percentile  The percentile, in [0 ; 1]
+ * @return                The latency in timeslots
+ */
+static uint64_t latency_percentile(const struct superframe_stats *const stats,
+                                   const double percentile)
+{
+	const uint64_t rank = (stats->sdus_delivered - 1) * percentile;
+	uint64_t count = 0;
+	size_t latency;
+
+	for (latency = 0; latency < LATENCY_HIST_LEN; latency++) {
+		count += stats->latency_hist[latency];
+		if (count > rank) {
+			break;
+		}
+	}
+
+	return latency;
+}
+
+
+/**
+ * @brief Print the results of the simulation
+ *
+ * @param[in] conf       The parameters of the simulation
+ * @param[in] stats      The statistics of the simulation
+ * @param[in] terminals  The terminals
+ */
+static void print_stats(const struct superframe_conf *const conf,
+                        const struct superframe_stats *const stats,
+                        const struct terminal *const terminals)
+{
+	const double air_bytes = stats->air_bytes;
+	const double superframes_nr = conf->superframes_nr;
+	uint64_t queued_nr = 0;
+	uint64_t latency_sum = 0;
+	size_t latency;
+	size_t i;
+
+	for (i = 0; i < conf->terminals_nr; i++) {
+		queued_nr += terminals[i].tail - terminals[i].head;
+	}
+	for (latency = 0; latency < LATENCY_HIST_LEN; latency++) {
+		latency_sum += latency * stats->latency_hist[latency];
+	}
+
+	printf("\n=== results:\n");
+	printf("bursts:        %" PRIu64 " (%.1f%% idle)\n", stats->bursts_nr,
+	       100.0 * stats->idle_bursts_nr / stats->bursts_nr);
+	printf("bytes on air:  %" PRIu64 " = %.2f%% SDUs + %.2f%% RLE overhead + %.2f%% padding\n",
+	       stats->air_bytes, 100.0 * stats->sdu_bytes / air_bytes,
+	       100.0 * (air_bytes - stats->sdu_bytes - stats->padding_bytes) / air_bytes,
+	       100.0 * stats->padding_bytes / air_bytes);
+	printf("SDUs:          %" PRIu64 " offered, %" PRIu64 " delivered, %" PRIu64
+	       " dropped (queue full), %" PRIu64 " still queued\n", stats->sdus_offered,
+	       stats->sdus_delivered, stats->sdus_overflow, queued_nr);
+	if (stats->sdus_delivered > 0) {
+		printf("latency slots: mean %.1f, p50 %" PRIu64 ", p99 %" PRIu64 ", p99.9 %" PRIu64
+		       ", max %" PRIu64 "%s\n", (double)latency_sum / stats->sdus_delivered,
+		       latency_percentile(stats, 0.5), latency_percentile(stats, 0.99),
+		       latency_percentile(stats, 0.999), latency_percentile(stats, 1),
+		       stats->latency_hist[LATENCY_HIST_LEN - 1] != 0 ? " (or more)" : "");
+	}
+	printf("CPU/superframe: terminals %.1f us (max %.1f us), hub %.1f us (max %.1f us)\n",
+	       stats->tx_ns / superframes_nr / 1e3, stats->tx_ns_max / 1e3,
+	       stats->hub_ns / superframes_nr / 1e3, stats->hub_ns_max / 1e3);
+	printf("CPU/burst:     terminals %.0f ns, hub %.0f ns\n",
+	       (double)stats->tx_ns / stats->bursts_nr, (double)stats->hub_ns / stats->bursts_nr);
+}
+
+
+/**
+ * @brief Simulate the superframes
+ *
+ * Every superframe, the waveforms of the terminals may change, then the bursts of the
+ * carriers are allocated in turn to the terminals. The terminals fill their bursts in time
+ * order, then the hub decapsulates all the bursts of the superframe. With a pool of threads,
+ * the terminals fill their bursts in parallel and the time of the terminals is the time of
+ * the whole pass, SDU arrivals included.
+ *
+ * @param[in] conf     The parameters of the simulation
+ * @param[in] traffic  The SDUs, shared by the terminals
+ * @param[in] seed     The seed of the burst time plan
+ * @return             0 in case of success, 1 otherwise
+ */
+static int test_perfs_superframe(const struct superframe_conf *const conf,
+                                 const struct traffic *const traffic,
+                                 const uint32_t seed)
+{
+	const struct rle_config rle_conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = conf->use_crc,
+		.allow_alpdu_sequence_number = !conf->use_crc,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const size_t bursts_nr = conf->carriers_nr * conf->slots_nr;
+	uint64_t rand_state = traffic_rand_init(seed);
+	struct superframe_stats *stats;
+	struct terminal *terminals;
+	struct burst *bursts;
+	unsigned char *fpdus;
+	struct rle_sdu sdus[BURST_SDUS_MAX_NR];
+	unsigned char *sdus_buf;
+	struct tx_pool *pool = NULL;
+	struct tx_job job = {
+		.conf = conf,
+		.traffic = traffic,
+		.tasks = NULL,
+		.order = NULL,
+		.counts = NULL,
+		.stats = NULL,
+	};
+	size_t offset = 0;
+	size_t superframe;
+	size_t i;
+	int status = 1;
+
+	stats = calloc(1, sizeof(struct superframe_stats));
+	terminals = calloc(conf->terminals_nr, sizeof(struct terminal));
+	bursts = calloc(bursts_nr, sizeof(struct burst));
+	fpdus = malloc(bursts_nr * RLE_MAX_PDU_SIZE);
+	sdus_buf = malloc(BURST_SDUS_MAX_NR * SDU_BUF_LEN);
+	if (stats == NULL || terminals == NULL || bursts == NULL || fpdus == NULL ||
+	    sdus_buf == NULL) {
+		printf("failed to allocate the simulation\n");
+		goto free_sim;
+	}
+	for (i = 0; i < BURST_SDUS_MAX_NR; i++) {
+		sdus[i].buffer = sdus_buf + i * SDU_BUF_LEN;
+	}
+	for (i = 0; i < bursts_nr; i++) {
+		bursts[i].fpdu = fpdus + i * RLE_MAX_PDU_SIZE;
+	}
+	job.bursts = bursts;
+
+	if (conf->threads_nr > 0) {
+		int cpus[CPU_SETSIZE];
+		size_t cpus_nr = 0;
+
+		if (conf->pin) {
+			cpu_set_t cpu_set;
+			int cpu;
+
+			if (sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set) != 0) {
+				perror("failed to get the CPUs of the test");
+				goto free_sim;
+			}
+			for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+				if (CPU_ISSET(cpu, &cpu_set)) {
+					cpus[cpus_nr++] = cpu;
+				}
+			}
+			for (i = cpus_nr; i < conf->threads_nr; i++) {
+				cpus[i] = cpus[i % cpus_nr];
+			}
+		}
+
+		job.tasks = malloc((conf->terminals_nr + 1) * sizeof(size_t));
+		job.order = malloc(bursts_nr * sizeof(size_t));
+		job.counts = malloc(conf->terminals_nr * sizeof(size_t));
+		job.stats = calloc(conf->threads_nr, sizeof(struct superframe_stats));
+		if (job.tasks == NULL || job.order == NULL || job.counts == NULL ||
+		    job.stats == NULL) {
+			printf("failed to allocate the pool of %zu threads\n", conf->threads_nr);
+			goto free_sim;
+		}
+		pool = tx_pool_new(conf->threads_nr, cpus_nr > 0 ? cpus : NULL);
+		if (pool == NULL) {
+			goto free_sim;
+		}
+	}
+
+	for (i = 0; i < conf->terminals_nr; i++) {
+		struct terminal *const terminal = &terminals[i];
+
+		terminal->transmitter = rle_transmitter_new(&rle_conf);
+		terminal->receiver = rle_receiver_new(&rle_conf);
+		if (terminal->transmitter == NULL || terminal->receiver == NULL) {
+			printf("failed to create terminal #%zu\n", i + 1);
+			goto destroy;
+		}
+		terminal->wf_id = traffic_rand(&rand_state) % conf->wfs_nr;
+		terminal->next_sdu = (i * 7919) % traffic->sdus_nr;
+	}
+
+	printf("\n=== test: \n");
+	printf("===\t%zu terminals, %zu carriers of %zu timeslots, %zu superframes, load %.2f, "
+	       "%s\n", conf->terminals_nr, conf->carriers_nr, conf->slots_nr, conf->superframes_nr,
+	       conf->load, conf->use_crc ? "CRC" : "SeqNo");
+	if (pool != NULL) {
+		printf("===\tbursts built by %zu threads%s\n", conf->threads_nr,
+		       conf->pin ? ", pinned" : "");
+	}
+
+	for (superframe = 0; superframe < conf->superframes_nr; superframe++) {
+		uint64_t sf_ns;
+		uint64_t start_ns;
+
+		/* waveform changes and burst time plan */
+		for (i = 0; i < conf->terminals_nr; i++) {
+			struct terminal *const terminal = &terminals[i];
+
+			if (rand_uniform(&rand_state) < conf->fade_rate) {
+				if (traffic_rand(&rand_state) % 2 == 0) {
+					if (terminal->wf_id > 0) {
+						terminal->wf_id--;
+					}
+				} else if (terminal->wf_id + 1 < conf->wfs_nr) {
+					terminal->wf_id++;
+				}
+			}
+		}
+		for (i = 0; i < bursts_nr; i++) {
+			struct burst *const burst = &bursts[i];
+
+			/* time first, then carriers */
+			burst->terminal = &terminals[(offset + i) % conf->terminals_nr];
+			burst->slot = superframe * conf->slots_nr + i / conf->carriers_nr;
+			burst->size = conf->wfs[burst->terminal->wf_id].payload;
+		}
+		offset = (offset + bursts_nr) % conf->terminals_nr;
+
+		/* the terminals send their bursts */
+		sf_ns = 0;
+		if (pool != NULL) {
+			const size_t tasks_nr = tx_job_tasks(&job, terminals, bursts_nr);
+
+			start_ns = get_time_ns();
+			if (tx_pool_run(pool, tasks_nr, terminal_build_bursts, &job) != 0) {
+				goto destroy;
+			}
+			sf_ns = get_time_ns() - start_ns;
+			tx_job_merge_stats(&job, stats);
+		} else {
+			for (i = 0; i < bursts_nr; i++) {
+				terminal_arrivals(bursts[i].terminal, conf, traffic, bursts[i].slot, stats);
+				start_ns = get_time_ns();
+				if (terminal_build_burst(bursts[i].terminal, traffic, &bursts[i], stats) != 0) {
+					goto destroy;
+				}
+				sf_ns += get_time_ns() - start_ns;
+			}
+		}
+		stats->tx_ns += sf_ns;
+		if (sf_ns > stats->tx_ns_max) {
+			stats->tx_ns_max = sf_ns;
+		}
+
+		/* the hub receives the whole superframe */
+		start_ns = get_time_ns();
+		for (i = 0; i < bursts_nr; i++) {
+			if (hub_receive_burst(&bursts[i], traffic, sdus, stats) != 0) {
+				goto destroy;
+			}
+		}
+		sf_ns = get_time_ns() - start_ns;
+		stats->hub_ns += sf_ns;
+		if (sf_ns > stats->hub_ns_max) {
+			stats->hub_ns_max = sf_ns;
+		}
+		TRACE("superframe %zu: %" PRIu64 " SDUs delivered\n", superframe,
+		      stats->sdus_delivered);
+	}
+
+	if (conf->superframes_nr > 0) {
+		print_stats(conf, stats, terminals);
+	}
+	if (pool != NULL) {
+		for (i = 0; i < conf->threads_nr; i++) {
+			struct tx_pool_stats pool_stats;
+
+			tx_pool_get_stats(pool, i, &pool_stats);
+			printf("thread #%zu:     %" PRIu64 " terminals, %" PRIu64 " stolen\n", i + 1,
+			       pool_stats.tasks_nr, pool_stats.steals_nr);
+		}
+	}
+	printf("\n=== shutdown:\n");
+	status = 0;
+
+destroy:
+	for (i = 0; i < conf->terminals_nr; i++) {
+		if (terminals[i].transmitter != NULL) {
+			rle_transmitter_destroy(&terminals[i].transmitter);
+		}
+		if (terminals[i].receiver != NULL) {
+			rle_receiver_destroy(&terminals[i].receiver);
+		}
+	}
+free_sim:
+	if (pool != NULL) {
+		tx_pool_destroy(pool);
+	}
+	free(job.stats);
+	free(job.counts);
+	free(job.order);
+	free(job.tasks);
+	free(sdus_buf);
+	free(fpdus);
+	free(bursts);
+	free(terminals);
+	free(stats);
+	return status;
+}
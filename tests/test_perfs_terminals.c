@@ -0,0 +1,639 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_terminals.c
+ * @brief  Measure the RLE memory and throughput costs as the number of terminals grows.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* system includes */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <time.h>
+#include <unistd.h>
+#include <malloc.h>
+#include <getopt.h>
+
+#include "rle.h"
+#include "test_traffic_gen.h"
+#include "test_perf_counters.h"
+
+/** The program version */
+#define TEST_VERSION  "RLE terminals scaling performances test application, version 0.0.1\n"
+
+/** Min and max burst sizes for fragmentation in the test. */
+#define MIN_BURST_SIZE 14
+#define MAX_BURST_SIZE 599
+
+/** The default burst size, small enough for most SDUs to be fragmented */
+#define DEFAULT_BURST_SIZE 123U
+
+/** The maximum number of terminal counts that may be given on command line */
+#define MAX_TERMINALS_NRS 16
+
+/** The default duration (in seconds) of every measure */
+#define DEFAULT_DURATION 1.0
+
+/** The number of SDUs of the traffic shared by the terminals */
+#define SDUS_NR 1024U
+
+/** The length of the SDU buffers given to the receiver (room for VLAN ptype re-insertion) */
+#define SDU_BUF_LEN  (RLE_MAX_PDU_SIZE + 4U)
+
+/** Number of FPDUs processed between two checks of the elapsed time */
+#define CLOCK_CHECK_PERIOD 32U
+
+/** One terminal: a transmitter and the receiver at the other end of its link */
+struct terminal {
+	struct rle_transmitter *transmitter;  /**< The transmitter */
+	struct rle_receiver *receiver;        /**< The receiver */
+	size_t next_sdu;                      /**< The next SDU of the traffic to send */
+	uint8_t frag_id;                      /**< The frag_id of the SDU being fragmented */
+};
+
+/** The heap usage, counted by the malloc() and free() wrappers */
+struct heap_usage {
+	uint64_t allocs_nr;  /**< The number of allocations */
+	int64_t bytes;       /**< The number of bytes currently allocated */
+};
+
+/** The result of the measure for one number of terminals */
+struct terminals_result {
+	uint64_t sdus_nr;       /**< The number of SDUs delivered */
+	uint64_t sdus_bytes;    /**< The number of SDU bytes delivered */
+	uint64_t fpdus_nr;      /**< The number of FPDUs processed */
+	uint64_t elapsed_ns;    /**< The measure duration in nanoseconds */
+	uint64_t counters[PERF_COUNTERS_NR];  /**< The hardware counters */
+};
+
+/* prototypes of private functions */
+void * __real_malloc(size_t size);
+void * __wrap_malloc(size_t size);
+void * __real_calloc(size_t nmemb, size_t size);
+void * __wrap_calloc(size_t nmemb, size_t size);
+void __real_free(void *ptr);
+void __wrap_free(void *ptr);
+static void usage(void);
+static uint64_t get_time_ns(void);
+static size_t get_rss(void);
+static int terminal_step(struct terminal *const terminal,
+                         const struct traffic *const traffic,
+                         const size_t burst_size,
+                         struct rle_sdu *const sdus,
+                         const size_t sdus_max_nr,
+                         struct terminals_result *const result);
+static void terminals_destroy(struct terminal *const terminals, const size_t terminals_nr);
+static int test_perfs_terminals(const struct traffic *const traffic,
+                                const size_t *const terminals_nrs,
+                                const size_t terminals_nrs_nr,
+                                const size_t burst_size,
+                                const double duration);
+
+/** Whether the application runs in verbose mode or not */
+static int is_verbose = 0;
+
+/** The heap usage since the start of the program */
+static struct heap_usage heap_usage = { 0, 0 };
+
+/** The hardware counters measured around the traffic loop */
+static struct perf_counters perf_counters;
+
+#define TRACE(x ...) do { \
+		if (is_verbose) { printf(x); } \
+} while (0)
+
+
+/**
+ * @brief Main function for the RLE terminals scaling performances test program
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	size_t terminals_nrs[MAX_TERMINALS_NRS] = { 1, 10, 100, 1000, 10000, 100000 };
+	size_t terminals_nrs_nr = 6;
+	bool terminals_nrs_given = false;
+	size_t burst_size = DEFAULT_BURST_SIZE;
+	double duration = DEFAULT_DURATION;
+	struct traffic_gen_conf gen_conf;
+	struct traffic traffic;
+
+	traffic_gen_conf_init(&gen_conf);
+
+	while (1) {
+		int c;
+
+		static struct option long_options[] =
+		{
+			{ "verbose", no_argument, &is_verbose, 1 },
+			{ "terminals", required_argument, 0, 'N' },
+			{ "burst_size", required_argument, 0, 'b' },
+			{ "duration", required_argument, 0, 'd' },
+			{ "sizes", required_argument, 0, 'S' },
+			{ "flows", required_argument, 0, 'f' },
+			{ "seed", required_argument, 0, 'r' },
+			{ 0, 0, 0, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, "vhN:b:d:S:f:r:", long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 0:
+			/* If this option set a flag, do nothing else now. */
+			break;
+		case 'N': /* Number of terminals */
+			assert(optarg != NULL);
+			if (!terminals_nrs_given) {
+				terminals_nrs_given = true;
+				terminals_nrs_nr = 0;
+			}
+			if (terminals_nrs_nr >= MAX_TERMINALS_NRS) {
+				printf("ERROR: too many terminal counts. Maximum = %d.\n", MAX_TERMINALS_NRS);
+				goto error;
+			}
+			terminals_nrs[terminals_nrs_nr] = strtoul(optarg, NULL, 10);
+			if (terminals_nrs[terminals_nrs_nr] == 0) {
+				printf("ERROR: at least one terminal is required\n");
+				goto error;
+			}
+			terminals_nrs_nr++;
+			break;
+		case 'b': /* Burst Size */
+			assert(optarg != NULL);
+			burst_size = strtoul(optarg, NULL, 10);
+			if (burst_size < MIN_BURST_SIZE || burst_size > MAX_BURST_SIZE) {
+				printf("ERROR: %zu burst size shall be within [%d ; %d] octets.\n",
+				       burst_size, MIN_BURST_SIZE, MAX_BURST_SIZE);
+				goto error;
+			}
+			break;
+		case 'd': /* Duration of every measure */
+			assert(optarg != NULL);
+			duration = strtod(optarg, NULL);
+			if (duration <= 0) {
+				printf("ERROR: duration shall be strictly positive\n");
+				goto error;
+			}
+			break;
+		case 'S': /* Size distribution */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_sizes(optarg, &gen_conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'f': /* Number of flows */
+			assert(optarg != NULL);
+			gen_conf.flows_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'r': /* Seed of the traffic */
+			assert(optarg != NULL);
+			gen_conf.seed = strtoul(optarg, NULL, 10);
+			break;
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc) {
+		usage();
+		goto error;
+	}
+
+	printf("=== initialization:\n");
+	if (traffic_gen(&gen_conf, SDUS_NR, 0, &traffic) != 0) {
+		goto error;
+	}
+	printf("===\t%u synthetic packets generated (seed %u)\n", SDUS_NR, gen_conf.seed);
+
+	if (perf_counters_open(&perf_counters) == 0) {
+		printf("===\tno hardware counter available, cache misses are not measured\n");
+	}
+
+	status = test_perfs_terminals(&traffic, terminals_nrs, terminals_nrs_nr, burst_size,
+	                              duration);
+
+	perf_counters_close(&perf_counters);
+
+	printf("=== exit test with code %d\n", status);
+	traffic_free(&traffic);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Count the allocations of the library and of the test
+ *
+ * @param[in] size  The size to allocate
+ * @return          The allocated memory, NULL in case of failure
+ */
+void * __wrap_malloc(size_t size)
+{
+	void *const ptr = __real_malloc(size);
+
+	if (ptr != NULL) {
+		heap_usage.allocs_nr++;
+		heap_usage.bytes += malloc_usable_size(ptr);
+	}
+
+	return ptr;
+}
+
+
+/**
+ * @brief Count the zeroed allocations of the library and of the test
+ *
+ * The compiler may merge a malloc() followed by a memset() to 0 into a calloc().
+ *
+ * @param[in] nmemb  The number of elements to allocate
+ * @param[in] size   The size of every element
+ * @return           The allocated memory, NULL in case of failure
+ */
+void * __wrap_calloc(size_t nmemb, size_t size)
+{
+	void *const ptr = __real_calloc(nmemb, size);
+
+	if (ptr != NULL) {
+		heap_usage.allocs_nr++;
+		heap_usage.bytes += malloc_usable_size(ptr);
+	}
+
+	return ptr;
+}
+
+
+/**
+ * @brief Count the memory released by the library and by the test
+ *
+ * @param[in] ptr  The memory to release
+ */
+void __wrap_free(void *ptr)
+{
+	if (ptr != NULL) {
+		heap_usage.bytes -= malloc_usable_size(ptr);
+	}
+	__real_free(ptr);
+}
+
+
+/**
+ * @brief Print usage of the terminals scaling performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE terminals scaling performances test tool: measure the memory and the\n"
+	        "throughput of N transmitter/receiver pairs carrying interleaved fragmented traffic.\n"
+	        "\n"
+	        "usage: test_perfs_terminals [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --terminals, -N         Add a number of terminals to test (default 1, 10, 100,\n"
+	        "                          1000, 10000 and 100000), may be given several times\n"
+	        "  --burst_size, -b        Burst size (default 123 octets)\n"
+	        "  --duration, -d          Duration of every measure in seconds (default 1)\n"
+	        "  --sizes, -S             Size distribution of the SDUs (default 'imix'),\n"
+	        "                          see test_traffic_gen\n"
+	        "  --flows, -f             Number of flows (frag_ids) per terminal (default 1)\n"
+	        "  --seed, -r              Seed of the traffic (default 0)\n"
+	        "  --verbose               Run the test in verbose mode\n");
+
+	return;
+}
+
+
+/**
+ * @brief  Get a monotonic timestamp
+ *
+ * @return the current time in nanoseconds
+ */
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/**
+ * @brief  Get the resident memory of the process
+ *
+ * @return the resident memory in bytes, 0 if not available
+ */
+static size_t get_rss(void)
+{
+	unsigned long size;
+	unsigned long resident = 0;
+	FILE *statm;
+
+	statm = fopen("/proc/self/statm", "r");
+	if (statm == NULL) {
+		return 0;
+	}
+	if (fscanf(statm, "%lu %lu", &size, &resident) != 2) {
+		resident = 0;
+	}
+	fclose(statm);
+
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+
+/**
+ * @brief Send one FPDU from the transmitter of a terminal to its receiver
+ *
+ * A new SDU is encapsulated if the previous one is completely fragmented, so that every
+ * FPDU carries a fragment (or a complete PPDU) of the terminal.
+ *
+ * @param[in,out] terminal     The terminal
+ * @param[in]     traffic      The SDUs to send
+ * @param[in]     burst_size   The size of the FPDU
+ * @param[out]    sdus         The SDUs given to rle_decapsulate()
+ * @param[in]     sdus_max_nr  The number of SDUs given to rle_decapsulate()
+ * @param[in,out] result       The delivered SDUs are added to the result
+ * @return                     0 in case of success, 1 otherwise
+ */
+static int terminal_step(struct terminal *const terminal,
+                         const struct traffic *const traffic,
+                         const size_t burst_size,
+                         struct rle_sdu *const sdus,
+                         const size_t sdus_max_nr,
+                         struct terminals_result *const result)
+{
+	unsigned char fpdu[burst_size];
+	size_t fpdu_cur_pos = 0;
+	size_t fpdu_remain_size = burst_size;
+	unsigned char *ppdu;
+	size_t ppdu_length = 0;
+	size_t sdus_nr = 0;
+	size_t sdu_id;
+
+	if (rle_transmitter_stats_get_queue_size(terminal->transmitter, terminal->frag_id) == 0) {
+		const struct traffic_sdu *const sdu = &traffic->sdus[terminal->next_sdu];
+		struct rle_sdu sdu_in;
+
+		sdu_in.buffer = sdu->data;
+		sdu_in.size = sdu->size;
+		sdu_in.protocol_type = sdu->protocol_type;
+		if (rle_encapsulate(terminal->transmitter, &sdu_in, sdu->frag_id) != RLE_ENCAP_OK) {
+			printf("failed to encapsulate SDU\n");
+			return 1;
+		}
+		terminal->frag_id = sdu->frag_id;
+		terminal->next_sdu = (terminal->next_sdu + 1) % traffic->sdus_nr;
+	}
+
+	if (rle_fragment(terminal->transmitter, terminal->frag_id, fpdu_remain_size, &ppdu,
+	                 &ppdu_length) != RLE_FRAG_OK) {
+		printf("failed to fragment SDU\n");
+		return 1;
+	}
+	if (rle_pack(ppdu, ppdu_length, NULL, 0, fpdu, &fpdu_cur_pos,
+	             &fpdu_remain_size) != RLE_PACK_OK) {
+		printf("failed to pack PPDU\n");
+		return 1;
+	}
+	rle_pad(fpdu, fpdu_cur_pos, fpdu_remain_size);
+
+	if (rle_decapsulate(terminal->receiver, fpdu, burst_size, sdus, sdus_max_nr, &sdus_nr,
+	                    NULL, 0) != RLE_DECAP_OK) {
+		printf("failed to decapsulate FPDU\n");
+		return 1;
+	}
+	for (sdu_id = 0; sdu_id < sdus_nr; sdu_id++) {
+		result->sdus_bytes += sdus[sdu_id].size;
+	}
+	result->sdus_nr += sdus_nr;
+	result->fpdus_nr++;
+
+	return 0;
+}
+
+
+/**
+ * @brief Destroy terminals, even partially created
+ *
+ * @param[in,out] terminals     The terminals
+ * @param[in]     terminals_nr  The number of terminals
+ */
+static void terminals_destroy(struct terminal *const terminals, const size_t terminals_nr)
+{
+	size_t i;
+
+	for (i = 0; i < terminals_nr; i++) {
+		if (terminals[i].transmitter != NULL) {
+			rle_transmitter_destroy(&terminals[i].transmitter);
+		}
+		if (terminals[i].receiver != NULL) {
+			rle_receiver_destroy(&terminals[i].receiver);
+		}
+	}
+	free(terminals);
+}
+
+
+/**
+ * @brief Measure the memory and throughput for every number of terminals
+ *
+ * @param[in] traffic           The SDUs to send
+ * @param[in] terminals_nrs     The numbers of terminals to test
+ * @param[in] terminals_nrs_nr  The number of numbers of terminals to test
+ * @param[in] burst_size        The size of the FPDUs
+ * @param[in] duration          The duration of every measure in seconds
+ * @return                      0 in case of success, 1 otherwise
+ */
+static int test_perfs_terminals(const struct traffic *const traffic,
+                                const size_t *const terminals_nrs,
+                                const size_t terminals_nrs_nr,
+                                const size_t burst_size,
+                                const double duration)
+{
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 0,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const uint64_t duration_ns = duration * 1e9;
+	const size_t sdus_max_nr = burst_size / 2 + 1;
+	struct rle_sdu sdus[sdus_max_nr];
+	unsigned char *sdus_buf;
+	size_t terminals_nrs_id;
+	double rss_per_terminal = 0;
+	size_t i;
+	int status = 1;
+
+	sdus_buf = malloc(sdus_max_nr * SDU_BUF_LEN);
+	if (sdus_buf == NULL) {
+		printf("failed to allocate the SDU buffers.\n");
+		goto error;
+	}
+	for (i = 0; i < sdus_max_nr; i++) {
+		sdus[i].buffer = sdus_buf + i * SDU_BUF_LEN;
+	}
+
+	printf("\n=== test: \n");
+	printf("%7s %9s %10s %10s %7s %10s %10s %8s %10s %10s\n", "N", "allocs/N", "heap B/N",
+	       "RSS B/N", "allocs", "FPDU/s", "SDU/s", "Gbit/s", "L1D/FPDU", "LLC/FPDU");
+
+	for (terminals_nrs_id = 0; terminals_nrs_id < terminals_nrs_nr; terminals_nrs_id++) {
+		const size_t terminals_nr = terminals_nrs[terminals_nrs_id];
+		struct terminals_result result;
+		struct terminal *terminals;
+		struct heap_usage heap_start;
+		uint64_t run_allocs_nr;
+		size_t rss_start;
+		size_t rss_end;
+		size_t created_nr;
+		uint64_t start_ns;
+		uint64_t now_ns;
+		size_t cur = 0;
+		int id;
+
+		memset(&result, 0, sizeof(struct terminals_result));
+
+		/* with memory overcommit, the OOM killer would end the process before any malloc()
+		 * fails, so stop when the memory measured for the previous step is not available */
+		if (rss_per_terminal * terminals_nr >
+		    (double)sysconf(_SC_AVPHYS_PAGES) * sysconf(_SC_PAGESIZE)) {
+			printf("%7zu not enough memory for %.0f MB, stop\n", terminals_nr,
+			       rss_per_terminal * terminals_nr / 1e6);
+			break;
+		}
+
+		terminals = calloc(terminals_nr, sizeof(struct terminal));
+		if (terminals == NULL) {
+			printf("%7zu out of memory for the terminals table, stop\n", terminals_nr);
+			break;
+		}
+
+		rss_start = get_rss();
+		heap_start = heap_usage;
+		for (created_nr = 0; created_nr < terminals_nr; created_nr++) {
+			struct terminal *const terminal = &terminals[created_nr];
+
+			terminal->transmitter = rle_transmitter_new(&conf);
+			terminal->receiver = rle_receiver_new(&conf);
+			if (terminal->transmitter == NULL || terminal->receiver == NULL) {
+				break;
+			}
+			terminal->next_sdu = created_nr % traffic->sdus_nr;
+		}
+		if (created_nr < terminals_nr) {
+			/* running out of memory ends the sweep, it is not a failure of the test */
+			printf("%7zu out of memory after %zu terminals, stop\n", terminals_nr, created_nr);
+			terminals_destroy(terminals, created_nr + 1);
+			break;
+		}
+
+		/* interleave the terminals: one FPDU of each terminal in turn */
+		run_allocs_nr = heap_usage.allocs_nr;
+		perf_counters_start(&perf_counters);
+		start_ns = get_time_ns();
+		do {
+			for (i = 0; i < CLOCK_CHECK_PERIOD; i++) {
+				if (terminal_step(&terminals[cur], traffic, burst_size, sdus, sdus_max_nr,
+				                  &result) != 0) {
+					terminals_destroy(terminals, terminals_nr);
+					goto free_buf;
+				}
+				cur = (cur + 1) % terminals_nr;
+			}
+			now_ns = get_time_ns();
+		} while ((now_ns - start_ns) < duration_ns);
+		result.elapsed_ns = now_ns - start_ns;
+		perf_counters_stop(&perf_counters);
+		memcpy(result.counters, perf_counters.values, sizeof(result.counters));
+		run_allocs_nr = heap_usage.allocs_nr - run_allocs_nr;
+		rss_end = get_rss();
+		if (rss_end > rss_start) {
+			rss_per_terminal = ((double)rss_end - rss_start) / terminals_nr;
+		}
+
+		/* the resident memory is measured once the reassembly buffers were used */
+		printf("%7zu %9.1f %10.0f %10.0f %7" PRIu64 " %10.0f %10.0f %8.3f",
+		       terminals_nr,
+		       (double)(heap_usage.allocs_nr - heap_start.allocs_nr - run_allocs_nr) /
+		       terminals_nr,
+		       (double)(heap_usage.bytes - heap_start.bytes) / terminals_nr,
+		       ((double)rss_end - rss_start) / terminals_nr,
+		       run_allocs_nr,
+		       result.fpdus_nr * 1e9 / result.elapsed_ns,
+		       result.sdus_nr * 1e9 / result.elapsed_ns,
+		       result.sdus_bytes * 8.0 / result.elapsed_ns);
+		for (id = PERF_COUNTER_L1D_MISSES; id <= PERF_COUNTER_LLC_MISSES; id++) {
+			if (perf_counters_is_available(&perf_counters, id)) {
+				printf(" %10.2f", (double)result.counters[id] / result.fpdus_nr);
+			} else {
+				printf(" %10s", "n/a");
+			}
+		}
+		printf("\n");
+		TRACE("\t%" PRIu64 " FPDUs, %" PRIu64 " SDUs in %.3f s\n", result.fpdus_nr,
+		      result.sdus_nr, result.elapsed_ns / 1e9);
+
+		terminals_destroy(terminals, terminals_nr);
+	}
+
+	printf("\n=== shutdown:\n");
+	status = 0;
+
+free_buf:
+	free(sdus_buf);
+error:
+	return status;
+}
@@ -64,6 +64,7 @@ static bool encap_tests(void)
 	const struct test null_transmitter = { "Null transmitter", test_encap_null_transmitter };
 	const struct test too_big = { "Too big", test_encap_too_big };
 	const struct test inv_config = { "Invalid configuration", test_encap_inv_config };
+	const struct test alpdu_cache = { "ALPDU cache", test_encap_alpdu_cache };
 
 	const struct test *const encapsulation_tests[] =
 	{
@@ -71,6 +72,7 @@ static bool encap_tests(void)
 		&null_transmitter,
 		&too_big,
 		&inv_config,
+		&alpdu_cache,
 		NULL
 	};
 
@@ -88,6 +90,7 @@ static bool encap_ctxtless_tests(void)
 	const struct test f_buff_not_init = { "fragmentation buffer not initialized",
 		                              test_encap_ctxtless_f_buff_not_init };
 	const struct test too_big = { "Too big", test_encap_ctxtless_too_big };
+	const struct test pack_complete = { "Pack COMPLETE PPDU", test_encap_pack_complete };
 
 	const struct test *const encapsulation_contextless_tests[] =
 	{
@@ -95,6 +98,7 @@ static bool encap_ctxtless_tests(void)
 		&null_f_buff,
 		&f_buff_not_init,
 		&too_big,
+		&pack_complete,
 		NULL
 	};
 
@@ -194,6 +198,7 @@ static bool decap_tests(void)
 	const struct test wrong_crc = { "Wrong CRC", test_decap_wrong_crc };
 	const struct test interlaced_reassembly = { "Interlaced reassembly",
 		                                    test_decap_interlaced_reassembly };
+	const struct test complete = { "COMPLETE PPDUs without receiver", test_decap_complete };
 
 	const struct test *const decapsulation_tests[] =
 	{
@@ -211,6 +216,7 @@ static bool decap_tests(void)
 		&ppdu_2_bytes,
 		&wrong_crc,
 		&interlaced_reassembly,
+		&complete,
 		NULL
 	};
 
@@ -237,6 +243,10 @@ static bool misc_tests(void)
 		                                test_rle_allocation_f_buff };
 	const struct test destruction_f_buff = { "Fragmentation buffer destruction",
 		                                 test_rle_destruction_f_buff };
+	const struct test allocation_f_buff_sized = { "Fragmentation buffer size classes",
+		                                      test_rle_allocation_f_buff_sized };
+	const struct test allocation_pool = { "Allocation in a memory pool",
+		                              test_rle_allocation_pool };
 	const struct test api_robustness_trans = { "API robustness for transmitter",
 		                                   test_rle_api_robustness_transmitter };
 	const struct test api_robustness_recv = { "API robustness for receiver",
@@ -252,6 +262,8 @@ static bool misc_tests(void)
 		&destruction_receiver,
 		&allocation_f_buff,
 		&destruction_f_buff,
+		&allocation_f_buff_sized,
+		&allocation_pool,
 		&api_robustness_trans,
 		&api_robustness_recv,
 		NULL
@@ -0,0 +1,1331 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_rle_bench.c
+ * @brief  Microbenchmarks of the hot functions of the RLE library
+ *
+ * Every benchmark runs its function in batches, one batch being long enough to be timed
+ * accurately. The time per call of every batch is a sample; the median and the 99th
+ * percentile of the samples are reported in JSON so that results of two releases may be
+ * compared with tests/scripts/compare_bench.py.
+ *
+ * The stateful functions (ALPDU/PPDU header push, reassembly of START/CONT/END PPDUs) are
+ * benchmarked on a state restored before every call; the restoration is part of the
+ * measure but only copies a few pointers and counters.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* system includes */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <time.h>
+#include <getopt.h>
+
+#include "rle.h"
+#include "crc.h"
+#include "header.h"
+#include "fragmentation_buffer.h"
+#include "reassembly.h"
+#include "reassembly_buffer.h"
+#include "rle_transmitter.h"
+#include "rle_receiver.h"
+#include "rle_copy.h"
+#include "test_perf_counters.h"
+
+/** The program version */
+#define TEST_VERSION  "RLE microbenchmarks application, version 0.0.1\n"
+
+/** The default number of samples (batches) per benchmark */
+#define DEFAULT_SAMPLES_NR 101U
+
+/** The minimal duration of one batch, in nanoseconds */
+#define MIN_BATCH_NS 20000U
+
+/** The number of calls before the measures, to warm caches and branch predictors up */
+#define WARMUP_CALLS 1000U
+
+/** The size of the SDUs reassembled from fragments */
+#define FRAG_SDU_LEN 1500U
+
+/** The burst size used to fragment the SDUs in START, CONT and END PPDUs */
+#define FRAG_BURST_SIZE 599U
+
+/** The size of the SDUs packed into the FPDUs given to rle_decapsulate() */
+#define DECAP_SDU_LEN 64U
+
+/** The size of the signalling SDUs given to rle_encapsulate() */
+#define ENCAP_SIGNAL_SDU_LEN 48U
+
+/** The maximum number of PPDUs in the FPDUs given to rle_decapsulate() */
+#define DECAP_MAX_PPDUS_NR 16U
+
+/** The length of the SDU buffers given to the receiver (room for VLAN ptype re-insertion) */
+#define SDU_BUF_LEN  (RLE_MAX_PDU_SIZE + 4U)
+
+/**
+ * @brief  A benchmarked operation: call the measured function a given number of times
+ *
+ * @param[in,out] arg            The benchmark context
+ * @param[in]     iterations     The number of calls to perform
+ * @return                       0 in case of success, 1 if the function failed
+ */
+typedef int (*bench_op_t)(void *const arg, const size_t iterations);
+
+/** The JSON output */
+struct bench_output {
+	FILE *file;            /**< The file to write results to */
+	const char *filter;    /**< Run only benchmarks which name contains this string */
+	size_t samples_nr;     /**< The number of samples per benchmark */
+	size_t results_nr;     /**< The number of results already written */
+	struct perf_counters *counters;  /**< The hardware counters, NULL if disabled */
+};
+
+/** The context of the frag buffer benchmarks */
+struct frag_buf_ctx {
+	struct rle_config conf;        /**< The RLE configuration */
+	struct rle_frag_buf *frag_buf; /**< The fragmentation buffer */
+	struct rle_frag_buf state;     /**< The state restored before every call (not buffer) */
+	size_t ppdu_len;               /**< The burst size given to push_ppdu_hdr() */
+	struct rle_ctx_mngt rle_ctx;   /**< The context given to push_ppdu_hdr() */
+};
+
+/** The context of the CRC benchmark */
+struct crc_ctx {
+	const unsigned char *data;  /**< The data to compute the CRC of */
+	size_t length;              /**< The length of the data */
+	uint32_t crc;               /**< The last CRC, so that computations are not elided */
+};
+
+/** The context of the copy benchmarks */
+struct copy_ctx {
+	const unsigned char *src;   /**< The data to copy */
+	unsigned char *dst;         /**< The destination, as large as the data plus 8 octets */
+	size_t length;              /**< The length of the copies */
+};
+
+/** The context of the packing benchmarks */
+struct pack_ctx {
+	const unsigned char *ppdu;  /**< The PPDU to pack */
+	size_t ppdu_len;            /**< The length of the PPDU */
+	unsigned char *fpdu;        /**< The FPDU to pack in */
+	size_t fpdu_len;            /**< The size of the FPDU */
+	size_t pad_pos;             /**< The position of the padding in the FPDU */
+};
+
+/** The context of the reassembly benchmarks */
+struct rasm_ctx {
+	struct rle_receiver *receiver;    /**< The receiver */
+	unsigned char *ppdu;              /**< The PPDU to reassemble */
+	size_t ppdu_len;                  /**< The length of the PPDU */
+	uint8_t frag_id;                  /**< The fragment ID of the PPDU */
+	struct rle_ctx_mngt ctx_state;    /**< The context restored before every call */
+	rle_rasm_buf_t rasm_buf_state;    /**< The reassembly buffer restored before every call */
+	uint8_t free_ctx_state;           /**< The free contexts restored before every call */
+	struct rle_sdu sdu;               /**< The reassembled SDU */
+};
+
+/** The context of the decapsulation benchmark */
+struct decap_ctx {
+	struct rle_receiver *receiver;  /**< The receiver */
+	const struct rle_config *conf;  /**< The configuration of the receiver */
+	unsigned char *fpdu;            /**< The FPDU to decapsulate */
+	size_t fpdu_len;                /**< The length of the FPDU */
+	struct rle_sdu *sdus;           /**< The decapsulated SDUs */
+	size_t sdus_max_nr;             /**< The number of SDU buffers */
+};
+
+/** The context of the encapsulation benchmark */
+struct encap_ctx {
+	struct rle_transmitter *transmitter;  /**< The transmitter */
+	const struct rle_sdu *sdu;            /**< The SDU to encapsulate */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static uint64_t get_time_ns(void);
+static int cmp_double(const void *const a, const void *const b);
+static int bench_run(struct bench_output *const output,
+                     const char *const name,
+                     const char *const param,
+                     const bench_op_t op,
+                     void *const arg);
+static int op_compute_crc(void *const arg, const size_t iterations);
+static int op_frag_buf_init(void *const arg, const size_t iterations);
+static int op_push_alpdu_hdr(void *const arg, const size_t iterations);
+static int op_push_ppdu_hdr(void *const arg, const size_t iterations);
+static int op_rle_copy(void *const arg, const size_t iterations);
+static int op_memcpy(void *const arg, const size_t iterations);
+static int op_pack(void *const arg, const size_t iterations);
+static int op_pad(void *const arg, const size_t iterations);
+static int op_reassembly_comp_ppdu(void *const arg, const size_t iterations);
+static int op_reassembly_start_ppdu(void *const arg, const size_t iterations);
+static int op_reassembly_cont_ppdu(void *const arg, const size_t iterations);
+static int op_reassembly_end_ppdu(void *const arg, const size_t iterations);
+static int op_decapsulate(void *const arg, const size_t iterations);
+static int op_decapsulate_complete(void *const arg, const size_t iterations);
+static int op_encapsulate(void *const arg, const size_t iterations);
+static void fill_sdu(unsigned char *const buffer, const size_t length);
+static void frag_buf_save(struct frag_buf_ctx *const ctx);
+static void frag_buf_restore(struct frag_buf_ctx *const ctx);
+static void rasm_save(struct rasm_ctx *const ctx);
+static void rasm_restore(struct rasm_ctx *const ctx);
+static int build_ppdus(const struct rle_config *const conf,
+                       const size_t sdu_len,
+                       const size_t burst_size,
+                       unsigned char ppdus[][FRAG_BURST_SIZE],
+                       size_t ppdus_len[],
+                       const size_t ppdus_max_nr,
+                       size_t *const ppdus_nr);
+static int bench_crc(struct bench_output *const output);
+static int bench_frag_buf(struct bench_output *const output);
+static int bench_copy(struct bench_output *const output);
+static int bench_pack(struct bench_output *const output);
+static int bench_reassembly(struct bench_output *const output);
+static int bench_decapsulate(struct bench_output *const output);
+static int bench_encapsulate(struct bench_output *const output);
+
+/** Whether the hardware counters are requested or not */
+static int use_perf_counters = 0;
+
+/** The default configuration of the benchmarks */
+static const struct rle_config default_conf = {
+	.allow_ptype_omission = 0,
+	.use_compressed_ptype = 0,
+	.allow_alpdu_crc = 0,
+	.allow_alpdu_sequence_number = 1,
+	.use_explicit_payload_header_map = 0,
+	.implicit_protocol_type = 0x00,
+	.implicit_ppdu_label_size = 0,
+	.implicit_payload_label_size = 0,
+	.type_0_alpdu_label_size = 0,
+};
+
+
+/**
+ * @brief Main function for the RLE microbenchmarks program
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	const char *output_filename = NULL;
+	struct perf_counters counters;
+	struct bench_output output = {
+		.file = stdout,
+		.filter = NULL,
+		.samples_nr = DEFAULT_SAMPLES_NR,
+		.results_nr = 0,
+		.counters = NULL,
+	};
+
+	while (1) {
+		int c;
+
+		static struct option long_options[] =
+		{
+			{ "output", required_argument, 0, 'o' },
+			{ "filter", required_argument, 0, 'f' },
+			{ "samples", required_argument, 0, 's' },
+			{ "perf-counters", no_argument, &use_perf_counters, 1 },
+			{ 0, 0, 0, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, "vho:f:s:", long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 0:
+			/* If this option set a flag, do nothing else now. */
+			break;
+		case 'o': /* Output file */
+			output_filename = optarg;
+			break;
+		case 'f': /* Benchmarks filter */
+			output.filter = optarg;
+			break;
+		case 's': /* Number of samples */
+			assert(optarg != NULL);
+			output.samples_nr = strtoul(optarg, NULL, 10);
+			if (output.samples_nr == 0) {
+				printf("ERROR: at least one sample is required\n");
+				goto error;
+			}
+			break;
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc) {
+		usage();
+		goto error;
+	}
+
+	if (output_filename != NULL) {
+		output.file = fopen(output_filename, "w");
+		if (output.file == NULL) {
+			printf("failed to open output file '%s'\n", output_filename);
+			goto error;
+		}
+	}
+
+	if (use_perf_counters) {
+		if (perf_counters_open(&counters) == 0) {
+			fprintf(stderr, "WARNING: no hardware counter available (check "
+			        "/proc/sys/kernel/perf_event_paranoid), counters are disabled\n");
+		} else {
+			output.counters = &counters;
+		}
+	}
+
+	fprintf(output.file, "{\n");
+	fprintf(output.file, "  \"version\": \"%s\",\n", "0.0.1");
+	fprintf(output.file, "  \"samples\": %zu,\n", output.samples_nr);
+	fprintf(output.file, "  \"benchmarks\": [");
+
+	if (bench_crc(&output) != 0 ||
+	    bench_frag_buf(&output) != 0 ||
+	    bench_copy(&output) != 0 ||
+	    bench_pack(&output) != 0 ||
+	    bench_reassembly(&output) != 0 ||
+	    bench_decapsulate(&output) != 0 ||
+	    bench_encapsulate(&output) != 0) {
+		fprintf(stderr, "benchmark failed\n");
+		goto close_output;
+	}
+
+	fprintf(output.file, "\n  ]\n}\n");
+	status = EXIT_SUCCESS;
+
+close_output:
+	if (output.counters != NULL) {
+		perf_counters_close(output.counters);
+	}
+	if (output.file != stdout) {
+		fclose(output.file);
+	}
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the microbenchmarks application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE microbenchmarks tool:  measure the hot functions of the RLE library.\n"
+	        "\n"
+	        "usage: test_rle_bench [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --output, -o            Write the JSON results in the given file (default stdout)\n"
+	        "  --filter, -f            Run only benchmarks which name contains the given string\n"
+	        "  --samples, -s           Number of samples per benchmark (default 101)\n"
+	        "  --perf-counters         Add the hardware counters (cycles, instructions, cache\n"
+	        "                          and branch misses) per call to every result\n");
+
+	return;
+}
+
+
+/**
+ * @brief  Get a monotonic timestamp
+ *
+ * @return the current time in nanoseconds
+ */
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/**
+ * @brief  Compare two doubles for qsort()
+ *
+ * @param[in] a  The first double
+ * @param[in] b  The second double
+ * @return       -1, 0 or 1 whether a is lower, equal or greater than b
+ */
+static int cmp_double(const void *const a, const void *const b)
+{
+	const double da = *(const double *)a;
+	const double db = *(const double *)b;
+
+	return (da > db) - (da < db);
+}
+
+
+/**
+ * @brief Run one benchmark and write its result in JSON
+ *
+ * @param[in,out] output  The JSON output
+ * @param[in]     name    The name of the benchmarked function
+ * @param[in]     param   The parameter of the benchmark (length, configuration...)
+ * @param[in]     op      The benchmarked operation
+ * @param[in,out] arg     The context of the operation
+ * @return                0 in case of success, 1 otherwise
+ */
+static int bench_run(struct bench_output *const output,
+                     const char *const name,
+                     const char *const param,
+                     const bench_op_t op,
+                     void *const arg)
+{
+	double *samples;
+	size_t batch_size = 1;
+	size_t sample_id;
+	uint64_t elapsed_ns;
+	int status = 1;
+
+	if (output->filter != NULL && strstr(name, output->filter) == NULL) {
+		return 0;
+	}
+
+	samples = calloc(output->samples_nr, sizeof(double));
+	if (samples == NULL) {
+		fprintf(stderr, "failed to allocate %zu samples\n", output->samples_nr);
+		goto error;
+	}
+
+	if (op(arg, WARMUP_CALLS) != 0) {
+		fprintf(stderr, "%s(%s) failed\n", name, param);
+		goto free_samples;
+	}
+
+	/* calibrate the batch size, so that one batch is long enough to be timed */
+	do {
+		const uint64_t start_ns = get_time_ns();
+		if (op(arg, batch_size) != 0) {
+			fprintf(stderr, "%s(%s) failed\n", name, param);
+			goto free_samples;
+		}
+		elapsed_ns = get_time_ns() - start_ns;
+		if (elapsed_ns < MIN_BATCH_NS) {
+			batch_size *= 2;
+		}
+	} while (elapsed_ns < MIN_BATCH_NS);
+
+	if (output->counters != NULL) {
+		perf_counters_start(output->counters);
+	}
+	for (sample_id = 0; sample_id < output->samples_nr; sample_id++) {
+		const uint64_t start_ns = get_time_ns();
+		if (op(arg, batch_size) != 0) {
+			fprintf(stderr, "%s(%s) failed\n", name, param);
+			goto free_samples;
+		}
+		samples[sample_id] = (double)(get_time_ns() - start_ns) / batch_size;
+	}
+	if (output->counters != NULL) {
+		perf_counters_stop(output->counters);
+	}
+
+	qsort(samples, output->samples_nr, sizeof(double), cmp_double);
+
+	fprintf(output->file, "%s\n    { \"name\": \"%s\", \"param\": \"%s\", "
+	        "\"iterations\": %zu, \"median_ns\": %.2f, \"p99_ns\": %.2f",
+	        output->results_nr == 0 ? "" : ",", name, param,
+	        batch_size * output->samples_nr, samples[output->samples_nr / 2],
+	        samples[(output->samples_nr * 99 + 99) / 100 - 1]);
+	if (output->counters != NULL) {
+		const double calls_nr = batch_size * output->samples_nr;
+		int id;
+
+		/* counters are per call, averaged over all the samples */
+		fprintf(output->file, ", \"counters\": {");
+		for (id = 0; id < PERF_COUNTERS_NR; id++) {
+			fprintf(output->file, "%s \"%s\": ", id == 0 ? "" : ",",
+			        perf_counters_get_name(id));
+			if (perf_counters_is_available(output->counters, id)) {
+				fprintf(output->file, "%.3f", output->counters->values[id] / calls_nr);
+			} else {
+				fprintf(output->file, "null");
+			}
+		}
+		fprintf(output->file, " }");
+	}
+	fprintf(output->file, " }");
+	output->results_nr++;
+
+	status = 0;
+
+free_samples:
+	free(samples);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Fill a SDU with an IPv4-like content
+ *
+ * @param[out] buffer  The SDU
+ * @param[in]  length  The length of the SDU
+ */
+static void fill_sdu(unsigned char *const buffer, const size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		buffer[i] = i & 0xff;
+	}
+	buffer[0] = 0x45;
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ BENCHMARKED OPERATIONS ------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static int op_compute_crc(void *const arg, const size_t iterations)
+{
+	struct crc_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		ctx->crc = compute_crc(ctx->data, ctx->length, ctx->crc);
+	}
+
+	return 0;
+}
+
+static int op_frag_buf_init(void *const arg, const size_t iterations)
+{
+	struct frag_buf_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		if (rle_frag_buf_init(ctx->frag_buf) != 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int op_push_alpdu_hdr(void *const arg, const size_t iterations)
+{
+	struct frag_buf_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		frag_buf_restore(ctx);
+		push_alpdu_hdr(ctx->frag_buf, &ctx->conf);
+	}
+
+	return 0;
+}
+
+static int op_push_ppdu_hdr(void *const arg, const size_t iterations)
+{
+	struct frag_buf_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		frag_buf_restore(ctx);
+		if (!push_ppdu_hdr(ctx->frag_buf, &ctx->conf, ctx->ppdu_len, &ctx->rle_ctx)) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int op_pack(void *const arg, const size_t iterations)
+{
+	struct pack_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		size_t fpdu_cur_pos = 0;
+		size_t fpdu_remain_size = ctx->fpdu_len;
+
+		if (rle_pack(ctx->ppdu, ctx->ppdu_len, NULL, 0, ctx->fpdu, &fpdu_cur_pos,
+		             &fpdu_remain_size) != RLE_PACK_OK) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int op_rle_copy(void *const arg, const size_t iterations)
+{
+	struct copy_ctx *const ctx = arg;
+	size_t i;
+
+	/* the destination moves by one octet at every call, as the PPDUs in a FPDU */
+	for (i = 0; i < iterations; i++) {
+		rle_copy(ctx->dst + (i & 7), ctx->src, ctx->length);
+		__asm__ __volatile__("" : : "r"(ctx->dst) : "memory");
+	}
+
+	return 0;
+}
+
+static int op_memcpy(void *const arg, const size_t iterations)
+{
+	struct copy_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		memcpy(ctx->dst + (i & 7), ctx->src, ctx->length);
+		__asm__ __volatile__("" : : "r"(ctx->dst) : "memory");
+	}
+
+	return 0;
+}
+
+static int op_pad(void *const arg, const size_t iterations)
+{
+	struct pack_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		rle_pad(ctx->fpdu, ctx->pad_pos, ctx->fpdu_len - ctx->pad_pos);
+	}
+
+	return 0;
+}
+
+static int op_reassembly_comp_ppdu(void *const arg, const size_t iterations)
+{
+	struct rasm_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		if (reassembly_comp_ppdu(&ctx->receiver->conf, ctx->ppdu, ctx->ppdu_len,
+		                         &ctx->sdu) != C_REASSEMBLY_OK) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int op_reassembly_start_ppdu(void *const arg, const size_t iterations)
+{
+	struct rasm_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		int index_ctx;
+
+		rasm_restore(ctx);
+		if (reassembly_start_ppdu(ctx->receiver, ctx->ppdu, ctx->ppdu_len,
+		                          &index_ctx) != C_OK) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int op_reassembly_cont_ppdu(void *const arg, const size_t iterations)
+{
+	struct rasm_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		int index_ctx;
+
+		rasm_restore(ctx);
+		if (reassembly_cont_ppdu(ctx->receiver, ctx->ppdu, ctx->ppdu_len,
+		                         &index_ctx) != C_OK) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int op_reassembly_end_ppdu(void *const arg, const size_t iterations)
+{
+	struct rasm_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		int index_ctx;
+
+		rasm_restore(ctx);
+		if (reassembly_end_ppdu(ctx->receiver, ctx->ppdu, ctx->ppdu_len, &index_ctx,
+		                        &ctx->sdu) != C_REASSEMBLY_OK) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int op_decapsulate(void *const arg, const size_t iterations)
+{
+	struct decap_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		size_t sdus_nr;
+
+		if (rle_decapsulate(ctx->receiver, ctx->fpdu, ctx->fpdu_len, ctx->sdus,
+		                    ctx->sdus_max_nr, &sdus_nr, NULL, 0) != RLE_DECAP_OK) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int op_decapsulate_complete(void *const arg, const size_t iterations)
+{
+	struct decap_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		size_t sdus_nr;
+
+		if (rle_decapsulate_complete(ctx->conf, ctx->fpdu, ctx->fpdu_len, ctx->sdus,
+		                             ctx->sdus_max_nr, &sdus_nr, NULL, 0) != RLE_DECAP_OK) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Encapsulate the same SDU again and again in the fragment context 0, then free it
+ *
+ * @param[in,out] arg         The encapsulation benchmark context
+ * @param[in]     iterations  The number of calls to perform
+ * @return                    0 in case of success, 1 if the function failed
+ */
+static int op_encapsulate(void *const arg, const size_t iterations)
+{
+	struct encap_ctx *const ctx = arg;
+	size_t i;
+
+	for (i = 0; i < iterations; i++) {
+		if (rle_encapsulate(ctx->transmitter, ctx->sdu, 0) != RLE_ENCAP_OK) {
+			return 1;
+		}
+		rle_transmitter_free_context(ctx->transmitter, 0);
+	}
+
+	return 0;
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------------- STATE HELPERS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Save the pointers and SDU information of a fragmentation buffer
+ *
+ * @param[in,out] ctx  The frag buffer benchmark context
+ */
+static void frag_buf_save(struct frag_buf_ctx *const ctx)
+{
+	const size_t offset = offsetof(struct rle_frag_buf, cur_pos);
+
+	memcpy((unsigned char *)&ctx->state + offset, (unsigned char *)ctx->frag_buf + offset,
+	       sizeof(struct rle_frag_buf) - offset);
+}
+
+/**
+ * @brief Restore the pointers and SDU information of a fragmentation buffer
+ *
+ * @param[in,out] ctx  The frag buffer benchmark context
+ */
+static void frag_buf_restore(struct frag_buf_ctx *const ctx)
+{
+	const size_t offset = offsetof(struct rle_frag_buf, cur_pos);
+
+	memcpy((unsigned char *)ctx->frag_buf + offset, (unsigned char *)&ctx->state + offset,
+	       sizeof(struct rle_frag_buf) - offset);
+}
+
+/**
+ * @brief Save the reassembly context of the fragment ID of a reassembly benchmark
+ *
+ * @param[in,out] ctx  The reassembly benchmark context
+ */
+static void rasm_save(struct rasm_ctx *const ctx)
+{
+	const struct rle_ctx_mngt *const rle_ctx = &ctx->receiver->rle_ctx_man[ctx->frag_id];
+
+	ctx->ctx_state = *rle_ctx;
+	ctx->rasm_buf_state = *((rle_rasm_buf_t *)rle_ctx->buff);
+	ctx->free_ctx_state = ctx->receiver->free_ctx;
+}
+
+/**
+ * @brief Restore the reassembly context of the fragment ID of a reassembly benchmark
+ *
+ * @param[in,out] ctx  The reassembly benchmark context
+ */
+static void rasm_restore(struct rasm_ctx *const ctx)
+{
+	struct rle_ctx_mngt *const rle_ctx = &ctx->receiver->rle_ctx_man[ctx->frag_id];
+
+	*rle_ctx = ctx->ctx_state;
+	*((rle_rasm_buf_t *)rle_ctx->buff) = ctx->rasm_buf_state;
+	ctx->receiver->free_ctx = ctx->free_ctx_state;
+}
+
+/**
+ * @brief Encapsulate and fragment one SDU into PPDUs
+ *
+ * @param[in]  conf          The RLE configuration
+ * @param[in]  sdu_len       The length of the SDU
+ * @param[in]  burst_size    The maximum size of the PPDUs
+ * @param[out] ppdus         The PPDUs
+ * @param[out] ppdus_len     The length of the PPDUs
+ * @param[in]  ppdus_max_nr  The maximum number of PPDUs
+ * @param[out] ppdus_nr      The number of PPDUs
+ * @return                   0 in case of success, 1 otherwise
+ */
+static int build_ppdus(const struct rle_config *const conf,
+                       const size_t sdu_len,
+                       const size_t burst_size,
+                       unsigned char ppdus[][FRAG_BURST_SIZE],
+                       size_t ppdus_len[],
+                       const size_t ppdus_max_nr,
+                       size_t *const ppdus_nr)
+{
+	struct rle_transmitter *transmitter;
+	unsigned char sdu_buf[RLE_MAX_PDU_SIZE];
+	struct rle_sdu sdu = {
+		.buffer = sdu_buf,
+		.size = sdu_len,
+		.protocol_type = 0x0800,
+	};
+	const uint8_t frag_id = 0;
+	int status = 1;
+
+	assert(burst_size <= FRAG_BURST_SIZE);
+
+	transmitter = rle_transmitter_new(conf);
+	if (transmitter == NULL) {
+		fprintf(stderr, "failed to create the transmitter\n");
+		goto error;
+	}
+
+	fill_sdu(sdu_buf, sdu_len);
+	if (rle_encapsulate(transmitter, &sdu, frag_id) != RLE_ENCAP_OK) {
+		fprintf(stderr, "failed to encapsulate the %zu-byte SDU\n", sdu_len);
+		goto destroy;
+	}
+
+	*ppdus_nr = 0;
+	while (rle_transmitter_stats_get_queue_size(transmitter, frag_id) != 0) {
+		unsigned char *ppdu;
+
+		if (*ppdus_nr >= ppdus_max_nr ||
+		    rle_fragment(transmitter, frag_id, burst_size, &ppdu,
+		                 &ppdus_len[*ppdus_nr]) != RLE_FRAG_OK) {
+			fprintf(stderr, "failed to fragment the %zu-byte SDU\n", sdu_len);
+			goto destroy;
+		}
+		memcpy(ppdus[*ppdus_nr], ppdu, ppdus_len[*ppdus_nr]);
+		(*ppdus_nr)++;
+	}
+
+	status = 0;
+
+destroy:
+	rle_transmitter_destroy(&transmitter);
+error:
+	return status;
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------------ BENCHMARKS ------------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief Benchmark compute_crc() with several lengths
+ *
+ * @param[in,out] output  The JSON output
+ * @return                0 in case of success, 1 otherwise
+ */
+static int bench_crc(struct bench_output *const output)
+{
+	const size_t lengths[] = { 16, 64, 256, 1024, RLE_MAX_PDU_SIZE };
+	unsigned char data[RLE_MAX_PDU_SIZE];
+	size_t i;
+
+	fill_sdu(data, sizeof(data));
+
+	for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+		struct crc_ctx ctx = {
+			.data = data,
+			.length = lengths[i],
+			.crc = RLE_CRC_INIT,
+		};
+		char param[16];
+
+		snprintf(param, sizeof(param), "%zu", lengths[i]);
+		if (bench_run(output, "compute_crc", param, op_compute_crc, &ctx) != 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Benchmark the copy kernel of the data path against the memcpy() of the libc
+ *
+ * @param[in,out] output  The JSON output
+ * @return                0 in case of success, 1 otherwise
+ */
+static int bench_copy(struct bench_output *const output)
+{
+	const size_t lengths[] = { 8, 20, 40, 64, 128, 300, FRAG_BURST_SIZE, FRAG_BURST_SIZE * 2 };
+	/* not on the stack, where the destination would just follow the source, as no buffers of
+	 * the data path do */
+	static unsigned char src[FRAG_BURST_SIZE * 2];
+	static unsigned char dst[FRAG_BURST_SIZE * 2 + 8];
+	struct copy_ctx ctx = {
+		.src = src,
+		.dst = dst,
+	};
+	size_t i;
+
+	fill_sdu(src, sizeof(src));
+	fprintf(stderr, "copy kernel: %s\n", rle_copy_get_kernel_name());
+
+	for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+		char param[16];
+
+		size_t offset;
+
+		/* check the copy at every offset of the destination first */
+		for (offset = 0; offset < 8; offset++) {
+			memset(dst, 0, sizeof(dst));
+			rle_copy(dst + offset, src, lengths[i]);
+			if (memcmp(dst + offset, src, lengths[i]) != 0 ||
+			    (offset > 0 && dst[offset - 1] != 0) || dst[offset + lengths[i]] != 0) {
+				fprintf(stderr, "rle_copy(%zu) at offset %zu is wrong\n", lengths[i], offset);
+				return 1;
+			}
+		}
+
+		ctx.length = lengths[i];
+		snprintf(param, sizeof(param), "%zu", lengths[i]);
+		if (bench_run(output, "rle_copy", param, op_rle_copy, &ctx) != 0 ||
+		    bench_run(output, "memcpy", param, op_memcpy, &ctx) != 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Benchmark the functions working on a fragmentation buffer
+ *
+ * @param[in,out] output  The JSON output
+ * @return                0 in case of success, 1 otherwise
+ */
+static int bench_frag_buf(struct bench_output *const output)
+{
+	const char *const alpdu_params[] = { "uncomp", "comp", "omitted" };
+	unsigned char sdu_buf[FRAG_SDU_LEN];
+	const struct rle_sdu sdu = {
+		.buffer = sdu_buf,
+		.size = FRAG_SDU_LEN,
+		.protocol_type = 0x0800,
+	};
+	struct frag_buf_ctx ctx;
+	size_t i;
+	int status = 1;
+
+	fill_sdu(sdu_buf, sizeof(sdu_buf));
+
+	memset(&ctx.rle_ctx, 0, sizeof(struct rle_ctx_mngt));
+	ctx.conf = default_conf;
+	ctx.frag_buf = rle_frag_buf_new();
+	if (ctx.frag_buf == NULL) {
+		fprintf(stderr, "failed to create the fragmentation buffer\n");
+		goto error;
+	}
+
+	if (bench_run(output, "rle_frag_buf_init", "", op_frag_buf_init, &ctx) != 0) {
+		goto free_frag_buf;
+	}
+
+	for (i = 0; i < sizeof(alpdu_params) / sizeof(alpdu_params[0]); i++) {
+		ctx.conf = default_conf;
+		ctx.conf.use_compressed_ptype = (i == 1);
+		ctx.conf.allow_ptype_omission = (i == 2);
+		ctx.conf.implicit_protocol_type = (i == 2 ? 0x0d : 0x00);
+
+		if (rle_frag_buf_init(ctx.frag_buf) != 0 ||
+		    rle_frag_buf_cpy_sdu(ctx.frag_buf, &sdu) != 0) {
+			fprintf(stderr, "failed to copy the SDU in the fragmentation buffer\n");
+			goto free_frag_buf;
+		}
+		frag_buf_save(&ctx);
+
+		if (bench_run(output, "push_alpdu_hdr", alpdu_params[i], op_push_alpdu_hdr,
+		              &ctx) != 0) {
+			goto free_frag_buf;
+		}
+	}
+
+	/* PPDU header of a COMP PPDU (ALPDU fits in the burst) and of a START PPDU */
+	ctx.conf = default_conf;
+	if (rle_frag_buf_init(ctx.frag_buf) != 0 ||
+	    rle_frag_buf_cpy_sdu(ctx.frag_buf, &sdu) != 0) {
+		fprintf(stderr, "failed to copy the SDU in the fragmentation buffer\n");
+		goto free_frag_buf;
+	}
+	push_alpdu_hdr(ctx.frag_buf, &ctx.conf);
+	frag_buf_save(&ctx);
+
+	ctx.ppdu_len = RLE_MAX_PPDU_PL_SIZE;
+	if (bench_run(output, "push_ppdu_hdr", "complete", op_push_ppdu_hdr, &ctx) != 0) {
+		goto free_frag_buf;
+	}
+	ctx.ppdu_len = FRAG_BURST_SIZE;
+	if (bench_run(output, "push_ppdu_hdr", "start", op_push_ppdu_hdr, &ctx) != 0) {
+		goto free_frag_buf;
+	}
+
+	status = 0;
+
+free_frag_buf:
+	rle_frag_buf_del(&ctx.frag_buf);
+error:
+	return status;
+}
+
+/**
+ * @brief Benchmark rle_pack() and rle_pad()
+ *
+ * @param[in,out] output  The JSON output
+ * @return                0 in case of success, 1 otherwise
+ */
+static int bench_pack(struct bench_output *const output)
+{
+	const size_t ppdu_lengths[] = { 64, FRAG_BURST_SIZE };
+	const size_t pad_lengths[] = { 8, 64, FRAG_BURST_SIZE };
+	unsigned char ppdu[FRAG_BURST_SIZE];
+	unsigned char fpdu[FRAG_BURST_SIZE];
+	struct pack_ctx ctx = {
+		.ppdu = ppdu,
+		.fpdu = fpdu,
+		.fpdu_len = FRAG_BURST_SIZE,
+	};
+	size_t i;
+
+	fill_sdu(ppdu, sizeof(ppdu));
+
+	for (i = 0; i < sizeof(ppdu_lengths) / sizeof(ppdu_lengths[0]); i++) {
+		char param[16];
+
+		ctx.ppdu_len = ppdu_lengths[i];
+		snprintf(param, sizeof(param), "%zu", ppdu_lengths[i]);
+		if (bench_run(output, "rle_pack", param, op_pack, &ctx) != 0) {
+			return 1;
+		}
+	}
+
+	for (i = 0; i < sizeof(pad_lengths) / sizeof(pad_lengths[0]); i++) {
+		char param[16];
+
+		ctx.pad_pos = ctx.fpdu_len - pad_lengths[i];
+		snprintf(param, sizeof(param), "%zu", pad_lengths[i]);
+		if (bench_run(output, "rle_pad", param, op_pad, &ctx) != 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Benchmark the reassembly of COMP, START, CONT and END PPDUs
+ *
+ * @param[in,out] output  The JSON output
+ * @return                0 in case of success, 1 otherwise
+ */
+static int bench_reassembly(struct bench_output *const output)
+{
+	const size_t comp_lengths[] = { 64, 512 };
+	unsigned char ppdus[3][FRAG_BURST_SIZE];
+	size_t ppdus_len[3];
+	size_t ppdus_nr;
+	unsigned char sdu_buf[SDU_BUF_LEN];
+	struct rasm_ctx ctx;
+	size_t i;
+	int status = 1;
+
+	ctx.sdu.buffer = sdu_buf;
+	ctx.frag_id = 0;
+	ctx.receiver = rle_receiver_new(&default_conf);
+	if (ctx.receiver == NULL) {
+		fprintf(stderr, "failed to create the receiver\n");
+		goto error;
+	}
+
+	for (i = 0; i < sizeof(comp_lengths) / sizeof(comp_lengths[0]); i++) {
+		char param[16];
+
+		if (build_ppdus(&default_conf, comp_lengths[i], FRAG_BURST_SIZE, ppdus, ppdus_len,
+		                1, &ppdus_nr) != 0) {
+			goto destroy;
+		}
+		ctx.ppdu = ppdus[0];
+		ctx.ppdu_len = ppdus_len[0];
+
+		snprintf(param, sizeof(param), "%zu", comp_lengths[i]);
+		if (bench_run(output, "reassembly_comp_ppdu", param, op_reassembly_comp_ppdu,
+		              &ctx) != 0) {
+			goto destroy;
+		}
+	}
+
+	/* one SDU in exactly one START, one CONT and one END PPDUs */
+	if (build_ppdus(&default_conf, FRAG_SDU_LEN, FRAG_BURST_SIZE, ppdus, ppdus_len, 3,
+	                &ppdus_nr) != 0 || ppdus_nr != 3) {
+		fprintf(stderr, "failed to build START, CONT and END PPDUs\n");
+		goto destroy;
+	}
+
+	/* START on a free context */
+	rasm_save(&ctx);
+	ctx.ppdu = ppdus[0];
+	ctx.ppdu_len = ppdus_len[0];
+	if (bench_run(output, "reassembly_start_ppdu", "599", op_reassembly_start_ppdu,
+	              &ctx) != 0) {
+		goto destroy;
+	}
+
+	/* CONT on a context that just received the START */
+	{
+		int index_ctx;
+
+		rasm_restore(&ctx);
+		if (reassembly_start_ppdu(ctx.receiver, ppdus[0], ppdus_len[0], &index_ctx) != C_OK) {
+			fprintf(stderr, "failed to reassemble the START PPDU\n");
+			goto destroy;
+		}
+		rasm_save(&ctx);
+	}
+	ctx.ppdu = ppdus[1];
+	ctx.ppdu_len = ppdus_len[1];
+	if (bench_run(output, "reassembly_cont_ppdu", "599", op_reassembly_cont_ppdu,
+	              &ctx) != 0) {
+		goto destroy;
+	}
+
+	/* END on a context that just received the START and the CONT */
+	{
+		int index_ctx;
+
+		rasm_restore(&ctx);
+		if (reassembly_cont_ppdu(ctx.receiver, ppdus[1], ppdus_len[1], &index_ctx) != C_OK) {
+			fprintf(stderr, "failed to reassemble the CONT PPDU\n");
+			goto destroy;
+		}
+		rasm_save(&ctx);
+	}
+	ctx.ppdu = ppdus[2];
+	ctx.ppdu_len = ppdus_len[2];
+	if (bench_run(output, "reassembly_end_ppdu", "1500", op_reassembly_end_ppdu, &ctx) != 0) {
+		goto destroy;
+	}
+
+	status = 0;
+
+destroy:
+	rle_receiver_destroy(&ctx.receiver);
+error:
+	return status;
+}
+
+/**
+ * @brief Benchmark rle_decapsulate() and rle_decapsulate_complete() with FPDUs of 1 to
+ *        DECAP_MAX_PPDUS_NR COMP PPDUs
+ *
+ * @param[in,out] output  The JSON output
+ * @return                0 in case of success, 1 otherwise
+ */
+static int bench_decapsulate(struct bench_output *const output)
+{
+	unsigned char ppdus[1][FRAG_BURST_SIZE];
+	size_t ppdus_len[1];
+	size_t ppdus_nr;
+	unsigned char fpdu[DECAP_MAX_PPDUS_NR * FRAG_BURST_SIZE];
+	struct rle_sdu sdus[DECAP_MAX_PPDUS_NR];
+	unsigned char *sdus_buf;
+	struct decap_ctx ctx;
+	size_t nr;
+	size_t i;
+	int status = 1;
+
+	sdus_buf = malloc(DECAP_MAX_PPDUS_NR * SDU_BUF_LEN);
+	if (sdus_buf == NULL) {
+		fprintf(stderr, "failed to allocate the SDU buffers\n");
+		goto error;
+	}
+	for (i = 0; i < DECAP_MAX_PPDUS_NR; i++) {
+		sdus[i].buffer = sdus_buf + i * SDU_BUF_LEN;
+	}
+
+	ctx.fpdu = fpdu;
+	ctx.sdus = sdus;
+	ctx.sdus_max_nr = DECAP_MAX_PPDUS_NR;
+	ctx.conf = &default_conf;
+	ctx.receiver = rle_receiver_new(&default_conf);
+	if (ctx.receiver == NULL) {
+		fprintf(stderr, "failed to create the receiver\n");
+		goto free_buf;
+	}
+
+	if (build_ppdus(&default_conf, DECAP_SDU_LEN, FRAG_BURST_SIZE, ppdus, ppdus_len, 1,
+	                &ppdus_nr) != 0) {
+		goto destroy;
+	}
+
+	for (nr = 1; nr <= DECAP_MAX_PPDUS_NR; nr *= 2) {
+		size_t fpdu_cur_pos = 0;
+		size_t fpdu_remain_size = nr * ppdus_len[0];
+		char param[16];
+
+		for (i = 0; i < nr; i++) {
+			if (rle_pack(ppdus[0], ppdus_len[0], NULL, 0, fpdu, &fpdu_cur_pos,
+			             &fpdu_remain_size) != RLE_PACK_OK) {
+				fprintf(stderr, "failed to pack PPDU #%zu\n", i + 1);
+				goto destroy;
+			}
+		}
+		ctx.fpdu_len = fpdu_cur_pos;
+
+		snprintf(param, sizeof(param), "%zu", nr);
+		if (bench_run(output, "rle_decapsulate", param, op_decapsulate, &ctx) != 0 ||
+		    bench_run(output, "rle_decapsulate_complete", param, op_decapsulate_complete,
+		              &ctx) != 0) {
+			goto destroy;
+		}
+	}
+
+	status = 0;
+
+destroy:
+	rle_receiver_destroy(&ctx.receiver);
+free_buf:
+	free(sdus_buf);
+error:
+	return status;
+}
+
+/**
+ * @brief Benchmark rle_encapsulate() in CRC mode with a signalling SDU sent again and again,
+ *        without and with the ALPDU cache of the transmitter
+ *
+ * @param[in,out] output  The JSON output
+ * @return                0 in case of success, 1 otherwise
+ */
+static int bench_encapsulate(struct bench_output *const output)
+{
+	const char *const cache_params[] = { "signal/nocache", "signal/cache" };
+	unsigned char sdu_buf[ENCAP_SIGNAL_SDU_LEN];
+	const struct rle_sdu sdu = {
+		.buffer = sdu_buf,
+		.size = sizeof(sdu_buf),
+		.protocol_type = 0x0082,
+	};
+	struct rle_config conf = default_conf;
+	struct encap_ctx ctx;
+	size_t i;
+	int status = 1;
+
+	fill_sdu(sdu_buf, sizeof(sdu_buf));
+	conf.allow_alpdu_crc = 1;
+	conf.allow_alpdu_sequence_number = 0;
+	ctx.sdu = &sdu;
+
+	for (i = 0; i < sizeof(cache_params) / sizeof(cache_params[0]); i++) {
+		int ret;
+
+		ctx.transmitter = rle_transmitter_new(&conf);
+		if (ctx.transmitter == NULL) {
+			fprintf(stderr, "failed to create the transmitter\n");
+			goto error;
+		}
+		if (i == 1 && rle_transmitter_enable_alpdu_cache(ctx.transmitter) != 0) {
+			fprintf(stderr, "failed to enable the ALPDU cache\n");
+			rle_transmitter_destroy(&ctx.transmitter);
+			goto error;
+		}
+
+		ret = bench_run(output, "rle_encapsulate", cache_params[i], op_encapsulate, &ctx);
+		rle_transmitter_destroy(&ctx.transmitter);
+		if (ret != 0) {
+			goto error;
+		}
+	}
+
+	status = 0;
+
+error:
+	return status;
+}
@@ -2261,3 +2261,150 @@ error:
 	printf("\n");
 	return is_success;
 }
+
+bool test_decap_complete(void)
+{
+	bool is_success = false;
+
+	const struct rle_config conf = {
+		.allow_ptype_omission = 1,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 3,
+		.type_0_alpdu_label_size = 0,
+	};
+
+	/* Ethernet frame with a VLAN header and an IPv4 payload */
+	unsigned char vlan_frame[100];
+	const unsigned char label[3] = { 0x00, 0x01, 0x02 };
+	unsigned char fpdu_label[3];
+
+	const struct rle_sdu sdus_in[] = {
+		{ .buffer = vlan_frame, .size = sizeof(vlan_frame), .protocol_type = 0x8100 },
+		{ .buffer = (unsigned char *)payload_initializer, .size = 500, .protocol_type = 0x1234 },
+		{ .buffer = (unsigned char *)payload_initializer, .size = 60, .protocol_type = 0x0082 },
+		{ .buffer = (unsigned char *)payload_initializer, .size = 1, .protocol_type = 0x0806 },
+	};
+	const size_t sdus_in_nr = sizeof(sdus_in) / sizeof(sdus_in[0]);
+
+	const size_t sdu_buffer_len = 600;
+	unsigned char sdu_buffers[sizeof(sdus_in) / sizeof(sdus_in[0])][sdu_buffer_len];
+	struct rle_sdu sdus[sizeof(sdus_in) / sizeof(sdus_in[0])];
+	size_t sdus_nr = 0;
+
+	unsigned char fpdu[1000];
+	size_t fpdu_pos = 0;
+	size_t fpdu_rem = sizeof(fpdu);
+
+	struct rle_transmitter *transmitter = NULL;
+	struct rle_receiver *receiver = NULL;
+	enum rle_decap_status ret_decap;
+	unsigned char *ppdu;
+	size_t ppdu_len;
+	size_t i;
+
+	PRINT_TEST("Decapsulation of COMPLETE PPDUs without receiver");
+
+	memcpy(vlan_frame, payload_initializer, sizeof(vlan_frame));
+	vlan_frame[12] = 0x81;
+	vlan_frame[13] = 0x00;
+	vlan_frame[16] = 0x08;
+	vlan_frame[17] = 0x00;
+	vlan_frame[18] = 0x45;
+
+	for (i = 0; i < sdus_in_nr; i++) {
+		sdus[i].buffer = sdu_buffers[i];
+		sdus[i].size = 0;
+		sdus[i].protocol_type = 0x0000;
+
+		if (rle_encap_pack_complete(&conf, &sdus_in[i], label, sizeof(label), fpdu, &fpdu_pos,
+		                            &fpdu_rem) != RLE_PACK_OK) {
+			PRINT_ERROR("failed to pack SDU #%zu", i + 1);
+			goto out;
+		}
+	}
+	rle_pad(fpdu, fpdu_pos, fpdu_rem);
+
+	ret_decap = rle_decapsulate_complete(NULL, fpdu, sizeof(fpdu), sdus, sdus_in_nr, &sdus_nr,
+	                                     fpdu_label, sizeof(fpdu_label));
+	if (ret_decap != RLE_DECAP_ERR) {
+		PRINT_ERROR("Decap without configuration does not return ERR.");
+		goto out;
+	}
+
+	printf("\tdecapsulate %zu-byte FPDU of COMPLETE PPDUs\n", sizeof(fpdu));
+	ret_decap = rle_decapsulate_complete(&conf, fpdu, sizeof(fpdu), sdus, sdus_in_nr, &sdus_nr,
+	                                     fpdu_label, sizeof(fpdu_label));
+	if (ret_decap != RLE_DECAP_OK) {
+		PRINT_ERROR("Decap does not return OK.");
+		goto out;
+	}
+	if (sdus_nr != sdus_in_nr) {
+		PRINT_ERROR("%zu SDUs decapsulated while %zu expected", sdus_nr, sdus_in_nr);
+		goto out;
+	}
+	if (memcmp(fpdu_label, label, sizeof(label)) != 0) {
+		PRINT_ERROR("wrong payload label");
+		goto out;
+	}
+	for (i = 0; i < sdus_in_nr; i++) {
+		if (sdus[i].size != sdus_in[i].size ||
+		    sdus[i].protocol_type != sdus_in[i].protocol_type ||
+		    memcmp(sdus[i].buffer, sdus_in[i].buffer, sdus[i].size) != 0) {
+			PRINT_ERROR("SDU #%zu differs from the encapsulated one", i + 1);
+			goto out;
+		}
+	}
+
+	/* a START PPDU after the COMPLETE one: the FPDU is left to the receiver */
+	transmitter = rle_transmitter_new(&conf);
+	receiver = rle_receiver_new(&conf);
+	if (transmitter == NULL || receiver == NULL) {
+		PRINT_ERROR("Error allocating transmitter or receiver");
+		goto out;
+	}
+	fpdu_pos = 0;
+	fpdu_rem = 200;
+	if (rle_encap_pack_complete(&conf, &sdus_in[2], label, sizeof(label), fpdu, &fpdu_pos,
+	                            &fpdu_rem) != RLE_PACK_OK ||
+	    rle_encapsulate(transmitter, &sdus_in[1], 0) != RLE_ENCAP_OK ||
+	    rle_fragment(transmitter, 0, fpdu_rem, &ppdu, &ppdu_len) != RLE_FRAG_OK ||
+	    rle_pack(ppdu, ppdu_len, label, sizeof(label), fpdu, &fpdu_pos,
+	             &fpdu_rem) != RLE_PACK_OK) {
+		PRINT_ERROR("failed to build the FPDU with a START PPDU");
+		goto out;
+	}
+	rle_pad(fpdu, fpdu_pos, fpdu_rem);
+
+	/* the SDUs count of the previous FPDU is reset even if the FPDU is left to the receiver */
+	sdus_nr = sdus_in_nr;
+	ret_decap = rle_decapsulate_complete(&conf, fpdu, 200, sdus, sdus_in_nr, &sdus_nr,
+	                                     fpdu_label, sizeof(fpdu_label));
+	if (ret_decap != RLE_DECAP_NEED_RCVR || sdus_nr != 0) {
+		PRINT_ERROR("Decap of a START PPDU does not return NEED_RCVR.");
+		goto out;
+	}
+	ret_decap = rle_decapsulate(receiver, fpdu, 200, sdus, sdus_in_nr, &sdus_nr, fpdu_label,
+	                            sizeof(fpdu_label));
+	if (ret_decap != RLE_DECAP_OK || sdus_nr != 1 || sdus[0].size != sdus_in[2].size) {
+		PRINT_ERROR("Decap of the FPDU by the receiver failed.");
+		goto out;
+	}
+
+	is_success = true;
+
+out:
+	if (receiver != NULL) {
+		rle_receiver_destroy(&receiver);
+	}
+	if (transmitter != NULL) {
+		rle_transmitter_destroy(&transmitter);
+	}
+	PRINT_TEST_STATUS(is_success);
+	printf("\n");
+	return is_success;
+}
@@ -36,6 +36,7 @@
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdbool.h>
 #include <string.h>
 #include <assert.h>
@@ -684,3 +685,168 @@ error:
 	printf("\n");
 	return output;
 }
+
+bool test_encap_alpdu_cache(void)
+{
+	PRINT_TEST("Test the encapsulation of the SDUs found in the ALPDU cache.");
+	bool output = false;
+	const uint8_t frag_id = 0; /* Arbitrarly */
+	const size_t burst_size = 40; /* START, CONT and END PPDUs */
+	unsigned char signal[48];
+	unsigned char ipv4[60];
+	unsigned char vlan[64];
+	unsigned char big[300];
+	const struct rle_sdu sdus[] = {
+		{ .buffer = signal, .size = sizeof(signal), .protocol_type = 0x0082 },
+		{ .buffer = ipv4, .size = sizeof(ipv4), .protocol_type = 0x0800 },
+		{ .buffer = signal, .size = sizeof(signal), .protocol_type = 0x0082 },
+		{ .buffer = vlan, .size = sizeof(vlan), .protocol_type = 0x8100 },
+		{ .buffer = big, .size = sizeof(big), .protocol_type = 0x0800 },
+		{ .buffer = signal, .size = sizeof(signal), .protocol_type = 0x0082 },
+		{ .buffer = ipv4, .size = sizeof(ipv4), .protocol_type = 0x0800 },
+		{ .buffer = vlan, .size = sizeof(vlan), .protocol_type = 0x8100 },
+	};
+	/* the big SDU is not looked for, the others are found from their second time on */
+	const uint64_t expected_hits = 4;
+	const uint64_t expected_misses = 3;
+	const struct rle_config conf_crc = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const struct rle_config conf_omitted = {
+		.allow_ptype_omission = 1,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x0f, /* VLAN without protocol type field */
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const struct rle_config conf_seqnum = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const struct rle_config *const confs[] = { &conf_crc, &conf_omitted, NULL };
+	const struct rle_config *const *conf;
+	struct rle_transmitter *transmitter = NULL;
+	struct rle_transmitter *cached_transmitter = NULL;
+
+	memcpy(signal, payload_initializer, sizeof(signal));
+	memcpy(ipv4, payload_initializer + 7, sizeof(ipv4));
+	memcpy(big, payload_initializer + 11, sizeof(big));
+	/* Ethernet/VLAN/IPv4 frame, so the protocol type of the VLAN header may be omitted */
+	memcpy(vlan, payload_initializer + 13, sizeof(vlan));
+	vlan[12] = 0x81;
+	vlan[13] = 0x00;
+	vlan[16] = 0x08;
+	vlan[17] = 0x00;
+	vlan[18] = 0x45;
+
+	/* with sequence numbers, there is no CRC for the cache to save */
+	cached_transmitter = rle_transmitter_new(&conf_seqnum);
+	assert(cached_transmitter != NULL);
+	if (rle_transmitter_enable_alpdu_cache(cached_transmitter) == 0) {
+		PRINT_ERROR("ALPDU cache enabled with sequence numbers.");
+		goto exit_label;
+	}
+	if (rle_encapsulate(cached_transmitter, &sdus[0], frag_id) != RLE_ENCAP_OK ||
+	    rle_transmitter_stats_get_alpdu_cache_misses(cached_transmitter) != 0) {
+		PRINT_ERROR("ALPDU cache used with sequence numbers.");
+		goto exit_label;
+	}
+	rle_transmitter_destroy(&cached_transmitter);
+
+	for (conf = confs; *conf; ++conf) {
+		size_t i;
+
+		transmitter = rle_transmitter_new(*conf);
+		cached_transmitter = rle_transmitter_new(*conf);
+		assert(transmitter != NULL && cached_transmitter != NULL);
+
+		if (rle_transmitter_enable_alpdu_cache(cached_transmitter) != 0) {
+			PRINT_ERROR("ALPDU cache not enabled.");
+			goto exit_label;
+		}
+
+		/* the SDUs shall be sent in the same PPDUs with and without the cache */
+		for (i = 0; i < sizeof(sdus) / sizeof(sdus[0]); ++i) {
+			if (rle_encapsulate(transmitter, &sdus[i], frag_id) != RLE_ENCAP_OK ||
+			    rle_encapsulate(cached_transmitter, &sdus[i], frag_id) != RLE_ENCAP_OK) {
+				PRINT_ERROR("SDU %zu not encapsulated.", i);
+				goto exit_label;
+			}
+
+			while (rle_transmitter_stats_get_queue_size(transmitter, frag_id) > 0) {
+				unsigned char *ppdu;
+				unsigned char *cached_ppdu;
+				size_t ppdu_len;
+				size_t cached_ppdu_len;
+
+				if (rle_fragment(transmitter, frag_id, burst_size, &ppdu,
+				                 &ppdu_len) != RLE_FRAG_OK ||
+				    rle_fragment(cached_transmitter, frag_id, burst_size, &cached_ppdu,
+				                 &cached_ppdu_len) != RLE_FRAG_OK) {
+					PRINT_ERROR("SDU %zu not fragmented.", i);
+					goto exit_label;
+				}
+				if (!compare_packets(ppdu, ppdu_len, cached_ppdu, cached_ppdu_len)) {
+					PRINT_ERROR("SDU %zu not sent the same with the ALPDU cache.", i);
+					goto exit_label;
+				}
+			}
+			if (rle_transmitter_stats_get_queue_size(cached_transmitter, frag_id) != 0) {
+				PRINT_ERROR("SDU %zu longer with the ALPDU cache.", i);
+				goto exit_label;
+			}
+		}
+
+		if (rle_transmitter_stats_get_alpdu_cache_hits(cached_transmitter) != expected_hits ||
+		    rle_transmitter_stats_get_alpdu_cache_misses(cached_transmitter) !=
+		    expected_misses) {
+			PRINT_ERROR("ALPDU cache: %" PRIu64 " hits and %" PRIu64 " misses, "
+			            "%" PRIu64 " and %" PRIu64 " expected.",
+			            rle_transmitter_stats_get_alpdu_cache_hits(cached_transmitter),
+			            rle_transmitter_stats_get_alpdu_cache_misses(cached_transmitter),
+			            expected_hits, expected_misses);
+			goto exit_label;
+		}
+		if (rle_transmitter_stats_get_alpdu_cache_hits(transmitter) != 0) {
+			PRINT_ERROR("ALPDU cache used while disabled.");
+			goto exit_label;
+		}
+
+		rle_transmitter_destroy(&transmitter);
+		rle_transmitter_destroy(&cached_transmitter);
+	}
+
+	output = true;
+
+exit_label:
+
+	if (transmitter != NULL) {
+		rle_transmitter_destroy(&transmitter);
+	}
+	if (cached_transmitter != NULL) {
+		rle_transmitter_destroy(&cached_transmitter);
+	}
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+	return output;
+}
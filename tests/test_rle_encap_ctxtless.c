@@ -318,3 +318,206 @@ out:
 	printf("\n");
 	return output;
 }
+
+/**
+ * @brief         Encapsulate and pack a SDU in a COMPLETE PPDU with the stateful functions.
+ *
+ * @param[in]     transmitter             The transmitter.
+ * @param[in,out] f_buff                  The fragmentation buffer.
+ * @param[in]     sdu                     The SDU.
+ * @param[in]     label                   The FPDU label fields.
+ * @param[in]     label_size              Size of the FPDU label fields.
+ * @param[in,out] fpdu                    The FPDU.
+ * @param[in,out] fpdu_current_pos        Current position in the FPDU.
+ * @param[in,out] fpdu_remaining_size     Remaining size in the FPDU.
+ *
+ * @return        true if OK, else false.
+ */
+static bool encap_pack_complete_ref(struct rle_transmitter *const transmitter,
+                                    struct rle_frag_buf *const f_buff,
+                                    const struct rle_sdu *const sdu,
+                                    const unsigned char *const label,
+                                    const size_t label_size,
+                                    unsigned char *const fpdu,
+                                    size_t *const fpdu_current_pos,
+                                    size_t *const fpdu_remaining_size)
+{
+	unsigned char *ppdu;
+	size_t ppdu_len = RLE_MAX_PPDU_PL_SIZE + sizeof(uint16_t);
+	int ret;
+
+	ret = rle_frag_buf_init(f_buff);
+	assert(ret == 0); /* cannot fail since f_buff is not NULL */
+
+	return rle_frag_buf_cpy_sdu(f_buff, sdu) == 0 &&
+	       rle_encap_contextless(transmitter, f_buff) == RLE_ENCAP_OK &&
+	       rle_frag_contextless(transmitter, f_buff, &ppdu, &ppdu_len) == RLE_FRAG_OK &&
+	       rle_pack(ppdu, ppdu_len, label, label_size, fpdu, fpdu_current_pos,
+	                fpdu_remaining_size) == RLE_PACK_OK;
+}
+
+bool test_encap_pack_complete(void)
+{
+	bool output = false;
+
+	struct rle_frag_buf *f_buff = rle_frag_buf_new();
+	struct rle_transmitter *transmitter = NULL;
+
+	/* Ethernet frame with a VLAN header and an IPv4 payload, IPv4 packet */
+	unsigned char vlan_frame[100];
+	unsigned char ipv4_packet[100];
+	const unsigned char label[3] = { 0xaa, 0xbb, 0xcc };
+
+	const struct rle_sdu sdus[] = {
+		{ .buffer = ipv4_packet, .size = sizeof(ipv4_packet), .protocol_type = 0x0800 },
+		{ .buffer = vlan_frame, .size = sizeof(vlan_frame), .protocol_type = 0x8100 },
+		{ .buffer = (unsigned char *)payload_initializer, .size = 500, .protocol_type = 0x1234 },
+		{ .buffer = (unsigned char *)payload_initializer, .size = 60, .protocol_type = 0x0082 },
+		{ .buffer = (unsigned char *)payload_initializer, .size = 1, .protocol_type = 0x86dd },
+	};
+	const size_t sdus_nr = sizeof(sdus) / sizeof(sdus[0]);
+
+	const struct rle_sdu sdu_too_long = {
+		.buffer = (unsigned char *)payload_initializer,
+		.size = 2100,
+		.protocol_type = 0x0800,
+	};
+
+	struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 0,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 3,
+		.type_0_alpdu_label_size = 0,
+	};
+
+	/* the configurations test the uncompressed, compressed, fallback and omitted protocol
+	 * types, and the omission of the VLAN protocol type */
+	const struct {
+		uint8_t allow_ptype_omission;
+		uint8_t use_compressed_ptype;
+		uint8_t implicit_protocol_type;
+		uint8_t allow_alpdu_crc;
+	} confs[] = {
+		{ 0, 0, 0x00, 0 },
+		{ 0, 1, 0x00, 1 },
+		{ 1, 0, RLE_PROTO_TYPE_IP_COMP, 0 },
+		{ 1, 1, RLE_PROTO_TYPE_IPV4_COMP, 1 },
+		{ 1, 1, RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD, 0 },
+	};
+	const size_t confs_nr = sizeof(confs) / sizeof(confs[0]);
+
+	size_t conf_id;
+
+	PRINT_TEST("Stateless encapsulation of COMPLETE PPDUs straight in the FPDU.");
+
+	if (!f_buff) {
+		PRINT_ERROR("Fragmentation buffer is NULL. Cannot test stateless encapsulation.");
+		goto out;
+	}
+
+	memcpy(ipv4_packet, payload_initializer, sizeof(ipv4_packet));
+	ipv4_packet[0] = 0x45;
+	memcpy(vlan_frame, payload_initializer, sizeof(vlan_frame));
+	vlan_frame[12] = 0x81;
+	vlan_frame[13] = 0x00;
+	vlan_frame[16] = 0x08;
+	vlan_frame[17] = 0x00;
+	vlan_frame[18] = 0x45;
+
+	for (conf_id = 0; conf_id < confs_nr; conf_id++) {
+		unsigned char fpdu[1000];
+		unsigned char fpdu_ref[1000];
+		size_t fpdu_pos = 0;
+		size_t fpdu_rem = sizeof(fpdu);
+		size_t fpdu_ref_pos = 0;
+		size_t fpdu_ref_rem = sizeof(fpdu_ref);
+		enum rle_pack_status ret_pack;
+		size_t sdu_id;
+
+		conf.allow_ptype_omission = confs[conf_id].allow_ptype_omission;
+		conf.use_compressed_ptype = confs[conf_id].use_compressed_ptype;
+		conf.implicit_protocol_type = confs[conf_id].implicit_protocol_type;
+		conf.allow_alpdu_crc = confs[conf_id].allow_alpdu_crc;
+		conf.allow_alpdu_sequence_number = !confs[conf_id].allow_alpdu_crc;
+
+		transmitter = rle_transmitter_new(&conf);
+		if (!transmitter) {
+			PRINT_ERROR("Transmitter is NULL. Cannot test stateless encapsulation.");
+			goto out;
+		}
+
+		/* every SDU is packed in the same FPDU, after the label */
+		for (sdu_id = 0; sdu_id < sdus_nr; sdu_id++) {
+			ret_pack = rle_encap_pack_complete(&conf, &sdus[sdu_id], label, sizeof(label), fpdu,
+			                                   &fpdu_pos, &fpdu_rem);
+			if (ret_pack != RLE_PACK_OK) {
+				PRINT_ERROR("Configuration %zu, SDU %zu: stateless encapsulation failed (%d).",
+				            conf_id, sdu_id, ret_pack);
+				goto out;
+			}
+			if (!encap_pack_complete_ref(transmitter, f_buff, &sdus[sdu_id], label, sizeof(label),
+			                             fpdu_ref, &fpdu_ref_pos, &fpdu_ref_rem)) {
+				PRINT_ERROR("Configuration %zu, SDU %zu: stateful encapsulation failed.",
+				            conf_id, sdu_id);
+				goto out;
+			}
+			if (fpdu_pos != fpdu_ref_pos || fpdu_rem != fpdu_ref_rem ||
+			    memcmp(fpdu, fpdu_ref, fpdu_pos) != 0) {
+				PRINT_ERROR("Configuration %zu, SDU %zu: FPDUs differ.", conf_id, sdu_id);
+				goto out;
+			}
+		}
+
+		/* no room left for another SDU, the FPDU shall be left untouched */
+		fpdu_rem = sdus[2].size;
+		ret_pack = rle_encap_pack_complete(&conf, &sdus[2], label, sizeof(label), fpdu,
+		                                   &fpdu_pos, &fpdu_rem);
+		if (ret_pack != RLE_PACK_ERR_FPDU_TOO_SMALL || fpdu_pos != fpdu_ref_pos ||
+		    fpdu_rem != sdus[2].size) {
+			PRINT_ERROR("Configuration %zu: SDU packed in a too small FPDU.", conf_id);
+			goto out;
+		}
+
+		rle_transmitter_destroy(&transmitter);
+	}
+
+	/* SDU that needs fragmentation */
+	{
+		unsigned char fpdu[RLE_MAX_PDU_SIZE];
+		size_t fpdu_pos = 0;
+		size_t fpdu_rem = sizeof(fpdu);
+
+		if (rle_encap_pack_complete(&conf, &sdu_too_long, NULL, 0, fpdu, &fpdu_pos,
+		                            &fpdu_rem) != RLE_PACK_ERR_FPDU_TOO_SMALL ||
+		    fpdu_pos != 0 || fpdu_rem != sizeof(fpdu)) {
+			PRINT_ERROR("SDU longer than a COMPLETE PPDU packed.");
+			goto out;
+		}
+		if (rle_encap_pack_complete(&conf, NULL, NULL, 0, fpdu, &fpdu_pos, &fpdu_rem) !=
+		    RLE_PACK_ERR_INVALID_SDU) {
+			PRINT_ERROR("NULL SDU packed.");
+			goto out;
+		}
+	}
+
+	output = true;
+
+out:
+
+	if (transmitter) {
+		rle_transmitter_destroy(&transmitter);
+	}
+
+	if (f_buff) {
+		rle_frag_buf_del(&f_buff);
+	}
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+	return output;
+}
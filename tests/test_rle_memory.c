@@ -27,18 +27,90 @@
  */
 
 #include "rle.h"
+#include "test_traffic_gen.h"
 
 #include <stdarg.h> /* required by cmocka header file */
 #include <setjmp.h> /* required by cmocka header file */
 #include <cmocka.h>
 #include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+/** The number of SDUs of the data path workload, for every configuration */
+#define MEMORY_SDUS_NR 2000U
+
+/** The number of burst sizes of the data path workload */
+#define MEMORY_BURSTS_NR 257U
+
+/** The maximal number of SDUs that one FPDU of the workload may carry */
+#define MEMORY_SDUS_MAX_NR 300U
+
+/** The length of the SDU buffers given to the receiver (room for VLAN ptype re-insertion) */
+#define MEMORY_SDU_BUF_LEN (RLE_MAX_PDU_SIZE + 4U)
+
+/** The maximal length of the SDUs sent without context (COMPLETE PPDU payload minus ALPDU header) */
+#define MEMORY_CTXTLESS_SDU_MAX_LEN (RLE_MAX_PPDU_PL_SIZE - 4U)
+
+/** The maximal length of a COMPLETE PPDU (payload and 2-byte header) */
+#define MEMORY_CTXTLESS_PPDU_MAX_LEN (RLE_MAX_PPDU_PL_SIZE + 2U)
+
+/** The phases of the data path workload, the heap operations are counted per phase */
+enum memory_phase_id {
+	MEMORY_PHASE_MOCKED,   /**< Not counted: malloc() results given by will_return() */
+	MEMORY_PHASE_SETUP,    /**< Not checked: generation of the workload */
+	MEMORY_PHASE_NEW,      /**< Creation of the transmitter, receiver and fragmentation buffer */
+	MEMORY_PHASE_ENCAP,    /**< Encapsulation, with and without context */
+	MEMORY_PHASE_FRAG,     /**< Fragmentation, with and without context */
+	MEMORY_PHASE_PACK,     /**< Packing and padding */
+	MEMORY_PHASE_DECAP,    /**< Decapsulation */
+	MEMORY_PHASE_ERRORS,   /**< Error paths of all the previous phases */
+	MEMORY_PHASE_DESTROY,  /**< Destruction of the transmitter, receiver and fragmentation buffer */
+	MEMORY_PHASES_NR
+};
+
+/** The heap operations of one phase */
+struct memory_phase {
+	const char *name;  /**< The name of the phase */
+	size_t allocs_nr;  /**< The number of malloc() and calloc() calls */
+	size_t frees_nr;   /**< The number of free() calls */
+};
 
 void * __real_malloc(size_t size);
 void * __wrap_malloc(size_t size);
+void * __real_calloc(size_t nmemb, size_t size);
+void * __wrap_calloc(size_t nmemb, size_t size);
+void __real_free(void *ptr);
+void __wrap_free(void *ptr);
 
 void test_rle_memory_frag_buf_new(void **state);
 void test_rle_memory_transmitter_new(void **state);
 void test_rle_memory_receiver_new(void **state);
+void test_rle_memory_datapath(void **state);
+
+/** The phase the heap operations are counted in */
+static enum memory_phase_id memory_cur_phase = MEMORY_PHASE_MOCKED;
+
+/** The heap operations of every phase */
+static struct memory_phase memory_phases[MEMORY_PHASES_NR] = {
+	[MEMORY_PHASE_MOCKED] = { "mocked", 0, 0 },
+	[MEMORY_PHASE_SETUP] = { "setup", 0, 0 },
+	[MEMORY_PHASE_NEW] = { "new", 0, 0 },
+	[MEMORY_PHASE_ENCAP] = { "encap", 0, 0 },
+	[MEMORY_PHASE_FRAG] = { "frag", 0, 0 },
+	[MEMORY_PHASE_PACK] = { "pack", 0, 0 },
+	[MEMORY_PHASE_DECAP] = { "decap", 0, 0 },
+	[MEMORY_PHASE_ERRORS] = { "errors", 0, 0 },
+	[MEMORY_PHASE_DESTROY] = { "destroy", 0, 0 },
+};
+
+/** The FPDU of the data path workload */
+static unsigned char memory_fpdu[RLE_MAX_PDU_SIZE];
+
+/** The SDU buffers given to the receiver in the data path workload */
+static unsigned char memory_sdus_buf[MEMORY_SDUS_MAX_NR][MEMORY_SDU_BUF_LEN];
+
+/** The SDUs given to the receiver in the data path workload */
+static struct rle_sdu memory_sdus[MEMORY_SDUS_MAX_NR];
 
 
 int main(void)
@@ -50,6 +122,7 @@ int main(void)
 		cmocka_unit_test(test_rle_memory_frag_buf_new),
 		cmocka_unit_test(test_rle_memory_transmitter_new),
 		cmocka_unit_test(test_rle_memory_receiver_new),
+		cmocka_unit_test(test_rle_memory_datapath),
 	};
 	test_status = cmocka_run_group_tests(tests, NULL, NULL);
 #else
@@ -57,6 +130,7 @@ int main(void)
 		unit_test(test_rle_memory_frag_buf_new),
 		unit_test(test_rle_memory_transmitter_new),
 		unit_test(test_rle_memory_receiver_new),
+		unit_test(test_rle_memory_datapath),
 	};
 	test_status = run_tests(tests);
 #endif
@@ -143,13 +217,378 @@ void test_rle_memory_receiver_new(void **state __attribute__((unused)))
 }
 
 
+/**
+ * @brief Decapsulate the FPDU of the workload
+ *
+ * @param[in,out] receiver     The receiver
+ * @param[in]     fpdu_len     The length of the FPDU
+ * @param[in]     sdus_max_nr  The number of SDUs given to the receiver
+ * @param[out]    sdus_nr      The number of SDUs decapsulated
+ * @return                     The decapsulation status
+ */
+static enum rle_decap_status memory_decap(struct rle_receiver *const receiver,
+                                          const size_t fpdu_len, const size_t sdus_max_nr,
+                                          size_t *const sdus_nr)
+{
+	size_t i;
+
+	for (i = 0; i < sdus_max_nr; i++) {
+		memory_sdus[i].buffer = memory_sdus_buf[i];
+		memory_sdus[i].size = 0;
+		memory_sdus[i].protocol_type = 0;
+	}
+	*sdus_nr = 0;
+
+	return rle_decapsulate(receiver, memory_fpdu, fpdu_len, memory_sdus, sdus_max_nr, sdus_nr,
+	                       NULL, 0);
+}
+
+/**
+ * @brief Send the SDUs of a traffic through a transmitter and a receiver
+ *
+ * Up to one SDU per frag_id is encapsulated, then the fragments of all the contexts are
+ * packed together in FPDUs of the burst sizes of the traffic, so that COMPLETE, START, CONT
+ * and END PPDUs of several contexts are interleaved.
+ *
+ * @param[in,out] transmitter  The transmitter
+ * @param[in,out] receiver     The receiver
+ * @param[in]     traffic      The SDUs to send and the burst sizes
+ * @return                     The number of SDUs decapsulated
+ */
+static size_t memory_traffic(struct rle_transmitter *const transmitter,
+                             struct rle_receiver *const receiver,
+                             const struct traffic *const traffic)
+{
+	size_t sdu_id = 0;
+	size_t burst_id = 0;
+	size_t decap_nr = 0;
+
+	while (1) {
+		const size_t burst_size = traffic->bursts[burst_id % traffic->bursts_nr];
+		size_t fpdu_cur_pos = 0;
+		size_t fpdu_remain_size = burst_size;
+		bool queues_empty = true;
+		size_t sdus_nr;
+		uint8_t frag_id;
+
+		/* encapsulate the next SDUs as long as their context is free */
+		while (sdu_id < traffic->sdus_nr) {
+			const struct traffic_sdu *const sdu = &traffic->sdus[sdu_id];
+			struct rle_sdu sdu_in;
+
+			if (rle_transmitter_stats_get_queue_size(transmitter, sdu->frag_id) != 0) {
+				break;
+			}
+			sdu_in.buffer = sdu->data;
+			sdu_in.size = sdu->size;
+			sdu_in.protocol_type = sdu->protocol_type;
+			memory_cur_phase = MEMORY_PHASE_ENCAP;
+			assert_true(rle_encapsulate(transmitter, &sdu_in, sdu->frag_id) == RLE_ENCAP_OK);
+			sdu_id++;
+		}
+
+		/* pack one fragment of every context in the FPDU */
+		for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; frag_id++) {
+			enum rle_frag_status frag_status;
+			unsigned char *ppdu;
+			size_t ppdu_len;
+
+			if (rle_transmitter_stats_get_queue_size(transmitter, frag_id) == 0) {
+				continue;
+			}
+			queues_empty = false;
+			memory_cur_phase = MEMORY_PHASE_FRAG;
+			frag_status = rle_fragment(transmitter, frag_id, fpdu_remain_size, &ppdu, &ppdu_len);
+			if (frag_status == RLE_FRAG_ERR_BURST_TOO_SMALL) {
+				continue;
+			}
+			assert_true(frag_status == RLE_FRAG_OK);
+			memory_cur_phase = MEMORY_PHASE_PACK;
+			assert_true(rle_pack(ppdu, ppdu_len, NULL, 0, memory_fpdu, &fpdu_cur_pos,
+			                     &fpdu_remain_size) == RLE_PACK_OK);
+		}
+		if (queues_empty && sdu_id >= traffic->sdus_nr) {
+			break;
+		}
+		burst_id++;
+		if (fpdu_cur_pos == 0) {
+			continue;
+		}
+		memory_cur_phase = MEMORY_PHASE_PACK;
+		rle_pad(memory_fpdu, fpdu_cur_pos, fpdu_remain_size);
+
+		memory_cur_phase = MEMORY_PHASE_DECAP;
+		assert_true(memory_decap(receiver, burst_size, MEMORY_SDUS_MAX_NR,
+		                         &sdus_nr) == RLE_DECAP_OK);
+		decap_nr += sdus_nr;
+	}
+
+	return decap_nr;
+}
+
+/**
+ * @brief Run the error paths of the data path
+ *
+ * @param[in,out] transmitter  The transmitter
+ * @param[in,out] receiver     The receiver
+ * @param[in,out] f_buff       The fragmentation buffer
+ * @param[in]     traffic      The SDUs of the workload
+ */
+static void memory_errors(struct rle_transmitter *const transmitter,
+                          struct rle_receiver *const receiver,
+                          struct rle_frag_buf *const f_buff,
+                          const struct traffic *const traffic)
+{
+	static unsigned char big_sdu_buf[RLE_MAX_PDU_SIZE + 1];
+	const size_t burst_size = 100;
+	struct rle_sdu sdu_in = {
+		.buffer = big_sdu_buf,
+		.size = RLE_MAX_PDU_SIZE + 1,
+		.protocol_type = RLE_PROTO_TYPE_IPV4_UNCOMP,
+	};
+	unsigned char *ppdu;
+	size_t ppdu_len;
+	size_t fpdu_cur_pos;
+	size_t fpdu_remain_size;
+	size_t sdus_nr;
+	size_t fpdus_nr;
+	enum rle_decap_status status;
+
+	memory_cur_phase = MEMORY_PHASE_ERRORS;
+
+	/* SDU too big to be encapsulated */
+	assert_true(rle_encapsulate(transmitter, &sdu_in, 0) == RLE_ENCAP_ERR_SDU_TOO_BIG);
+
+	/* fragmentation of an empty context, then with a burst too small */
+	assert_true(rle_fragment(transmitter, 0, burst_size, &ppdu, &ppdu_len) != RLE_FRAG_OK);
+	sdu_in.size = 1000;
+	assert_true(rle_encapsulate(transmitter, &sdu_in, 0) == RLE_ENCAP_OK);
+	assert_true(rle_fragment(transmitter, 0, 1, &ppdu, &ppdu_len) ==
+	            RLE_FRAG_ERR_BURST_TOO_SMALL);
+
+	/* FPDU too small for the PPDU */
+	assert_true(rle_fragment(transmitter, 0, burst_size, &ppdu, &ppdu_len) == RLE_FRAG_OK);
+	fpdu_cur_pos = 0;
+	fpdu_remain_size = ppdu_len - 1;
+	assert_true(rle_pack(ppdu, ppdu_len, NULL, 0, memory_fpdu, &fpdu_cur_pos,
+	                     &fpdu_remain_size) == RLE_PACK_ERR_FPDU_TOO_SMALL);
+
+	/* the START PPDU is lost: the next fragments of the SDU are dropped, then a corrupted
+	 * fragment: the SDU is dropped by the sequence number or the CRC check */
+	for (fpdus_nr = 0; rle_transmitter_stats_get_queue_size(transmitter, 0) != 0; fpdus_nr++) {
+		assert_true(rle_fragment(transmitter, 0, burst_size, &ppdu, &ppdu_len) == RLE_FRAG_OK);
+		fpdu_cur_pos = 0;
+		fpdu_remain_size = burst_size;
+		assert_true(rle_pack(ppdu, ppdu_len, NULL, 0, memory_fpdu, &fpdu_cur_pos,
+		                     &fpdu_remain_size) == RLE_PACK_OK);
+		rle_pad(memory_fpdu, fpdu_cur_pos, fpdu_remain_size);
+		status = memory_decap(receiver, burst_size, MEMORY_SDUS_MAX_NR, &sdus_nr);
+		assert_true(sdus_nr == 0);
+		if (status != RLE_DECAP_OK) {
+			assert_true(status == RLE_DECAP_ERR);
+		}
+	}
+	assert_true(fpdus_nr > 2);
+
+	sdu_in.buffer = traffic->sdus[0].data;
+	sdu_in.size = traffic->sdus[0].size;
+	sdu_in.protocol_type = traffic->sdus[0].protocol_type;
+	for (fpdus_nr = 0; fpdus_nr < 2; fpdus_nr++) {
+		assert_true(rle_encapsulate(transmitter, &sdu_in, 0) == RLE_ENCAP_OK);
+		while (rle_transmitter_stats_get_queue_size(transmitter, 0) != 0) {
+			const size_t small_burst = 30;
+
+			assert_true(rle_fragment(transmitter, 0, small_burst, &ppdu,
+			                         &ppdu_len) == RLE_FRAG_OK);
+			fpdu_cur_pos = 0;
+			fpdu_remain_size = small_burst;
+			assert_true(rle_pack(ppdu, ppdu_len, NULL, 0, memory_fpdu, &fpdu_cur_pos,
+			                     &fpdu_remain_size) == RLE_PACK_OK);
+			rle_pad(memory_fpdu, fpdu_cur_pos, fpdu_remain_size);
+			if (rle_transmitter_stats_get_queue_size(transmitter, 0) == 0) {
+				/* corrupt the last byte of the END PPDU, in the CRC or in the SDU */
+				memory_fpdu[fpdu_cur_pos - 1] ^= 0xff;
+			}
+			(void)memory_decap(receiver, small_burst, MEMORY_SDUS_MAX_NR, &sdus_nr);
+		}
+	}
+
+	/* invalid arguments of the decapsulation */
+	assert_true(rle_decapsulate(receiver, NULL, 0, memory_sdus, MEMORY_SDUS_MAX_NR, &sdus_nr,
+	                            NULL, 0) == RLE_DECAP_ERR_INV_FPDU);
+	assert_true(memory_decap(receiver, burst_size, 0, &sdus_nr) == RLE_DECAP_ERR_INV_SDUS);
+
+	/* a SDU larger than the PPDU is not possible without context */
+	sdu_in.buffer = big_sdu_buf;
+	sdu_in.size = 1000;
+	assert_true(rle_frag_buf_init(f_buff) == 0);
+	assert_true(rle_frag_buf_cpy_sdu(f_buff, &sdu_in) == 0);
+	assert_true(rle_encap_contextless(transmitter, f_buff) == RLE_ENCAP_OK);
+	ppdu_len = 1;
+	assert_true(rle_frag_contextless(transmitter, f_buff, &ppdu, &ppdu_len) ==
+	            RLE_FRAG_ERR_BURST_TOO_SMALL);
+}
+
+/**
+ * @brief Send the SDUs of a traffic with the contextless API
+ *
+ * @param[in,out] transmitter  The transmitter
+ * @param[in,out] receiver     The receiver
+ * @param[in,out] f_buff       The fragmentation buffer
+ * @param[in]     traffic      The SDUs to send
+ * @return                     The number of SDUs decapsulated
+ */
+static size_t memory_traffic_contextless(struct rle_transmitter *const transmitter,
+                                         struct rle_receiver *const receiver,
+                                         struct rle_frag_buf *const f_buff,
+                                         const struct traffic *const traffic)
+{
+	size_t decap_nr = 0;
+	size_t sdu_id;
+
+	for (sdu_id = 0; sdu_id < traffic->sdus_nr; sdu_id++) {
+		const struct traffic_sdu *const sdu = &traffic->sdus[sdu_id];
+		const struct rle_sdu sdu_in = {
+			.buffer = sdu->data,
+			.size = sdu->size,
+			.protocol_type = sdu->protocol_type,
+		};
+		size_t fpdu_cur_pos = 0;
+		size_t fpdu_remain_size = RLE_MAX_PDU_SIZE;
+		unsigned char *ppdu;
+		size_t ppdu_len = MEMORY_CTXTLESS_PPDU_MAX_LEN;
+		size_t sdus_nr;
+
+		/* without context, the ALPDU shall fit in one COMPLETE PPDU */
+		if (sdu->size > MEMORY_CTXTLESS_SDU_MAX_LEN) {
+			continue;
+		}
+
+		memory_cur_phase = MEMORY_PHASE_ENCAP;
+		assert_true(rle_frag_buf_init(f_buff) == 0);
+		assert_true(rle_frag_buf_cpy_sdu(f_buff, &sdu_in) == 0);
+		assert_true(rle_encap_contextless(transmitter, f_buff) == RLE_ENCAP_OK);
+		memory_cur_phase = MEMORY_PHASE_FRAG;
+		assert_true(rle_frag_contextless(transmitter, f_buff, &ppdu, &ppdu_len) == RLE_FRAG_OK);
+		memory_cur_phase = MEMORY_PHASE_PACK;
+		assert_true(rle_pack(ppdu, ppdu_len, NULL, 0, memory_fpdu, &fpdu_cur_pos,
+		                     &fpdu_remain_size) == RLE_PACK_OK);
+		memory_cur_phase = MEMORY_PHASE_DECAP;
+		assert_true(memory_decap(receiver, fpdu_cur_pos, MEMORY_SDUS_MAX_NR,
+		                         &sdus_nr) == RLE_DECAP_OK);
+		assert_true(sdus_nr == 1);
+		decap_nr += sdus_nr;
+	}
+
+	return decap_nr;
+}
+
+/**
+ * @brief Check that the data path does not use the heap
+ *
+ * Once the transmitter and the receiver are created, a workload of all the PPDU types, over
+ * all the protocol types, several configurations and the error paths, shall neither allocate
+ * nor release memory. The heap operations of every phase are reported.
+ */
+void test_rle_memory_datapath(void **state __attribute__((unused)))
+{
+	const struct rle_config confs[] = {
+		/* sequence number, uncompressed protocol type */
+		{ .allow_alpdu_sequence_number = 1 },
+		/* CRC, uncompressed protocol type */
+		{ .allow_alpdu_crc = 1 },
+		/* sequence number, compressed protocol type */
+		{ .allow_alpdu_sequence_number = 1, .use_compressed_ptype = 1 },
+		/* CRC, compressed protocol type, IPv4 omitted */
+		{ .allow_alpdu_crc = 1, .use_compressed_ptype = 1, .allow_ptype_omission = 1,
+		  .implicit_protocol_type = RLE_PROTO_TYPE_IPV4_COMP },
+		/* sequence number, uncompressed protocol type, IPv4 or IPv6 omitted */
+		{ .allow_alpdu_sequence_number = 1, .allow_ptype_omission = 1,
+		  .implicit_protocol_type = RLE_PROTO_TYPE_IP_COMP },
+		/* sequence number, compressed protocol type, VLAN protocol field omitted */
+		{ .allow_alpdu_sequence_number = 1, .use_compressed_ptype = 1,
+		  .allow_ptype_omission = 1,
+		  .implicit_protocol_type = RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD },
+	};
+	const size_t confs_nr = sizeof(confs) / sizeof(confs[0]);
+	struct traffic_gen_conf gen_conf;
+	struct traffic traffic;
+	size_t conf_id;
+	int phase_id;
+
+	/* all the protocol types on all the contexts, with SDUs from 1 byte to the maximum size */
+	memory_cur_phase = MEMORY_PHASE_SETUP;
+	traffic_gen_conf_init(&gen_conf);
+	assert_true(traffic_gen_parse_sizes("40:7,576:4,1500:1,1-4088:2", &gen_conf) == 0);
+	assert_true(traffic_gen_parse_ptypes("ipv4,ipv6,vlan,arp,signal", &gen_conf) == 0);
+	gen_conf.flows_nr = RLE_MAX_FRAG_NUMBER;
+	assert_true(traffic_gen(&gen_conf, MEMORY_SDUS_NR, MEMORY_BURSTS_NR, &traffic) == 0);
+
+	for (conf_id = 0; conf_id < confs_nr; conf_id++) {
+		struct rle_transmitter *transmitter;
+		struct rle_receiver *receiver;
+		struct rle_frag_buf *f_buff;
+
+		for (phase_id = 0; phase_id < MEMORY_PHASES_NR; phase_id++) {
+			memory_phases[phase_id].allocs_nr = 0;
+			memory_phases[phase_id].frees_nr = 0;
+		}
+
+		memory_cur_phase = MEMORY_PHASE_NEW;
+		transmitter = rle_transmitter_new(&confs[conf_id]);
+		assert_true(transmitter != NULL);
+		receiver = rle_receiver_new(&confs[conf_id]);
+		assert_true(receiver != NULL);
+		f_buff = rle_frag_buf_new();
+		assert_true(f_buff != NULL);
+
+		assert_true(memory_traffic(transmitter, receiver, &traffic) == traffic.sdus_nr);
+		assert_true(memory_traffic_contextless(transmitter, receiver, f_buff, &traffic) > 0);
+		memory_errors(transmitter, receiver, f_buff, &traffic);
+
+		memory_cur_phase = MEMORY_PHASE_DESTROY;
+		rle_frag_buf_del(&f_buff);
+		rle_receiver_destroy(&receiver);
+		rle_transmitter_destroy(&transmitter);
+		memory_cur_phase = MEMORY_PHASE_SETUP;
+
+		printf("configuration #%zu:", conf_id + 1);
+		for (phase_id = MEMORY_PHASE_NEW; phase_id < MEMORY_PHASES_NR; phase_id++) {
+			printf(" %s %zu/%zu", memory_phases[phase_id].name,
+			       memory_phases[phase_id].allocs_nr, memory_phases[phase_id].frees_nr);
+		}
+		printf(" (allocations/frees)\n");
+
+		for (phase_id = MEMORY_PHASE_ENCAP; phase_id <= MEMORY_PHASE_ERRORS; phase_id++) {
+			assert_int_equal(memory_phases[phase_id].allocs_nr, 0);
+			assert_int_equal(memory_phases[phase_id].frees_nr, 0);
+		}
+		assert_int_equal(memory_phases[MEMORY_PHASE_NEW].allocs_nr,
+		                 memory_phases[MEMORY_PHASE_DESTROY].frees_nr);
+	}
+
+	traffic_free(&traffic);
+	memory_cur_phase = MEMORY_PHASE_MOCKED;
+}
+
+
 /*---------------------------------------------------------------------------*/
 /*--------------------------   WRAPPED FUNCTIONS  ---------------------------*/
 /*---------------------------------------------------------------------------*/
 
 void * __wrap_malloc(size_t size)
 {
-	void *ptr = mock_ptr_type(void *);
+	void *ptr;
+
+	if (memory_cur_phase != MEMORY_PHASE_MOCKED) {
+		ptr = __real_malloc(size);
+		if (ptr != NULL) {
+			memory_phases[memory_cur_phase].allocs_nr++;
+		}
+		return ptr;
+	}
+
+	ptr = mock_ptr_type(void *);
 
 	if (ptr != NULL) {
 		return __real_malloc(size);
@@ -157,3 +596,23 @@ void * __wrap_malloc(size_t size)
 		return ptr;
 	}
 }
+
+/* the compiler may merge a malloc() followed by a memset() to 0 into a calloc() */
+void * __wrap_calloc(size_t nmemb, size_t size)
+{
+	void *const ptr = __real_calloc(nmemb, size);
+
+	if (ptr != NULL && memory_cur_phase != MEMORY_PHASE_MOCKED) {
+		memory_phases[memory_cur_phase].allocs_nr++;
+	}
+
+	return ptr;
+}
+
+void __wrap_free(void *ptr)
+{
+	if (ptr != NULL && memory_cur_phase != MEMORY_PHASE_MOCKED) {
+		memory_phases[memory_cur_phase].frees_nr++;
+	}
+	__real_free(ptr);
+}
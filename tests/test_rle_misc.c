@@ -34,6 +34,7 @@
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdbool.h>
 #include <string.h>
 #include <netinet/in.h>
@@ -532,3 +533,247 @@ out:
 
 	return output;
 }
+
+bool test_rle_allocation_f_buff_sized(void)
+{
+	bool output = false;
+
+	struct rle_frag_buf *f = NULL;
+	const struct rle_sdu small_sdu = {
+		.buffer = (unsigned char *)payload_initializer,
+		.size = 256,
+		.protocol_type = 0x0800,
+	};
+	const struct rle_sdu medium_sdu = {
+		.buffer = (unsigned char *)payload_initializer,
+		.size = 257,
+		.protocol_type = 0x0800,
+	};
+	const struct rle_sdu max_sdu = {
+		.buffer = (unsigned char *)payload_initializer,
+		.size = RLE_MAX_PDU_SIZE,
+		.protocol_type = 0x0800,
+	};
+
+	PRINT_TEST("RLE fragmentation buffer allocation in size classes.\n");
+
+	f = rle_frag_buf_new_sized(RLE_MAX_PDU_SIZE + 1);
+	if (f) {
+		PRINT_ERROR("Fragmentation buffer should not be allocated for too long SDUs.");
+		goto out;
+	}
+
+	/* a 100-byte SDU gives the 256-byte class */
+	f = rle_frag_buf_new_sized(100);
+	if (!f || rle_frag_buf_init(f) != 0) {
+		PRINT_ERROR("Fragmentation buffer should be allocated.");
+		goto out;
+	}
+	if (rle_frag_buf_cpy_sdu(f, &medium_sdu) == 0) {
+		PRINT_ERROR("257-byte SDU should not be copied in a 256-byte class buffer.");
+		goto out;
+	}
+	if (rle_frag_buf_cpy_sdu(f, &small_sdu) != 0) {
+		PRINT_ERROR("256-byte SDU should be copied in a 256-byte class buffer.");
+		goto out;
+	}
+	rle_frag_buf_del(&f);
+
+	/* a 3000-byte SDU gives the largest class */
+	f = rle_frag_buf_new_sized(3000);
+	if (!f || rle_frag_buf_init(f) != 0 || rle_frag_buf_cpy_sdu(f, &max_sdu) != 0) {
+		PRINT_ERROR("%d-byte SDU should be copied in the largest class buffer.",
+		            RLE_MAX_PDU_SIZE);
+		goto out;
+	}
+
+	output = true;
+
+out:
+	rle_frag_buf_del(&f);
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_allocation_pool(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 0,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const struct rle_pool_config pool_conf = {
+		.numa_node = -1,
+		.use_hugepages = 1,
+	};
+	const size_t fpdu_size = 1200;
+	const size_t sdu_len = 1000;
+	struct rle_pool *pool = NULL;
+	struct rle_transmitter *t = NULL;
+	struct rle_receiver *r = NULL;
+	unsigned char *fpdu = NULL;
+	unsigned char *sdu_buf = NULL;
+	unsigned char *rx_buf = NULL;
+	struct rle_pool_stats stats;
+	struct rle_sdu sdu;
+	struct rle_sdu rx_sdu;
+	size_t fpdu_pos = 0;
+	size_t fpdu_remaining = fpdu_size;
+	size_t sdus_nr = 0;
+	size_t i;
+
+	PRINT_TEST("RLE transmitter and receiver allocation in a memory pool.\n");
+
+	t = rle_transmitter_new_in_pool(&conf, NULL);
+	if (t) {
+		PRINT_ERROR("Transmitter should not be allocated without pool.");
+		goto out;
+	}
+
+	pool = rle_pool_new(&pool_conf);
+	if (!pool) {
+		PRINT_ERROR("Pool should be allocated.");
+		goto out;
+	}
+
+	t = rle_transmitter_new_in_pool(&conf, pool);
+	r = rle_receiver_new_in_pool(&conf, pool);
+	fpdu = rle_pool_buf_new(pool, fpdu_size);
+	sdu_buf = rle_pool_buf_new(pool, sdu_len);
+	rx_buf = rle_pool_buf_new(pool, sdu_len);
+	if (!t || !r || !fpdu || !sdu_buf || !rx_buf) {
+		PRINT_ERROR("Transmitter, receiver and buffers should be allocated in the pool.");
+		goto out;
+	}
+
+	if (((uintptr_t)t | (uintptr_t)r | (uintptr_t)fpdu) % 64 != 0) {
+		PRINT_ERROR("Allocations in the pool should be aligned on cache lines.");
+		goto out;
+	}
+
+	for (i = 0; i < sdu_len; i++) {
+		sdu_buf[i] = (unsigned char)i;
+	}
+	sdu.buffer = sdu_buf;
+	sdu.size = sdu_len;
+	sdu.protocol_type = 0x0800;
+
+	if (rle_encapsulate(t, &sdu, 0) != RLE_ENCAP_OK) {
+		PRINT_ERROR("SDU should be encapsulated.");
+		goto out;
+	}
+
+	while (rle_transmitter_stats_get_queue_size(t, 0) > 0) {
+		unsigned char *ppdu;
+		size_t ppdu_len;
+
+		if (rle_fragment(t, 0, 600, &ppdu, &ppdu_len) != RLE_FRAG_OK ||
+		    rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos, &fpdu_remaining) != RLE_PACK_OK) {
+			PRINT_ERROR("ALPDU should be fragmented and packed.");
+			goto out;
+		}
+	}
+	rle_pad(fpdu, fpdu_pos, fpdu_remaining);
+
+	rx_sdu.buffer = rx_buf;
+	rx_sdu.size = sdu_len;
+	if (rle_decapsulate(r, fpdu, fpdu_size, &rx_sdu, 1, &sdus_nr, NULL, 0) != RLE_DECAP_OK ||
+	    sdus_nr != 1 || rx_sdu.size != sdu_len || memcmp(rx_buf, sdu_buf, sdu_len) != 0) {
+		PRINT_ERROR("SDU should be decapsulated intact.");
+		goto out;
+	}
+
+	/* the SDUs swap the fragmentation buffer of the context for the one of their size class */
+	for (i = 0; i < 3; i++) {
+		sdu.size = (i % 2 == 0 ? 100 : 3000);
+		sdu.buffer = (unsigned char *)payload_initializer;
+		if (rle_encapsulate(t, &sdu, 0) != RLE_ENCAP_OK) {
+			PRINT_ERROR("%zu-byte SDU should be encapsulated.", sdu.size);
+			goto out;
+		}
+		while (rle_transmitter_stats_get_queue_size(t, 0) > 0) {
+			unsigned char *ppdu;
+			size_t ppdu_len;
+
+			if (rle_fragment(t, 0, 600, &ppdu, &ppdu_len) != RLE_FRAG_OK) {
+				PRINT_ERROR("ALPDU should be fragmented.");
+				goto out;
+			}
+		}
+	}
+
+	/* more sizes than the pool keeps fall back on the generic sizes */
+	{
+		unsigned char *bufs[24];
+
+		for (i = 0; i < 24; i++) {
+			bufs[i] = rle_pool_buf_new(pool, 100 * (i + 1) + 1);
+			if (bufs[i] == NULL) {
+				PRINT_ERROR("%zu-byte buffer should be allocated in the pool.",
+				            100 * (i + 1) + 1);
+				goto out;
+			}
+			memset(bufs[i], 0xa5, 100 * (i + 1) + 1);
+		}
+		for (i = 0; i < 24; i++) {
+			rle_pool_buf_del(pool, (void **)&bufs[i], 100 * (i + 1) + 1);
+		}
+	}
+
+	/* a buffer given back with a size never allocated is not taken back */
+	{
+		struct rle_pool *other_pool = rle_pool_new(&pool_conf);
+		void *buf;
+
+		if (!other_pool) {
+			PRINT_ERROR("Pool should be allocated.");
+			goto out;
+		}
+		buf = rle_pool_buf_new(other_pool, 5000);
+		rle_pool_buf_del(other_pool, &buf, 7000);
+		rle_pool_get_stats(other_pool, &stats);
+		rle_pool_get_stats(other_pool, NULL);
+		rle_pool_get_stats(NULL, &stats);
+		rle_pool_destroy(&other_pool);
+		if (stats.bytes_used == 0) {
+			PRINT_ERROR("Buffer given back with a wrong size should stay used.");
+			goto out;
+		}
+	}
+
+	output = true;
+
+out:
+	rle_transmitter_destroy(&t);
+	rle_receiver_destroy(&r);
+	if (pool) {
+		rle_pool_buf_del(pool, (void **)&fpdu, fpdu_size);
+		rle_pool_buf_del(pool, (void **)&sdu_buf, sdu_len);
+		rle_pool_buf_del(pool, (void **)&rx_buf, sdu_len);
+
+		rle_pool_get_stats(pool, &stats);
+		if (stats.bytes_used != 0) {
+			PRINT_ERROR("All the memory should be given back to the pool, %" PRIu64
+			            " octets are still used.", stats.bytes_used);
+			output = false;
+		}
+		printf("pool: %" PRIu64 " chunk(s), %" PRIu64 " backed by huge pages, NUMA node %d\n",
+		       stats.chunks_nr, stats.hugepage_chunks_nr, stats.numa_node);
+	}
+	rle_pool_destroy(&pool);
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
@@ -0,0 +1,1326 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_rle_modem.c
+ * @brief  Reference RLE modem emulator between a TAP device or a port and a UDP socket.
+ *
+ *         The frames read from the TAP device are stripped from their Ethernet header,
+ *         encapsulated as SDUs in the frag_id of their DSCP class, then packed in FPDUs sent
+ *         as UDP datagrams to the peer modem. The FPDUs received from the peer are
+ *         decapsulated, and their SDUs are written back to the TAP device behind a rebuilt
+ *         Ethernet header. The FPDUs are sent and received in batches with sendmmsg(2) and
+ *         recvmmsg(2).
+ *
+ *         The frames may rather be ingested from a physical or veth port through the
+ *         TPACKET_V3 ring of an AF_PACKET socket, and encapsulated directly from the ring. The
+ *         frames of a port are bridged: they are encapsulated whole, with their MAC addresses.
+ *         The VLAN frames are always encapsulated whole, as the VLAN protocol type requires,
+ *         so that the library may suppress the EtherType of the VLAN header of IP packets.
+ *
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* for sendmmsg() and recvmmsg() */
+#define _GNU_SOURCE
+
+/* system includes */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <getopt.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <linux/if_tun.h>
+
+#include "rle.h"
+#include "test_packet_ring.h"
+
+/** The program version */
+#define TEST_VERSION  "RLE TAP/UDP modem emulator, version 0.0.1\n"
+
+/** The default UDP port of the modems */
+#define DEFAULT_PORT 5000U
+
+/** Min, max and default burst sizes */
+#define MIN_BURST_SIZE 14
+#define MAX_BURST_SIZE 4096
+#define DEFAULT_BURST_SIZE 599U
+
+/** The default and maximal numbers of FPDUs per sendmmsg() or recvmmsg() call */
+#define DEFAULT_BATCH 32U
+#define MAX_BATCH 1024U
+
+/** The length of an Ethernet header */
+#define ETH_HDR_LEN 14U
+
+/** The length of a MAC address */
+#define ETH_ADDR_LEN 6U
+
+/** The smallest EtherType, shorter values are 802.3 lengths */
+#define ETH_TYPE_MIN 0x0600
+
+/** The protocol type of the bridged Ethernet frames (Transparent Ethernet Bridging) */
+#define ETH_TYPE_TEB 0x6558
+
+/** The maximal number of VLAN tags skipped to find the IP header of a frame */
+#define VLAN_TAGS_MAX_NR 2U
+
+/** The number of DSCP values */
+#define DSCP_NR 64U
+
+/** The length of the SDU buffers given to the receiver (room for VLAN ptype re-insertion) */
+#define SDU_BUF_LEN  (RLE_MAX_PDU_SIZE + 4U)
+
+/** The source MAC address of the rebuilt Ethernet headers, locally administered */
+static const unsigned char peer_mac[ETH_ADDR_LEN] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+/** The destination MAC address of the rebuilt Ethernet headers sent on a port */
+static const unsigned char bcast_mac[ETH_ADDR_LEN] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+/** The counters of the modem that the library does not count */
+struct modem_stats {
+	uint64_t frames_in;         /**< The number of frames read from the TAP device or port */
+	uint64_t frames_dropped;    /**< The number of frames not encapsulated */
+	uint64_t fpdus_sent;        /**< The number of FPDUs sent */
+	uint64_t fpdus_lost;        /**< The number of FPDUs that failed to be sent */
+	uint64_t sendmmsg_nr;       /**< The number of sendmmsg() calls */
+	uint64_t fpdus_received;    /**< The number of FPDUs received */
+	uint64_t fpdus_invalid;     /**< The number of FPDUs that failed to decapsulate */
+	uint64_t recvmmsg_nr;       /**< The number of recvmmsg() calls */
+	uint64_t frames_out;        /**< The number of frames written to the TAP device or port */
+	uint64_t frames_out_lost;   /**< The number of frames that failed to be written */
+};
+
+/** The library counters at the previous statistics report, for the rates */
+struct modem_rates {
+	uint64_t time_ns;           /**< The time of the report */
+	uint64_t tx_sdus;           /**< The number of SDUs sent */
+	uint64_t tx_bytes;          /**< The number of SDU bytes given to the transmitter */
+	uint64_t rx_sdus;           /**< The number of SDUs reassembled */
+	uint64_t rx_bytes;          /**< The number of SDU bytes reassembled */
+};
+
+/** The modem */
+struct modem {
+	int tap_fd;                           /**< The TAP device, -1 for a port */
+	struct packet_ring *port;             /**< The ring of the port, NULL for a TAP device */
+	int udp_fd;                           /**< The UDP socket, connected to the peer */
+	unsigned char dst_mac[ETH_ADDR_LEN];  /**< The destination of the rebuilt headers */
+	struct rle_transmitter *transmitter;  /**< The transmitter */
+	struct rle_receiver *receiver;        /**< The receiver */
+	size_t burst_size;                    /**< The size of the FPDUs */
+	size_t batch;                         /**< The number of FPDUs per system call */
+	uint8_t classes[DSCP_NR];             /**< The frag_id of every DSCP value */
+	unsigned char *frame;                 /**< The frame read from the TAP device */
+	unsigned char *tx_fpdus;              /**< The FPDUs of the batch to send */
+	struct mmsghdr *tx_msgs;              /**< The messages of the batch to send */
+	struct iovec *tx_iovs;                /**< The buffers of the messages to send */
+	size_t tx_fpdus_nr;                   /**< The number of complete FPDUs in the batch */
+	bool fpdu_started;                    /**< Whether the next FPDU of the batch is started */
+	size_t cur_pos;                       /**< The position in the FPDU being filled */
+	size_t remain_size;                   /**< The room left in the FPDU being filled */
+	unsigned char *rx_fpdus;              /**< The FPDUs of the received batch */
+	struct mmsghdr *rx_msgs;              /**< The messages of the received batch */
+	struct iovec *rx_iovs;                /**< The buffers of the received messages */
+	struct rle_sdu *sdus;                 /**< The SDUs of a received FPDU */
+	size_t sdus_max_nr;                   /**< The maximal number of SDUs in an FPDU */
+	unsigned char *sdus_buf;              /**< The memory of the received SDUs */
+	struct modem_stats stats;             /**< The counters of the modem */
+	struct modem_rates last;              /**< The counters at the previous report */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static uint64_t get_time_ns(void);
+static void handle_signal(int signum);
+static int parse_addr(const char *const str, struct sockaddr_in *const addr);
+static int parse_class(const char *const str, uint8_t classes[DSCP_NR]);
+static int tap_open(const char *const name);
+static int udp_open(const struct sockaddr_in *const local,
+                    const struct sockaddr_in *const remote);
+static int modem_init(struct modem *const modem, const size_t burst_size, const size_t batch);
+static void modem_release(struct modem *const modem);
+static bool is_vlan_ptype(const uint16_t ptype);
+static uint8_t modem_classify(const struct modem *const modem, const unsigned char *const frame,
+                              const size_t len);
+static int modem_send_fpdus(struct modem *const modem);
+static int modem_close_fpdu(struct modem *const modem);
+static int modem_pack(struct modem *const modem, const uint8_t frag_id);
+static int modem_drain(struct modem *const modem, const uint8_t last_frag_id);
+static int modem_frame_input(void *const arg, const unsigned char *const frame,
+                             const size_t len);
+static int modem_flush(struct modem *const modem);
+static int modem_tap_input(struct modem *const modem);
+static int modem_port_input(struct modem *const modem);
+static int modem_udp_input(struct modem *const modem);
+static void modem_print_stats(struct modem *const modem);
+static int test_rle_modem(struct modem *const modem, const uint64_t duration_ns,
+                          const uint64_t stats_ns);
+
+/** Whether the application runs in verbose mode or not */
+static int is_verbose = 0;
+
+/** Whether the ALPDUs are protected by CRC or SeqNo */
+static int use_crc = 0;
+
+/** Set by SIGINT or SIGTERM to stop the modem */
+static volatile sig_atomic_t stop_modem = 0;
+
+#define TRACE(x ...) do { \
+		if (is_verbose) { printf(x); } \
+} while (0)
+
+
+/**
+ * @brief Main function for the RLE modem emulator
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	const char *tap_name = NULL;
+	const char *port_name = NULL;
+	struct packet_ring_conf ring_conf;
+	size_t burst_size = DEFAULT_BURST_SIZE;
+	size_t batch = DEFAULT_BATCH;
+	unsigned long duration = 0;
+	unsigned long stats_interval = 0;
+	unsigned long default_class = 0;
+	bool has_remote = false;
+	struct sockaddr_in local;
+	struct sockaddr_in remote;
+	uint8_t classes[DSCP_NR];
+	struct modem modem;
+	size_t i;
+
+	memset(&local, 0, sizeof(struct sockaddr_in));
+	local.sin_family = AF_INET;
+	local.sin_addr.s_addr = htonl(INADDR_ANY);
+	local.sin_port = htons(DEFAULT_PORT);
+	memset(&remote, 0, sizeof(struct sockaddr_in));
+	memset(classes, RLE_MAX_FRAG_NUMBER, DSCP_NR);
+	packet_ring_conf_init(&ring_conf);
+
+	while (1) {
+		int c;
+
+		static struct option long_options[] =
+		{
+			{ "verbose", no_argument, &is_verbose, 1 },
+			{ "crc", no_argument, &use_crc, 1 },
+			{ "tap", required_argument, 0, 'i' },
+			{ "port", required_argument, 0, 'P' },
+			{ "blocks", required_argument, 0, 'k' },
+			{ "block_timeout", required_argument, 0, 'T' },
+			{ "local", required_argument, 0, 'L' },
+			{ "remote", required_argument, 0, 'R' },
+			{ "burst_size", required_argument, 0, 'b' },
+			{ "batch", required_argument, 0, 'B' },
+			{ "class", required_argument, 0, 'c' },
+			{ "default_class", required_argument, 0, 'd' },
+			{ "stats", required_argument, 0, 's' },
+			{ "duration", required_argument, 0, 't' },
+			{ 0, 0, 0, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, "vhi:P:k:T:L:R:b:B:c:d:s:t:", long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 0:
+			/* If this option set a flag, do nothing else now. */
+			break;
+		case 'i': /* TAP device */
+			assert(optarg != NULL);
+			tap_name = optarg;
+			break;
+		case 'P': /* Port */
+			assert(optarg != NULL);
+			port_name = optarg;
+			break;
+		case 'k': /* Number of blocks of the ring of the port */
+			assert(optarg != NULL);
+			ring_conf.blocks_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'T': /* Timeout of the blocks of the ring of the port */
+			assert(optarg != NULL);
+			ring_conf.timeout_ms = strtoul(optarg, NULL, 10);
+			break;
+		case 'L': /* Local address */
+			assert(optarg != NULL);
+			if (parse_addr(optarg, &local) != 0) {
+				goto error;
+			}
+			break;
+		case 'R': /* Remote address */
+			assert(optarg != NULL);
+			if (parse_addr(optarg, &remote) != 0) {
+				goto error;
+			}
+			has_remote = true;
+			break;
+		case 'b': /* Burst Size */
+			assert(optarg != NULL);
+			burst_size = strtoul(optarg, NULL, 10);
+			if (burst_size < MIN_BURST_SIZE || burst_size > MAX_BURST_SIZE) {
+				printf("ERROR: %zu burst size shall be within [%d ; %d] octets.\n",
+				       burst_size, MIN_BURST_SIZE, MAX_BURST_SIZE);
+				goto error;
+			}
+			break;
+		case 'B': /* Number of FPDUs per system call */
+			assert(optarg != NULL);
+			batch = strtoul(optarg, NULL, 10);
+			if (batch == 0 || batch > MAX_BATCH) {
+				printf("ERROR: the batch shall be within [1 ; %u] FPDUs\n", MAX_BATCH);
+				goto error;
+			}
+			break;
+		case 'c': /* DSCP class */
+			assert(optarg != NULL);
+			if (parse_class(optarg, classes) != 0) {
+				goto error;
+			}
+			break;
+		case 'd': /* frag_id of the unclassified SDUs */
+			assert(optarg != NULL);
+			default_class = strtoul(optarg, NULL, 10);
+			if (default_class > RLE_MAX_FRAG_ID) {
+				printf("ERROR: the frag_id shall be within [0 ; %d]\n", RLE_MAX_FRAG_ID);
+				goto error;
+			}
+			break;
+		case 's': /* Statistics interval */
+			assert(optarg != NULL);
+			stats_interval = strtoul(optarg, NULL, 10);
+			break;
+		case 't': /* Duration */
+			assert(optarg != NULL);
+			duration = strtoul(optarg, NULL, 10);
+			break;
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc || (tap_name == NULL) == (port_name == NULL) || !has_remote) {
+		usage();
+		goto error;
+	}
+	for (i = 0; i < DSCP_NR; i++) {
+		if (classes[i] == RLE_MAX_FRAG_NUMBER) {
+			classes[i] = default_class;
+		}
+	}
+
+	printf("=== initialization:\n");
+	if (modem_init(&modem, burst_size, batch) != 0) {
+		goto error;
+	}
+	memcpy(modem.classes, classes, DSCP_NR);
+	modem.udp_fd = udp_open(&local, &remote);
+	if (modem.udp_fd < 0) {
+		goto release_modem;
+	}
+	if (port_name != NULL) {
+		modem.port = packet_ring_open(port_name, &ring_conf);
+		if (modem.port == NULL) {
+			goto release_modem;
+		}
+		/* the frames of a port have no known destination, unless bridged whole */
+		memcpy(modem.dst_mac, bcast_mac, ETH_ADDR_LEN);
+		printf("===\tport %s (%zu %zu-byte blocks)", port_name, ring_conf.blocks_nr,
+		       ring_conf.block_size);
+	} else {
+		struct ifreq ifr;
+
+		modem.tap_fd = tap_open(tap_name);
+		if (modem.tap_fd < 0) {
+			goto release_modem;
+		}
+		memset(&ifr, 0, sizeof(struct ifreq));
+		memcpy(ifr.ifr_name, tap_name, strlen(tap_name));
+		if (ioctl(modem.udp_fd, SIOCGIFHWADDR, &ifr) != 0) {
+			perror("failed to get the MAC address of the TAP device");
+			goto release_modem;
+		}
+		memcpy(modem.dst_mac, ifr.ifr_hwaddr.sa_data, ETH_ADDR_LEN);
+		printf("===\tTAP device %s", tap_name);
+	}
+	printf(", UDP %s:%u", inet_ntoa(local.sin_addr), ntohs(local.sin_port));
+	printf(" to %s:%u, %zu-byte FPDUs by %zu\n", inet_ntoa(remote.sin_addr),
+	       ntohs(remote.sin_port), burst_size, batch);
+
+	status = test_rle_modem(&modem, duration * 1000000000ULL, stats_interval * 1000000000ULL);
+
+	printf("=== exit test with code %d\n", status);
+release_modem:
+	modem_release(&modem);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the modem emulator
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE modem emulator: encapsulate the frames read from a TAP device or a port in\n"
+	        "FPDUs sent over UDP to a peer modem, and write back to the TAP device or the port\n"
+	        "the SDUs of the FPDUs received from the peer. The FPDUs are sent and received by\n"
+	        "batches with sendmmsg(2) and recvmmsg(2). Stop with SIGINT or SIGTERM.\n"
+	        "\n"
+	        "usage: test_rle_modem [OPTIONS] {--tap NAME|--port NAME} --remote ADDR:PORT\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --tap, -i               Name of the TAP device, created if it does not exist\n"
+	        "  --port, -P              Name of a port whose frames are bridged, read through\n"
+	        "                          an AF_PACKET TPACKET_V3 ring, instead of a TAP device.\n"
+	        "                          The hosts of the port shall not offload their TX\n"
+	        "                          checksums (ethtool -K DEV tx off)\n"
+	        "  --blocks, -k            Number of 1 MiB blocks of the ring of the port\n"
+	        "                          (default 8)\n"
+	        "  --block_timeout, -T     Delay before a block of the ring is read if it is not\n"
+	        "                          full (default 1 ms)\n"
+	        "  --local, -L             Local IPv4 address and UDP port (default 0.0.0.0:5000)\n"
+	        "  --remote, -R            IPv4 address and UDP port of the peer modem\n"
+	        "  --burst_size, -b        Size of the FPDUs (default 599 octets, at most 4096)\n"
+	        "  --batch, -B             Number of FPDUs per sendmmsg() or recvmmsg() call\n"
+	        "                          (default 32, at most 1024)\n"
+	        "  --class, -c             Send the IPv4 and IPv6 packets of a DSCP with a frag_id,\n"
+	        "                          as DSCP:FRAG_ID, may be repeated. The lowest frag_ids\n"
+	        "                          are served first\n"
+	        "  --default_class, -d     The frag_id of the other SDUs (default 0)\n"
+	        "  --stats, -s             Print the statistics every given seconds (default 0,\n"
+	        "                          only at exit)\n"
+	        "  --duration, -t          Stop after the given seconds (default 0, never)\n"
+	        "  --crc                   Protect the ALPDUs with CRC instead of SeqNo\n"
+	        "  --verbose               Run the test in verbose mode\n");
+
+	return;
+}
+
+
+/**
+ * @brief  Get a monotonic timestamp
+ *
+ * @return the current time in nanoseconds
+ */
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+
+/**
+ * @brief  Stop the modem on SIGINT or SIGTERM
+ *
+ * @param[in] signum  The signal
+ */
+static void handle_signal(int signum __attribute__((unused)))
+{
+	stop_modem = 1;
+}
+
+
+/**
+ * @brief  Parse an IPv4 address and UDP port
+ *
+ * @param[in]  str   The address, as ADDR:PORT or ADDR
+ * @param[out] addr  The address, its port is kept if none is given
+ * @return           0 in case of success, 1 otherwise
+ */
+static int parse_addr(const char *const str, struct sockaddr_in *const addr)
+{
+	char host[INET_ADDRSTRLEN];
+	const char *const colon = strchr(str, ':');
+	const size_t host_len = colon != NULL ? (size_t)(colon - str) : strlen(str);
+
+	if (host_len >= INET_ADDRSTRLEN) {
+		goto error;
+	}
+	memcpy(host, str, host_len);
+	host[host_len] = '\0';
+	addr->sin_family = AF_INET;
+	if (inet_pton(AF_INET, host, &addr->sin_addr) != 1) {
+		goto error;
+	}
+	if (colon != NULL) {
+		char *end;
+		const unsigned long port = strtoul(colon + 1, &end, 10);
+
+		if (*end != '\0' || port == 0 || port > UINT16_MAX) {
+			goto error;
+		}
+		addr->sin_port = htons(port);
+	} else if (addr->sin_port == 0) {
+		addr->sin_port = htons(DEFAULT_PORT);
+	}
+
+	return 0;
+
+error:
+	printf("ERROR: invalid address '%s', expected IPV4_ADDR[:PORT]\n", str);
+	return 1;
+}
+
+
+/**
+ * @brief  Parse a DSCP class
+ *
+ * @param[in]     str      The class, as DSCP:FRAG_ID
+ * @param[in,out] classes  The frag_id of every DSCP value
+ * @return                 0 in case of success, 1 otherwise
+ */
+static int parse_class(const char *const str, uint8_t classes[DSCP_NR])
+{
+	unsigned long dscp;
+	unsigned long frag_id;
+	char *end;
+
+	dscp = strtoul(str, &end, 10);
+	if (end == str || *end != ':' || dscp >= DSCP_NR) {
+		goto error;
+	}
+	frag_id = strtoul(end + 1, &end, 10);
+	if (*end != '\0' || frag_id > RLE_MAX_FRAG_ID) {
+		goto error;
+	}
+	classes[dscp] = frag_id;
+
+	return 0;
+
+error:
+	printf("ERROR: invalid class '%s', expected DSCP:FRAG_ID with DSCP within [0 ; %u] and "
+	       "FRAG_ID within [0 ; %d]\n", str, DSCP_NR - 1, RLE_MAX_FRAG_ID);
+	return 1;
+}
+
+
+/**
+ * @brief  Open a TAP device, without packet information
+ *
+ * @param[in] name  The name of the device
+ * @return          The non-blocking file descriptor of the device, -1 in case of error
+ */
+static int tap_open(const char *const name)
+{
+	struct ifreq ifr;
+	int fd;
+
+	if (strlen(name) >= IFNAMSIZ) {
+		printf("ERROR: the name of the TAP device shall be shorter than %d\n", IFNAMSIZ);
+		goto error;
+	}
+	fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+	if (fd < 0) {
+		perror("failed to open /dev/net/tun");
+		goto error;
+	}
+	memset(&ifr, 0, sizeof(struct ifreq));
+	ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+	memcpy(ifr.ifr_name, name, strlen(name));
+	if (ioctl(fd, TUNSETIFF, &ifr) != 0) {
+		perror("failed to attach the TAP device");
+		goto close_fd;
+	}
+
+	return fd;
+
+close_fd:
+	close(fd);
+error:
+	return -1;
+}
+
+
+/**
+ * @brief  Open the UDP socket to the peer modem
+ *
+ * @param[in] local   The local address
+ * @param[in] remote  The address of the peer
+ * @return            The file descriptor of the socket, -1 in case of error
+ */
+static int udp_open(const struct sockaddr_in *const local,
+                    const struct sockaddr_in *const remote)
+{
+	const int buf_len = 4 * 1024 * 1024;
+	int fd;
+
+	fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (fd < 0) {
+		perror("failed to create the UDP socket");
+		goto error;
+	}
+	/* bursts of FPDUs shall not overflow the socket buffers, best effort */
+	setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buf_len, sizeof(int));
+	setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buf_len, sizeof(int));
+	if (bind(fd, (const struct sockaddr *)local, sizeof(struct sockaddr_in)) != 0) {
+		perror("failed to bind the UDP socket");
+		goto close_fd;
+	}
+	if (connect(fd, (const struct sockaddr *)remote, sizeof(struct sockaddr_in)) != 0) {
+		perror("failed to connect the UDP socket");
+		goto close_fd;
+	}
+
+	return fd;
+
+close_fd:
+	close(fd);
+error:
+	return -1;
+}
+
+
+/**
+ * @brief  Create the transmitter, the receiver and the buffers of a modem
+ *
+ * @param[out] modem       The modem
+ * @param[in]  burst_size  The size of the FPDUs
+ * @param[in]  batch       The number of FPDUs per system call
+ * @return                 0 in case of success, 1 otherwise
+ */
+static int modem_init(struct modem *const modem, const size_t burst_size, const size_t batch)
+{
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = use_crc,
+		.allow_alpdu_sequence_number = !use_crc,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	size_t i;
+
+	memset(modem, 0, sizeof(struct modem));
+	modem->tap_fd = -1;
+	modem->udp_fd = -1;
+	modem->burst_size = burst_size;
+	modem->batch = batch;
+	/* a COMPLETE PPDU takes at least 3 bytes */
+	modem->sdus_max_nr = burst_size / 3;
+
+	modem->transmitter = rle_transmitter_new(&conf);
+	if (modem->transmitter == NULL) {
+		printf("failed to create transmitter\n");
+		goto error;
+	}
+	modem->receiver = rle_receiver_new(&conf);
+	if (modem->receiver == NULL) {
+		printf("failed to create receiver\n");
+		goto error;
+	}
+
+	modem->frame = malloc(ETH_HDR_LEN + RLE_MAX_PDU_SIZE + 1);
+	modem->tx_fpdus = malloc(batch * burst_size);
+	modem->tx_msgs = calloc(batch, sizeof(struct mmsghdr));
+	modem->tx_iovs = calloc(batch, sizeof(struct iovec));
+	modem->rx_fpdus = malloc(batch * burst_size);
+	modem->rx_msgs = calloc(batch, sizeof(struct mmsghdr));
+	modem->rx_iovs = calloc(batch, sizeof(struct iovec));
+	modem->sdus = calloc(modem->sdus_max_nr, sizeof(struct rle_sdu));
+	modem->sdus_buf = malloc(modem->sdus_max_nr * SDU_BUF_LEN);
+	if (modem->frame == NULL || modem->tx_fpdus == NULL || modem->tx_msgs == NULL ||
+	    modem->tx_iovs == NULL || modem->rx_fpdus == NULL || modem->rx_msgs == NULL ||
+	    modem->rx_iovs == NULL || modem->sdus == NULL || modem->sdus_buf == NULL) {
+		printf("failed to allocate the buffers of the modem\n");
+		goto error;
+	}
+
+	/* the messages always point to the same buffers */
+	for (i = 0; i < batch; i++) {
+		modem->tx_iovs[i].iov_base = modem->tx_fpdus + i * burst_size;
+		modem->tx_iovs[i].iov_len = burst_size;
+		modem->tx_msgs[i].msg_hdr.msg_iov = &modem->tx_iovs[i];
+		modem->tx_msgs[i].msg_hdr.msg_iovlen = 1;
+		modem->rx_iovs[i].iov_base = modem->rx_fpdus + i * burst_size;
+		modem->rx_iovs[i].iov_len = burst_size;
+		modem->rx_msgs[i].msg_hdr.msg_iov = &modem->rx_iovs[i];
+		modem->rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+	for (i = 0; i < modem->sdus_max_nr; i++) {
+		modem->sdus[i].buffer = modem->sdus_buf + i * SDU_BUF_LEN;
+	}
+
+	return 0;
+
+error:
+	modem_release(modem);
+	return 1;
+}
+
+
+/**
+ * @brief  Close the devices and free the resources of a modem
+ *
+ * @param[in,out] modem  The modem
+ */
+static void modem_release(struct modem *const modem)
+{
+	if (modem->tap_fd >= 0) {
+		close(modem->tap_fd);
+		modem->tap_fd = -1;
+	}
+	if (modem->port != NULL) {
+		packet_ring_close(modem->port);
+		modem->port = NULL;
+	}
+	if (modem->udp_fd >= 0) {
+		close(modem->udp_fd);
+		modem->udp_fd = -1;
+	}
+	if (modem->receiver != NULL) {
+		rle_receiver_destroy(&modem->receiver);
+	}
+	if (modem->transmitter != NULL) {
+		rle_transmitter_destroy(&modem->transmitter);
+	}
+	free(modem->frame);
+	free(modem->tx_fpdus);
+	free(modem->tx_msgs);
+	free(modem->tx_iovs);
+	free(modem->rx_fpdus);
+	free(modem->rx_msgs);
+	free(modem->rx_iovs);
+	free(modem->sdus);
+	free(modem->sdus_buf);
+	modem->frame = NULL;
+	modem->tx_fpdus = NULL;
+	modem->tx_msgs = NULL;
+	modem->tx_iovs = NULL;
+	modem->rx_fpdus = NULL;
+	modem->rx_msgs = NULL;
+	modem->rx_iovs = NULL;
+	modem->sdus = NULL;
+	modem->sdus_buf = NULL;
+}
+
+
+/**
+ * @brief  Whether a protocol type is the one of a VLAN frame, encapsulated whole
+ *
+ * @param[in] ptype  The protocol type
+ * @return           true for 802.1Q and 802.1ad frames, false otherwise
+ */
+static bool is_vlan_ptype(const uint16_t ptype)
+{
+	return (ptype == RLE_PROTO_TYPE_VLAN_UNCOMP || ptype == RLE_PROTO_TYPE_VLAN_QINQ_UNCOMP ||
+	        ptype == RLE_PROTO_TYPE_VLAN_QINQ_LEGACY_UNCOMP);
+}
+
+
+/**
+ * @brief  Get the frag_id of a frame from the DSCP of its IPv4 or IPv6 header, behind its
+ *         VLAN tags if any
+ *
+ * @param[in] modem  The modem
+ * @param[in] frame  The Ethernet frame
+ * @param[in] len    The length of the frame
+ * @return           The frag_id of the frame
+ */
+static uint8_t modem_classify(const struct modem *const modem, const unsigned char *const frame,
+                              const size_t len)
+{
+	size_t offset = ETH_HDR_LEN;
+	uint16_t ptype = (frame[12] << 8) | frame[13];
+	uint8_t dscp = 0;
+	size_t tags_nr;
+
+	for (tags_nr = 0; tags_nr < VLAN_TAGS_MAX_NR && is_vlan_ptype(ptype) &&
+	     offset + 4 <= len; tags_nr++) {
+		ptype = (frame[offset + 2] << 8) | frame[offset + 3];
+		offset += 4;
+	}
+
+	if (ptype == RLE_PROTO_TYPE_IPV4_UNCOMP && offset + 20 <= len) {
+		dscp = frame[offset + 1] >> 2;
+	} else if (ptype == RLE_PROTO_TYPE_IPV6_UNCOMP && offset + 40 <= len) {
+		dscp = ((frame[offset] & 0x0f) << 2) | (frame[offset + 1] >> 6);
+	}
+
+	return modem->classes[dscp];
+}
+
+
+/**
+ * @brief  Send the complete FPDUs of the batch in as few sendmmsg() calls as possible
+ *
+ * @param[in,out] modem  The modem
+ * @return               0 in case of success, 1 if the socket failed
+ */
+static int modem_send_fpdus(struct modem *const modem)
+{
+	size_t sent_nr = 0;
+
+	while (sent_nr < modem->tx_fpdus_nr) {
+		const int ret = sendmmsg(modem->udp_fd, modem->tx_msgs + sent_nr,
+		                         modem->tx_fpdus_nr - sent_nr, 0);
+
+		modem->stats.sendmmsg_nr++;
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			/* the peer is not there yet, or the socket buffer is full: the FPDUs are
+			 * lost as they would be on the channel */
+			if (errno != ECONNREFUSED && errno != ENOBUFS && errno != EAGAIN) {
+				perror("failed to send FPDUs");
+				return 1;
+			}
+			TRACE("%zu FPDUs lost: %s\n", modem->tx_fpdus_nr - sent_nr, strerror(errno));
+			modem->stats.fpdus_lost += modem->tx_fpdus_nr - sent_nr;
+			break;
+		}
+		sent_nr += ret;
+		modem->stats.fpdus_sent += ret;
+	}
+	modem->tx_fpdus_nr = 0;
+
+	return 0;
+}
+
+
+/**
+ * @brief  Pad the FPDU being filled, then send the batch if it is full
+ *
+ * @param[in,out] modem  The modem
+ * @return               0 in case of success, 1 if the socket failed
+ */
+static int modem_close_fpdu(struct modem *const modem)
+{
+	unsigned char *const fpdu = modem->tx_fpdus + modem->tx_fpdus_nr * modem->burst_size;
+
+	rle_pad(fpdu, modem->cur_pos, modem->remain_size);
+	modem->fpdu_started = false;
+	modem->tx_fpdus_nr++;
+	if (modem->tx_fpdus_nr == modem->batch) {
+		return modem_send_fpdus(modem);
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief  Pack all the PPDUs of the SDU of a frag_id in the FPDUs of the batch
+ *
+ * @param[in,out] modem    The modem
+ * @param[in]     frag_id  The frag_id
+ * @return                 0 in case of success, 1 otherwise
+ */
+static int modem_pack(struct modem *const modem, const uint8_t frag_id)
+{
+	while (rle_transmitter_stats_get_queue_size(modem->transmitter, frag_id) != 0) {
+		unsigned char *const fpdu = modem->tx_fpdus + modem->tx_fpdus_nr * modem->burst_size;
+		enum rle_frag_status ret_frag;
+		unsigned char *ppdu;
+		size_t ppdu_length = 0;
+
+		if (!modem->fpdu_started) {
+			modem->cur_pos = 0;
+			modem->remain_size = modem->burst_size;
+			modem->fpdu_started = true;
+		}
+
+		ret_frag = rle_fragment(modem->transmitter, frag_id, modem->remain_size, &ppdu,
+		                        &ppdu_length);
+		if (ret_frag == RLE_FRAG_ERR_BURST_TOO_SMALL && modem->cur_pos != 0) {
+			/* not enough room for a PPDU in the current FPDU, close it */
+			if (modem_close_fpdu(modem) != 0) {
+				return 1;
+			}
+			continue;
+		} else if (ret_frag != RLE_FRAG_OK) {
+			printf("failed to fragment SDU of frag_id %u\n", frag_id);
+			return 1;
+		}
+		if (rle_pack(ppdu, ppdu_length, NULL, 0, fpdu, &modem->cur_pos,
+		             &modem->remain_size) != RLE_PACK_OK) {
+			printf("failed to pack PPDU\n");
+			return 1;
+		}
+		if (modem->remain_size == 0 && modem_close_fpdu(modem) != 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief  Pack the SDUs of the frag_ids up to a given one, the lowest frag_ids first
+ *
+ * @param[in,out] modem         The modem
+ * @param[in]     last_frag_id  The last frag_id to pack
+ * @return                      0 in case of success, 1 otherwise
+ */
+static int modem_drain(struct modem *const modem, const uint8_t last_frag_id)
+{
+	uint8_t frag_id;
+
+	for (frag_id = 0; frag_id <= last_frag_id; frag_id++) {
+		if (modem_pack(modem, frag_id) != 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief  Encapsulate one Ethernet frame
+ *
+ *         The frame waits in the context of its frag_id until another SDU needs the context,
+ *         so that the SDUs of the lowest frag_ids are sent first. The IP packets of the TAP
+ *         device are encapsulated without their Ethernet header, the VLAN frames and the
+ *         frames of a port are encapsulated whole. The library copies the SDU, so the frame
+ *         may be read in place from the ring of a port.
+ *
+ * @param[in,out] arg    The modem
+ * @param[in]     frame  The Ethernet frame
+ * @param[in]     len    The length of the frame
+ * @return               0 in case of success, 1 otherwise
+ */
+static int modem_frame_input(void *const arg, const unsigned char *const frame,
+                             const size_t len)
+{
+	struct modem *const modem = arg;
+	const uint16_t eth_type = len >= ETH_HDR_LEN ? (frame[12] << 8) | frame[13] : 0;
+	struct rle_sdu sdu;
+	uint8_t frag_id;
+
+	modem->stats.frames_in++;
+	if (len <= ETH_HDR_LEN || eth_type < ETH_TYPE_MIN) {
+		TRACE("%zu-byte frame with EtherType 0x%04x dropped\n", len, eth_type);
+		modem->stats.frames_dropped++;
+		return 0;
+	}
+
+	/* the SDU is not written by the library */
+	if (is_vlan_ptype(eth_type)) {
+		sdu.buffer = (unsigned char *)frame;
+		sdu.size = len;
+		sdu.protocol_type = eth_type;
+	} else if (modem->port != NULL) {
+		sdu.buffer = (unsigned char *)frame;
+		sdu.size = len;
+		sdu.protocol_type = ETH_TYPE_TEB;
+	} else {
+		sdu.buffer = (unsigned char *)frame + ETH_HDR_LEN;
+		sdu.size = len - ETH_HDR_LEN;
+		sdu.protocol_type = eth_type;
+	}
+	frag_id = modem_classify(modem, frame, len);
+
+	/* the context of the frag_id shall be free before a new SDU is encapsulated */
+	if (rle_transmitter_stats_get_queue_size(modem->transmitter, frag_id) != 0 &&
+	    modem_drain(modem, frag_id) != 0) {
+		return 1;
+	}
+	if (rle_encapsulate(modem->transmitter, &sdu, frag_id) != RLE_ENCAP_OK) {
+		TRACE("%zu-byte SDU with protocol type 0x%04x dropped\n", sdu.size,
+		      sdu.protocol_type);
+		modem->stats.frames_dropped++;
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief  Pack the SDUs of all the frag_ids, then send the FPDUs of the batch, the last one
+ *         padded
+ *
+ * @param[in,out] modem  The modem
+ * @return               0 in case of success, 1 otherwise
+ */
+static int modem_flush(struct modem *const modem)
+{
+	if (modem_drain(modem, RLE_MAX_FRAG_ID) != 0) {
+		return 1;
+	}
+	if (modem->fpdu_started && modem_close_fpdu(modem) != 0) {
+		return 1;
+	}
+	if (modem->tx_fpdus_nr > 0) {
+		return modem_send_fpdus(modem);
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief  Encapsulate the frames waiting on the TAP device, then send them
+ *
+ *         At most one batch of frames is read, then the partial FPDU is sent.
+ *
+ * @param[in,out] modem  The modem
+ * @return               0 in case of success, 1 otherwise
+ */
+static int modem_tap_input(struct modem *const modem)
+{
+	const size_t frame_max_len = ETH_HDR_LEN + RLE_MAX_PDU_SIZE + 1;
+	size_t frames_nr;
+
+	for (frames_nr = 0; frames_nr < modem->batch; frames_nr++) {
+		const ssize_t len = read(modem->tap_fd, modem->frame, frame_max_len);
+
+		if (len < 0) {
+			if (errno == EAGAIN || errno == EINTR) {
+				break;
+			}
+			perror("failed to read the TAP device");
+			return 1;
+		}
+		if ((size_t)len == frame_max_len) {
+			/* truncated, too large for an SDU anyway */
+			modem->stats.frames_in++;
+			modem->stats.frames_dropped++;
+			continue;
+		}
+		if (modem_frame_input(modem, modem->frame, len) != 0) {
+			return 1;
+		}
+	}
+
+	return modem_flush(modem);
+}
+
+
+/**
+ * @brief  Encapsulate the frames of the blocks of the ring of the port handed over by the
+ *         kernel, then send them
+ *
+ * @param[in,out] modem  The modem
+ * @return               0 in case of success, 1 otherwise
+ */
+static int modem_port_input(struct modem *const modem)
+{
+	if (packet_ring_read(modem->port, modem_frame_input, modem) < 0) {
+		return 1;
+	}
+
+	return modem_flush(modem);
+}
+
+
+/**
+ * @brief  Decapsulate one batch of FPDUs received from the peer, and write their SDUs to
+ *         the TAP device or the port
+ *
+ * @param[in,out] modem  The modem
+ * @return               0 in case of success, 1 otherwise
+ */
+static int modem_udp_input(struct modem *const modem)
+{
+	const int out_fd = modem->port != NULL ? packet_ring_get_fd(modem->port) : modem->tap_fd;
+	unsigned char eth_hdr[ETH_HDR_LEN];
+	int msgs_nr;
+	int i;
+
+	msgs_nr = recvmmsg(modem->udp_fd, modem->rx_msgs, modem->batch, MSG_DONTWAIT, NULL);
+	modem->stats.recvmmsg_nr++;
+	if (msgs_nr < 0) {
+		if (errno == EAGAIN || errno == EINTR || errno == ECONNREFUSED) {
+			return 0;
+		}
+		perror("failed to receive FPDUs");
+		return 1;
+	}
+
+	/* the IP packets are sent to the TAP device, or to any host of the port, from the peer
+	 * modem */
+	memcpy(eth_hdr, modem->dst_mac, ETH_ADDR_LEN);
+	memcpy(eth_hdr + ETH_ADDR_LEN, peer_mac, ETH_ADDR_LEN);
+
+	for (i = 0; i < msgs_nr; i++) {
+		struct mmsghdr *const msg = &modem->rx_msgs[i];
+		size_t sdus_nr = 0;
+		size_t j;
+
+		modem->stats.fpdus_received++;
+		if (msg->msg_len == 0 || (msg->msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+			modem->stats.fpdus_invalid++;
+			continue;
+		}
+		if (rle_decapsulate(modem->receiver, modem->rx_iovs[i].iov_base, msg->msg_len,
+		                    modem->sdus, modem->sdus_max_nr, &sdus_nr, NULL,
+		                    0) != RLE_DECAP_OK) {
+			modem->stats.fpdus_invalid++;
+		}
+
+		for (j = 0; j < sdus_nr; j++) {
+			const uint16_t ptype = modem->sdus[j].protocol_type;
+			struct iovec iov[2];
+			int iovs_nr = 0;
+
+			/* the VLAN and bridged frames are whole */
+			if (!is_vlan_ptype(ptype) && ptype != ETH_TYPE_TEB) {
+				eth_hdr[12] = ptype >> 8;
+				eth_hdr[13] = ptype & 0xff;
+				iov[iovs_nr].iov_base = eth_hdr;
+				iov[iovs_nr].iov_len = ETH_HDR_LEN;
+				iovs_nr++;
+			}
+			iov[iovs_nr].iov_base = modem->sdus[j].buffer;
+			iov[iovs_nr].iov_len = modem->sdus[j].size;
+			iovs_nr++;
+			if (writev(out_fd, iov, iovs_nr) < 0) {
+				modem->stats.frames_out_lost++;
+			} else {
+				modem->stats.frames_out++;
+			}
+			modem->sdus[j].size = 0;
+			modem->sdus[j].protocol_type = 0;
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief  Print the counters of the library and of the modem, and the rates since the
+ *         previous report
+ *
+ * @param[in,out] modem  The modem
+ */
+static void modem_print_stats(struct modem *const modem)
+{
+	const uint64_t now_ns = get_time_ns();
+	const double elapsed_s = (now_ns - modem->last.time_ns) / 1e9;
+	const struct modem_stats *const stats = &modem->stats;
+	struct rle_transmitter_stats tx_total;
+	struct rle_receiver_stats rx_total;
+	uint8_t frag_id;
+
+	memset(&tx_total, 0, sizeof(struct rle_transmitter_stats));
+	memset(&rx_total, 0, sizeof(struct rle_receiver_stats));
+
+	printf("\n=== statistics:\n");
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; frag_id++) {
+		struct rle_transmitter_stats tx;
+		struct rle_receiver_stats rx;
+
+		if (rle_transmitter_stats_get_counters(modem->transmitter, frag_id, &tx) != 0 ||
+		    rle_receiver_stats_get_counters(modem->receiver, frag_id, &rx) != 0) {
+			continue;
+		}
+		tx_total.sdus_in += tx.sdus_in;
+		tx_total.sdus_sent += tx.sdus_sent;
+		tx_total.sdus_dropped += tx.sdus_dropped;
+		tx_total.bytes_in += tx.bytes_in;
+		tx_total.bytes_sent += tx.bytes_sent;
+		tx_total.bytes_dropped += tx.bytes_dropped;
+		rx_total.sdus_received += rx.sdus_received;
+		rx_total.sdus_reassembled += rx.sdus_reassembled;
+		rx_total.sdus_dropped += rx.sdus_dropped;
+		rx_total.sdus_lost += rx.sdus_lost;
+		rx_total.bytes_received += rx.bytes_received;
+		rx_total.bytes_reassembled += rx.bytes_reassembled;
+		rx_total.bytes_dropped += rx.bytes_dropped;
+		if (tx.sdus_in != 0 || rx.sdus_received != 0) {
+			printf("frag_id %u: TX %" PRIu64 " SDUs in, %" PRIu64 " sent, %" PRIu64
+			       " dropped; RX %" PRIu64 " SDUs received, %" PRIu64 " reassembled, %"
+			       PRIu64 " dropped, %" PRIu64 " lost\n", frag_id, tx.sdus_in, tx.sdus_sent,
+			       tx.sdus_dropped, rx.sdus_received, rx.sdus_reassembled, rx.sdus_dropped,
+			       rx.sdus_lost);
+		}
+	}
+
+	printf("TX: %" PRIu64 " frames read (%" PRIu64 " dropped), %" PRIu64 " SDUs in (%" PRIu64
+	       " bytes), %" PRIu64 " sent, %" PRIu64 " dropped (%" PRIu64 " bytes)\n",
+	       stats->frames_in, stats->frames_dropped, tx_total.sdus_in, tx_total.bytes_in,
+	       tx_total.sdus_sent, tx_total.sdus_dropped, tx_total.bytes_dropped);
+	printf("    %" PRIu64 " FPDUs sent in %" PRIu64 " sendmmsg() calls (%.1f per call), %"
+	       PRIu64 " lost, %" PRIu64 " bytes of PPDUs\n", stats->fpdus_sent,
+	       stats->sendmmsg_nr, stats->sendmmsg_nr != 0 ?
+	       (double) stats->fpdus_sent / stats->sendmmsg_nr : 0.0, stats->fpdus_lost,
+	       tx_total.bytes_sent);
+	if (modem->port != NULL) {
+		struct packet_ring_stats ring_stats;
+
+		packet_ring_get_stats(modem->port, &ring_stats);
+		printf("    port: %" PRIu64 " frames in %" PRIu64 " blocks (%" PRIu64 " VLAN tags "
+		       "re-inserted, %" PRIu64 " truncated, %" PRIu64 " without L4 checksum), "
+		       "kernel: %" PRIu64 " frames, %" PRIu64 " drops, %" PRIu64 " ring full\n",
+		       ring_stats.frames_nr, ring_stats.blocks_nr, ring_stats.vlan_nr,
+		       ring_stats.truncated_nr, ring_stats.csum_partial_nr, ring_stats.kernel_nr,
+		       ring_stats.drops_nr, ring_stats.freezes_nr);
+	}
+	printf("RX: %" PRIu64 " FPDUs received in %" PRIu64 " recvmmsg() calls (%.1f per call), %"
+	       PRIu64 " invalid\n", stats->fpdus_received, stats->recvmmsg_nr,
+	       stats->recvmmsg_nr != 0 ? (double) stats->fpdus_received / stats->recvmmsg_nr : 0.0,
+	       stats->fpdus_invalid);
+	printf("    %" PRIu64 " SDUs received, %" PRIu64 " reassembled (%" PRIu64 " bytes), %"
+	       PRIu64 " dropped, %" PRIu64 " lost, %" PRIu64 " frames written (%" PRIu64
+	       " failed)\n", rx_total.sdus_received, rx_total.sdus_reassembled,
+	       rx_total.bytes_reassembled, rx_total.sdus_dropped, rx_total.sdus_lost,
+	       stats->frames_out, stats->frames_out_lost);
+	if (elapsed_s > 0) {
+		printf("rates: TX %.0f SDU/s %.3f Mbit/s, RX %.0f SDU/s %.3f Mbit/s over %.1f s\n",
+		       (tx_total.sdus_sent - modem->last.tx_sdus) / elapsed_s,
+		       (tx_total.bytes_in - modem->last.tx_bytes) * 8 / elapsed_s / 1e6,
+		       (rx_total.sdus_reassembled - modem->last.rx_sdus) / elapsed_s,
+		       (rx_total.bytes_reassembled - modem->last.rx_bytes) * 8 / elapsed_s / 1e6,
+		       elapsed_s);
+	}
+
+	modem->last.time_ns = now_ns;
+	modem->last.tx_sdus = tx_total.sdus_sent;
+	modem->last.tx_bytes = tx_total.bytes_in;
+	modem->last.rx_sdus = rx_total.sdus_reassembled;
+	modem->last.rx_bytes = rx_total.bytes_reassembled;
+}
+
+
+/**
+ * @brief  Run the modem until it is stopped by a signal or its duration is over
+ *
+ * @param[in,out] modem        The modem
+ * @param[in]     duration_ns  The duration of the run, 0 for no limit
+ * @param[in]     stats_ns     The interval of the statistics reports, 0 for one at exit
+ * @return                     0 in case of success, 1 otherwise
+ */
+static int test_rle_modem(struct modem *const modem, const uint64_t duration_ns,
+                          const uint64_t stats_ns)
+{
+	const uint64_t start_ns = get_time_ns();
+	uint64_t next_stats_ns = start_ns + stats_ns;
+	struct sigaction action;
+	struct pollfd fds[2];
+	int status = 1;
+
+	/* no SA_RESTART, so that poll() returns on the signals */
+	memset(&action, 0, sizeof(struct sigaction));
+	action.sa_handler = handle_signal;
+	sigemptyset(&action.sa_mask);
+	if (sigaction(SIGINT, &action, NULL) != 0 || sigaction(SIGTERM, &action, NULL) != 0) {
+		perror("failed to handle the signals");
+		goto error;
+	}
+
+	fds[0].fd = modem->port != NULL ? packet_ring_get_fd(modem->port) : modem->tap_fd;
+	fds[0].events = POLLIN;
+	fds[1].fd = modem->udp_fd;
+	fds[1].events = POLLIN;
+	modem->last.time_ns = start_ns;
+
+	printf("\n=== run:\n");
+	while (!stop_modem) {
+		const uint64_t now_ns = get_time_ns();
+		int timeout_ms = -1;
+		int ret;
+
+		if (duration_ns != 0) {
+			if (now_ns - start_ns >= duration_ns) {
+				break;
+			}
+			timeout_ms = (start_ns + duration_ns - now_ns) / 1000000 + 1;
+		}
+		if (stats_ns != 0) {
+			if (now_ns >= next_stats_ns) {
+				modem_print_stats(modem);
+				next_stats_ns += stats_ns;
+			}
+			const int stats_timeout_ms = (next_stats_ns - now_ns) / 1000000 + 1;
+
+			if (timeout_ms < 0 || stats_timeout_ms < timeout_ms) {
+				timeout_ms = stats_timeout_ms;
+			}
+		}
+
+		ret = poll(fds, 2, timeout_ms);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			perror("failed to poll the TAP device or port and the UDP socket");
+			goto error;
+		}
+		if ((fds[1].revents & (POLLIN | POLLERR)) != 0 && modem_udp_input(modem) != 0) {
+			goto error;
+		}
+		if ((fds[0].revents & POLLIN) != 0) {
+			ret = modem->port != NULL ? modem_port_input(modem) : modem_tap_input(modem);
+			if (ret != 0) {
+				goto error;
+			}
+		}
+	}
+
+	status = 0;
+
+error:
+	modem_print_stats(modem);
+	return status;
+}
@@ -0,0 +1,469 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_rx_pool.c
+ * @brief  Pool of hub receivers sharded on worker threads.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* for pthread_attr_setaffinity_np() */
+#define _GNU_SOURCE
+
+#include "test_rx_pool.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+/** The length of a cache line, the indexes of the rings are kept on their own lines */
+#define RX_POOL_CACHE_LINE 64U
+
+/** The maximal number of SDUs decapsulated from one FPDU */
+#define RX_POOL_FPDU_SDUS_MAX 256U
+
+/** The length of the SDU buffers given to the receivers (room for VLAN ptype re-insertion) */
+#define RX_POOL_SDU_BUF_LEN (RLE_MAX_PDU_SIZE + 4U)
+
+/** An FPDU in the input ring of a worker */
+struct rx_fpdu_slot {
+	size_t len;                                /**< The length of the FPDU */
+	unsigned char data[RX_POOL_MAX_FPDU_LEN];  /**< The FPDU */
+};
+
+/** An SDU in the output ring of a worker */
+struct rx_sdu_slot {
+	struct rx_pool_sdu sdu;                    /**< The SDU, its buffer points to data */
+	unsigned char data[RX_POOL_SDU_BUF_LEN];   /**< The content of the SDU */
+};
+
+/** A single-producer single-consumer ring, the producer and consumer indexes are free
+ *  running and each one is written by one thread only */
+struct rx_ring {
+	size_t tail;                                          /**< Written by the producer */
+	unsigned char pad_tail[RX_POOL_CACHE_LINE - sizeof(size_t)];
+	size_t head;                                          /**< Written by the consumer */
+	unsigned char pad_head[RX_POOL_CACHE_LINE - sizeof(size_t)];
+	size_t mask;                                          /**< The number of slots - 1 */
+	void *slots;                                          /**< The slots */
+};
+
+/** The receiver of one terminal of a worker */
+struct rx_terminal {
+	unsigned char label[RX_POOL_MAX_LABEL_LEN];  /**< The payload label of the terminal */
+	struct rle_receiver *receiver;               /**< The receiver, NULL if the entry is free */
+};
+
+/** One worker thread of the pool */
+struct rx_worker {
+	struct rx_ring in;                /**< The FPDUs pushed by the dispatcher */
+	struct rx_ring out;               /**< The SDUs reassembled for the collector */
+	struct rx_pool *pool;             /**< The pool of the worker */
+	pthread_t thread;                 /**< The thread of the worker */
+	bool started;                     /**< Whether the thread runs or not */
+	struct rx_terminal *terminals;    /**< The receivers of the terminals, hashed by label */
+	size_t terminals_mask;            /**< The number of entries of the table - 1 */
+	struct rle_sdu sdus[RX_POOL_FPDU_SDUS_MAX];  /**< The SDUs of the current FPDU */
+	unsigned char *sdus_buf;          /**< The buffers of the SDUs of the current FPDU */
+	struct rx_pool_stats stats;       /**< The statistics, written by the worker only */
+	unsigned char pad[RX_POOL_CACHE_LINE];
+};
+
+/** The receivers pool */
+struct rx_pool {
+	struct rx_pool_conf conf;      /**< The configuration of the pool */
+	struct rx_worker **workers;    /**< The workers */
+	int stop;                      /**< Whether the workers shall stop once idle or not */
+};
+
+/* prototypes of private functions */
+static uint32_t rx_pool_hash(const unsigned char *const label, const size_t label_size);
+static int rx_ring_init(struct rx_ring *const ring, const size_t len, const size_t slot_len);
+static struct rle_receiver * rx_worker_receiver(struct rx_worker *const worker,
+                                                const unsigned char *const label,
+                                                const uint32_t hash);
+static void rx_worker_handle(struct rx_worker *const worker,
+                             struct rx_fpdu_slot *const fpdu);
+static void * rx_worker_run(void *const arg);
+static void rx_worker_free(struct rx_worker *const worker);
+
+
+/**
+ * @brief  Hash the payload label of a terminal (FNV-1a)
+ *
+ * @param[in] label       The payload label
+ * @param[in] label_size  The length of the payload label
+ * @return                The hash
+ */
+static uint32_t rx_pool_hash(const unsigned char *const label, const size_t label_size)
+{
+	uint32_t hash = 2166136261U;
+	size_t i;
+
+	for (i = 0; i < label_size; i++) {
+		hash = (hash ^ label[i]) * 16777619U;
+	}
+
+	return hash;
+}
+
+/**
+ * @brief  Allocate the slots of a ring
+ *
+ * @param[out] ring      The ring
+ * @param[in]  len       The number of slots, a power of 2
+ * @param[in]  slot_len  The length of one slot
+ * @return               0 in case of success, -1 otherwise
+ */
+static int rx_ring_init(struct rx_ring *const ring, const size_t len, const size_t slot_len)
+{
+	ring->head = 0;
+	ring->tail = 0;
+	ring->mask = len - 1;
+	if (posix_memalign(&ring->slots, RX_POOL_CACHE_LINE, len * slot_len) != 0) {
+		ring->slots = NULL;
+		return -1;
+	}
+
+	return 0;
+}
+
+struct rx_pool * rx_pool_new(const struct rx_pool_conf *const conf)
+{
+	struct rx_pool *pool;
+	size_t terminals_len = 1;
+	size_t i;
+
+	if (conf->workers_nr == 0 || conf->ring_len < 2 ||
+	    (conf->ring_len & (conf->ring_len - 1)) != 0 ||
+	    (conf->payload_label_size != 3 && conf->payload_label_size != 6) ||
+	    conf->terminals_max_nr == 0) {
+		fprintf(stderr, "invalid configuration of the receivers pool\n");
+		goto error;
+	}
+	while (terminals_len < 2 * conf->terminals_max_nr) {
+		terminals_len *= 2;
+	}
+
+	pool = calloc(1, sizeof(struct rx_pool));
+	if (pool == NULL) {
+		goto error;
+	}
+	pool->conf = *conf;
+	pool->conf.cpus = NULL;
+	pool->workers = calloc(conf->workers_nr, sizeof(struct rx_worker *));
+	if (pool->workers == NULL) {
+		goto free_pool;
+	}
+
+	for (i = 0; i < conf->workers_nr; i++) {
+		struct rx_worker *worker;
+		size_t j;
+
+		if (posix_memalign((void **)&pool->workers[i], RX_POOL_CACHE_LINE,
+		                   sizeof(struct rx_worker)) != 0) {
+			pool->workers[i] = NULL;
+			fprintf(stderr, "failed to allocate worker #%zu\n", i + 1);
+			goto destroy;
+		}
+		worker = pool->workers[i];
+		memset(worker, 0, sizeof(struct rx_worker));
+		worker->pool = pool;
+		worker->terminals_mask = terminals_len - 1;
+		worker->terminals = calloc(terminals_len, sizeof(struct rx_terminal));
+		worker->sdus_buf = malloc(RX_POOL_FPDU_SDUS_MAX * RX_POOL_SDU_BUF_LEN);
+		if (worker->terminals == NULL || worker->sdus_buf == NULL ||
+		    rx_ring_init(&worker->in, conf->ring_len, sizeof(struct rx_fpdu_slot)) != 0 ||
+		    rx_ring_init(&worker->out, conf->ring_len, sizeof(struct rx_sdu_slot)) != 0) {
+			fprintf(stderr, "failed to allocate worker #%zu\n", i + 1);
+			goto destroy;
+		}
+		for (j = 0; j < conf->ring_len; j++) {
+			struct rx_sdu_slot *const slot = (struct rx_sdu_slot *)worker->out.slots + j;
+
+			slot->sdu.sdu.buffer = slot->data;
+		}
+		for (j = 0; j < RX_POOL_FPDU_SDUS_MAX; j++) {
+			worker->sdus[j].buffer = worker->sdus_buf + j * RX_POOL_SDU_BUF_LEN;
+		}
+	}
+
+	for (i = 0; i < conf->workers_nr; i++) {
+		struct rx_worker *const worker = pool->workers[i];
+		pthread_attr_t attr;
+		int ret;
+
+		pthread_attr_init(&attr);
+		if (conf->cpus != NULL) {
+			cpu_set_t cpus;
+
+			CPU_ZERO(&cpus);
+			CPU_SET(conf->cpus[i], &cpus);
+			pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpus);
+		}
+		ret = pthread_create(&worker->thread, &attr, rx_worker_run, worker);
+		pthread_attr_destroy(&attr);
+		if (ret != 0) {
+			fprintf(stderr, "failed to start worker #%zu\n", i + 1);
+			goto destroy;
+		}
+		worker->started = true;
+	}
+
+	return pool;
+
+destroy:
+	rx_pool_destroy(pool);
+	return NULL;
+free_pool:
+	free(pool);
+error:
+	return NULL;
+}
+
+int rx_pool_push(struct rx_pool *const pool, const unsigned char *const fpdu,
+                 const size_t fpdu_len)
+{
+	const size_t label_size = pool->conf.payload_label_size;
+	struct rx_worker *worker;
+	struct rx_fpdu_slot *slot;
+	size_t tail;
+
+	if (fpdu_len <= label_size || fpdu_len > RX_POOL_MAX_FPDU_LEN) {
+		return -1;
+	}
+
+	worker = pool->workers[rx_pool_hash(fpdu, label_size) % pool->conf.workers_nr];
+	tail = worker->in.tail;
+	if (tail - __atomic_load_n(&worker->in.head, __ATOMIC_ACQUIRE) > worker->in.mask) {
+		return 1;
+	}
+
+	slot = (struct rx_fpdu_slot *)worker->in.slots + (tail & worker->in.mask);
+	slot->len = fpdu_len;
+	memcpy(slot->data, fpdu, fpdu_len);
+	__atomic_store_n(&worker->in.tail, tail + 1, __ATOMIC_RELEASE);
+
+	return 0;
+}
+
+const struct rx_pool_sdu * rx_pool_peek(struct rx_pool *const pool, const size_t worker_id)
+{
+	struct rx_worker *const worker = pool->workers[worker_id];
+	const size_t head = worker->out.head;
+
+	if (head == __atomic_load_n(&worker->out.tail, __ATOMIC_ACQUIRE)) {
+		return NULL;
+	}
+
+	return &((struct rx_sdu_slot *)worker->out.slots)[head & worker->out.mask].sdu;
+}
+
+void rx_pool_release(struct rx_pool *const pool, const size_t worker_id)
+{
+	struct rx_worker *const worker = pool->workers[worker_id];
+
+	__atomic_store_n(&worker->out.head, worker->out.head + 1, __ATOMIC_RELEASE);
+}
+
+void rx_pool_get_stats(const struct rx_pool *const pool, const size_t worker_id,
+                       struct rx_pool_stats *const stats)
+{
+	const struct rx_worker *const worker = pool->workers[worker_id];
+
+	stats->fpdus_nr = __atomic_load_n(&worker->stats.fpdus_nr, __ATOMIC_RELAXED);
+	stats->sdus_nr = __atomic_load_n(&worker->stats.sdus_nr, __ATOMIC_RELAXED);
+	stats->errors_nr = __atomic_load_n(&worker->stats.errors_nr, __ATOMIC_RELAXED);
+	stats->terminals_nr = __atomic_load_n(&worker->stats.terminals_nr, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief  Get the receiver of a terminal of a worker, create it on the first FPDU
+ *
+ * @param[in,out] worker  The worker
+ * @param[in]     label   The payload label of the terminal
+ * @param[in]     hash    The hash of the payload label
+ * @return                The receiver, NULL if the worker has too many terminals
+ */
+static struct rle_receiver * rx_worker_receiver(struct rx_worker *const worker,
+                                                const unsigned char *const label,
+                                                const uint32_t hash)
+{
+	const size_t label_size = worker->pool->conf.payload_label_size;
+	size_t id = (hash / worker->pool->conf.workers_nr) & worker->terminals_mask;
+
+	/* linear probing, the table is at most half full */
+	while (worker->terminals[id].receiver != NULL) {
+		if (memcmp(worker->terminals[id].label, label, label_size) == 0) {
+			return worker->terminals[id].receiver;
+		}
+		id = (id + 1) & worker->terminals_mask;
+	}
+
+	if (worker->stats.terminals_nr >= worker->pool->conf.terminals_max_nr) {
+		return NULL;
+	}
+	worker->terminals[id].receiver = rle_receiver_new(&worker->pool->conf.rle_conf);
+	if (worker->terminals[id].receiver == NULL) {
+		return NULL;
+	}
+	memcpy(worker->terminals[id].label, label, label_size);
+	__atomic_store_n(&worker->stats.terminals_nr, worker->stats.terminals_nr + 1,
+	                 __ATOMIC_RELAXED);
+
+	return worker->terminals[id].receiver;
+}
+
+/**
+ * @brief  Decapsulate one FPDU, then push its SDUs in the output ring
+ *
+ * When the output ring is full, the worker waits for the collector, unless the pool is
+ * being destroyed: the SDU is dropped then.
+ *
+ * @param[in,out] worker  The worker
+ * @param[in]     fpdu    The FPDU
+ */
+static void rx_worker_handle(struct rx_worker *const worker,
+                             struct rx_fpdu_slot *const fpdu)
+{
+	const size_t label_size = worker->pool->conf.payload_label_size;
+	struct rle_receiver *receiver;
+	unsigned char label[RX_POOL_MAX_LABEL_LEN];
+	size_t sdus_nr = 0;
+	size_t i;
+
+	receiver = rx_worker_receiver(worker, fpdu->data, rx_pool_hash(fpdu->data, label_size));
+	if (receiver == NULL ||
+	    rle_decapsulate(receiver, fpdu->data, fpdu->len, worker->sdus, RX_POOL_FPDU_SDUS_MAX,
+	                    &sdus_nr, label, label_size) != RLE_DECAP_OK) {
+		__atomic_store_n(&worker->stats.errors_nr, worker->stats.errors_nr + 1,
+		                 __ATOMIC_RELAXED);
+	}
+
+	for (i = 0; i < sdus_nr; i++) {
+		const size_t tail = worker->out.tail;
+		struct rx_sdu_slot *slot;
+
+		while (tail - __atomic_load_n(&worker->out.head, __ATOMIC_ACQUIRE) > worker->out.mask) {
+			if (__atomic_load_n(&worker->pool->stop, __ATOMIC_ACQUIRE)) {
+				break;
+			}
+			sched_yield();
+		}
+		if (tail - worker->out.head > worker->out.mask) {
+			continue;
+		}
+
+		slot = (struct rx_sdu_slot *)worker->out.slots + (tail & worker->out.mask);
+		memcpy(slot->sdu.label, label, label_size);
+		slot->sdu.sdu.size = worker->sdus[i].size;
+		slot->sdu.sdu.protocol_type = worker->sdus[i].protocol_type;
+		memcpy(slot->data, worker->sdus[i].buffer, worker->sdus[i].size);
+		__atomic_store_n(&worker->out.tail, tail + 1, __ATOMIC_RELEASE);
+	}
+
+	/* the receiver expects empty SDUs */
+	for (i = 0; i < sdus_nr; i++) {
+		worker->sdus[i].size = 0;
+		worker->sdus[i].protocol_type = 0;
+	}
+
+	__atomic_store_n(&worker->stats.fpdus_nr, worker->stats.fpdus_nr + 1, __ATOMIC_RELAXED);
+	__atomic_store_n(&worker->stats.sdus_nr, worker->stats.sdus_nr + sdus_nr, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief  The loop of a worker thread: handle the FPDUs of the input ring until the pool
+ *         is stopped and the ring is empty
+ *
+ * @param[in,out] arg  The worker
+ * @return             NULL
+ */
+static void * rx_worker_run(void *const arg)
+{
+	struct rx_worker *const worker = arg;
+
+	while (1) {
+		const size_t head = worker->in.head;
+
+		if (head == __atomic_load_n(&worker->in.tail, __ATOMIC_ACQUIRE)) {
+			/* the stop flag is set after the last FPDU is pushed, check the ring again */
+			if (__atomic_load_n(&worker->pool->stop, __ATOMIC_ACQUIRE) &&
+			    head == __atomic_load_n(&worker->in.tail, __ATOMIC_ACQUIRE)) {
+				break;
+			}
+			sched_yield();
+			continue;
+		}
+
+		rx_worker_handle(worker, (struct rx_fpdu_slot *)worker->in.slots +
+		                 (head & worker->in.mask));
+		__atomic_store_n(&worker->in.head, head + 1, __ATOMIC_RELEASE);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief  Release the receivers and the memory of a stopped worker
+ *
+ * @param[in,out] worker  The worker
+ */
+static void rx_worker_free(struct rx_worker *const worker)
+{
+	size_t i;
+
+	if (worker->terminals != NULL) {
+		for (i = 0; i <= worker->terminals_mask; i++) {
+			if (worker->terminals[i].receiver != NULL) {
+				rle_receiver_destroy(&worker->terminals[i].receiver);
+			}
+		}
+	}
+	free(worker->terminals);
+	free(worker->sdus_buf);
+	free(worker->in.slots);
+	free(worker->out.slots);
+	free(worker);
+}
+
+void rx_pool_destroy(struct rx_pool *const pool)
+{
+	size_t i;
+
+	__atomic_store_n(&pool->stop, 1, __ATOMIC_RELEASE);
+	for (i = 0; i < pool->conf.workers_nr; i++) {
+		if (pool->workers[i] != NULL && pool->workers[i]->started) {
+			pthread_join(pool->workers[i]->thread, NULL);
+		}
+	}
+	for (i = 0; i < pool->conf.workers_nr; i++) {
+		if (pool->workers[i] != NULL) {
+			rx_worker_free(pool->workers[i]);
+		}
+	}
+	free(pool->workers);
+	free(pool);
+}
@@ -0,0 +1,423 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_shm_ring.c
+ * @brief  Shared memory ring of SDUs between producer processes and an RLE transmitter.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* for memfd_create() */
+#define _GNU_SOURCE
+
+#include "test_shm_ring.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/** The magic number at the beginning of the shared memory: "RLESHMRG" */
+#define SHM_RING_MAGIC 0x524c4553484d5247ULL
+
+/** The version of the layout of the shared memory */
+#define SHM_RING_VERSION 1U
+
+/** The length of a cache line, the fields of the producer and of the consumer of a lane
+ *  are kept on their own lines */
+#define SHM_RING_CACHE_LINE 64U
+
+/** The states of a lane */
+#define SHM_LANE_FREE   0U
+#define SHM_LANE_OPEN   1U
+#define SHM_LANE_CLOSED 2U
+
+/** The header of the shared memory */
+struct shm_ring_header {
+	uint64_t magic;       /**< SHM_RING_MAGIC */
+	uint32_t version;     /**< SHM_RING_VERSION */
+	uint32_t lanes_nr;    /**< The number of lanes */
+	uint64_t descs_nr;    /**< The number of descriptors per lane */
+	uint64_t arena_len;   /**< The length of the arena of every lane */
+	uint64_t lane_len;    /**< The length of every lane, descriptors and arena included */
+	uint64_t map_len;     /**< The length of the shared memory */
+	unsigned char pad[SHM_RING_CACHE_LINE - 6 * sizeof(uint64_t)];
+};
+
+/** The descriptor of an SDU committed in a lane */
+struct shm_desc {
+	uint64_t offset;          /**< The offset of the SDU in the arena */
+	uint64_t end;             /**< The arena position freed once the SDU is released */
+	uint16_t size;            /**< The length of the SDU */
+	uint16_t protocol_type;   /**< The uncompressed protocol type of the SDU */
+	uint8_t frag_id;          /**< The frag_id of the SDU */
+	unsigned char pad[3];
+};
+
+/** The control fields of a lane, followed by its descriptors then its arena. The positions
+ *  in the descriptors and in the arena are free running. */
+struct shm_lane {
+	uint32_t state;              /**< SHM_LANE_FREE, SHM_LANE_OPEN or SHM_LANE_CLOSED */
+	unsigned char pad_state[SHM_RING_CACHE_LINE - sizeof(uint32_t)];
+	/* written by the producer */
+	uint64_t desc_tail;          /**< The next descriptor to commit */
+	uint64_t arena_tail;         /**< The end of the SDUs committed in the arena */
+	uint64_t reserved_pos;       /**< The arena position of the SDU reserved last */
+	uint64_t reserved_len;       /**< The length of the SDU reserved last */
+	uint64_t full_nr;            /**< The number of reservations refused */
+	unsigned char pad_producer[SHM_RING_CACHE_LINE - 5 * sizeof(uint64_t)];
+	/* written by the consumer */
+	uint64_t desc_head;          /**< The oldest descriptor not released */
+	uint64_t arena_head;         /**< The beginning of the SDUs not released in the arena */
+	uint64_t sdus_nr;            /**< The number of SDUs released */
+	uint64_t bytes_nr;           /**< The number of SDU bytes released */
+	uint64_t descs_max_used;     /**< The highest number of descriptors seen in use */
+	uint64_t arena_max_used;     /**< The highest number of arena bytes seen in use */
+	uint64_t peeks_nr;           /**< The number of SDUs peeked */
+	uint64_t descs_used_sum;     /**< The sum of the descriptors in use seen at every peek */
+};
+
+/* prototypes of private functions */
+static int shm_ring_map(struct shm_ring *const ring, const size_t map_len);
+static const struct shm_ring_header * shm_ring_header(const struct shm_ring *const ring);
+static struct shm_lane * shm_ring_lane(const struct shm_ring *const ring, const int lane);
+static struct shm_desc * shm_lane_descs(const struct shm_lane *const lane);
+static unsigned char * shm_lane_arena(const struct shm_ring *const ring,
+                                      const struct shm_lane *const lane);
+
+
+/**
+ * @brief  Map the shared memory of a ring
+ *
+ * @param[in,out] ring     The ring, with its file descriptor
+ * @param[in]     map_len  The length of the shared memory
+ * @return                 0 in case of success, -1 otherwise
+ */
+static int shm_ring_map(struct shm_ring *const ring, const size_t map_len)
+{
+	void *map;
+
+	map = mmap(NULL, map_len, PROT_READ | PROT_WRITE, MAP_SHARED, ring->fd, 0);
+	if (map == MAP_FAILED) {
+		perror("failed to map the shared memory");
+		return -1;
+	}
+	ring->map = map;
+	ring->map_len = map_len;
+
+	return 0;
+}
+
+/**
+ * @brief  Get the header of a ring
+ *
+ * @param[in] ring  The ring
+ * @return          The header
+ */
+static const struct shm_ring_header * shm_ring_header(const struct shm_ring *const ring)
+{
+	return (const struct shm_ring_header *)ring->map;
+}
+
+/**
+ * @brief  Get a lane of a ring
+ *
+ * @param[in] ring  The ring
+ * @param[in] lane  The lane id
+ * @return          The lane
+ */
+static struct shm_lane * shm_ring_lane(const struct shm_ring *const ring, const int lane)
+{
+	return (struct shm_lane *)(ring->map + sizeof(struct shm_ring_header) +
+	                           lane * shm_ring_header(ring)->lane_len);
+}
+
+/**
+ * @brief  Get the descriptors of a lane
+ *
+ * @param[in] lane  The lane
+ * @return          The descriptors
+ */
+static struct shm_desc * shm_lane_descs(const struct shm_lane *const lane)
+{
+	return (struct shm_desc *)(lane + 1);
+}
+
+/**
+ * @brief  Get the arena of a lane
+ *
+ * @param[in] ring  The ring
+ * @param[in] lane  The lane
+ * @return          The arena
+ */
+static unsigned char * shm_lane_arena(const struct shm_ring *const ring,
+                                      const struct shm_lane *const lane)
+{
+	return (unsigned char *)(shm_lane_descs(lane) + shm_ring_header(ring)->descs_nr);
+}
+
+int shm_ring_create(struct shm_ring *const ring, const char *const name,
+                    const struct shm_ring_conf *const conf)
+{
+	struct shm_ring_header *header;
+	size_t lane_len;
+	size_t map_len;
+
+	if (conf->lanes_nr == 0 || conf->descs_nr < 2 ||
+	    (conf->descs_nr & (conf->descs_nr - 1)) != 0 || conf->arena_len < RLE_MAX_PDU_SIZE) {
+		fprintf(stderr, "invalid configuration of the shared memory ring\n");
+		goto error;
+	}
+	lane_len = sizeof(struct shm_lane) + conf->descs_nr * sizeof(struct shm_desc) +
+	           conf->arena_len;
+	lane_len = (lane_len + SHM_RING_CACHE_LINE - 1) & ~((size_t)SHM_RING_CACHE_LINE - 1);
+	map_len = sizeof(struct shm_ring_header) + conf->lanes_nr * lane_len;
+
+	if (name != NULL) {
+		ring->fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	} else {
+		ring->fd = memfd_create("rle_shm_ring", MFD_CLOEXEC);
+	}
+	if (ring->fd < 0) {
+		perror("failed to create the shared memory");
+		goto error;
+	}
+	/* the new memory is filled with zeroes: all the lanes are free and empty */
+	if (ftruncate(ring->fd, map_len) != 0) {
+		perror("failed to size the shared memory");
+		goto close_fd;
+	}
+	if (shm_ring_map(ring, map_len) != 0) {
+		goto close_fd;
+	}
+
+	header = (struct shm_ring_header *)ring->map;
+	header->version = SHM_RING_VERSION;
+	header->lanes_nr = conf->lanes_nr;
+	header->descs_nr = conf->descs_nr;
+	header->arena_len = conf->arena_len;
+	header->lane_len = lane_len;
+	header->map_len = map_len;
+	__atomic_store_n(&header->magic, SHM_RING_MAGIC, __ATOMIC_RELEASE);
+
+	return 0;
+
+close_fd:
+	close(ring->fd);
+	if (name != NULL) {
+		shm_unlink(name);
+	}
+error:
+	return -1;
+}
+
+int shm_ring_attach(struct shm_ring *const ring, const char *const name)
+{
+	const struct shm_ring_header *header;
+	struct stat st;
+
+	ring->fd = shm_open(name, O_RDWR, 0);
+	if (ring->fd < 0) {
+		perror("failed to open the shared memory");
+		goto error;
+	}
+	if (fstat(ring->fd, &st) != 0) {
+		perror("failed to get the length of the shared memory");
+		goto close_fd;
+	}
+	if ((size_t)st.st_size < sizeof(struct shm_ring_header)) {
+		fprintf(stderr, "%s is not a shared memory ring\n", name);
+		goto close_fd;
+	}
+	if (shm_ring_map(ring, st.st_size) != 0) {
+		goto close_fd;
+	}
+
+	header = shm_ring_header(ring);
+	if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != SHM_RING_MAGIC ||
+	    header->version != SHM_RING_VERSION || header->map_len != ring->map_len ||
+	    header->lanes_nr == 0 ||
+	    header->map_len != sizeof(struct shm_ring_header) +
+	                       header->lanes_nr * header->lane_len) {
+		fprintf(stderr, "%s is not a shared memory ring\n", name);
+		goto unmap;
+	}
+
+	return 0;
+
+unmap:
+	munmap(ring->map, ring->map_len);
+close_fd:
+	close(ring->fd);
+error:
+	return -1;
+}
+
+void shm_ring_close(struct shm_ring *const ring, const char *const name)
+{
+	munmap(ring->map, ring->map_len);
+	close(ring->fd);
+	if (name != NULL) {
+		shm_unlink(name);
+	}
+	ring->map = NULL;
+	ring->fd = -1;
+}
+
+size_t shm_ring_lanes_nr(const struct shm_ring *const ring)
+{
+	return shm_ring_header(ring)->lanes_nr;
+}
+
+int shm_ring_lane_acquire(struct shm_ring *const ring)
+{
+	size_t i;
+
+	for (i = 0; i < shm_ring_lanes_nr(ring); i++) {
+		uint32_t state = SHM_LANE_FREE;
+
+		if (__atomic_compare_exchange_n(&shm_ring_lane(ring, i)->state, &state, SHM_LANE_OPEN,
+		                                false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+void shm_ring_lane_close(struct shm_ring *const ring, const int lane)
+{
+	__atomic_store_n(&shm_ring_lane(ring, lane)->state, SHM_LANE_CLOSED, __ATOMIC_RELEASE);
+}
+
+unsigned char * shm_ring_reserve(struct shm_ring *const ring, const int lane, const size_t len)
+{
+	const uint64_t arena_len = shm_ring_header(ring)->arena_len;
+	struct shm_lane *const l = shm_ring_lane(ring, lane);
+	uint64_t pos = l->arena_tail;
+	uint64_t offset = pos % arena_len;
+
+	/* an SDU is never split, skip the end of the arena if it is too short */
+	if (offset + len > arena_len) {
+		pos += arena_len - offset;
+		offset = 0;
+	}
+	if (len > RLE_MAX_PDU_SIZE) {
+		return NULL;
+	}
+	if (l->desc_tail - __atomic_load_n(&l->desc_head, __ATOMIC_ACQUIRE) >=
+	    shm_ring_header(ring)->descs_nr ||
+	    pos + len - __atomic_load_n(&l->arena_head, __ATOMIC_ACQUIRE) > arena_len) {
+		__atomic_store_n(&l->full_nr, l->full_nr + 1, __ATOMIC_RELAXED);
+		return NULL;
+	}
+	l->reserved_pos = pos;
+	l->reserved_len = len;
+
+	return shm_lane_arena(ring, l) + offset;
+}
+
+void shm_ring_commit(struct shm_ring *const ring, const int lane,
+                     const uint16_t protocol_type, const uint8_t frag_id)
+{
+	const uint64_t descs_nr = shm_ring_header(ring)->descs_nr;
+	struct shm_lane *const l = shm_ring_lane(ring, lane);
+	struct shm_desc *const desc = &shm_lane_descs(l)[l->desc_tail & (descs_nr - 1)];
+	const uint64_t end = l->reserved_pos + l->reserved_len;
+
+	desc->offset = l->reserved_pos % shm_ring_header(ring)->arena_len;
+	desc->end = end;
+	desc->size = l->reserved_len;
+	desc->protocol_type = protocol_type;
+	desc->frag_id = frag_id;
+	__atomic_store_n(&l->arena_tail, end, __ATOMIC_RELAXED);
+	__atomic_store_n(&l->desc_tail, l->desc_tail + 1, __ATOMIC_RELEASE);
+}
+
+int shm_ring_peek(struct shm_ring *const ring, const int lane, struct rle_sdu *const sdu,
+                  uint8_t *const frag_id)
+{
+	const uint64_t descs_nr = shm_ring_header(ring)->descs_nr;
+	struct shm_lane *const l = shm_ring_lane(ring, lane);
+	const uint64_t head = l->desc_head;
+	uint64_t tail = __atomic_load_n(&l->desc_tail, __ATOMIC_ACQUIRE);
+	const struct shm_desc *desc;
+	uint64_t arena_used;
+
+	if (head == tail) {
+		/* the lane is closed after its last commit, check the ring again */
+		if (__atomic_load_n(&l->state, __ATOMIC_ACQUIRE) == SHM_LANE_CLOSED &&
+		    head == __atomic_load_n(&l->desc_tail, __ATOMIC_ACQUIRE)) {
+			return -1;
+		}
+		return 0;
+	}
+
+	arena_used = __atomic_load_n(&l->arena_tail, __ATOMIC_RELAXED) - l->arena_head;
+	if (tail - head > l->descs_max_used) {
+		l->descs_max_used = tail - head;
+	}
+	if (arena_used > l->arena_max_used) {
+		l->arena_max_used = arena_used;
+	}
+	l->peeks_nr++;
+	l->descs_used_sum += tail - head;
+
+	desc = &shm_lane_descs(l)[head & (descs_nr - 1)];
+	sdu->buffer = shm_lane_arena(ring, l) + desc->offset;
+	sdu->size = desc->size;
+	sdu->protocol_type = desc->protocol_type;
+	*frag_id = desc->frag_id;
+
+	return 1;
+}
+
+void shm_ring_release(struct shm_ring *const ring, const int lane)
+{
+	const uint64_t descs_nr = shm_ring_header(ring)->descs_nr;
+	struct shm_lane *const l = shm_ring_lane(ring, lane);
+	const struct shm_desc *const desc = &shm_lane_descs(l)[l->desc_head & (descs_nr - 1)];
+
+	l->sdus_nr++;
+	l->bytes_nr += desc->size;
+	__atomic_store_n(&l->arena_head, desc->end, __ATOMIC_RELEASE);
+	__atomic_store_n(&l->desc_head, l->desc_head + 1, __ATOMIC_RELEASE);
+}
+
+void shm_ring_get_stats(const struct shm_ring *const ring, const int lane,
+                        struct shm_ring_stats *const stats)
+{
+	struct shm_lane *const l = shm_ring_lane(ring, lane);
+
+	stats->sdus_nr = l->sdus_nr;
+	stats->bytes_nr = l->bytes_nr;
+	stats->full_nr = __atomic_load_n(&l->full_nr, __ATOMIC_RELAXED);
+	stats->descs_used = __atomic_load_n(&l->desc_tail, __ATOMIC_ACQUIRE) - l->desc_head;
+	stats->descs_max_used = l->descs_max_used;
+	stats->arena_used = __atomic_load_n(&l->arena_tail, __ATOMIC_RELAXED) - l->arena_head;
+	stats->arena_max_used = l->arena_max_used;
+	stats->peeks_nr = l->peeks_nr;
+	stats->descs_used_sum = l->descs_used_sum;
+}
@@ -0,0 +1,475 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_trace.c
+ * @brief  Indexed trace files of SDUs and FPDUs, read through mmap(2).
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#include "test_trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/** The magic number at the beginning of the indexed trace files */
+#define TRACE_MAGIC "RLEINDEX"
+
+/** The length of the magic number */
+#define TRACE_MAGIC_LEN 8U
+
+/** The version of the indexed trace file format */
+#define TRACE_VERSION 1U
+
+/** The length of the trace file header: magic, version, reserved, records number and
+ *  offset of the index */
+#define TRACE_HDR_LEN 32U
+
+/** The length of the header of every record: timestamp, length, ptype, flags, frag_id,
+ *  label length and reserved */
+#define TRACE_RECORD_HDR_LEN 16U
+
+/** The alignment of the records */
+#define TRACE_RECORD_ALIGN 8U
+
+/** The length of one entry of the index */
+#define TRACE_INDEX_ENTRY_LEN 8U
+
+/** The initial number of offsets of a trace writer */
+#define TRACE_INIT_OFFSETS_NR 1024U
+
+/* prototypes of private functions */
+static void put_be16(unsigned char *const buf, const uint16_t val);
+static void put_be32(unsigned char *const buf, const uint32_t val);
+static void put_be64(unsigned char *const buf, const uint64_t val);
+static uint16_t get_be16(const unsigned char *const buf);
+static uint32_t get_be32(const unsigned char *const buf);
+static uint64_t get_be64(const unsigned char *const buf);
+static size_t trace_record_len(const size_t label_size, const size_t size);
+static int trace_check_record(const struct trace *const trace, const uint64_t index_offset,
+                              const size_t record_id);
+
+
+/**
+ * @brief  Write a 16-bit integer in network byte order
+ *
+ * @param[out] buf  The buffer
+ * @param[in]  val  The integer
+ */
+static void put_be16(unsigned char *const buf, const uint16_t val)
+{
+	buf[0] = (val >> 8) & 0xff;
+	buf[1] = val & 0xff;
+}
+
+/**
+ * @brief  Write a 32-bit integer in network byte order
+ *
+ * @param[out] buf  The buffer
+ * @param[in]  val  The integer
+ */
+static void put_be32(unsigned char *const buf, const uint32_t val)
+{
+	put_be16(buf, val >> 16);
+	put_be16(buf + 2, val & 0xffff);
+}
+
+/**
+ * @brief  Write a 64-bit integer in network byte order
+ *
+ * @param[out] buf  The buffer
+ * @param[in]  val  The integer
+ */
+static void put_be64(unsigned char *const buf, const uint64_t val)
+{
+	put_be32(buf, val >> 32);
+	put_be32(buf + 4, val & 0xffffffff);
+}
+
+/**
+ * @brief  Read a 16-bit integer in network byte order
+ *
+ * @param[in] buf  The buffer
+ * @return         The integer
+ */
+static uint16_t get_be16(const unsigned char *const buf)
+{
+	return (buf[0] << 8) | buf[1];
+}
+
+/**
+ * @brief  Read a 32-bit integer in network byte order
+ *
+ * @param[in] buf  The buffer
+ * @return         The integer
+ */
+static uint32_t get_be32(const unsigned char *const buf)
+{
+	return (((uint32_t)get_be16(buf)) << 16) | get_be16(buf + 2);
+}
+
+/**
+ * @brief  Read a 64-bit integer in network byte order
+ *
+ * @param[in] buf  The buffer
+ * @return         The integer
+ */
+static uint64_t get_be64(const unsigned char *const buf)
+{
+	return (((uint64_t)get_be32(buf)) << 32) | get_be32(buf + 4);
+}
+
+/**
+ * @brief  Get the length of a record in the trace file, padding included
+ *
+ * @param[in] label_size  The length of the payload label
+ * @param[in] size        The length of the content
+ * @return                The length of the record
+ */
+static size_t trace_record_len(const size_t label_size, const size_t size)
+{
+	const size_t len = TRACE_RECORD_HDR_LEN + label_size + size;
+
+	return (len + TRACE_RECORD_ALIGN - 1) & ~((size_t)TRACE_RECORD_ALIGN - 1);
+}
+
+int trace_writer_open(struct trace_writer *const writer, const char *const filename)
+{
+	unsigned char hdr[TRACE_HDR_LEN];
+
+	memset(writer, 0, sizeof(struct trace_writer));
+
+	writer->offsets = malloc(TRACE_INIT_OFFSETS_NR * sizeof(uint64_t));
+	if (writer->offsets == NULL) {
+		fprintf(stderr, "failed to allocate the index of trace file '%s'\n", filename);
+		goto error;
+	}
+	writer->offsets_max_nr = TRACE_INIT_OFFSETS_NR;
+
+	writer->file = fopen(filename, "wb");
+	if (writer->file == NULL) {
+		fprintf(stderr, "failed to create trace file '%s'\n", filename);
+		goto free_offsets;
+	}
+
+	/* the header is written again with the records number and the index offset on close */
+	memset(hdr, 0, TRACE_HDR_LEN);
+	if (fwrite(hdr, TRACE_HDR_LEN, 1, writer->file) != 1) {
+		fprintf(stderr, "failed to write trace file '%s'\n", filename);
+		goto close_file;
+	}
+	writer->offset = TRACE_HDR_LEN;
+
+	return 0;
+
+close_file:
+	fclose(writer->file);
+	writer->file = NULL;
+free_offsets:
+	free(writer->offsets);
+	writer->offsets = NULL;
+error:
+	return -1;
+}
+
+int trace_writer_add(struct trace_writer *const writer, const struct trace_record *const record)
+{
+	static const unsigned char padding[TRACE_RECORD_ALIGN] = { 0 };
+	unsigned char hdr[TRACE_RECORD_HDR_LEN];
+	const size_t record_len = trace_record_len(record->label_size, record->size);
+	const size_t padding_len = record_len - TRACE_RECORD_HDR_LEN - record->label_size -
+	                           record->size;
+
+	if (record->label_size > TRACE_MAX_LABEL_LEN || record->size > UINT16_MAX) {
+		fprintf(stderr, "record of %zu bytes with %zu-byte label too big for a trace file\n",
+		        record->size, record->label_size);
+		goto error;
+	}
+
+	if (writer->records_nr == writer->offsets_max_nr) {
+		uint64_t *const offsets = realloc(writer->offsets,
+		                                  2 * writer->offsets_max_nr * sizeof(uint64_t));
+
+		if (offsets == NULL) {
+			fprintf(stderr, "failed to grow the index of the trace file\n");
+			goto error;
+		}
+		writer->offsets = offsets;
+		writer->offsets_max_nr *= 2;
+	}
+
+	put_be64(hdr, record->timestamp_ns);
+	put_be16(hdr + 8, record->size);
+	put_be16(hdr + 10, record->protocol_type);
+	hdr[12] = record->flags;
+	hdr[13] = record->frag_id;
+	hdr[14] = record->label_size;
+	hdr[15] = 0;
+	if (fwrite(hdr, TRACE_RECORD_HDR_LEN, 1, writer->file) != 1 ||
+	    (record->label_size > 0 &&
+	     fwrite(record->label, record->label_size, 1, writer->file) != 1) ||
+	    (record->size > 0 && fwrite(record->data, record->size, 1, writer->file) != 1) ||
+	    (padding_len > 0 && fwrite(padding, padding_len, 1, writer->file) != 1)) {
+		fprintf(stderr, "failed to write record #%zu in the trace file\n",
+		        writer->records_nr + 1);
+		goto error;
+	}
+
+	writer->offsets[writer->records_nr] = writer->offset;
+	writer->records_nr++;
+	writer->offset += record_len;
+
+	return 0;
+
+error:
+	return -1;
+}
+
+int trace_writer_close(struct trace_writer *const writer)
+{
+	unsigned char hdr[TRACE_HDR_LEN];
+	size_t i;
+	int status = -1;
+
+	for (i = 0; i < writer->records_nr; i++) {
+		unsigned char entry[TRACE_INDEX_ENTRY_LEN];
+
+		put_be64(entry, writer->offsets[i]);
+		if (fwrite(entry, TRACE_INDEX_ENTRY_LEN, 1, writer->file) != 1) {
+			goto write_error;
+		}
+	}
+
+	memcpy(hdr, TRACE_MAGIC, TRACE_MAGIC_LEN);
+	put_be32(hdr + 8, TRACE_VERSION);
+	put_be32(hdr + 12, 0);
+	put_be64(hdr + 16, writer->records_nr);
+	put_be64(hdr + 24, writer->offset);
+	if (fseek(writer->file, 0, SEEK_SET) != 0 ||
+	    fwrite(hdr, TRACE_HDR_LEN, 1, writer->file) != 1) {
+		goto write_error;
+	}
+	status = 0;
+
+write_error:
+	if (fclose(writer->file) != 0) {
+		status = -1;
+	}
+	if (status != 0) {
+		fprintf(stderr, "failed to write the index of the trace file\n");
+	}
+	free(writer->offsets);
+	memset(writer, 0, sizeof(struct trace_writer));
+	return status;
+}
+
+int trace_write_traffic(const struct traffic *const traffic, const char *const filename)
+{
+	struct trace_writer writer;
+	size_t i;
+
+	if (trace_writer_open(&writer, filename) != 0) {
+		goto error;
+	}
+
+	for (i = 0; i < traffic->sdus_nr; i++) {
+		const struct traffic_sdu *const sdu = &traffic->sdus[i];
+		const struct trace_record record = {
+			.timestamp_ns = 0,
+			.data = sdu->data,
+			.size = sdu->size,
+			.label = NULL,
+			.label_size = 0,
+			.protocol_type = sdu->protocol_type,
+			.frag_id = sdu->frag_id,
+			.flags = 0,
+		};
+
+		if (trace_writer_add(&writer, &record) != 0) {
+			trace_writer_close(&writer);
+			goto error;
+		}
+	}
+
+	return trace_writer_close(&writer);
+
+error:
+	return -1;
+}
+
+/**
+ * @brief  Check that a record of a mapped trace is within the records area
+ *
+ * @param[in] trace         The mapped trace
+ * @param[in] index_offset  The offset of the index, the end of the records area
+ * @param[in] record_id     The record
+ * @return                  0 if the record is valid, -1 otherwise
+ */
+static int trace_check_record(const struct trace *const trace, const uint64_t index_offset,
+                              const size_t record_id)
+{
+	const uint64_t offset = get_be64(trace->index + record_id * TRACE_INDEX_ENTRY_LEN);
+	const unsigned char *hdr;
+	size_t label_size;
+
+	if (offset < TRACE_HDR_LEN || offset % TRACE_RECORD_ALIGN != 0 ||
+	    offset + TRACE_RECORD_HDR_LEN > index_offset) {
+		return -1;
+	}
+	hdr = trace->map + offset;
+	label_size = hdr[14];
+	if (label_size > TRACE_MAX_LABEL_LEN ||
+	    offset + trace_record_len(label_size, get_be16(hdr + 8)) > index_offset) {
+		return -1;
+	}
+
+	return 0;
+}
+
+int trace_open(const char *const filename, struct trace *const trace)
+{
+	struct stat st;
+	uint64_t records_nr;
+	uint64_t index_offset;
+	size_t i;
+	int fd;
+	int status = -1;
+
+	memset(trace, 0, sizeof(struct trace));
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "failed to open trace file '%s'\n", filename);
+		goto error;
+	}
+	if (fstat(fd, &st) != 0) {
+		fprintf(stderr, "failed to get the length of trace file '%s'\n", filename);
+		goto close_file;
+	}
+	if (st.st_size < TRACE_HDR_LEN) {
+		status = 1;
+		goto close_file;
+	}
+
+	/* the mapping is private, so the tools may handle the SDUs as writable buffers */
+	trace->map_len = st.st_size;
+	trace->map = mmap(NULL, trace->map_len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	if (trace->map == MAP_FAILED) {
+		fprintf(stderr, "failed to map trace file '%s'\n", filename);
+		trace->map = NULL;
+		goto close_file;
+	}
+	if (memcmp(trace->map, TRACE_MAGIC, TRACE_MAGIC_LEN) != 0) {
+		status = 1;
+		goto unmap;
+	}
+
+	records_nr = get_be64(trace->map + 16);
+	index_offset = get_be64(trace->map + 24);
+	if (get_be32(trace->map + 8) != TRACE_VERSION || index_offset < TRACE_HDR_LEN ||
+	    index_offset > trace->map_len ||
+	    (trace->map_len - index_offset) / TRACE_INDEX_ENTRY_LEN != records_nr ||
+	    (trace->map_len - index_offset) % TRACE_INDEX_ENTRY_LEN != 0) {
+		fprintf(stderr, "malformed trace file '%s'\n", filename);
+		goto unmap;
+	}
+	trace->records_nr = records_nr;
+	trace->index = trace->map + index_offset;
+
+	for (i = 0; i < trace->records_nr; i++) {
+		if (trace_check_record(trace, index_offset, i) != 0) {
+			fprintf(stderr, "malformed record #%zu in trace file '%s'\n", i + 1, filename);
+			goto unmap;
+		}
+	}
+
+	status = 0;
+	goto close_file;
+
+unmap:
+	munmap(trace->map, trace->map_len);
+	memset(trace, 0, sizeof(struct trace));
+close_file:
+	close(fd);
+error:
+	return status;
+}
+
+void trace_get(const struct trace *const trace, const size_t record_id,
+               struct trace_record *const record)
+{
+	const unsigned char *const hdr =
+		trace->map + get_be64(trace->index + record_id * TRACE_INDEX_ENTRY_LEN);
+
+	record->timestamp_ns = get_be64(hdr);
+	record->size = get_be16(hdr + 8);
+	record->protocol_type = get_be16(hdr + 10);
+	record->flags = hdr[12];
+	record->frag_id = hdr[13];
+	record->label_size = hdr[14];
+	record->label = record->label_size > 0 ? hdr + TRACE_RECORD_HDR_LEN : NULL;
+	record->data = hdr + TRACE_RECORD_HDR_LEN + record->label_size;
+}
+
+int trace_to_traffic(const struct trace *const trace, struct traffic *const traffic)
+{
+	size_t i;
+
+	memset(traffic, 0, sizeof(struct traffic));
+
+	traffic->sdus = calloc(trace->records_nr, sizeof(struct traffic_sdu));
+	if (traffic->sdus == NULL && trace->records_nr > 0) {
+		fprintf(stderr, "failed to allocate %zu SDUs\n", trace->records_nr);
+		return -1;
+	}
+
+	for (i = 0; i < trace->records_nr; i++) {
+		struct traffic_sdu *const sdu = &traffic->sdus[traffic->sdus_nr];
+		struct trace_record record;
+
+		trace_get(trace, i, &record);
+		if ((record.flags & TRACE_RECORD_FPDU) != 0) {
+			continue;
+		}
+		/* the record points in the private mapping of the trace */
+		sdu->data = trace->map + (record.data - trace->map);
+		sdu->size = record.size;
+		sdu->protocol_type = record.protocol_type;
+		sdu->frag_id = record.frag_id;
+		traffic->data_len += record.size;
+		traffic->sdus_nr++;
+	}
+
+	return 0;
+}
+
+void trace_close(struct trace *const trace)
+{
+	if (trace->map != NULL) {
+		munmap(trace->map, trace->map_len);
+	}
+	memset(trace, 0, sizeof(struct trace));
+}
@@ -0,0 +1,620 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_traffic_gen.c
+ * @brief  Synthetic traffic generator shared by the benchmarks and stress tests.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+#include "test_traffic_gen.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+#include "rle.h"
+
+/** The magic number at the beginning of the trace files */
+#define TRAFFIC_MAGIC "RLETRACE"
+
+/** The length of the magic number */
+#define TRAFFIC_MAGIC_LEN 8U
+
+/** The version of the trace file format */
+#define TRAFFIC_VERSION 1U
+
+/** The length of the trace file header: magic, version, SDUs and bursts numbers */
+#define TRAFFIC_HDR_LEN (TRAFFIC_MAGIC_LEN + 3 * sizeof(uint32_t))
+
+/** The length of the record before every SDU content: size, ptype and frag_id */
+#define TRAFFIC_SDU_HDR_LEN 5U
+
+/** The length of the Ethernet header of the VLAN frames */
+#define TRAFFIC_ETH_HDR_LEN 14U
+
+/** The length of an ARP request for IPv4 over Ethernet */
+#define TRAFFIC_ARP_LEN 28U
+
+/** The names of the kinds of SDUs */
+static const char *const traffic_ptype_names[TRAFFIC_PTYPES_NR] = {
+	[TRAFFIC_PTYPE_IPV4] = "ipv4",
+	[TRAFFIC_PTYPE_IPV6] = "ipv6",
+	[TRAFFIC_PTYPE_VLAN] = "vlan",
+	[TRAFFIC_PTYPE_ARP] = "arp",
+	[TRAFFIC_PTYPE_SIGNAL] = "signal",
+};
+
+/** The uncompressed protocol types of the kinds of SDUs */
+static const uint16_t traffic_ptype_values[TRAFFIC_PTYPES_NR] = {
+	[TRAFFIC_PTYPE_IPV4] = RLE_PROTO_TYPE_IPV4_UNCOMP,
+	[TRAFFIC_PTYPE_IPV6] = RLE_PROTO_TYPE_IPV6_UNCOMP,
+	[TRAFFIC_PTYPE_VLAN] = RLE_PROTO_TYPE_VLAN_UNCOMP,
+	[TRAFFIC_PTYPE_ARP] = RLE_PROTO_TYPE_ARP_UNCOMP,
+	[TRAFFIC_PTYPE_SIGNAL] = RLE_PROTO_TYPE_SIGNAL_UNCOMP,
+};
+
+/** The minimal sizes of the kinds of SDUs, so that their headers are consistent */
+static const size_t traffic_ptype_min_sizes[TRAFFIC_PTYPES_NR] = {
+	[TRAFFIC_PTYPE_IPV4] = 20,
+	[TRAFFIC_PTYPE_IPV6] = 40,
+	[TRAFFIC_PTYPE_VLAN] = TRAFFIC_ETH_HDR_LEN + 4 + 20,
+	[TRAFFIC_PTYPE_ARP] = TRAFFIC_ARP_LEN,
+	[TRAFFIC_PTYPE_SIGNAL] = 1,
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PRIVATE FUNCTIONS CODE ------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief  Draw an index according to relative weights
+ *
+ * @param[in,out] state       The state of the pseudo-random generator
+ * @param[in]     weights     The relative weights
+ * @param[in]     weights_nr  The number of weights
+ * @param[in]     total       The sum of the weights, not 0
+ * @return                    The drawn index
+ */
+static size_t traffic_draw(uint64_t *const state, const unsigned int *const weights,
+                           const size_t weights_nr, const unsigned int total)
+{
+	unsigned int draw = traffic_rand(state) % total;
+	size_t i;
+
+	for (i = 0; i < weights_nr - 1; i++) {
+		if (draw < weights[i]) {
+			break;
+		}
+		draw -= weights[i];
+	}
+
+	return i;
+}
+
+/**
+ * @brief  Fill the headers of a generated SDU
+ *
+ * @param[in,out] sdu    The SDU, with its random content already written
+ * @param[in]     ptype  The kind of SDU
+ */
+static void traffic_fill_headers(struct traffic_sdu *const sdu, const enum traffic_ptype ptype)
+{
+	unsigned char *const data = sdu->data;
+	const size_t size = sdu->size;
+
+	switch (ptype) {
+	case TRAFFIC_PTYPE_IPV4:
+		data[0] = 0x45;
+		data[2] = (size >> 8) & 0xff;
+		data[3] = size & 0xff;
+		break;
+	case TRAFFIC_PTYPE_IPV6:
+		data[0] = 0x60;
+		data[4] = ((size - 40) >> 8) & 0xff;
+		data[5] = (size - 40) & 0xff;
+		break;
+	case TRAFFIC_PTYPE_VLAN:
+	{
+		/* Ethernet header with VLAN ethertype, TCI, then IPv4 ethertype and packet */
+		unsigned char *const ip = data + TRAFFIC_ETH_HDR_LEN + 4;
+		const size_t ip_len = size - TRAFFIC_ETH_HDR_LEN - 4;
+
+		data[12] = (RLE_PROTO_TYPE_VLAN_UNCOMP >> 8) & 0xff;
+		data[13] = RLE_PROTO_TYPE_VLAN_UNCOMP & 0xff;
+		data[16] = (RLE_PROTO_TYPE_IPV4_UNCOMP >> 8) & 0xff;
+		data[17] = RLE_PROTO_TYPE_IPV4_UNCOMP & 0xff;
+		ip[0] = 0x45;
+		ip[2] = (ip_len >> 8) & 0xff;
+		ip[3] = ip_len & 0xff;
+		break;
+	}
+	case TRAFFIC_PTYPE_ARP:
+		/* Ethernet, IPv4, 6-byte MAC, 4-byte address, request */
+		data[0] = 0x00;
+		data[1] = 0x01;
+		data[2] = 0x08;
+		data[3] = 0x00;
+		data[4] = 0x06;
+		data[5] = 0x04;
+		data[6] = 0x00;
+		data[7] = 0x01;
+		break;
+	case TRAFFIC_PTYPE_SIGNAL:
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief  Parse an unsigned number and move after it
+ *
+ * @param[in,out] str    The string to parse, moved after the number
+ * @param[out]    value  The parsed number
+ * @return               0 in case of success, -1 if there is no number
+ */
+static int traffic_parse_num(const char **const str, unsigned long *const value)
+{
+	char *end;
+
+	*value = strtoul(*str, &end, 10);
+	if (end == *str) {
+		return -1;
+	}
+	*str = end;
+
+	return 0;
+}
+
+/**
+ * @brief  Parse the optional ":WEIGHT" suffix of an item
+ *
+ * @param[in,out] str     The string to parse, moved after the weight
+ * @param[out]    weight  The parsed weight, 1 if not given
+ * @return                0 in case of success, -1 if the weight is malformed
+ */
+static int traffic_parse_weight(const char **const str, unsigned int *const weight)
+{
+	unsigned long value = 1;
+
+	if (**str == ':') {
+		(*str)++;
+		if (traffic_parse_num(str, &value) != 0) {
+			return -1;
+		}
+	}
+	if (**str != ',' && **str != '\0') {
+		return -1;
+	}
+	if (**str == ',') {
+		(*str)++;
+	}
+	*weight = value;
+
+	return 0;
+}
+
+/**
+ * @brief  Read a 16-bit or 32-bit big-endian number
+ *
+ * @param[in] data  The number
+ * @param[in] len   The length of the number (2 or 4)
+ * @return          The number
+ */
+static uint32_t traffic_get_be(const unsigned char *const data, const size_t len)
+{
+	uint32_t value = 0;
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		value = (value << 8) | data[i];
+	}
+
+	return value;
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+uint64_t traffic_rand_init(const uint32_t seed)
+{
+	return ((uint64_t)seed << 1) ^ 0x9e3779b97f4a7c15ULL;
+}
+
+uint32_t traffic_rand(uint64_t *const state)
+{
+	uint64_t x = *state;
+
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+
+	return (uint32_t)((x * 0x2545f4914f6cdd1dULL) >> 32);
+}
+
+void traffic_gen_conf_init(struct traffic_gen_conf *const conf)
+{
+	memset(conf, 0, sizeof(struct traffic_gen_conf));
+	traffic_gen_parse_sizes("imix", conf);
+	conf->ptype_weights[TRAFFIC_PTYPE_IPV4] = 1;
+	conf->flows_nr = 1;
+	conf->burst_min = 14;
+	conf->burst_max = 599;
+	conf->seed = 0;
+}
+
+int traffic_gen_parse_sizes(const char *const spec, struct traffic_gen_conf *const conf)
+{
+	const char *str = spec;
+	size_t sizes_nr = 0;
+
+	if (strcmp(spec, "imix") == 0) {
+		str = "40:7,576:4,1500:1";
+	}
+
+	while (*str != '\0') {
+		struct traffic_size_bin *const bin = &conf->sizes[sizes_nr];
+		unsigned long min;
+		unsigned long max;
+
+		if (sizes_nr >= TRAFFIC_MAX_SIZE_BINS) {
+			fprintf(stderr, "too many size bins, maximum = %d\n", TRAFFIC_MAX_SIZE_BINS);
+			return -1;
+		}
+		if (traffic_parse_num(&str, &min) != 0) {
+			goto malformed;
+		}
+		max = min;
+		if (*str == '-') {
+			str++;
+			if (traffic_parse_num(&str, &max) != 0) {
+				goto malformed;
+			}
+		}
+		if (min == 0 || max < min || max > RLE_MAX_PDU_SIZE) {
+			fprintf(stderr, "size bin %lu-%lu shall be within [1 ; %d]\n", min, max,
+			        RLE_MAX_PDU_SIZE);
+			return -1;
+		}
+		if (traffic_parse_weight(&str, &bin->weight) != 0) {
+			goto malformed;
+		}
+		bin->min = min;
+		bin->max = max;
+		sizes_nr++;
+	}
+	if (sizes_nr == 0) {
+		goto malformed;
+	}
+	conf->sizes_nr = sizes_nr;
+
+	return 0;
+
+malformed:
+	fprintf(stderr, "malformed size distribution '%s'\n", spec);
+	return -1;
+}
+
+int traffic_gen_parse_ptypes(const char *const spec, struct traffic_gen_conf *const conf)
+{
+	unsigned int weights[TRAFFIC_PTYPES_NR] = { 0 };
+	const char *str = spec;
+
+	while (*str != '\0') {
+		const size_t name_len = strcspn(str, ":,");
+		int ptype;
+
+		for (ptype = 0; ptype < TRAFFIC_PTYPES_NR; ptype++) {
+			if (strlen(traffic_ptype_names[ptype]) == name_len &&
+			    strncmp(str, traffic_ptype_names[ptype], name_len) == 0) {
+				break;
+			}
+		}
+		if (ptype == TRAFFIC_PTYPES_NR) {
+			goto malformed;
+		}
+		str += name_len;
+		if (traffic_parse_weight(&str, &weights[ptype]) != 0) {
+			goto malformed;
+		}
+	}
+	memcpy(conf->ptype_weights, weights, sizeof(weights));
+
+	return 0;
+
+malformed:
+	fprintf(stderr, "malformed protocol types mix '%s'\n", spec);
+	return -1;
+}
+
+int traffic_gen(const struct traffic_gen_conf *const conf, const size_t sdus_nr,
+                const size_t bursts_nr, struct traffic *const traffic)
+{
+	unsigned int size_weights[TRAFFIC_MAX_SIZE_BINS];
+	unsigned int sizes_total = 0;
+	unsigned int ptypes_total = 0;
+	uint64_t state = traffic_rand_init(conf->seed);
+	size_t *ptypes = NULL;
+	size_t data_len = 0;
+	size_t i;
+
+	memset(traffic, 0, sizeof(struct traffic));
+
+	for (i = 0; i < conf->sizes_nr; i++) {
+		size_weights[i] = conf->sizes[i].weight;
+		sizes_total += conf->sizes[i].weight;
+	}
+	for (i = 0; i < TRAFFIC_PTYPES_NR; i++) {
+		ptypes_total += conf->ptype_weights[i];
+	}
+	if (sizes_total == 0 || ptypes_total == 0) {
+		fprintf(stderr, "size distribution or protocol types mix is empty\n");
+		goto error;
+	}
+	if (conf->flows_nr < 1 || conf->flows_nr > RLE_MAX_FRAG_NUMBER) {
+		fprintf(stderr, "%u flows requested, only [1 ; %d] allowed\n", conf->flows_nr,
+		        RLE_MAX_FRAG_NUMBER);
+		goto error;
+	}
+	if (bursts_nr > 0 && (conf->burst_min == 0 || conf->burst_max < conf->burst_min ||
+	                      conf->burst_max > UINT16_MAX)) {
+		fprintf(stderr, "invalid burst sizes range [%zu ; %zu]\n", conf->burst_min,
+		        conf->burst_max);
+		goto error;
+	}
+
+	traffic->sdus = calloc(sdus_nr, sizeof(struct traffic_sdu));
+	ptypes = calloc(sdus_nr, sizeof(size_t));
+	traffic->bursts = calloc(bursts_nr + 1, sizeof(uint16_t));
+	if (traffic->sdus == NULL || ptypes == NULL || traffic->bursts == NULL) {
+		fprintf(stderr, "failed to allocate %zu SDUs\n", sdus_nr);
+		goto error;
+	}
+	traffic->sdus_nr = sdus_nr;
+
+	/* draw the kind, size and flow of every SDU first, to allocate all of them at once */
+	for (i = 0; i < sdus_nr; i++) {
+		const struct traffic_size_bin *const bin =
+			&conf->sizes[traffic_draw(&state, size_weights, conf->sizes_nr, sizes_total)];
+		size_t size = bin->min + traffic_rand(&state) % (bin->max - bin->min + 1);
+
+		ptypes[i] = traffic_draw(&state, conf->ptype_weights, TRAFFIC_PTYPES_NR,
+		                         ptypes_total);
+		if (ptypes[i] == TRAFFIC_PTYPE_ARP) {
+			size = TRAFFIC_ARP_LEN;
+		} else if (size < traffic_ptype_min_sizes[ptypes[i]]) {
+			size = traffic_ptype_min_sizes[ptypes[i]];
+		}
+		traffic->sdus[i].size = size;
+		traffic->sdus[i].protocol_type = traffic_ptype_values[ptypes[i]];
+		traffic->sdus[i].frag_id = traffic_rand(&state) % conf->flows_nr;
+		data_len += size;
+	}
+
+	traffic->data = malloc(data_len + 1);
+	if (traffic->data == NULL) {
+		fprintf(stderr, "failed to allocate %zu bytes of SDUs\n", data_len);
+		goto error;
+	}
+	traffic->data_len = data_len;
+
+	data_len = 0;
+	for (i = 0; i < sdus_nr; i++) {
+		struct traffic_sdu *const sdu = &traffic->sdus[i];
+		size_t j;
+
+		sdu->data = traffic->data + data_len;
+		data_len += sdu->size;
+		for (j = 0; j < sdu->size; j++) {
+			sdu->data[j] = traffic_rand(&state) & 0xff;
+		}
+		traffic_fill_headers(sdu, ptypes[i]);
+	}
+
+	for (i = 0; i < bursts_nr; i++) {
+		traffic->bursts[i] =
+			conf->burst_min + traffic_rand(&state) % (conf->burst_max - conf->burst_min + 1);
+	}
+	traffic->bursts_nr = bursts_nr;
+
+	free(ptypes);
+
+	return 0;
+
+error:
+	free(ptypes);
+	traffic_free(traffic);
+	return -1;
+}
+
+int traffic_write(const struct traffic *const traffic, const char *const filename)
+{
+	FILE *file;
+	uint32_t hdr[3];
+	size_t i;
+
+	if (traffic->sdus_nr > UINT32_MAX || traffic->bursts_nr > UINT32_MAX) {
+		fprintf(stderr, "too much traffic for a trace file\n");
+		goto error;
+	}
+
+	file = fopen(filename, "wb");
+	if (file == NULL) {
+		fprintf(stderr, "failed to create trace file '%s'\n", filename);
+		goto error;
+	}
+
+	hdr[0] = htonl(TRAFFIC_VERSION);
+	hdr[1] = htonl(traffic->sdus_nr);
+	hdr[2] = htonl(traffic->bursts_nr);
+	if (fwrite(TRAFFIC_MAGIC, TRAFFIC_MAGIC_LEN, 1, file) != 1 ||
+	    fwrite(hdr, sizeof(hdr), 1, file) != 1) {
+		goto write_error;
+	}
+
+	for (i = 0; i < traffic->bursts_nr; i++) {
+		const uint16_t burst = htons(traffic->bursts[i]);
+
+		if (fwrite(&burst, sizeof(burst), 1, file) != 1) {
+			goto write_error;
+		}
+	}
+
+	for (i = 0; i < traffic->sdus_nr; i++) {
+		const struct traffic_sdu *const sdu = &traffic->sdus[i];
+		const unsigned char sdu_hdr[TRAFFIC_SDU_HDR_LEN] = {
+			(sdu->size >> 8) & 0xff, sdu->size & 0xff,
+			(sdu->protocol_type >> 8) & 0xff, sdu->protocol_type & 0xff,
+			sdu->frag_id
+		};
+
+		if (fwrite(sdu_hdr, TRAFFIC_SDU_HDR_LEN, 1, file) != 1 ||
+		    fwrite(sdu->data, sdu->size, 1, file) != 1) {
+			goto write_error;
+		}
+	}
+
+	if (fclose(file) != 0) {
+		fprintf(stderr, "failed to write trace file '%s'\n", filename);
+		goto error;
+	}
+
+	return 0;
+
+write_error:
+	fprintf(stderr, "failed to write trace file '%s'\n", filename);
+	fclose(file);
+error:
+	return -1;
+}
+
+int traffic_read(const char *const filename, struct traffic *const traffic)
+{
+	unsigned char magic[TRAFFIC_MAGIC_LEN];
+	unsigned char *pos;
+	unsigned char *end;
+	FILE *file;
+	long file_len;
+	size_t i;
+	int status = -1;
+
+	memset(traffic, 0, sizeof(struct traffic));
+
+	file = fopen(filename, "rb");
+	if (file == NULL) {
+		fprintf(stderr, "failed to open trace file '%s'\n", filename);
+		goto error;
+	}
+
+	if (fread(magic, TRAFFIC_MAGIC_LEN, 1, file) != 1 ||
+	    memcmp(magic, TRAFFIC_MAGIC, TRAFFIC_MAGIC_LEN) != 0) {
+		status = 1;
+		goto close_file;
+	}
+
+	/* the whole file is kept in memory, SDUs point to their content in it */
+	if (fseek(file, 0, SEEK_END) != 0 || (file_len = ftell(file)) < 0 ||
+	    fseek(file, 0, SEEK_SET) != 0) {
+		fprintf(stderr, "failed to get the length of trace file '%s'\n", filename);
+		goto close_file;
+	}
+	traffic->data = malloc(file_len + 1);
+	if (traffic->data == NULL) {
+		fprintf(stderr, "failed to allocate %ld bytes for trace file '%s'\n", file_len,
+		        filename);
+		goto close_file;
+	}
+	traffic->data_len = file_len;
+	if (fread(traffic->data, 1, file_len, file) != (size_t)file_len) {
+		fprintf(stderr, "failed to read trace file '%s'\n", filename);
+		goto free_traffic;
+	}
+	pos = traffic->data + TRAFFIC_MAGIC_LEN;
+	end = traffic->data + file_len;
+
+	if ((size_t)file_len < TRAFFIC_HDR_LEN ||
+	    traffic_get_be(pos, sizeof(uint32_t)) != TRAFFIC_VERSION) {
+		fprintf(stderr, "unsupported version of trace file '%s'\n", filename);
+		goto free_traffic;
+	}
+	traffic->sdus_nr = traffic_get_be(pos + 4, sizeof(uint32_t));
+	traffic->bursts_nr = traffic_get_be(pos + 8, sizeof(uint32_t));
+	pos += 3 * sizeof(uint32_t);
+
+	traffic->sdus = calloc(traffic->sdus_nr + 1, sizeof(struct traffic_sdu));
+	traffic->bursts = calloc(traffic->bursts_nr + 1, sizeof(uint16_t));
+	if (traffic->sdus == NULL || traffic->bursts == NULL) {
+		fprintf(stderr, "failed to allocate %zu SDUs\n", traffic->sdus_nr);
+		goto free_traffic;
+	}
+
+	if ((size_t)(end - pos) < traffic->bursts_nr * sizeof(uint16_t)) {
+		goto truncated;
+	}
+	for (i = 0; i < traffic->bursts_nr; i++) {
+		traffic->bursts[i] = traffic_get_be(pos, sizeof(uint16_t));
+		pos += sizeof(uint16_t);
+	}
+
+	for (i = 0; i < traffic->sdus_nr; i++) {
+		struct traffic_sdu *const sdu = &traffic->sdus[i];
+
+		if ((size_t)(end - pos) < TRAFFIC_SDU_HDR_LEN) {
+			goto truncated;
+		}
+		sdu->size = traffic_get_be(pos, sizeof(uint16_t));
+		sdu->protocol_type = traffic_get_be(pos + 2, sizeof(uint16_t));
+		sdu->frag_id = pos[4];
+		pos += TRAFFIC_SDU_HDR_LEN;
+		if ((size_t)(end - pos) < sdu->size || sdu->size > RLE_MAX_PDU_SIZE ||
+		    sdu->frag_id >= RLE_MAX_FRAG_NUMBER) {
+			goto truncated;
+		}
+		sdu->data = pos;
+		pos += sdu->size;
+	}
+
+	status = 0;
+	goto close_file;
+
+truncated:
+	fprintf(stderr, "trace file '%s' is truncated or malformed\n", filename);
+free_traffic:
+	traffic_free(traffic);
+close_file:
+	fclose(file);
+error:
+	return status;
+}
+
+void traffic_free(struct traffic *const traffic)
+{
+	free(traffic->sdus);
+	free(traffic->data);
+	free(traffic->bursts);
+	memset(traffic, 0, sizeof(struct traffic));
+}
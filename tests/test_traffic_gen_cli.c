@@ -0,0 +1,308 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_traffic_gen_cli.c
+ * @brief  Generate synthetic traffic into a compact trace file, an indexed trace file or a
+ *         PCAP file.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* system includes */
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pcap/pcap.h>
+#include <pcap.h>
+#include <getopt.h>
+
+#include "rle.h"
+#include "test_traffic_gen.h"
+#include "test_trace.h"
+
+/** The program version */
+#define TEST_VERSION  "RLE traffic generator application, version 0.0.1\n"
+
+/** The length (in bytes) of the Ethernet header */
+#define ETHER_HDR_LEN  14U
+
+/** The default number of SDUs */
+#define DEFAULT_SDUS_NR 10000U
+
+/** The default number of burst sizes in the schedule */
+#define DEFAULT_BURSTS_NR 1000U
+
+/* prototypes of private functions */
+static void usage(void);
+static int write_pcap(const struct traffic *const traffic, const char *const filename);
+
+
+/**
+ * @brief Main function for the RLE traffic generator program
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	struct traffic_gen_conf conf;
+	struct traffic traffic;
+	size_t sdus_nr = DEFAULT_SDUS_NR;
+	size_t bursts_nr = DEFAULT_BURSTS_NR;
+	bool pcap_output = false;
+	bool indexed_output = false;
+	size_t i;
+
+	traffic_gen_conf_init(&conf);
+
+	while (1) {
+		int c;
+
+		static struct option long_options[] =
+		{
+			{ "count", required_argument, 0, 'n' },
+			{ "sizes", required_argument, 0, 'S' },
+			{ "ptypes", required_argument, 0, 'p' },
+			{ "flows", required_argument, 0, 'f' },
+			{ "bursts", required_argument, 0, 'B' },
+			{ "burst_min", required_argument, 0, 'm' },
+			{ "burst_max", required_argument, 0, 'M' },
+			{ "seed", required_argument, 0, 'r' },
+			{ "pcap", no_argument, 0, 'P' },
+			{ "indexed", no_argument, 0, 'I' },
+			{ 0, 0, 0, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, "vhn:S:p:f:B:m:M:r:PI", long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'n': /* Number of SDUs */
+			assert(optarg != NULL);
+			sdus_nr = strtoul(optarg, NULL, 10);
+			if (sdus_nr == 0) {
+				printf("ERROR: at least one SDU is required\n");
+				goto error;
+			}
+			break;
+		case 'S': /* Size distribution */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_sizes(optarg, &conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'p': /* Protocol types mix */
+			assert(optarg != NULL);
+			if (traffic_gen_parse_ptypes(optarg, &conf) != 0) {
+				goto error;
+			}
+			break;
+		case 'f': /* Number of flows */
+			assert(optarg != NULL);
+			conf.flows_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'B': /* Number of burst sizes */
+			assert(optarg != NULL);
+			bursts_nr = strtoul(optarg, NULL, 10);
+			break;
+		case 'm': /* Minimal burst size */
+			assert(optarg != NULL);
+			conf.burst_min = strtoul(optarg, NULL, 10);
+			break;
+		case 'M': /* Maximal burst size */
+			assert(optarg != NULL);
+			conf.burst_max = strtoul(optarg, NULL, 10);
+			break;
+		case 'r': /* Seed */
+			assert(optarg != NULL);
+			conf.seed = strtoul(optarg, NULL, 10);
+			break;
+		case 'P': /* PCAP output */
+			pcap_output = true;
+			break;
+		case 'I': /* Indexed trace output */
+			indexed_output = true;
+			break;
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc - 1) {
+		fprintf(stderr, "OUTPUT is a mandatory parameter\n\n");
+		usage();
+		goto error;
+	}
+
+	if (traffic_gen(&conf, sdus_nr, bursts_nr, &traffic) != 0) {
+		goto error;
+	}
+
+	if (pcap_output) {
+		if (write_pcap(&traffic, argv[optind]) != 0) {
+			goto free_traffic;
+		}
+	} else if (indexed_output) {
+		if (trace_write_traffic(&traffic, argv[optind]) != 0) {
+			goto free_traffic;
+		}
+	} else if (traffic_write(&traffic, argv[optind]) != 0) {
+		goto free_traffic;
+	}
+
+	printf("%zu SDUs (%zu bytes", traffic.sdus_nr, traffic.data_len);
+	if (!pcap_output && !indexed_output) {
+		printf(", %zu burst sizes", traffic.bursts_nr);
+	}
+	printf(") written in %s\n", argv[optind]);
+	for (i = 0; i < conf.sizes_nr; i++) {
+		printf("\tsizes [%zu ; %zu] weight %u\n", conf.sizes[i].min, conf.sizes[i].max,
+		       conf.sizes[i].weight);
+	}
+
+	status = EXIT_SUCCESS;
+
+free_traffic:
+	traffic_free(&traffic);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the traffic generator application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE traffic generator: generate synthetic SDUs for the benchmarks and the stress\n"
+	        "tests, in a compact trace file, in an indexed trace file or in a PCAP file.\n"
+	        "\n"
+	        "usage: test_traffic_gen [OPTIONS] OUTPUT\n"
+	        "\n"
+	        "with:\n"
+	        "  OUTPUT                  The trace (or PCAP) file to create\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --count, -n             Number of SDUs (default 10000)\n"
+	        "  --sizes, -S             Size distribution: 'imix' (default) or a list of\n"
+	        "                          SIZE[-MAX][:WEIGHT], e.g. '40:7,576:4,1500:1'\n"
+	        "  --ptypes, -p            Protocol types mix: a list of NAME[:WEIGHT] among\n"
+	        "                          ipv4, ipv6, vlan, arp and signal (default 'ipv4')\n"
+	        "  --flows, -f             Number of flows, one per frag_id (default 1)\n"
+	        "  --bursts, -B            Number of burst sizes in the schedule (default 1000)\n"
+	        "  --burst_min, -m         Minimal burst size of the schedule (default 14)\n"
+	        "  --burst_max, -M         Maximal burst size of the schedule (default 599)\n"
+	        "  --seed, -r              Seed of the generator (default 0)\n"
+	        "  --pcap, -P              Write Ethernet frames in a PCAP file instead of a trace\n"
+	        "                          file, flows and burst sizes are lost\n"
+	        "  --indexed, -I           Write an indexed trace file, mapped in memory by the\n"
+	        "                          benchmarks, instead of a compact trace file, burst\n"
+	        "                          sizes are lost\n");
+
+	return;
+}
+
+
+/**
+ * @brief Write traffic as Ethernet frames in a PCAP file
+ *
+ * VLAN SDUs are already Ethernet frames, other SDUs get an Ethernet header with their
+ * protocol type.
+ *
+ * @param[in] traffic   The traffic to write
+ * @param[in] filename  The name of the PCAP file
+ * @return              0 in case of success, 1 otherwise
+ */
+static int write_pcap(const struct traffic *const traffic, const char *const filename)
+{
+	unsigned char frame[ETHER_HDR_LEN + RLE_MAX_PDU_SIZE];
+	pcap_t *handle;
+	pcap_dumper_t *dumper;
+	size_t i;
+	int status = 1;
+
+	handle = pcap_open_dead(DLT_EN10MB, ETHER_HDR_LEN + RLE_MAX_PDU_SIZE);
+	if (handle == NULL) {
+		fprintf(stderr, "failed to create the PCAP handle\n");
+		goto error;
+	}
+	dumper = pcap_dump_open(handle, filename);
+	if (dumper == NULL) {
+		fprintf(stderr, "failed to create PCAP file '%s': %s\n", filename,
+		        pcap_geterr(handle));
+		goto close_handle;
+	}
+
+	memset(frame, 0, ETHER_HDR_LEN);
+	for (i = 0; i < traffic->sdus_nr; i++) {
+		const struct traffic_sdu *const sdu = &traffic->sdus[i];
+		struct pcap_pkthdr header;
+
+		memset(&header, 0, sizeof(struct pcap_pkthdr));
+		header.ts.tv_sec = i / 1000000;
+		header.ts.tv_usec = i % 1000000;
+		if (sdu->protocol_type == RLE_PROTO_TYPE_VLAN_UNCOMP) {
+			header.len = sdu->size;
+			header.caplen = sdu->size;
+			pcap_dump((unsigned char *)dumper, &header, sdu->data);
+		} else {
+			frame[ETHER_HDR_LEN - 2] = (sdu->protocol_type >> 8) & 0xff;
+			frame[ETHER_HDR_LEN - 1] = sdu->protocol_type & 0xff;
+			memcpy(frame + ETHER_HDR_LEN, sdu->data, sdu->size);
+			header.len = ETHER_HDR_LEN + sdu->size;
+			header.caplen = ETHER_HDR_LEN + sdu->size;
+			pcap_dump((unsigned char *)dumper, &header, frame);
+		}
+	}
+
+	status = 0;
+
+	pcap_dump_close(dumper);
+close_handle:
+	pcap_close(handle);
+error:
+	return status;
+}
@@ -0,0 +1,364 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2026, agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_tx_pool.c
+ * @brief  Work-stealing pool of threads to build the bursts of many transmitters.
+ * @author agent <agent@local>
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, agent <agent@local>
+ */
+
+/* for pthread_attr_setaffinity_np() */
+#define _GNU_SOURCE
+
+#include "test_tx_pool.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+/** The length of a cache line, the ends of the deques are kept on their own lines */
+#define TX_POOL_CACHE_LINE 64U
+
+/** The tasks of a worker not started yet, the range [top ; bottom[ of the task ids.
+ *  The owner takes the tasks at the bottom, the thieves at the top (Chase-Lev deque,
+ *  without any array since the tasks of a run are contiguous ids). */
+struct tx_deque {
+	int64_t top;                                           /**< Moved by the thieves */
+	unsigned char pad_top[TX_POOL_CACHE_LINE - sizeof(int64_t)];
+	int64_t bottom;                                        /**< Moved by the owner */
+	unsigned char pad_bottom[TX_POOL_CACHE_LINE - sizeof(int64_t)];
+};
+
+/** One worker of the pool */
+struct tx_worker {
+	struct tx_deque deque;         /**< The tasks of the worker */
+	struct tx_pool *pool;          /**< The pool of the worker */
+	size_t id;                     /**< The worker id, 0 for the calling thread */
+	pthread_t thread;              /**< The thread of the worker */
+	bool started;                  /**< Whether the thread runs or not */
+	struct tx_pool_stats stats;    /**< The statistics, written by the worker only */
+	unsigned char pad[TX_POOL_CACHE_LINE];
+};
+
+/** The pool */
+struct tx_pool {
+	size_t workers_nr;           /**< The number of workers, including the calling thread */
+	struct tx_worker **workers;  /**< The workers */
+	pthread_mutex_t lock;        /**< Protects the fields below */
+	pthread_cond_t start;        /**< Signaled when a run starts or the pool stops */
+	pthread_cond_t done;         /**< Signaled when the last thread ends its run */
+	uint64_t generation;         /**< The number of runs started */
+	size_t threads_nr;           /**< The number of threads started */
+	size_t done_nr;              /**< The number of threads that ended the current run */
+	int stop;                    /**< Whether the threads shall stop or not */
+	tx_pool_task_t task;         /**< The function of the current run */
+	void *arg;                   /**< The argument of the current run */
+	int error;                   /**< Whether a task of the current run failed or not */
+};
+
+/* prototypes of private functions */
+static bool tx_deque_pop(struct tx_deque *const deque, size_t *const task_id);
+static bool tx_deque_steal(struct tx_deque *const deque, size_t *const task_id);
+static void tx_worker_work(struct tx_worker *const worker);
+static void * tx_worker_run(void *const arg);
+
+
+/**
+ * @brief  Take the newest task of a deque, by its owner
+ *
+ * @param[in,out] deque    The deque of the worker
+ * @param[out]    task_id  The task
+ * @return                 true if a task was taken, false if the deque is empty
+ */
+static bool tx_deque_pop(struct tx_deque *const deque, size_t *const task_id)
+{
+	const int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+	int64_t top;
+
+	__atomic_store_n(&deque->bottom, bottom, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	top = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+	if (top > bottom) {
+		/* empty */
+		__atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+		return false;
+	}
+	if (top == bottom) {
+		/* last task, race with the thieves */
+		const bool won = __atomic_compare_exchange_n(&deque->top, &top, top + 1, false,
+		                                             __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+
+		__atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+		if (!won) {
+			return false;
+		}
+	}
+	*task_id = bottom;
+
+	return true;
+}
+
+/**
+ * @brief  Take the oldest task of a deque, by another worker
+ *
+ * @param[in,out] deque    The deque of the victim
+ * @param[out]    task_id  The task
+ * @return                 true if a task was stolen, false if the deque is empty
+ */
+static bool tx_deque_steal(struct tx_deque *const deque, size_t *const task_id)
+{
+	while (1) {
+		int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+		int64_t bottom;
+
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+		if (top >= bottom) {
+			return false;
+		}
+		if (__atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST,
+		                                __ATOMIC_RELAXED)) {
+			*task_id = top;
+			return true;
+		}
+		/* another thief or the owner took it, try the next one */
+	}
+}
+
+/**
+ * @brief  Run the tasks of a worker, then steal the ones of the others until none is left
+ *
+ *         No task is added during a run, so the run ends for the worker once all the deques
+ *         are seen empty.
+ *
+ * @param[in,out] worker  The worker
+ */
+static void tx_worker_work(struct tx_worker *const worker)
+{
+	struct tx_pool *const pool = worker->pool;
+	size_t task_id;
+
+	worker->stats.runs_nr++;
+	while (!__atomic_load_n(&pool->error, __ATOMIC_RELAXED)) {
+		bool found = false;
+		size_t i;
+
+		if (tx_deque_pop(&worker->deque, &task_id)) {
+			found = true;
+		} else {
+			for (i = 1; i < pool->workers_nr && !found; i++) {
+				struct tx_worker *const victim =
+					pool->workers[(worker->id + i) % pool->workers_nr];
+
+				if (tx_deque_steal(&victim->deque, &task_id)) {
+					worker->stats.steals_nr++;
+					found = true;
+				}
+			}
+		}
+		if (!found) {
+			break;
+		}
+
+		worker->stats.tasks_nr++;
+		if (pool->task(pool->arg, task_id, worker->id) != 0) {
+			__atomic_store_n(&pool->error, 1, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+/**
+ * @brief  The loop of a worker thread: wait for a run, work, then signal its end
+ *
+ * @param[in,out] arg  The worker
+ * @return             NULL
+ */
+static void * tx_worker_run(void *const arg)
+{
+	struct tx_worker *const worker = arg;
+	struct tx_pool *const pool = worker->pool;
+	uint64_t generation = 0;
+
+	pthread_mutex_lock(&pool->lock);
+	while (1) {
+		while (pool->generation == generation && !pool->stop) {
+			pthread_cond_wait(&pool->start, &pool->lock);
+		}
+		if (pool->stop) {
+			break;
+		}
+		generation = pool->generation;
+		pthread_mutex_unlock(&pool->lock);
+
+		tx_worker_work(worker);
+
+		pthread_mutex_lock(&pool->lock);
+		pool->done_nr++;
+		if (pool->done_nr == pool->threads_nr) {
+			pthread_cond_signal(&pool->done);
+		}
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return NULL;
+}
+
+struct tx_pool * tx_pool_new(const size_t workers_nr, const int *const cpus)
+{
+	struct tx_pool *pool;
+	size_t i;
+
+	if (workers_nr == 0) {
+		fprintf(stderr, "invalid configuration of the transmitters pool\n");
+		goto error;
+	}
+
+	pool = calloc(1, sizeof(struct tx_pool));
+	if (pool == NULL) {
+		goto error;
+	}
+	pool->workers_nr = workers_nr;
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->start, NULL);
+	pthread_cond_init(&pool->done, NULL);
+	pool->workers = calloc(workers_nr, sizeof(struct tx_worker *));
+	if (pool->workers == NULL) {
+		goto destroy;
+	}
+
+	for (i = 0; i < workers_nr; i++) {
+		if (posix_memalign((void **)&pool->workers[i], TX_POOL_CACHE_LINE,
+		                   sizeof(struct tx_worker)) != 0) {
+			pool->workers[i] = NULL;
+			fprintf(stderr, "failed to allocate worker #%zu\n", i + 1);
+			goto destroy;
+		}
+		memset(pool->workers[i], 0, sizeof(struct tx_worker));
+		pool->workers[i]->pool = pool;
+		pool->workers[i]->id = i;
+	}
+
+	if (cpus != NULL) {
+		cpu_set_t cpu_set;
+
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cpus[0], &cpu_set);
+		pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+	}
+	for (i = 1; i < workers_nr; i++) {
+		struct tx_worker *const worker = pool->workers[i];
+		pthread_attr_t attr;
+		int ret;
+
+		pthread_attr_init(&attr);
+		if (cpus != NULL) {
+			cpu_set_t cpu_set;
+
+			CPU_ZERO(&cpu_set);
+			CPU_SET(cpus[i], &cpu_set);
+			pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpu_set);
+		}
+		ret = pthread_create(&worker->thread, &attr, tx_worker_run, worker);
+		pthread_attr_destroy(&attr);
+		if (ret != 0) {
+			fprintf(stderr, "failed to start worker #%zu\n", i + 1);
+			goto destroy;
+		}
+		worker->started = true;
+		pool->threads_nr++;
+	}
+
+	return pool;
+
+destroy:
+	tx_pool_destroy(pool);
+error:
+	return NULL;
+}
+
+int tx_pool_run(struct tx_pool *const pool, const size_t tasks_nr, const tx_pool_task_t task,
+                void *const arg)
+{
+	size_t i;
+
+	/* the deques are set while the threads wait, the lock publishes them */
+	pthread_mutex_lock(&pool->lock);
+	for (i = 0; i < pool->workers_nr; i++) {
+		struct tx_deque *const deque = &pool->workers[i]->deque;
+
+		deque->top = i * tasks_nr / pool->workers_nr;
+		deque->bottom = (i + 1) * tasks_nr / pool->workers_nr;
+	}
+	pool->task = task;
+	pool->arg = arg;
+	pool->error = 0;
+	pool->done_nr = 0;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+
+	tx_worker_work(pool->workers[0]);
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->done_nr < pool->threads_nr) {
+		pthread_cond_wait(&pool->done, &pool->lock);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return pool->error ? -1 : 0;
+}
+
+void tx_pool_get_stats(const struct tx_pool *const pool, const size_t worker_id,
+                       struct tx_pool_stats *const stats)
+{
+	*stats = pool->workers[worker_id]->stats;
+}
+
+void tx_pool_destroy(struct tx_pool *const pool)
+{
+	size_t i;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+
+	if (pool->workers != NULL) {
+		for (i = 0; i < pool->workers_nr; i++) {
+			if (pool->workers[i] != NULL && pool->workers[i]->started) {
+				pthread_join(pool->workers[i]->thread, NULL);
+			}
+		}
+		for (i = 0; i < pool->workers_nr; i++) {
+			free(pool->workers[i]);
+		}
+	}
+	free(pool->workers);
+	pthread_cond_destroy(&pool->done);
+	pthread_cond_destroy(&pool->start);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool);
+}